@@ -1156,6 +1156,44 @@ public:
    */
   virtual void modifyTapeDrive(const common::dataStructures::TapeDrive &tapeDrive) = 0;
 
+  /**
+   * Modifies the statuses reported by the tape servers for several Tape Drives at once. The desired
+   * state, the user comment, the disk space reservation, the configuration and the creation log of the
+   * drives are left unchanged. The drives which do not exist are ignored.
+   * @param tapeDrives The Tape Drives with their reported statuses.
+   */
+  virtual void modifyTapeDriveStatuses(const std::list<common::dataStructures::TapeDrive> &tapeDrives) = 0;
+
+  /**
+   * Gets the disk space reserved by all the Tape Drives, summed per disk system.
+   * @return The reserved bytes, by disk system name.
+   */
+  virtual std::map<std::string, uint64_t> getDiskSpaceReservations() const = 0;
+
+  /**
+   * Adds a disk space reservation to the specified Tape Drive, provided that the disk space reserved by all the
+   * Tape Drives for the disk system does not exceed maxReservedBytes afterwards. The check and the reservation are
+   * atomic with respect to the reservations of the other Tape Drives for the same disk system.
+   * @param tapeDriveName The name of the tape drive (nothing is reserved if it does not exist).
+   * @param diskSystemName The name of the disk system.
+   * @param bytes The number of bytes to reserve.
+   * @param maxReservedBytes The maximum number of bytes reserved for the disk system.
+   * @return false if the reservation would exceed maxReservedBytes.
+   */
+  virtual bool reserveDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName,
+    const uint64_t bytes, const uint64_t maxReservedBytes) = 0;
+
+  /**
+   * Removes a disk space reservation from the specified Tape Drive.
+   * @param tapeDriveName The name of the tape drive.
+   * @param diskSystemName The name of the disk system.
+   * @param bytes The number of bytes to release.
+   * @return false if the tape drive does not exist or has less than bytes reserved, in which case nothing is
+   * changed.
+   */
+  virtual bool releaseDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName,
+    const uint64_t bytes) = 0;
+
   /**
    * Deletes the entry of a Tape Drive
    * @param tapeDriveName The name of the tape drive.
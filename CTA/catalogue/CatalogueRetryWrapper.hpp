@@ -643,6 +643,24 @@ public:
     return retryOnLostConnection(m_log,[&]{return m_catalogue->modifyTapeDrive(tapeDrive);},m_maxTriesToConnect);
   }
 
+  void modifyTapeDriveStatuses(const std::list<common::dataStructures::TapeDrive> &tapeDrives) override {
+    return retryOnLostConnection(m_log,[&]{return m_catalogue->modifyTapeDriveStatuses(tapeDrives);},m_maxTriesToConnect);
+  }
+
+  std::map<std::string, uint64_t> getDiskSpaceReservations() const override {
+    return retryOnLostConnection(m_log,[&]{return m_catalogue->getDiskSpaceReservations();},m_maxTriesToConnect);
+  }
+
+  bool reserveDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName, const uint64_t bytes,
+    const uint64_t maxReservedBytes) override {
+    return retryOnLostConnection(m_log,[&]{return m_catalogue->reserveDiskSpace(tapeDriveName, diskSystemName, bytes, maxReservedBytes);},m_maxTriesToConnect);
+  }
+
+  bool releaseDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName,
+    const uint64_t bytes) override {
+    return retryOnLostConnection(m_log,[&]{return m_catalogue->releaseDiskSpace(tapeDriveName, diskSystemName, bytes);},m_maxTriesToConnect);
+  }
+
   void deleteTapeDrive(const std::string &tapeDriveName) override {
     return retryOnLostConnection(m_log,[&]{return m_catalogue->deleteTapeDrive(tapeDriveName);},m_maxTriesToConnect);
   }
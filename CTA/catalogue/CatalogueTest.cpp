@@ -11127,6 +11127,82 @@ TEST_P(cta_catalogue_CatalogueTest, filesWrittenToTape_1_file_recycle_log_delete
   ASSERT_NO_THROW(m_catalogue->deleteStorageClass(m_storageClassSingleCopy.name));
 }
 
+TEST_P(cta_catalogue_CatalogueTest, filesWrittenToTape_tape_statistics_maintained_incrementally) {
+  using namespace cta;
+
+  log::LogContext dummyLc(m_dummyLog);
+
+  const std::string diskInstance = "disk_instance";
+  const bool logicalLibraryIsDisabled= false;
+  const uint64_t nbPartialTapes = 2;
+  const bool isEncrypted = true;
+  const cta::optional<std::string> supply("value for the supply pool mechanism");
+
+  m_catalogue->createMediaType(m_admin, m_mediaType);
+  m_catalogue->createLogicalLibrary(m_admin, m_tape1.logicalLibraryName, logicalLibraryIsDisabled, "Create logical library");
+  m_catalogue->createVirtualOrganization(m_admin, m_vo);
+  m_catalogue->createTapePool(m_admin, m_tape1.tapePoolName, m_vo.name, nbPartialTapes, isEncrypted, supply, "Create tape pool");
+  m_catalogue->createTape(m_admin, m_tape1);
+  m_catalogue->createStorageClass(m_admin, m_storageClassSingleCopy);
+
+  const std::string tapeDrive = "tape_drive";
+  std::set<cta::catalogue::TapeItemWrittenPointer> filesWrittenSet;
+  for(uint64_t i = 1; i <= 2; i++) {
+    auto fileWrittenUP=cta::make_unique<cta::catalogue::TapeFileWritten>();
+    auto & fileWritten = *fileWrittenUP;
+    fileWritten.archiveFileId        = i;
+    fileWritten.diskInstance         = diskInstance;
+    fileWritten.diskFileId           = std::to_string(i);
+    fileWritten.diskFileOwnerUid     = PUBLIC_DISK_USER;
+    fileWritten.diskFileGid          = PUBLIC_DISK_GROUP;
+    fileWritten.size                 = i * 1000;
+    fileWritten.checksumBlob.insert(checksum::ADLER32, "1234");
+    fileWritten.storageClassName     = m_storageClassSingleCopy.name;
+    fileWritten.vid                  = m_tape1.vid;
+    fileWritten.fSeq                 = i;
+    fileWritten.blockId              = i * 100;
+    fileWritten.copyNb               = 1;
+    fileWritten.tapeDrive            = tapeDrive;
+    filesWrittenSet.insert(fileWrittenUP.release());
+  }
+  m_catalogue->filesWrittenToTape(filesWrittenSet);
+
+  {
+    catalogue::TapeSearchCriteria searchCriteria;
+    searchCriteria.vid = m_tape1.vid;
+    std::list<common::dataStructures::Tape> tapes = m_catalogue->getTapes(searchCriteria);
+    ASSERT_EQ(1, tapes.size());
+    const common::dataStructures::Tape &tape = tapes.front();
+    ASSERT_EQ(2, tape.lastFSeq);
+    ASSERT_EQ(2, tape.nbMasterFiles);
+    ASSERT_EQ(3000, tape.masterDataInBytes);
+  }
+
+  {
+    const common::dataStructures::ArchiveFile archiveFile = m_catalogue->getArchiveFileById(1);
+
+    cta::common::dataStructures::DeleteArchiveRequest deletedArchiveReq;
+    deletedArchiveReq.archiveFile = archiveFile;
+    deletedArchiveReq.diskInstance = diskInstance;
+    deletedArchiveReq.archiveFileID = archiveFile.archiveFileID;
+    deletedArchiveReq.diskFileId = archiveFile.diskFileId;
+    deletedArchiveReq.recycleTime = time(nullptr);
+    deletedArchiveReq.requester = cta::common::dataStructures::RequesterIdentity(m_admin.username,"group");
+    deletedArchiveReq.diskFilePath = "/path/";
+    m_catalogue->moveArchiveFileToRecycleLog(deletedArchiveReq,dummyLc);
+  }
+
+  {
+    catalogue::TapeSearchCriteria searchCriteria;
+    searchCriteria.vid = m_tape1.vid;
+    std::list<common::dataStructures::Tape> tapes = m_catalogue->getTapes(searchCriteria);
+    ASSERT_EQ(1, tapes.size());
+    const common::dataStructures::Tape &tape = tapes.front();
+    ASSERT_EQ(1, tape.nbMasterFiles);
+    ASSERT_EQ(2000, tape.masterDataInBytes);
+  }
+}
+
 TEST_P(cta_catalogue_CatalogueTest, filesWrittenToTape_1_archive_file_2_tape_copies) {
   using namespace cta;
 
@@ -16056,6 +16132,90 @@ TEST_P(cta_catalogue_CatalogueTest, modifyTapeDrive) {
   m_catalogue->deleteTapeDrive(tapeDrive2.driveName);
 }
 
+TEST_P(cta_catalogue_CatalogueTest, modifyTapeDriveStatuses) {
+  using namespace cta;
+
+  const std::list<std::string> tapeDriveNames = {"VDSTK11", "VDSTK12"};
+  std::list<common::dataStructures::TapeDrive> tapeDriveStatuses;
+  for (const auto &tapeDriveName : tapeDriveNames) {
+    m_catalogue->createTapeDrive(getTapeDriveWithAllElements(tapeDriveName));
+    auto tapeDriveStatus = getTapeDriveWithMandatoryElements(tapeDriveName);
+    tapeDriveStatus.driveStatus = common::dataStructures::DriveStatus::Transferring;
+    tapeDriveStatus.mountType = common::dataStructures::MountType::Retrieve;
+    tapeDriveStatus.sessionId = 42;
+    tapeDriveStatus.bytesTransferedInSession = 1000;
+    tapeDriveStatus.currentVid = "VIDTHREE";
+    tapeDriveStatus.desiredUp = true;
+    tapeDriveStatus.userComment = "Ignored comment";
+    tapeDriveStatus.diskSystemName = "ignoredDiskSystemName";
+    tapeDriveStatus.reservedBytes = 1;
+    tapeDriveStatuses.push_back(tapeDriveStatus);
+  }
+  // Drives which do not exist are ignored
+  tapeDriveStatuses.push_back(getTapeDriveWithMandatoryElements("VDSTK13"));
+  m_catalogue->modifyTapeDriveStatuses(tapeDriveStatuses);
+
+  for (const auto &tapeDriveName : tapeDriveNames) {
+    const auto tapeDrive = getTapeDriveWithAllElements(tapeDriveName);
+    const auto storedTapeDrive = m_catalogue->getTapeDrive(tapeDriveName);
+    ASSERT_TRUE(static_cast<bool>(storedTapeDrive));
+    ASSERT_EQ(common::dataStructures::DriveStatus::Transferring, storedTapeDrive.value().driveStatus);
+    ASSERT_EQ(common::dataStructures::MountType::Retrieve, storedTapeDrive.value().mountType);
+    ASSERT_EQ(42U, storedTapeDrive.value().sessionId.value());
+    ASSERT_EQ(1000U, storedTapeDrive.value().bytesTransferedInSession.value());
+    ASSERT_EQ("VIDTHREE", storedTapeDrive.value().currentVid.value());
+    // The desired state, the comment and the disk space reservation are not modified
+    ASSERT_EQ(tapeDrive.desiredUp, storedTapeDrive.value().desiredUp);
+    ASSERT_EQ(tapeDrive.userComment, storedTapeDrive.value().userComment);
+    ASSERT_EQ(tapeDrive.diskSystemName, storedTapeDrive.value().diskSystemName);
+    ASSERT_EQ(tapeDrive.reservedBytes, storedTapeDrive.value().reservedBytes);
+    m_catalogue->deleteTapeDrive(tapeDriveName);
+  }
+  ASSERT_FALSE(static_cast<bool>(m_catalogue->getTapeDrive("VDSTK13")));
+}
+
+TEST_P(cta_catalogue_CatalogueTest, reserveAndReleaseDiskSpace) {
+  using namespace cta;
+
+  const std::list<std::string> tapeDriveNames = {"VDSTK11", "VDSTK12", "VDSTK13"};
+  for (const auto &tapeDriveName : tapeDriveNames) {
+    auto tapeDrive = getTapeDriveWithMandatoryElements(tapeDriveName);
+    tapeDrive.diskSystemName = "NULL";
+    tapeDrive.reservedBytes = 0;
+    m_catalogue->createTapeDrive(tapeDrive);
+  }
+
+  ASSERT_TRUE(m_catalogue->reserveDiskSpace("VDSTK11", "diskSystem1", 600, 1000));
+  ASSERT_TRUE(m_catalogue->reserveDiskSpace("VDSTK12", "diskSystem1", 400, 1000));
+  // The reservations of the other drives count against the limit of the disk system
+  ASSERT_FALSE(m_catalogue->reserveDiskSpace("VDSTK13", "diskSystem1", 1, 1000));
+  ASSERT_TRUE(m_catalogue->reserveDiskSpace("VDSTK13", "diskSystem2", 1, 1000));
+  // Reservations for a drive which does not exist are ignored
+  ASSERT_TRUE(m_catalogue->reserveDiskSpace("VDSTK14", "diskSystem2", 1, 1000));
+  {
+    const auto reservations = m_catalogue->getDiskSpaceReservations();
+    ASSERT_EQ(2U, reservations.size());
+    ASSERT_EQ(1000U, reservations.at("diskSystem1"));
+    ASSERT_EQ(1U, reservations.at("diskSystem2"));
+  }
+  ASSERT_EQ(600U, m_catalogue->getTapeDrive("VDSTK11").value().reservedBytes);
+  ASSERT_EQ("diskSystem1", m_catalogue->getTapeDrive("VDSTK11").value().diskSystemName);
+
+  ASSERT_TRUE(m_catalogue->releaseDiskSpace("VDSTK11", "diskSystem1", 500));
+  // The reservation of a drive never becomes negative
+  ASSERT_FALSE(m_catalogue->releaseDiskSpace("VDSTK11", "diskSystem1", 101));
+  ASSERT_FALSE(m_catalogue->releaseDiskSpace("VDSTK14", "diskSystem1", 1));
+  ASSERT_EQ(100U, m_catalogue->getTapeDrive("VDSTK11").value().reservedBytes);
+  ASSERT_TRUE(m_catalogue->releaseDiskSpace("VDSTK13", "diskSystem2", 1));
+  ASSERT_TRUE(m_catalogue->reserveDiskSpace("VDSTK13", "diskSystem1", 500, 1000));
+  ASSERT_EQ(1000U, m_catalogue->getDiskSpaceReservations().at("diskSystem1"));
+
+  for (const auto &tapeDriveName : tapeDriveNames) {
+    m_catalogue->deleteTapeDrive(tapeDriveName);
+  }
+  ASSERT_TRUE(m_catalogue->getDiskSpaceReservations().empty());
+}
+
 TEST_P(cta_catalogue_CatalogueTest, getDriveConfig) {
   using namespace cta;
 
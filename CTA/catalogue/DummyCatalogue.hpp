@@ -21,6 +21,7 @@
 
 #include "Catalogue.hpp"
 #include "common/make_unique.hpp"
+#include "common/threading/MutexLocker.hpp"
 
 namespace cta {
 
@@ -277,6 +278,33 @@ public:
     m_tapeDriveStatus = tapeDrive;
   }
 
+  void modifyTapeDriveStatuses(const std::list<common::dataStructures::TapeDrive> &tapeDrives) {
+    for (const auto &tapeDrive: tapeDrives) m_tapeDriveStatus = tapeDrive;
+  }
+
+  std::map<std::string, uint64_t> getDiskSpaceReservations() const {
+    if (m_tapeDriveStatus.driveName == "") return {};
+    return {{m_tapeDriveStatus.diskSystemName, m_tapeDriveStatus.reservedBytes}};
+  }
+
+  bool reserveDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName, const uint64_t bytes,
+    const uint64_t maxReservedBytes) {
+    const auto reservations = getDiskSpaceReservations();
+    const auto reservation = reservations.find(diskSystemName);
+    if ((reservation == reservations.end() ? 0 : reservation->second) + bytes > maxReservedBytes) return false;
+    if (m_tapeDriveStatus.driveName != tapeDriveName) return true;
+    m_tapeDriveStatus.diskSystemName = diskSystemName;
+    m_tapeDriveStatus.reservedBytes += bytes;
+    return true;
+  }
+
+  bool releaseDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName, const uint64_t bytes) {
+    if (m_tapeDriveStatus.driveName != tapeDriveName || m_tapeDriveStatus.reservedBytes < bytes) return false;
+    m_tapeDriveStatus.diskSystemName = diskSystemName;
+    m_tapeDriveStatus.reservedBytes -= bytes;
+    return true;
+  }
+
 
 private:
   mutable threading::Mutex m_tapeEnablingMutex;
@@ -16,7 +16,6 @@
  */
 
 #include "catalogue/ArchiveFileRow.hpp"
-#include "catalogue/ArchiveFileRowWithoutTimestamps.hpp"
 #include "catalogue/MysqlCatalogueSchema.hpp"
 #include "catalogue/MysqlCatalogue.hpp"
 #include "common/exception/Exception.hpp"
@@ -27,7 +26,6 @@
 #include "common/utils/utils.hpp"
 #include "rdbms/AutoRollback.hpp"
 #include "rdbms/ConstraintError.hpp"
-#include "rdbms/PrimaryKeyError.hpp"
 #include "common/log/TimingList.hpp"
 
 namespace cta {
@@ -76,10 +74,9 @@ std::string MysqlCatalogue::createAndPopulateTempTableFxid(rdbms::Conn &conn, co
 
       sql = "INSERT INTO " + tempTableName + " VALUES(:DISK_FILE_ID)";
       auto stmt = conn.createStmt(sql);
-      for(auto &diskFileId : diskFileIds.value()) {
-        stmt.bindString(":DISK_FILE_ID", diskFileId);
-        stmt.executeNonQuery();
-      }
+      stmt.bindStringArray(":DISK_FILE_ID",
+        std::vector<optional<std::string>>(diskFileIds.value().begin(), diskFileIds.value().end()));
+      stmt.executeArrayNonQuery();
     } catch(exception::Exception &ex) {
       ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
       throw;
@@ -423,6 +420,7 @@ void MysqlCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer> &
     const uint64_t lastFSeq = selectTapeForUpdateAndGetLastFSeq(conn, firstEvent.vid);
     uint64_t expectedFSeq = lastFSeq + 1;
     uint64_t totalLogicalBytesWritten = 0;
+    std::set<TapeFileWritten> fileEvents;
 
     for(const auto &eventP: events) {
       const auto & event = *eventP;
@@ -444,7 +442,9 @@ void MysqlCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer> &
       try {
         // If this is a file (as opposed to a placeholder), do the full processing.
         const auto &fileEvent=dynamic_cast<const TapeFileWritten &>(event); 
+        checkTapeFileWrittenFieldsAreSet(__FUNCTION__, fileEvent);
         totalLogicalBytesWritten += fileEvent.size;
+        fileEvents.insert(fileEvent);
       } catch (std::bad_cast&) {}
     }
 
@@ -453,13 +453,67 @@ void MysqlCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer> &
     const TapeItemWritten &lastEvent = **lastEventItor;
     updateTape(conn, lastEvent.vid, lastEvent.fSeq, totalLogicalBytesWritten, lastEvent.tapeDrive);
 
-    for(const auto &event : events) {
-      try {
-        // If this is a file (as opposed to a placeholder), do the full processing.
-        const auto &fileEvent=dynamic_cast<const TapeFileWritten &>(*event); 
-        fileWrittenToTape(conn, fileEvent);
-      } catch (std::bad_cast&) {}
+    // If we had only placeholders and no file recorded, we are done
+    if(fileEvents.empty()) {
+      conn.commit();
+      return;
+    }
+
+    // Create the archive file entries, skipping those that already exist
+    idempotentBatchInsertArchiveFiles(conn, fileEvents);
+
+    // Verify that the archive file entries in the catalogue database agree with
+    // the tape file written events, and move the tape files the new ones
+    // replace to the file recycle log
+    const time_t now = time(nullptr);
+    std::list<InsertFileRecycleLog> recycledFiles;
+    for(const auto &event: fileEvents) {
+      const auto archiveFileRow = getArchiveFileRowById(conn, event.archiveFileId);
+
+      if(nullptr == archiveFileRow) {
+        // This should never happen
+        exception::Exception ex;
+        ex.getMessage() << "Failed to find archive file: archiveFileId=" << event.archiveFileId;
+        throw ex;
+      }
+
+      std::ostringstream fileContext;
+      fileContext << "archiveFileId=" << event.archiveFileId << ", diskInstanceName=" << event.diskInstance <<
+        ", diskFileId=" << event.diskFileId;
+
+      if(archiveFileRow->size != event.size) {
+        catalogue::FileSizeMismatch ex;
+        ex.getMessage() << "File size mismatch: expected=" << archiveFileRow->size << ", actual=" << event.size << ": "
+          << fileContext.str();
+        throw ex;
+      }
+
+      archiveFileRow->checksumBlob.validate(event.checksumBlob);
+
+      common::dataStructures::TapeFile tapeFile;
+      tapeFile.vid            = event.vid;
+      tapeFile.fSeq           = event.fSeq;
+      tapeFile.copyNb         = event.copyNb;
+      recycledFiles.splice(recycledFiles.end(),
+        insertOldCopiesOfFilesIfAnyOnFileRecycleLog(conn, tapeFile, event.archiveFileId));
     }
+
+    batchInsertTapeFiles(conn, fileEvents, now);
+
+    for(const auto &recycledFile: recycledFiles) {
+      const char *const sql =
+        "DELETE FROM "
+          "TAPE_FILE "
+        "WHERE "
+          "VID=:VID AND "
+          "FSEQ=:FSEQ";
+      auto stmt = conn.createStmt(sql);
+      stmt.bindString(":VID", recycledFile.vid);
+      stmt.bindUint64(":FSEQ", recycledFile.fSeq);
+      stmt.executeNonQuery();
+    }
+
+    updateTapeStatistics(conn, getTapeStatisticsDeltas(fileEvents, recycledFiles));
     conn.commit();
   } catch(exception::UserError &) {
     throw;
@@ -470,61 +524,102 @@ void MysqlCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer> &
 }
 
 //------------------------------------------------------------------------------
-// fileWrittenToTape
+// idempotentBatchInsertArchiveFiles
 //------------------------------------------------------------------------------
-void MysqlCatalogue::fileWrittenToTape(rdbms::Conn &conn, const TapeFileWritten &event) {
+void MysqlCatalogue::idempotentBatchInsertArchiveFiles(rdbms::Conn &conn, const std::set<TapeFileWritten> &events) {
   try {
-    checkTapeFileWrittenFieldsAreSet(__FUNCTION__, event);
-
-    // Try to insert a row into the ARCHIVE_FILE table - it is normal this will
-    // fail if another tape copy has already been written to tape
-    try {
-      ArchiveFileRowWithoutTimestamps row;
-      row.archiveFileId = event.archiveFileId;
-      row.diskFileId = event.diskFileId;
-      row.diskInstance = event.diskInstance;
-      row.size = event.size;
-      row.checksumBlob = event.checksumBlob;
-      row.storageClassName = event.storageClassName;
-      row.diskFileOwnerUid = event.diskFileOwnerUid;
-      row.diskFileGid = event.diskFileGid;
-      insertArchiveFile(conn, row);
-    } catch(rdbms::PrimaryKeyError &) {
-      // Ignore this error
-    }
-
     const time_t now = time(nullptr);
-    const auto archiveFileRow = getArchiveFileRowById(conn, event.archiveFileId);
-
-    if(nullptr == archiveFileRow) {
-      // This should never happen
-      exception::Exception ex;
-      ex.getMessage() << "Failed to find archive file: archiveFileId=" << event.archiveFileId;
-      throw ex;
-    }
+    std::map<std::string, uint64_t> storageClassIds;
+    std::vector<optional<uint64_t>> archiveFileIds;
+    std::vector<optional<std::string>> diskInstances;
+    std::vector<optional<std::string>> diskFileIds;
+    std::vector<optional<uint64_t>> diskFileUids;
+    std::vector<optional<uint64_t>> diskFileGids;
+    std::vector<optional<uint64_t>> sizes;
+    std::vector<std::string> checksumBlobs;
+    std::vector<optional<uint64_t>> checksumAdler32s;
+    std::vector<optional<uint64_t>> storageClassIdValues;
+    for(const auto &event: events) {
+      auto storageClassIdItor = storageClassIds.find(event.storageClassName);
+      if(storageClassIds.end() == storageClassIdItor) {
+        const char *const sql =
+          "SELECT "
+            "STORAGE_CLASS_ID AS STORAGE_CLASS_ID "
+          "FROM "
+            "STORAGE_CLASS "
+          "WHERE "
+            "STORAGE_CLASS_NAME = :STORAGE_CLASS_NAME";
+        auto stmt = conn.createStmt(sql);
+        stmt.bindString(":STORAGE_CLASS_NAME", event.storageClassName);
+        auto rset = stmt.executeQuery();
+        if(!rset.next()) {
+          throw exception::UserError(std::string("Storage class ") + event.diskInstance + ":" + event.storageClassName +
+            " does not exist");
+        }
+        storageClassIdItor = storageClassIds.emplace(event.storageClassName, rset.columnUint64("STORAGE_CLASS_ID")).first;
+      }
 
-    std::ostringstream fileContext;
-    fileContext << "archiveFileId=" << event.archiveFileId << ", diskInstanceName=" << event.diskInstance <<
-      ", diskFileId=" << event.diskFileId;
+      // Keep transition ADLER32 checksum up-to-date if it exists
+      uint32_t adler32;
+      try {
+        std::string adler32hex = checksum::ChecksumBlob::ByteArrayToHex(event.checksumBlob.at(checksum::ADLER32));
+        adler32 = strtoul(adler32hex.c_str(), 0, 16);
+      } catch(exception::ChecksumTypeMismatch &ex) {
+        adler32 = 0;
+      }
 
-    if(archiveFileRow->size != event.size) {
-      catalogue::FileSizeMismatch ex;
-      ex.getMessage() << "File size mismatch: expected=" << archiveFileRow->size << ", actual=" << event.size << ": "
-        << fileContext.str();
-      throw ex;
+      archiveFileIds.push_back(event.archiveFileId);
+      diskInstances.push_back(event.diskInstance);
+      diskFileIds.push_back(event.diskFileId);
+      diskFileUids.push_back(event.diskFileOwnerUid);
+      diskFileGids.push_back(event.diskFileGid);
+      sizes.push_back(event.size);
+      checksumBlobs.push_back(event.checksumBlob.serialize());
+      checksumAdler32s.push_back(adler32);
+      storageClassIdValues.push_back(storageClassIdItor->second);
     }
 
-    archiveFileRow->checksumBlob.validate(event.checksumBlob);
-
-    // Insert the tape file
-    common::dataStructures::TapeFile tapeFile;
-    tapeFile.vid            = event.vid;
-    tapeFile.fSeq           = event.fSeq;
-    tapeFile.blockId        = event.blockId;
-    tapeFile.fileSize       = event.size;
-    tapeFile.copyNb         = event.copyNb;
-    tapeFile.creationTime   = now;
-    insertTapeFile(conn, tapeFile, event.archiveFileId);
+    // Rows whose archive file ID already exists are left unchanged
+    const char *const sql =
+      "INSERT INTO ARCHIVE_FILE("
+        "ARCHIVE_FILE_ID,"
+        "DISK_INSTANCE_NAME,"
+        "DISK_FILE_ID,"
+        "DISK_FILE_UID,"
+        "DISK_FILE_GID,"
+        "SIZE_IN_BYTES,"
+        "CHECKSUM_BLOB,"
+        "CHECKSUM_ADLER32,"
+        "STORAGE_CLASS_ID,"
+        "CREATION_TIME,"
+        "RECONCILIATION_TIME)"
+      "VALUES("
+        ":ARCHIVE_FILE_ID,"
+        ":DISK_INSTANCE_NAME,"
+        ":DISK_FILE_ID,"
+        ":DISK_FILE_UID,"
+        ":DISK_FILE_GID,"
+        ":SIZE_IN_BYTES,"
+        ":CHECKSUM_BLOB,"
+        ":CHECKSUM_ADLER32,"
+        ":STORAGE_CLASS_ID,"
+        ":CREATION_TIME,"
+        ":RECONCILIATION_TIME)" 
+      "ON DUPLICATE KEY UPDATE "
+        "ARCHIVE_FILE_ID = ARCHIVE_FILE_ID";
+    auto stmt = conn.createStmt(sql);
+    stmt.bindUint64Array(":ARCHIVE_FILE_ID", archiveFileIds);
+    stmt.bindStringArray(":DISK_INSTANCE_NAME", diskInstances);
+    stmt.bindStringArray(":DISK_FILE_ID", diskFileIds);
+    stmt.bindUint64Array(":DISK_FILE_UID", diskFileUids);
+    stmt.bindUint64Array(":DISK_FILE_GID", diskFileGids);
+    stmt.bindUint64Array(":SIZE_IN_BYTES", sizes);
+    stmt.bindBlobArray(":CHECKSUM_BLOB", checksumBlobs);
+    stmt.bindUint64Array(":CHECKSUM_ADLER32", checksumAdler32s);
+    stmt.bindUint64Array(":STORAGE_CLASS_ID", storageClassIdValues);
+    stmt.bindUint64Array(":CREATION_TIME", std::vector<optional<uint64_t>>(events.size(), now));
+    stmt.bindUint64Array(":RECONCILIATION_TIME", std::vector<optional<uint64_t>>(events.size(), now));
+    stmt.executeArrayNonQuery();
   } catch(exception::UserError &) {
     throw;
   } catch(exception::Exception &ex) {
@@ -533,6 +628,59 @@ void MysqlCatalogue::fileWrittenToTape(rdbms::Conn &conn, const TapeFileWritten
   }
 }
 
+//------------------------------------------------------------------------------
+// batchInsertTapeFiles
+//------------------------------------------------------------------------------
+void MysqlCatalogue::batchInsertTapeFiles(rdbms::Conn &conn, const std::set<TapeFileWritten> &events,
+  const time_t creationTime) {
+  try {
+    std::vector<optional<std::string>> vids;
+    std::vector<optional<uint64_t>> fSeqs;
+    std::vector<optional<uint64_t>> blockIds;
+    std::vector<optional<uint64_t>> sizes;
+    std::vector<optional<uint64_t>> copyNbs;
+    std::vector<optional<uint64_t>> archiveFileIds;
+    for(const auto &event: events) {
+      vids.push_back(event.vid);
+      fSeqs.push_back(event.fSeq);
+      blockIds.push_back(event.blockId);
+      sizes.push_back(event.size);
+      copyNbs.push_back(event.copyNb);
+      archiveFileIds.push_back(event.archiveFileId);
+    }
+
+    const char *const sql =
+      "INSERT INTO TAPE_FILE("
+        "VID,"
+        "FSEQ,"
+        "BLOCK_ID,"
+        "LOGICAL_SIZE_IN_BYTES,"
+        "COPY_NB,"
+        "CREATION_TIME,"
+        "ARCHIVE_FILE_ID)"
+      "VALUES("
+        ":VID,"
+        ":FSEQ,"
+        ":BLOCK_ID,"
+        ":LOGICAL_SIZE_IN_BYTES,"
+        ":COPY_NB,"
+        ":CREATION_TIME,"
+        ":ARCHIVE_FILE_ID)";
+    auto stmt = conn.createStmt(sql);
+    stmt.bindStringArray(":VID", vids);
+    stmt.bindUint64Array(":FSEQ", fSeqs);
+    stmt.bindUint64Array(":BLOCK_ID", blockIds);
+    stmt.bindUint64Array(":LOGICAL_SIZE_IN_BYTES", sizes);
+    stmt.bindUint64Array(":COPY_NB", copyNbs);
+    stmt.bindUint64Array(":CREATION_TIME", std::vector<optional<uint64_t>>(events.size(), creationTime));
+    stmt.bindUint64Array(":ARCHIVE_FILE_ID", archiveFileIds);
+    stmt.executeArrayNonQuery();
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
 //------------------------------------------------------------------------------
 // deleteArchiveFile
 //------------------------------------------------------------------------------
@@ -578,7 +726,6 @@ void MysqlCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string &
     rdbms::Rset selectRset = selectStmt.executeQuery();
     const auto selectFromArchiveFileTime = t.secs();
     std::unique_ptr<common::dataStructures::ArchiveFile> archiveFile;
-    std::set<std::string> vidsToSetDirty;
     while(selectRset.next()) {
       if(nullptr == archiveFile.get()) {
         archiveFile = cta::make_unique<common::dataStructures::ArchiveFile>();
@@ -600,7 +747,6 @@ void MysqlCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string &
         // Add the tape file to the archive file's in-memory structure
         common::dataStructures::TapeFile tapeFile;
         tapeFile.vid = selectRset.columnString("VID");
-        vidsToSetDirty.insert(tapeFile.vid);
         tapeFile.fSeq = selectRset.columnUint64("FSEQ");
         tapeFile.blockId = selectRset.columnUint64("BLOCK_ID");
         tapeFile.fileSize = selectRset.columnUint64("LOGICAL_SIZE_IN_BYTES");
@@ -668,12 +814,16 @@ void MysqlCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string &
     
     const auto deleteFromTapeFileTime = t.secs(utils::Timer::resetCounter);
 
-    for(auto &vidToSetDirty: vidsToSetDirty){
-      //We deleted the TAPE_FILE so the tapes containing them should be set as dirty
-      setTapeDirty(conn,vidToSetDirty);
+    //We deleted the TAPE_FILE so the statistics of the tapes containing them are updated
+    {
+      TapeStatisticsDeltas tapeStatisticsDeltas;
+      for(auto &tapeFile: archiveFile->tapeFiles){
+        tapeStatisticsDeltas.removeTapeFile(tapeFile.vid, tapeFile.copyNb, archiveFile->fileSize);
+      }
+      updateTapeStatistics(conn, tapeStatisticsDeltas);
     }
     
-    const auto setTapeDirtyTime = t.secs(utils::Timer::resetCounter);
+    const auto updateTapeStatisticsTime = t.secs(utils::Timer::resetCounter);
 
     {
       const char *const sql = "DELETE FROM ARCHIVE_FILE WHERE ARCHIVE_FILE_ID = :ARCHIVE_FILE_ID";
@@ -700,7 +850,7 @@ void MysqlCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string &
        .add("selectFromArchiveFileTime", selectFromArchiveFileTime)
        .add("deleteFromTapeFileTime", deleteFromTapeFileTime)
        .add("deleteFromArchiveFileTime", deleteFromArchiveFileTime)
-       .add("setTapeDirtyTime",setTapeDirtyTime)
+       .add("updateTapeStatisticsTime", updateTapeStatisticsTime)
        .add("commitTime", commitTime);
     archiveFile->checksumBlob.addFirstChecksumToLog(spc);
     for(auto it=archiveFile->tapeFiles.begin(); it!=archiveFile->tapeFiles.end(); it++) {
@@ -735,8 +885,6 @@ void MysqlCatalogue::copyArchiveFileToFileRecyleLogAndDelete(rdbms::Conn & conn,
     conn.executeNonQuery("START TRANSACTION");
     copyArchiveFileToFileRecycleLog(conn,request);
     tl.insertAndReset("insertToRecycleBinTime",t);
-    setTapeDirty(conn,request.archiveFileID);
-    tl.insertAndReset("setTapeDirtyTime",t);
     deleteTapeFiles(conn,request);
     tl.insertAndReset("deleteTapeFilesTime",t);
     RdbmsCatalogue::deleteArchiveFile(conn,request);
@@ -798,8 +946,6 @@ void MysqlCatalogue::copyTapeFileToFileRecyleLogAndDelete(rdbms::Conn & conn, co
     conn.executeNonQuery("START TRANSACTION");
     copyTapeFilesToFileRecycleLog(conn, file, reason);
     tl.insertAndReset("insertToRecycleBinTime",t);
-    setTapeDirty(conn, file.archiveFileID);
-    tl.insertAndReset("setTapeDirtyTime",t);
     deleteTapeFiles(conn,file);
     tl.insertAndReset("deleteTapeFilesTime",t);
     conn.commit();
@@ -910,5 +1056,30 @@ void MysqlCatalogue::restoreFileCopyInRecycleLog(rdbms::Conn & conn, const commo
   }
 }
 
+//------------------------------------------------------------------------------
+// beginDiskSpaceReservation
+//------------------------------------------------------------------------------
+void MysqlCatalogue::beginDiskSpaceReservation(rdbms::Conn & conn, const std::string & diskSystemName) {
+  try {
+    conn.executeNonQuery("START TRANSACTION");
+    const char *const sql =
+      "SELECT "
+        "DISK_SYSTEM_NAME AS DISK_SYSTEM_NAME "
+      "FROM "
+        "DISK_SYSTEM "
+      "WHERE "
+        "DISK_SYSTEM_NAME = :DISK_SYSTEM_NAME "
+      "FOR UPDATE";
+    auto stmt = conn.createStmt(sql);
+    stmt.bindString(":DISK_SYSTEM_NAME", diskSystemName);
+    auto rset = stmt.executeQuery();
+    // A disk system which is not in the catalogue is not locked
+    rset.next();
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
 } // namespace catalogue
 } // namespace cta
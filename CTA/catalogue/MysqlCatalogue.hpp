@@ -235,16 +235,44 @@ protected:
    */
   void restoreFileCopyInRecycleLog(rdbms::Conn & conn, const common::dataStructures::FileRecycleLog &fileRecycleLogItor, log::LogContext & lc);
 
+  /**
+   * Starts the transaction of a disk space reservation and locks the disk system, so that the concurrent
+   * reservations for the same disk system are serialized until the transaction is committed or rolled back.
+   * @param conn the database connection
+   * @param diskSystemName the name of the disk system
+   */
+  void beginDiskSpaceReservation(rdbms::Conn & conn, const std::string & diskSystemName) override;
+
 
 private:
 
   /**
-   * Notifies the catalogue that a file has been written to tape.
+   * Batch inserts rows into the ARCHIVE_FILE table that correspond to the
+   * specified TapeFileWritten events.
+   *
+   * This method has idempotent behaviour in the case where an ARCHIVE_FILE
+   * already exists.  Such a situation will occur when a file has more than one
+   * copy on tape.  The first tape copy will cause two successful inserts, one
+   * into the ARCHIVE_FILE table and one into the  TAPE_FILE table.  The second
+   * tape copy will try to do the same, but the insert into the ARCHIVE_FILE
+   * table will simply bounce as the row will already exists.  The insert into
+   * the TABLE_FILE table will succeed because the two TAPE_FILE rows will be
+   * unique.
+   *
+   * @param conn The database connection.
+   * @param events The tape file written events.
+   */
+  void idempotentBatchInsertArchiveFiles(rdbms::Conn &conn, const std::set<TapeFileWritten> &events);
+
+  /**
+   * Batch inserts rows into the TAPE_FILE table that correspond to the
+   * specified TapeFileWritten events.
    *
    * @param conn The database connection.
-   * @param event The tape file written event.
+   * @param events The tape file written events.
+   * @param creationTime The creation time of the tape files.
    */
-  void fileWrittenToTape(rdbms::Conn &conn, const TapeFileWritten &event);
+  void batchInsertTapeFiles(rdbms::Conn &conn, const std::set<TapeFileWritten> &events, const time_t creationTime);
 
   /**
    * Selects the specified tape for update and returns its last FSeq.
@@ -595,6 +595,8 @@ void OracleCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer>
       stmt.bindUint64(":FSEQ",recycledFile.fSeq);
       stmt.executeNonQuery();
     } 
+
+    updateTapeStatistics(conn, getTapeStatisticsDeltas(fileEvents, recycledFiles));
     
     {
       conn.setAutocommitMode(rdbms::AutocommitMode::AUTOCOMMIT_ON);
@@ -906,7 +908,6 @@ void OracleCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string
     rdbms::Rset selectRset = selectStmt.executeQuery();
     const auto selectFromArchiveFileTime = t.secs();
     std::unique_ptr<common::dataStructures::ArchiveFile> archiveFile;
-    std::set<std::string> vidsToSetDirty;
     while(selectRset.next()) {
       if(nullptr == archiveFile.get()) {
         archiveFile = cta::make_unique<common::dataStructures::ArchiveFile>();
@@ -928,7 +929,6 @@ void OracleCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string
         // Add the tape file to the archive file's in-memory structure
         common::dataStructures::TapeFile tapeFile;
         tapeFile.vid = selectRset.columnString("VID");
-        vidsToSetDirty.insert(tapeFile.vid);
         tapeFile.fSeq = selectRset.columnUint64("FSEQ");
         tapeFile.blockId = selectRset.columnUint64("BLOCK_ID");
         tapeFile.fileSize = selectRset.columnUint64("LOGICAL_SIZE_IN_BYTES");
@@ -994,12 +994,16 @@ void OracleCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string
     
     const auto deleteFromTapeFileTime = t.secs(utils::Timer::resetCounter);
     
-    //Set the tapes where the files have been deleted to dirty
-    for(auto &vidToSetDirty: vidsToSetDirty){
-      setTapeDirty(conn,vidToSetDirty);
+    //We deleted the TAPE_FILE so the statistics of the tapes containing them are updated
+    {
+      TapeStatisticsDeltas tapeStatisticsDeltas;
+      for(auto &tapeFile: archiveFile->tapeFiles){
+        tapeStatisticsDeltas.removeTapeFile(tapeFile.vid, tapeFile.copyNb, archiveFile->fileSize);
+      }
+      updateTapeStatistics(conn, tapeStatisticsDeltas);
     }
     
-    const auto setTapeDirtyTime = t.secs(utils::Timer::resetCounter);
+    const auto updateTapeStatisticsTime = t.secs(utils::Timer::resetCounter);
 
     {
       const char *const sql = "DELETE FROM ARCHIVE_FILE WHERE ARCHIVE_FILE_ID = :ARCHIVE_FILE_ID";
@@ -1026,7 +1030,7 @@ void OracleCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::string
        .add("createStmtTime", createStmtTime)
        .add("selectFromArchiveFileTime", selectFromArchiveFileTime)
        .add("deleteFromTapeFileTime", deleteFromTapeFileTime)
-       .add("setTapeDirtyTime",setTapeDirtyTime)
+       .add("updateTapeStatisticsTime", updateTapeStatisticsTime)
        .add("deleteFromArchiveFileTime", deleteFromArchiveFileTime)
        .add("commitTime", commitTime);
     archiveFile->checksumBlob.addFirstChecksumToLog(spc);
@@ -1066,8 +1070,6 @@ void OracleCatalogue::copyArchiveFileToFileRecyleLogAndDelete(rdbms::Conn & conn
     conn.setAutocommitMode(rdbms::AutocommitMode::AUTOCOMMIT_OFF);
     copyArchiveFileToFileRecycleLog(conn,request);
     tl.insertAndReset("insertToRecycleBinTime",t);
-    setTapeDirty(conn,request.archiveFileID);
-    tl.insertAndReset("setTapeDirtyTime",t);
     deleteTapeFiles(conn,request);
     tl.insertAndReset("deleteTapeFilesTime",t);
     conn.setAutocommitMode(rdbms::AutocommitMode::AUTOCOMMIT_ON);
@@ -1126,8 +1128,6 @@ void OracleCatalogue::copyTapeFileToFileRecyleLogAndDelete(rdbms::Conn & conn, c
     conn.setAutocommitMode(rdbms::AutocommitMode::AUTOCOMMIT_OFF);
     copyTapeFilesToFileRecycleLog(conn, file, reason);
     tl.insertAndReset("insertToRecycleBinTime",t);
-    setTapeDirty(conn, file.archiveFileID);
-    tl.insertAndReset("setTapeDirtyTime",t);
     deleteTapeFiles(conn,file);
     tl.insertAndReset("deleteTapeFilesTime",t);
     conn.setAutocommitMode(rdbms::AutocommitMode::AUTOCOMMIT_ON);
@@ -1241,7 +1241,30 @@ void OracleCatalogue::restoreFileCopyInRecycleLog(rdbms::Conn & conn, const comm
   }
 }
 
-
+//------------------------------------------------------------------------------
+// beginDiskSpaceReservation
+//------------------------------------------------------------------------------
+void OracleCatalogue::beginDiskSpaceReservation(rdbms::Conn & conn, const std::string & diskSystemName) {
+  try {
+    conn.setAutocommitMode(rdbms::AutocommitMode::AUTOCOMMIT_OFF);
+    const char *const sql =
+      "SELECT "
+        "DISK_SYSTEM_NAME AS DISK_SYSTEM_NAME "
+      "FROM "
+        "DISK_SYSTEM "
+      "WHERE "
+        "DISK_SYSTEM_NAME = :DISK_SYSTEM_NAME "
+      "FOR UPDATE";
+    auto stmt = conn.createStmt(sql);
+    stmt.bindString(":DISK_SYSTEM_NAME", diskSystemName);
+    auto rset = stmt.executeQuery();
+    // A disk system which is not in the catalogue is not locked
+    rset.next();
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
 
 } // namespace catalogue
 } // namespace cta
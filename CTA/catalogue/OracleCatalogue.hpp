@@ -278,6 +278,14 @@ private:
    */
   void restoreFileCopyInRecycleLog(rdbms::Conn & conn, const common::dataStructures::FileRecycleLog &fileRecycleLogItor, log::LogContext & lc);
 
+  /**
+   * Starts the transaction of a disk space reservation and locks the disk system, so that the concurrent
+   * reservations for the same disk system are serialized until the transaction is committed or rolled back.
+   * @param conn the database connection
+   * @param diskSystemName the name of the disk system
+   */
+  void beginDiskSpaceReservation(rdbms::Conn & conn, const std::string & diskSystemName) override;
+
   /**
    * The size and checksum of a file.
    */
@@ -36,9 +36,12 @@ namespace cta {
 namespace catalogue {
 
 namespace {
+  const auto NUMERIC = rdbms::wrapper::PostgresColumn::BinaryType::NUMERIC;
+  const auto BYTEA = rdbms::wrapper::PostgresColumn::BinaryType::BYTEA;
+
   /**
-   * Structure used to assemble a batch of rows to insert into the TAPE_FILE
-   * table.
+   * Structure used to assemble a batch of rows to insert into the
+   * TEMP_TAPE_FILE_INSERTION_BATCH staging table.
    */
   struct TapeFileBatch {
     size_t nbRows;
@@ -58,18 +61,18 @@ namespace {
     TapeFileBatch(const size_t nbRowsValue):
       nbRows(nbRowsValue),
       vid("VID", nbRows),
-      fSeq("FSEQ", nbRows),
-      blockId("BLOCK_ID", nbRows),
-      fileSize("LOGICAL_SIZE_IN_BYTES", nbRows),
-      copyNb("COPY_NB", nbRows),
-      creationTime("CREATION_TIME", nbRows),
-      archiveFileId("ARCHIVE_FILE_ID", nbRows) {
+      fSeq("FSEQ", nbRows, NUMERIC),
+      blockId("BLOCK_ID", nbRows, NUMERIC),
+      fileSize("LOGICAL_SIZE_IN_BYTES", nbRows, NUMERIC),
+      copyNb("COPY_NB", nbRows, NUMERIC),
+      creationTime("CREATION_TIME", nbRows, NUMERIC),
+      archiveFileId("ARCHIVE_FILE_ID", nbRows, NUMERIC) {
     }
   }; // struct TapeFileBatch
 
   /**
    * Structure used to assemble a batch of rows to insert into the TEMP_ARCHIVE_FILE_BATCH
-   * table.
+   * staging table.
    */
   struct ArchiveFileBatch {
     size_t nbRows;
@@ -92,38 +95,19 @@ namespace {
      */
     ArchiveFileBatch(const size_t nbRowsValue):
       nbRows(nbRowsValue),
-      archiveFileId("ARCHIVE_FILE_ID", nbRows),
+      archiveFileId("ARCHIVE_FILE_ID", nbRows, NUMERIC),
       diskInstance("DISK_INSTANCE_NAME", nbRows),
       diskFileId("DISK_FILE_ID", nbRows),
-      diskFileUser("DISK_FILE_UID", nbRows),
-      diskFileGroup("DISK_FILE_GID", nbRows),
-      size("SIZE_IN_BYTES", nbRows),
-      checksumBlob("CHECKSUM_BLOB", nbRows),
-      checksumAdler32("CHECKSUM_ADLER32", nbRows),
+      diskFileUser("DISK_FILE_UID", nbRows, NUMERIC),
+      diskFileGroup("DISK_FILE_GID", nbRows, NUMERIC),
+      size("SIZE_IN_BYTES", nbRows, NUMERIC),
+      checksumBlob("CHECKSUM_BLOB", nbRows, BYTEA),
+      checksumAdler32("CHECKSUM_ADLER32", nbRows, NUMERIC),
       storageClassName("STORAGE_CLASS_NAME", nbRows),
-      creationTime("CREATION_TIME", nbRows),
-      reconciliationTime("RECONCILIATION_TIME", nbRows) {
+      creationTime("CREATION_TIME", nbRows, NUMERIC),
+      reconciliationTime("RECONCILIATION_TIME", nbRows, NUMERIC) {
     }
   }; // struct ArchiveFileBatch
-
-  /**
-   * Structure used to assemble a batch of rows to insert into the
-   * TAPE_FILE_BATCH temporary table.
-   */
-  struct TempTapeFileBatch {
-    size_t nbRows;
-    rdbms::wrapper::PostgresColumn archiveFileId;
-
-    /**
-     * Constructor.
-     *
-     * @param nbRowsValue  The Number of rows to be inserted.
-     */
-    TempTapeFileBatch(const size_t nbRowsValue):
-      nbRows(nbRowsValue),
-      archiveFileId("ARCHIVE_FILE_ID", nbRows) {
-    }
-  }; // struct TempTapeFileBatch
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -370,11 +354,11 @@ void PostgresCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer
     auto conn = m_connPool.getConn();
     rdbms::AutoRollback autoRollback(conn);
 
-    // Start DB transaction and create temporary tables TEMP_ARCHIVE_FILE_BATCH and TEMP_TAPE_FILE_BATCH.
-    // These two tables will exist only for the duration of the transaction.
+    // Start DB transaction, creating the staging tables TEMP_ARCHIVE_FILE_BATCH and TEMP_TAPE_FILE_INSERTION_BATCH
+    // first if this database session does not have them yet. Their content only lasts for the transaction.
     // Set deferrable for second (disk instance, disk file id) constraint of the ARCHIVE_FILE table
     // to avoid violation in the case of concurrent inserts of a previously not existing archive file.
-    beginCreateTemporarySetDeferred(conn);
+    createStagingTablesAndBeginSetDeferred(conn);
 
     const uint64_t lastFSeq = selectTapeForUpdateAndGetLastFSeq(conn, firstEvent.vid);
     uint64_t expectedFSeq = lastFSeq + 1;
@@ -438,38 +422,7 @@ void PostgresCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer
     // inserting another tape file.
     idempotentBatchInsertArchiveFiles(conn, fileEvents);
 
-    insertTapeFileBatchIntoTempTable(conn, fileEvents);
-
-    // Verify that the archive file entries in the catalogue database agree with
-    // the tape file written events
-    const auto fileSizesAndChecksums = selectArchiveFileSizesAndChecksums(conn, fileEvents);
-    for (const auto &event: fileEvents) {
-      const auto fileSizeAndChecksumItor = fileSizesAndChecksums.find(event.archiveFileId);
-
-      std::ostringstream fileContext;
-      fileContext << "archiveFileId=" << event.archiveFileId << ", diskInstanceName=" << event.diskInstance <<
-        ", diskFileId=" << event.diskFileId;
-
-      // This should never happen
-      if(fileSizesAndChecksums.end() == fileSizeAndChecksumItor) {
-        exception::Exception ex;
-        ex.getMessage() << __FUNCTION__ << ": Failed to find archive file entry in the catalogue: " << fileContext.str();
-        throw ex;
-      }
-
-      const auto &fileSizeAndChecksum = fileSizeAndChecksumItor->second;
-
-      if(fileSizeAndChecksum.fileSize != event.size) {
-        catalogue::FileSizeMismatch ex;
-        ex.getMessage() << __FUNCTION__ << ": File size mismatch: expected=" << fileSizeAndChecksum.fileSize <<
-          ", actual=" << event.size << ": " << fileContext.str();
-        throw ex;
-      }
-
-      fileSizeAndChecksum.checksumBlob.validate(event.checksumBlob);
-    }
-
-    // Store the value of each field
+    // Stage the tape files: they are used to check the archive files and then inserted into TAPE_FILE
     uint32_t i = 0;
     for (const auto &event: fileEvents) {
       tapeFileBatch.vid.setFieldValue(i, event.vid);
@@ -483,9 +436,6 @@ void PostgresCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer
     }
 
     const char *const sql =
-    "CREATE TEMPORARY TABLE TEMP_TAPE_FILE_INSERTION_BATCH ("                        "\n"
-      "LIKE TAPE_FILE) "                                                             "\n"
-      "ON COMMIT DROP;"                                                              "\n"
     "COPY TEMP_TAPE_FILE_INSERTION_BATCH("                                           "\n"
       "VID,"                                                                         "\n"
       "FSEQ,"                                                                        "\n"
@@ -494,7 +444,7 @@ void PostgresCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer
       "COPY_NB,"                                                                     "\n"
       "CREATION_TIME,"                                                               "\n"
       "ARCHIVE_FILE_ID) "                                                            "\n"
-    "FROM STDIN; --"                                                                 "\n"
+    "FROM STDIN WITH (FORMAT BINARY) --"                                             "\n"
       "-- :VID,"                                                                     "\n"
       "-- :FSEQ,"                                                                    "\n"
       "-- :BLOCK_ID,"                                                                "\n"
@@ -502,7 +452,7 @@ void PostgresCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer
       "-- :COPY_NB,"                                                                 "\n"
       "-- :CREATION_TIME,"                                                           "\n"
       "-- :ARCHIVE_FILE_ID;"                                                         "\n";
-    
+
     auto stmt = conn.createStmt(sql);
     rdbms::wrapper::PostgresStmt &postgresStmt = dynamic_cast<rdbms::wrapper::PostgresStmt &>(stmt.getStmt());
     postgresStmt.setColumn(tapeFileBatch.vid);
@@ -512,8 +462,37 @@ void PostgresCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer
     postgresStmt.setColumn(tapeFileBatch.copyNb);
     postgresStmt.setColumn(tapeFileBatch.creationTime);
     postgresStmt.setColumn(tapeFileBatch.archiveFileId);
-    
+
     postgresStmt.executeCopyInsert(tapeFileBatch.nbRows);
+
+    // Verify that the archive file entries in the catalogue database agree with
+    // the tape file written events
+    const auto fileSizesAndChecksums = selectArchiveFileSizesAndChecksums(conn, fileEvents);
+    for (const auto &event: fileEvents) {
+      const auto fileSizeAndChecksumItor = fileSizesAndChecksums.find(event.archiveFileId);
+
+      std::ostringstream fileContext;
+      fileContext << "archiveFileId=" << event.archiveFileId << ", diskInstanceName=" << event.diskInstance <<
+        ", diskFileId=" << event.diskFileId;
+
+      // This should never happen
+      if(fileSizesAndChecksums.end() == fileSizeAndChecksumItor) {
+        exception::Exception ex;
+        ex.getMessage() << __FUNCTION__ << ": Failed to find archive file entry in the catalogue: " << fileContext.str();
+        throw ex;
+      }
+
+      const auto &fileSizeAndChecksum = fileSizeAndChecksumItor->second;
+
+      if(fileSizeAndChecksum.fileSize != event.size) {
+        catalogue::FileSizeMismatch ex;
+        ex.getMessage() << __FUNCTION__ << ": File size mismatch: expected=" << fileSizeAndChecksum.fileSize <<
+          ", actual=" << event.size << ": " << fileContext.str();
+        throw ex;
+      }
+
+      fileSizeAndChecksum.checksumBlob.validate(event.checksumBlob);
+    }
     
     auto recycledFiles = insertOldCopiesOfFilesIfAnyOnFileRecycleLog(conn);
     
@@ -527,14 +506,19 @@ void PostgresCatalogue::filesWrittenToTape(const std::set<TapeItemWrittenPointer
       conn.executeNonQuery(insertTapeFileSql);
     }
     
-    for(auto & recycledFile: recycledFiles){
-      const char * const deleteTapeFileSql = 
-      "DELETE FROM TAPE_FILE WHERE TAPE_FILE.VID = :VID AND TAPE_FILE.FSEQ = :FSEQ";
-      auto deleteTapeFileStmt = conn.createStmt(deleteTapeFileSql);
-      deleteTapeFileStmt.bindString(":VID",recycledFile.vid);
-      deleteTapeFileStmt.bindUint64(":FSEQ",recycledFile.fSeq);
-      deleteTapeFileStmt.executeNonQuery();
+    if (!recycledFiles.empty()) {
+      // Delete the old copies moved to the recycle log, with the same criteria as insertOldCopiesOfFilesIfAnyOnFileRecycleLog()
+      const char * const deleteTapeFileSql =
+      "DELETE FROM TAPE_FILE "                                                                        "\n"
+      "USING TEMP_TAPE_FILE_INSERTION_BATCH "                                                         "\n"
+      "WHERE TEMP_TAPE_FILE_INSERTION_BATCH.ARCHIVE_FILE_ID = TAPE_FILE.ARCHIVE_FILE_ID "             "\n"
+        "AND TEMP_TAPE_FILE_INSERTION_BATCH.COPY_NB = TAPE_FILE.COPY_NB "                             "\n"
+        "AND (TAPE_FILE.VID != TEMP_TAPE_FILE_INSERTION_BATCH.VID "                                   "\n"
+          "OR TAPE_FILE.FSEQ != TEMP_TAPE_FILE_INSERTION_BATCH.FSEQ)";
+      conn.executeNonQuery(deleteTapeFileSql);
     }
+
+    updateTapeStatistics(conn, getTapeStatisticsDeltas(fileEvents, recycledFiles));
     
     autoRollback.cancel();
     conn.commit();
@@ -564,7 +548,7 @@ void PostgresCatalogue::idempotentBatchInsertArchiveFiles(rdbms::Conn &conn,
       archiveFileBatch.diskFileUser.setFieldValue(i, event.diskFileOwnerUid);
       archiveFileBatch.diskFileGroup.setFieldValue(i, event.diskFileGid);
       archiveFileBatch.size.setFieldValue(i, event.size);
-      archiveFileBatch.checksumBlob.setFieldByteA(conn, i, event.checksumBlob.serialize());
+      archiveFileBatch.checksumBlob.setFieldValue(i, event.checksumBlob.serialize());
       // Keep transition ADLER32 checksum up-to-date if it exists
       std::string adler32str;
       try {
@@ -594,7 +578,7 @@ void PostgresCatalogue::idempotentBatchInsertArchiveFiles(rdbms::Conn &conn,
         "STORAGE_CLASS_NAME,"
         "CREATION_TIME,"
         "RECONCILIATION_TIME) "
-      "FROM STDIN --"
+      "FROM STDIN WITH (FORMAT BINARY) --"
         ":ARCHIVE_FILE_ID,"
         ":DISK_INSTANCE_NAME,"
         ":DISK_FILE_ID,"
@@ -736,8 +720,8 @@ std::map<uint64_t, PostgresCatalogue::FileSizeAndChecksum> PostgresCatalogue::se
         "ARCHIVE_FILE.CHECKSUM_ADLER32 AS CHECKSUM_ADLER32 "
       "FROM "
         "ARCHIVE_FILE "
-      "INNER JOIN TEMP_TAPE_FILE_BATCH ON "
-        "ARCHIVE_FILE.ARCHIVE_FILE_ID = TEMP_TAPE_FILE_BATCH.ARCHIVE_FILE_ID";
+      "INNER JOIN TEMP_TAPE_FILE_INSERTION_BATCH ON "
+        "ARCHIVE_FILE.ARCHIVE_FILE_ID = TEMP_TAPE_FILE_INSERTION_BATCH.ARCHIVE_FILE_ID";
     auto stmt = conn.createStmt(sql);
 
     auto rset = stmt.executeQuery();
@@ -768,40 +752,6 @@ std::map<uint64_t, PostgresCatalogue::FileSizeAndChecksum> PostgresCatalogue::se
   }
 }
 
-//------------------------------------------------------------------------------
-// insertArchiveFilesIntoTempTable
-//------------------------------------------------------------------------------
-void PostgresCatalogue::insertTapeFileBatchIntoTempTable(rdbms::Conn &conn,
-   const std::set<TapeFileWritten> &events) const {
-  try {
-    TempTapeFileBatch tempTapeFileBatch(events.size());
-
-    // Store the value of each field
-    uint32_t i = 0;
-    for (const auto &event: events) {
-      tempTapeFileBatch.archiveFileId.setFieldValue(i, event.archiveFileId);
-      i++;
-    }
-
-    const char *const sql =
-      "COPY TEMP_TAPE_FILE_BATCH("
-        "ARCHIVE_FILE_ID) "
-      "FROM STDIN --"
-        ":ARCHIVE_FILE_ID";
-
-    auto stmt = conn.createStmt(sql);
-    rdbms::wrapper::PostgresStmt &postgresStmt = dynamic_cast<rdbms::wrapper::PostgresStmt &>(stmt.getStmt());
-
-    postgresStmt.setColumn(tempTapeFileBatch.archiveFileId);
-    postgresStmt.executeCopyInsert(tempTapeFileBatch.nbRows);
-  } catch(exception::UserError &) {
-    throw;
-  } catch(exception::Exception &ex) {
-    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
-    throw;
-  }
-}
-
 //------------------------------------------------------------------------------
 // deleteArchiveFile
 //------------------------------------------------------------------------------
@@ -849,7 +799,6 @@ void PostgresCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::strin
     rdbms::Rset selectRset = selectStmt.executeQuery();
     const auto selectFromArchiveFileTime = t.secs();
     std::unique_ptr<common::dataStructures::ArchiveFile> archiveFile;
-    std::set<std::string> vidsToSetDirty;
     while(selectRset.next()) {
       if(nullptr == archiveFile.get()) {
         archiveFile = cta::make_unique<common::dataStructures::ArchiveFile>();
@@ -871,7 +820,6 @@ void PostgresCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::strin
         // Add the tape file to the archive file's in-memory structure
         common::dataStructures::TapeFile tapeFile;
         tapeFile.vid = selectRset.columnString("VID");
-        vidsToSetDirty.insert(tapeFile.vid);
         tapeFile.fSeq = selectRset.columnUint64("FSEQ");
         tapeFile.blockId = selectRset.columnUint64("BLOCK_ID");
         tapeFile.fileSize = selectRset.columnUint64("LOGICAL_SIZE_IN_BYTES");
@@ -938,12 +886,16 @@ void PostgresCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::strin
     
     const auto deleteFromTapeFileTime = t.secs(utils::Timer::resetCounter);
     
-    for(auto &vidToSetDirty: vidsToSetDirty){
-      //We deleted the TAPE_FILE so the tapes containing them should be set as dirty
-      setTapeDirty(conn,vidToSetDirty);
+    //We deleted the TAPE_FILE so the statistics of the tapes containing them are updated
+    {
+      TapeStatisticsDeltas tapeStatisticsDeltas;
+      for(auto &tapeFile: archiveFile->tapeFiles){
+        tapeStatisticsDeltas.removeTapeFile(tapeFile.vid, tapeFile.copyNb, archiveFile->fileSize);
+      }
+      updateTapeStatistics(conn, tapeStatisticsDeltas);
     }
     
-    const auto setTapeDirtyTime = t.secs(utils::Timer::resetCounter);
+    const auto updateTapeStatisticsTime = t.secs(utils::Timer::resetCounter);
 
     {
       const char *const sql = "DELETE FROM ARCHIVE_FILE WHERE ARCHIVE_FILE_ID = :ARCHIVE_FILE_ID";
@@ -972,7 +924,7 @@ void PostgresCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::strin
        .add("selectFromArchiveFileTime", selectFromArchiveFileTime)
        .add("deleteFromTapeFileTime", deleteFromTapeFileTime)
        .add("deleteFromArchiveFileTime", deleteFromArchiveFileTime)
-       .add("setTapeDirtyTime",setTapeDirtyTime)
+       .add("updateTapeStatisticsTime", updateTapeStatisticsTime)
        .add("commitTime", commitTime);
     archiveFile->checksumBlob.addFirstChecksumToLog(spc);
     for(auto it=archiveFile->tapeFiles.begin(); it!=archiveFile->tapeFiles.end(); it++) {
@@ -997,18 +949,33 @@ void PostgresCatalogue::DO_NOT_USE_deleteArchiveFile_DO_NOT_USE(const std::strin
 }
 
 //------------------------------------------------------------------------------
-// beginCreateTemporarySetDeferred
+// createStagingTablesAndBeginSetDeferred
 //------------------------------------------------------------------------------
-void PostgresCatalogue::beginCreateTemporarySetDeferred(rdbms::Conn &conn) const {
+void PostgresCatalogue::createStagingTablesAndBeginSetDeferred(rdbms::Conn &conn) const {
+  // The staging tables are temporary tables that live as long as the database session and are emptied at the end of
+  // each transaction. They are created (in their own transaction, so a later rollback does not drop them) the first
+  // time the session needs them: in the steady state there is no DDL nor catalog churn per batch.
+  bool stagingTablesExist = false;
+  {
+    const char *const sql =
+      "SELECT CASE WHEN TO_REGCLASS('PG_TEMP.TEMP_TAPE_FILE_INSERTION_BATCH') IS NULL THEN 0 ELSE 1 END AS STAGING_TABLES_EXIST";
+    auto stmt = conn.createStmt(sql);
+    auto rset = stmt.executeQuery();
+    stagingTablesExist = rset.next() && 1 == rset.columnUint64("STAGING_TABLES_EXIST");
+  }
+  if (!stagingTablesExist) {
+    // The statements are sent together and executed in a single implicit transaction.
+    conn.executeNonQuery(
+      "CREATE TEMPORARY TABLE TEMP_ARCHIVE_FILE_BATCH (LIKE ARCHIVE_FILE) ON COMMIT DELETE ROWS;"
+      "ALTER TABLE TEMP_ARCHIVE_FILE_BATCH ADD COLUMN STORAGE_CLASS_NAME VARCHAR(100);"
+      "ALTER TABLE TEMP_ARCHIVE_FILE_BATCH ALTER COLUMN STORAGE_CLASS_ID DROP NOT NULL;"
+      "ALTER TABLE TEMP_ARCHIVE_FILE_BATCH ALTER COLUMN IS_DELETED DROP NOT NULL;"
+      "CREATE INDEX TEMP_A_F_B_ARCHIVE_FILE_ID_I ON TEMP_ARCHIVE_FILE_BATCH(ARCHIVE_FILE_ID);"
+      "CREATE INDEX TEMP_A_F_B_DIN_SCN_I ON TEMP_ARCHIVE_FILE_BATCH(DISK_INSTANCE_NAME, STORAGE_CLASS_NAME);"
+      "CREATE TEMPORARY TABLE TEMP_TAPE_FILE_INSERTION_BATCH (LIKE TAPE_FILE) ON COMMIT DELETE ROWS;"
+      "CREATE INDEX TEMP_T_F_I_B_ARCHIVE_FILE_ID_I ON TEMP_TAPE_FILE_INSERTION_BATCH(ARCHIVE_FILE_ID)");
+  }
   conn.executeNonQuery("BEGIN");
-  conn.executeNonQuery("CREATE TEMPORARY TABLE TEMP_ARCHIVE_FILE_BATCH (LIKE ARCHIVE_FILE) ON COMMIT DROP");
-  conn.executeNonQuery("ALTER TABLE TEMP_ARCHIVE_FILE_BATCH ADD COLUMN STORAGE_CLASS_NAME VARCHAR(100)");
-  conn.executeNonQuery("ALTER TABLE TEMP_ARCHIVE_FILE_BATCH ALTER COLUMN STORAGE_CLASS_ID DROP NOT NULL");
-  conn.executeNonQuery("ALTER TABLE TEMP_ARCHIVE_FILE_BATCH ALTER COLUMN IS_DELETED DROP NOT NULL");
-  conn.executeNonQuery("CREATE INDEX TEMP_A_F_B_ARCHIVE_FILE_ID_I ON TEMP_ARCHIVE_FILE_BATCH(ARCHIVE_FILE_ID)");
-  conn.executeNonQuery("CREATE INDEX TEMP_A_F_B_DIN_SCN_I ON TEMP_ARCHIVE_FILE_BATCH(DISK_INSTANCE_NAME, STORAGE_CLASS_NAME)");
-  conn.executeNonQuery("CREATE TEMPORARY TABLE TEMP_TAPE_FILE_BATCH(ARCHIVE_FILE_ID NUMERIC(20,0)) ON COMMIT DROP");
-  conn.executeNonQuery("CREATE INDEX TEMP_T_F_B_ARCHIVE_FILE_ID_I ON TEMP_TAPE_FILE_BATCH(ARCHIVE_FILE_ID)");
   conn.executeNonQuery("SET CONSTRAINTS ARCHIVE_FILE_DIN_DFI_UN DEFERRED");
 }
 
@@ -1024,8 +991,6 @@ void PostgresCatalogue::copyArchiveFileToFileRecyleLogAndDelete(rdbms::Conn & co
     conn.executeNonQuery("BEGIN");
     copyArchiveFileToFileRecycleLog(conn,request);
     tl.insertAndReset("insertToRecycleBinTime",t);
-    setTapeDirty(conn,request.archiveFileID);
-    tl.insertAndReset("setTapeDirtyTime",t);
     deleteTapeFiles(conn,request);
     tl.insertAndReset("deleteTapeFilesTime",t);
     RdbmsCatalogue::deleteArchiveFile(conn,request);
@@ -1087,8 +1052,6 @@ void PostgresCatalogue::copyTapeFileToFileRecyleLogAndDelete(rdbms::Conn & conn,
     conn.executeNonQuery("BEGIN");
     copyTapeFilesToFileRecycleLog(conn, file, reason);
     tl.insertAndReset("insertToRecycleBinTime",t);
-    setTapeDirty(conn, file.archiveFileID);
-    tl.insertAndReset("setTapeDirtyTime",t);
     deleteTapeFiles(conn,file);
     tl.insertAndReset("deleteTapeFilesTime",t);
     conn.commit();
@@ -1199,6 +1162,30 @@ void PostgresCatalogue::restoreFileCopyInRecycleLog(rdbms::Conn & conn, const co
   }
 }
 
+//------------------------------------------------------------------------------
+// beginDiskSpaceReservation
+//------------------------------------------------------------------------------
+void PostgresCatalogue::beginDiskSpaceReservation(rdbms::Conn & conn, const std::string & diskSystemName) {
+  try {
+    conn.executeNonQuery("BEGIN");
+    const char *const sql =
+      "SELECT "
+        "DISK_SYSTEM_NAME AS DISK_SYSTEM_NAME "
+      "FROM "
+        "DISK_SYSTEM "
+      "WHERE "
+        "DISK_SYSTEM_NAME = :DISK_SYSTEM_NAME "
+      "FOR UPDATE";
+    auto stmt = conn.createStmt(sql);
+    stmt.bindString(":DISK_SYSTEM_NAME", diskSystemName);
+    auto rset = stmt.executeQuery();
+    // A disk system which is not in the catalogue is not locked
+    rset.next();
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
 
 } // namespace catalogue
 } // namespace cta
@@ -194,14 +194,15 @@ public:
 private:
 
   /**
-   * Start a database transaction and then create the temporary
-   * tables TEMP_ARCHIVE_FILE_BATCH and TEMP_TAPE_FILE_BATCH.
+   * Creates the session scoped staging tables TEMP_ARCHIVE_FILE_BATCH and
+   * TEMP_TAPE_FILE_INSERTION_BATCH if the database session does not have
+   * them yet, and then starts a database transaction.
    * Sets deferred mode for one of the db constraints to avoid
    * violations during concurrent bulk insert.
    *
    * @parm conn The database connection.
    */
-  void beginCreateTemporarySetDeferred(rdbms::Conn &conn) const;
+  void createStagingTablesAndBeginSetDeferred(rdbms::Conn &conn) const;
 
   /**
    * Selects the specified tape for update and returns its last FSeq.
@@ -260,15 +261,6 @@ private:
   std::map<uint64_t, FileSizeAndChecksum> selectArchiveFileSizesAndChecksums(rdbms::Conn &conn,
     const std::set<TapeFileWritten> &events) const;
 
-  /**
-   * Batch inserts rows into the TAPE_FILE_BATCH temporary table that correspond
-   * to the specified TapeFileWritten events.
-   *
-   * @param conn The database connection.
-   * @param events The tape file written events.
-   */
-  void insertTapeFileBatchIntoTempTable(rdbms::Conn &conn, const std::set<TapeFileWritten> &events) const;
-  
   /**
    * Copy the archiveFile and the associated tape files from the ARCHIVE_FILE and TAPE_FILE tables to the FILE_RECYCLE_LOG table
    * and deletes the ARCHIVE_FILE and TAPE_FILE entries.
@@ -312,6 +304,14 @@ private:
    */
   void restoreFileCopyInRecycleLog(rdbms::Conn & conn, const common::dataStructures::FileRecycleLog &fileRecycleLogItor, log::LogContext & lc);
 
+  /**
+   * Starts the transaction of a disk space reservation and locks the disk system, so that the concurrent
+   * reservations for the same disk system are serialized until the transaction is committed or rolled back.
+   * @param conn the database connection
+   * @param diskSystemName the name of the disk system
+   */
+  void beginDiskSpaceReservation(rdbms::Conn & conn, const std::string & diskSystemName) override;
+
 }; // class PostgresCatalogue
 
 } // namespace catalogue
@@ -63,7 +63,7 @@ RdbmsCatalogue::RdbmsCatalogue(
   m_groupMountPolicyCache(10),
   m_userMountPolicyCache(10),
   m_allMountPoliciesCache(60),
-  m_tapepoolVirtualOrganizationCache(60),
+  m_tapepoolVirtualOrganizationCache(60, true),
   m_expectedNbArchiveRoutesCache(10),
   m_isAdminCache(10),
   m_activitiesFairShareWeights(10) {}
@@ -2051,6 +2051,8 @@ void RdbmsCatalogue::createTapePool(
     stmt.bindUint64(":LAST_UPDATE_TIME", now);
 
     stmt.executeNonQuery();
+
+    m_tapepoolVirtualOrganizationCache.invalidate();
   } catch(exception::UserError &) {
     throw;
   } catch(exception::Exception &ex) {
@@ -4411,7 +4413,21 @@ void RdbmsCatalogue::deleteTapeFiles(rdbms::Conn& conn, const std::string& vid)
     auto stmt = conn.createStmt(sql);
     stmt.bindString(":VID", vid);
     stmt.executeNonQuery();
-    setTapeDirty(conn,vid);
+
+    const char * const resetStatisticsSql =
+    "UPDATE TAPE SET "
+      "NB_MASTER_FILES = 0,"
+      "MASTER_DATA_IN_BYTES = 0,"
+      "NB_COPY_NB_1 = 0,"
+      "COPY_NB_1_IN_BYTES = 0,"
+      "NB_COPY_NB_GT_1 = 0,"
+      "COPY_NB_GT_1_IN_BYTES = 0,"
+      "DIRTY = '0' "
+    "WHERE "
+      "VID = :VID";
+    auto resetStatisticsStmt = conn.createStmt(resetStatisticsSql);
+    resetStatisticsStmt.bindString(":VID", vid);
+    resetStatisticsStmt.executeNonQuery();
   } catch(exception::Exception &ex) {
     ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
     throw;
@@ -4435,23 +4451,72 @@ void RdbmsCatalogue::setTapeDirty(rdbms::Conn& conn, const std::string& vid) con
 }
 
 //------------------------------------------------------------------------------
-//setTapeDirty
+//updateTapeStatistics
 //------------------------------------------------------------------------------
-void RdbmsCatalogue::setTapeDirty(rdbms::Conn& conn, const uint64_t & archiveFileId) const {
+void RdbmsCatalogue::updateTapeStatistics(rdbms::Conn& conn, const TapeStatisticsDeltas& deltas) const {
   try {
-    const char * const sql =
-    "UPDATE TAPE SET DIRTY='1' "
-    "WHERE VID IN "
-    "  (SELECT DISTINCT TAPE_FILE.VID AS VID FROM TAPE_FILE WHERE TAPE_FILE.ARCHIVE_FILE_ID = :ARCHIVE_FILE_ID)";
-    auto stmt = conn.createStmt(sql);
-    stmt.bindUint64(":ARCHIVE_FILE_ID", archiveFileId);
-    stmt.executeNonQuery();
+    for (const auto & vidAndDelta: deltas.getDeltas()) {
+      const auto & delta = vidAndDelta.second;
+      if (delta.empty()) continue;
+      const std::list<std::pair<std::string, int64_t>> columnDeltas = {
+        {"NB_MASTER_FILES", delta.nbCopyNb1 + delta.nbCopyNbGt1},
+        {"MASTER_DATA_IN_BYTES", delta.copyNb1InBytes + delta.copyNbGt1InBytes},
+        {"NB_COPY_NB_1", delta.nbCopyNb1},
+        {"COPY_NB_1_IN_BYTES", delta.copyNb1InBytes},
+        {"NB_COPY_NB_GT_1", delta.nbCopyNbGt1},
+        {"COPY_NB_GT_1_IN_BYTES", delta.copyNbGt1InBytes}};
+      // The columns are unsigned: a decrement is written so that it cannot go below 0
+      std::string sql = "UPDATE TAPE SET ";
+      bool first = true;
+      for (const auto & columnDelta: columnDeltas) {
+        const std::string & column = columnDelta.first;
+        if (!columnDelta.second) continue;
+        if (!first) sql += ",";
+        first = false;
+        if (columnDelta.second > 0) {
+          sql += column + " = " + column + " + :" + column;
+        } else {
+          sql += column + " = CASE WHEN " + column + " > :" + column + " THEN " + column + " - :" + column + "_2 ELSE 0 END";
+        }
+      }
+      sql += " WHERE VID = :VID";
+      auto stmt = conn.createStmt(sql);
+      for (const auto & columnDelta: columnDeltas) {
+        const std::string & column = columnDelta.first;
+        if (columnDelta.second > 0) {
+          stmt.bindUint64(":" + column, columnDelta.second);
+        } else if (columnDelta.second < 0) {
+          stmt.bindUint64(":" + column, -columnDelta.second);
+          stmt.bindUint64(":" + column + "_2", -columnDelta.second);
+        }
+      }
+      stmt.bindString(":VID", vidAndDelta.first);
+      stmt.executeNonQuery();
+    }
   } catch(exception::Exception &ex) {
     ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
     throw;
   }
 }
 
+//------------------------------------------------------------------------------
+//getTapeStatisticsDeltas
+//------------------------------------------------------------------------------
+TapeStatisticsDeltas RdbmsCatalogue::getTapeStatisticsDeltas(const std::set<TapeFileWritten> &fileEvents,
+  const std::list<InsertFileRecycleLog> &recycledFiles) {
+  TapeStatisticsDeltas tapeStatisticsDeltas;
+  std::map<uint64_t, uint64_t> archiveFileSizes;
+  for (const auto &event: fileEvents) {
+    tapeStatisticsDeltas.addTapeFile(event.vid, event.copyNb, event.size);
+    archiveFileSizes[event.archiveFileId] = event.size;
+  }
+  for (const auto &recycledFile: recycledFiles) {
+    tapeStatisticsDeltas.removeTapeFile(recycledFile.vid, recycledFile.copyNb,
+      archiveFileSizes.at(recycledFile.archiveFileId));
+  }
+  return tapeStatisticsDeltas;
+}
+
 //------------------------------------------------------------------------------
 //resetTapeCounters
 //------------------------------------------------------------------------------
@@ -7834,8 +7899,7 @@ void RdbmsCatalogue::updateTape(
         "LAST_FSEQ = :LAST_FSEQ,"
         "DATA_IN_BYTES = DATA_IN_BYTES + :DATA_IN_BYTES,"
         "LAST_WRITE_DRIVE = :LAST_WRITE_DRIVE,"
-        "LAST_WRITE_TIME = :LAST_WRITE_TIME,"
-        "DIRTY='1' "
+        "LAST_WRITE_TIME = :LAST_WRITE_TIME "
       "WHERE "
         "VID = :VID";
     auto stmt = conn.createStmt(sql);
@@ -7868,8 +7932,22 @@ common::dataStructures::RetrieveFileQueueCriteria RdbmsCatalogue::prepareToRetri
     {
       auto conn = m_connPool.getConn();
       const auto getConnTime = t.secs(utils::Timer::resetCounter);
-      auto archiveFile = getArchiveFileToRetrieveByArchiveFileId(conn, archiveFileId);
-      const auto getArchiveFileTime = t.secs(utils::Timer::resetCounter);
+
+      // The archive file and the mount policies are independent, so both queries are sent together
+      auto archiveFileStmt = createGetArchiveFileToRetrieveStmt(conn, archiveFileId);
+      auto mountPoliciesStmt = createGetMountPoliciesStmt(conn, diskInstanceName, user.name, user.group);
+      auto rsets = conn.executeQueries({&archiveFileStmt, &mountPoliciesStmt});
+      const auto executeQueriesTime = t.secs(utils::Timer::resetCounter);
+      auto archiveFile = getArchiveFileToRetrieve(rsets.at(0));
+      const RequesterAndGroupMountPolicies mountPolicies = getRequesterAndGroupMountPolicies(rsets.at(1));
+      const auto readResultsTime = t.secs(utils::Timer::resetCounter);
+
+      log::ScopedParamContainer spc(lc);
+      spc.add("getConnTime", getConnTime)
+         .add("executeQueriesTime", executeQueriesTime)
+         .add("readResultsTime", readResultsTime);
+      lc.log(log::INFO, "Catalogue::prepareToRetrieve internal timings");
+
       if(nullptr == archiveFile.get()) {
         exception::UserError ex;
         ex.getMessage() << "No tape files available for archive file with archive file ID " << archiveFileId;
@@ -7884,17 +7962,6 @@ common::dataStructures::RetrieveFileQueueCriteria RdbmsCatalogue::prepareToRetri
         throw ue;
       }
 
-      t.reset();
-      const RequesterAndGroupMountPolicies mountPolicies = getMountPolicies(conn, diskInstanceName, user.name,
-        user.group);
-       const auto getMountPoliciesTime = t.secs(utils::Timer::resetCounter);
-
-      log::ScopedParamContainer spc(lc);
-      spc.add("getConnTime", getConnTime)
-         .add("getArchiveFileTime", getArchiveFileTime)
-         .add("getMountPoliciesTime", getMountPoliciesTime);
-      lc.log(log::INFO, "Catalogue::prepareToRetrieve internal timings");
-
       // Requester mount policies overrule requester group mount policies
       common::dataStructures::MountPolicy mountPolicy;
       if(!mountPolicies.requesterMountPolicies.empty()) {
@@ -7924,9 +7991,9 @@ common::dataStructures::RetrieveFileQueueCriteria RdbmsCatalogue::prepareToRetri
 }
 
 //------------------------------------------------------------------------------
-// getMountPolicies
+// createGetMountPoliciesStmt
 //------------------------------------------------------------------------------
-RequesterAndGroupMountPolicies RdbmsCatalogue::getMountPolicies(
+rdbms::Stmt RdbmsCatalogue::createGetMountPoliciesStmt(
   rdbms::Conn &conn,
   const std::string &diskInstanceName,
   const std::string &requesterName,
@@ -7990,8 +8057,20 @@ RequesterAndGroupMountPolicies RdbmsCatalogue::getMountPolicies(
     stmt.bindString(":GROUP_DISK_INSTANCE_NAME", diskInstanceName);
     stmt.bindString(":REQUESTER_NAME", requesterName);
     stmt.bindString(":REQUESTER_GROUP_NAME", requesterGroupName);
-    auto rset = stmt.executeQuery();
+    return stmt;
+  } catch(exception::UserError &) {
+    throw;
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
 
+//------------------------------------------------------------------------------
+// getRequesterAndGroupMountPolicies
+//------------------------------------------------------------------------------
+RequesterAndGroupMountPolicies RdbmsCatalogue::getRequesterAndGroupMountPolicies(rdbms::Rset &rset) const {
+  try {
     RequesterAndGroupMountPolicies policies;
     while(rset.next()) {
       common::dataStructures::MountPolicy policy;
@@ -8200,6 +8279,14 @@ void RdbmsCatalogue::insertTapeFile(
         stmt.executeNonQuery();
       }
     }
+    {
+      TapeStatisticsDeltas tapeStatisticsDeltas;
+      tapeStatisticsDeltas.addTapeFile(tapeFile.vid, tapeFile.copyNb, tapeFile.fileSize);
+      for(auto& fileRecycleLog: insertedFilesRecycleLog){
+        tapeStatisticsDeltas.removeTapeFile(fileRecycleLog.vid, fileRecycleLog.copyNb, tapeFile.fileSize);
+      }
+      updateTapeStatistics(conn, tapeStatisticsDeltas);
+    }
     conn.commit();
   } catch(exception::UserError &) {
     throw;
@@ -8322,10 +8409,10 @@ std::unique_ptr<ArchiveFileRow> RdbmsCatalogue::getArchiveFileRowById(rdbms::Con
 }
 
 //------------------------------------------------------------------------------
-// getArchiveFileToRetrieveByArchiveFileId
+// createGetArchiveFileToRetrieveStmt
 //------------------------------------------------------------------------------
-std::unique_ptr<common::dataStructures::ArchiveFile> RdbmsCatalogue::getArchiveFileToRetrieveByArchiveFileId(
-  rdbms::Conn &conn, const uint64_t archiveFileId) const {
+rdbms::Stmt RdbmsCatalogue::createGetArchiveFileToRetrieveStmt(rdbms::Conn &conn, const uint64_t archiveFileId)
+  const {
   try {
     const char *const sql =
       "SELECT "
@@ -8361,7 +8448,21 @@ std::unique_ptr<common::dataStructures::ArchiveFile> RdbmsCatalogue::getArchiveF
         "TAPE_FILE.CREATION_TIME ASC";
     auto stmt = conn.createStmt(sql);
     stmt.bindUint64(":ARCHIVE_FILE_ID", archiveFileId);
-    auto rset = stmt.executeQuery();
+    return stmt;
+  } catch(exception::UserError &) {
+    throw;
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
+//------------------------------------------------------------------------------
+// getArchiveFileToRetrieve
+//------------------------------------------------------------------------------
+std::unique_ptr<common::dataStructures::ArchiveFile> RdbmsCatalogue::getArchiveFileToRetrieve(rdbms::Rset &rset)
+  const {
+  try {
     std::unique_ptr<common::dataStructures::ArchiveFile> archiveFile;
     while (rset.next()) {
       if(nullptr == archiveFile.get()) {
@@ -9156,6 +9257,29 @@ void RdbmsCatalogue::insertFileInFileRecycleLog(rdbms::Conn& conn, const InsertF
 
 void RdbmsCatalogue::deleteTapeFiles(rdbms::Conn & conn, const common::dataStructures::DeleteArchiveRequest& request){
   try {
+    //Get the tape files to delete, for the statistics of their tapes
+    TapeStatisticsDeltas tapeStatisticsDeltas;
+    {
+      const char *const selectTapeFilesSql =
+      "SELECT "
+        "TAPE_FILE.VID AS VID,"
+        "TAPE_FILE.COPY_NB AS COPY_NB,"
+        "ARCHIVE_FILE.SIZE_IN_BYTES AS SIZE_IN_BYTES "
+      "FROM "
+        "TAPE_FILE "
+      "INNER JOIN ARCHIVE_FILE ON "
+        "TAPE_FILE.ARCHIVE_FILE_ID = ARCHIVE_FILE.ARCHIVE_FILE_ID "
+      "WHERE TAPE_FILE.ARCHIVE_FILE_ID = :ARCHIVE_FILE_ID";
+
+      auto selectTapeFilesStmt = conn.createStmt(selectTapeFilesSql);
+      selectTapeFilesStmt.bindUint64(":ARCHIVE_FILE_ID",request.archiveFileID);
+      auto rset = selectTapeFilesStmt.executeQuery();
+      while(rset.next()) {
+        tapeStatisticsDeltas.removeTapeFile(rset.columnString("VID"), rset.columnUint64("COPY_NB"),
+          rset.columnUint64("SIZE_IN_BYTES"));
+      }
+    }
+
     //Delete the tape files after.
     const char *const deleteTapeFilesSql =
     "DELETE FROM "
@@ -9165,6 +9289,8 @@ void RdbmsCatalogue::deleteTapeFiles(rdbms::Conn & conn, const common::dataStruc
     auto deleteTapeFilesStmt = conn.createStmt(deleteTapeFilesSql);
     deleteTapeFilesStmt.bindUint64(":ARCHIVE_FILE_ID",request.archiveFileID);
     deleteTapeFilesStmt.executeNonQuery();
+
+    updateTapeStatistics(conn, tapeStatisticsDeltas);
   } catch(exception::UserError &) {
     throw;
   } catch(exception::Exception &ex) {
@@ -9175,6 +9301,7 @@ void RdbmsCatalogue::deleteTapeFiles(rdbms::Conn & conn, const common::dataStruc
 
 void RdbmsCatalogue::deleteTapeFiles(rdbms::Conn & conn, const common::dataStructures::ArchiveFile& file){
   try {
+    TapeStatisticsDeltas tapeStatisticsDeltas;
     for(auto &tapeFile: file.tapeFiles) {
 
       //Delete the tape file.
@@ -9189,7 +9316,11 @@ void RdbmsCatalogue::deleteTapeFiles(rdbms::Conn & conn, const common::dataStruc
       deleteTapeFilesStmt.bindString(":VID", tapeFile.vid);
       deleteTapeFilesStmt.bindUint64(":FSEQ", tapeFile.fSeq);
       deleteTapeFilesStmt.executeNonQuery();
+      if(deleteTapeFilesStmt.getNbAffectedRows()) {
+        tapeStatisticsDeltas.removeTapeFile(tapeFile.vid, tapeFile.copyNb, file.fileSize);
+      }
     }
+    updateTapeStatistics(conn, tapeStatisticsDeltas);
   } catch(exception::UserError &) {
     throw;
   } catch(exception::Exception &ex) {
@@ -9641,6 +9772,62 @@ void RdbmsCatalogue::settingSqlTapeDriveValues(cta::rdbms::Stmt *stmt,
     const optional<uint64_t> optionalField) {
     stmt->bindUint64(sqlField, optionalField ? optionalField.value() : 0);
   };
+
+  settingSqlTapeDriveStatusValues(stmt, tapeDrive);
+
+  stmt->bindBool(":DESIRED_UP", tapeDrive.desiredUp);
+  stmt->bindBool(":DESIRED_FORCE_DOWN", tapeDrive.desiredForceDown);
+  setOptionalString(":REASON_UP_DOWN", tapeDrive.reasonUpDown);
+
+  setOptionalString(":CTA_VERSION", tapeDrive.ctaVersion);
+  setOptionalUint64(":CURRENT_PRIORITY", tapeDrive.currentPriority);
+  stmt->bindUint32(":NEXT_MOUNT_TYPE", tapeDrive.nextMountType
+    ? static_cast<uint32_t>(tapeDrive.nextMountType.value()) : 9999);
+  setOptionalString(":NEXT_VID", tapeDrive.nextVid);
+  setOptionalString(":NEXT_TAPE_POOL", tapeDrive.nextTapePool);
+  setOptionalUint64(":NEXT_PRIORITY", tapeDrive.nextPriority);
+  setOptionalString(":NEXT_ACTIVITY", tapeDrive.nextActivity);
+  setOptionalString(":NEXT_ACTIVITY_WEIGHT", tapeDrive.nextActivityWeight);
+
+  setOptionalString(":DEV_FILE_NAME", tapeDrive.devFileName);
+  setOptionalString(":RAW_LIBRARY_SLOT", tapeDrive.rawLibrarySlot);
+
+  setOptionalString(":NEXT_VO", tapeDrive.nextVo);
+  setOptionalString(":USER_COMMENT", tapeDrive.userComment);
+
+  if (tapeDrive.creationLog) {
+    setOptionalString(":CREATION_LOG_USER_NAME", tapeDrive.creationLog.value().username);
+    setOptionalString(":CREATION_LOG_HOST_NAME", tapeDrive.creationLog.value().host);
+    setOptionalUint64(":CREATION_LOG_TIME", tapeDrive.creationLog.value().time);
+  } else {
+    setOptionalString(":CREATION_LOG_USER_NAME", nullStringMessage);
+    setOptionalString(":CREATION_LOG_HOST_NAME", nullStringMessage);
+    setOptionalUint64(":CREATION_LOG_TIME", 0);
+  }
+
+  stmt->bindString(":DISK_SYSTEM_NAME", tapeDrive.diskSystemName);
+  stmt->bindUint64(":RESERVED_BYTES", tapeDrive.reservedBytes);
+}
+
+void RdbmsCatalogue::settingSqlTapeDriveStatusValues(cta::rdbms::Stmt *stmt,
+  const common::dataStructures::TapeDrive &tapeDrive) const {
+  const std::string nullStringMessage = "NULL";
+  auto setOptionalString = [&stmt, nullStringMessage](const std::string &sqlField,
+    const optional<std::string> &optionalField) {
+    if (optionalField) {
+      if (optionalField.value().empty()) {
+        stmt->bindString(sqlField, nullStringMessage);
+      } else {
+        stmt->bindString(sqlField, optionalField.value());
+      }
+    } else {
+      stmt->bindString(sqlField, nullStringMessage);
+    }
+  };
+  auto setOptionalUint64 = [&stmt](const std::string &sqlField,
+    const optional<uint64_t> optionalField) {
+    stmt->bindUint64(sqlField, optionalField ? optionalField.value() : 0);
+  };
   auto setOptionalTime = [&stmt](const std::string &sqlField,
     const optional<time_t> optionalField) {
     stmt->bindUint64(sqlField, optionalField ? optionalField.value() : 0);
@@ -9671,54 +9858,21 @@ void RdbmsCatalogue::settingSqlTapeDriveValues(cta::rdbms::Stmt *stmt,
   stmt->bindString(":DRIVE_STATUS", common::dataStructures::TapeDrive::stateToString(
     tapeDrive.driveStatus));
 
-  stmt->bindBool(":DESIRED_UP", tapeDrive.desiredUp);
-  stmt->bindBool(":DESIRED_FORCE_DOWN", tapeDrive.desiredForceDown);
-  setOptionalString(":REASON_UP_DOWN", tapeDrive.reasonUpDown);
-
   setOptionalString(":CURRENT_VID", tapeDrive.currentVid);
-  setOptionalString(":CTA_VERSION", tapeDrive.ctaVersion);
-  setOptionalUint64(":CURRENT_PRIORITY", tapeDrive.currentPriority);
   setOptionalString(":CURRENT_ACTIVITY", tapeDrive.currentActivity);
   setOptionalString(":CURRENT_ACTIVITY_WEIGHT", tapeDrive.currentActivityWeight);
   setOptionalString(":CURRENT_TAPE_POOL", tapeDrive.currentTapePool);
-  stmt->bindUint32(":NEXT_MOUNT_TYPE", tapeDrive.nextMountType
-    ? static_cast<uint32_t>(tapeDrive.nextMountType.value()) : 9999);
-  setOptionalString(":NEXT_VID", tapeDrive.nextVid);
-  setOptionalString(":NEXT_TAPE_POOL", tapeDrive.nextTapePool);
-  setOptionalUint64(":NEXT_PRIORITY", tapeDrive.nextPriority);
-  setOptionalString(":NEXT_ACTIVITY", tapeDrive.nextActivity);
-  setOptionalString(":NEXT_ACTIVITY_WEIGHT", tapeDrive.nextActivityWeight);
-
-  setOptionalString(":DEV_FILE_NAME", tapeDrive.devFileName);
-  setOptionalString(":RAW_LIBRARY_SLOT", tapeDrive.rawLibrarySlot);
-
   setOptionalString(":CURRENT_VO", tapeDrive.currentVo);
-  setOptionalString(":NEXT_VO", tapeDrive.nextVo);
-  setOptionalString(":USER_COMMENT", tapeDrive.userComment);
-
-  auto setEntryLog = [stmt, setOptionalString, setOptionalUint64](const std::string &field, const std::string &username,
-    const std::string &host, const time_t &time) {
-      setOptionalString(field + "_USER_NAME", username);
-      setOptionalString(field + "_HOST_NAME", host);
-      setOptionalUint64(field + "_TIME", time);
-  };
-
-  if (tapeDrive.creationLog) {
-    setEntryLog(":CREATION_LOG", tapeDrive.creationLog.value().username,
-      tapeDrive.creationLog.value().host, tapeDrive.creationLog.value().time);
-  } else {
-    setEntryLog(":CREATION_LOG", nullStringMessage, nullStringMessage, 0);
-  }
 
   if (tapeDrive.lastModificationLog) {
-    setEntryLog(":LAST_UPDATE", tapeDrive.lastModificationLog.value().username,
-      tapeDrive.lastModificationLog.value().host, tapeDrive.lastModificationLog.value().time);
+    setOptionalString(":LAST_UPDATE_USER_NAME", tapeDrive.lastModificationLog.value().username);
+    setOptionalString(":LAST_UPDATE_HOST_NAME", tapeDrive.lastModificationLog.value().host);
+    setOptionalUint64(":LAST_UPDATE_TIME", tapeDrive.lastModificationLog.value().time);
   } else {
-    setEntryLog(":LAST_UPDATE", nullStringMessage, nullStringMessage, 0);
+    setOptionalString(":LAST_UPDATE_USER_NAME", nullStringMessage);
+    setOptionalString(":LAST_UPDATE_HOST_NAME", nullStringMessage);
+    setOptionalUint64(":LAST_UPDATE_TIME", 0);
   }
-
-  stmt->bindString(":DISK_SYSTEM_NAME", tapeDrive.diskSystemName);
-  stmt->bindUint64(":RESERVED_BYTES", tapeDrive.reservedBytes);
 }
 
 void RdbmsCatalogue::deleteTapeDrive(const std::string &tapeDriveName) {
@@ -10007,6 +10161,162 @@ void RdbmsCatalogue::modifyTapeDrive(const common::dataStructures::TapeDrive &ta
   }
 }
 
+void RdbmsCatalogue::modifyTapeDriveStatuses(const std::list<common::dataStructures::TapeDrive> &tapeDrives) {
+  try {
+    if (tapeDrives.empty()) return;
+    const char *const sql =
+      "UPDATE TAPE_DRIVE "
+      "SET "
+        "HOST = :HOST,"
+        "LOGICAL_LIBRARY = :LOGICAL_LIBRARY,"
+        "SESSION_ID = :SESSION_ID,"
+
+        "BYTES_TRANSFERED_IN_SESSION = :BYTES_TRANSFERED_IN_SESSION,"
+        "FILES_TRANSFERED_IN_SESSION = :FILES_TRANSFERED_IN_SESSION,"
+        "LATEST_BANDWIDTH = :LATEST_BANDWIDTH,"
+
+        "SESSION_START_TIME = :SESSION_START_TIME,"
+        "MOUNT_START_TIME = :MOUNT_START_TIME,"
+        "TRANSFER_START_TIME = :TRANSFER_START_TIME,"
+        "UNLOAD_START_TIME = :UNLOAD_START_TIME,"
+        "UNMOUNT_START_TIME = :UNMOUNT_START_TIME,"
+        "DRAINING_START_TIME = :DRAINING_START_TIME,"
+        "DOWN_OR_UP_START_TIME = :DOWN_OR_UP_START_TIME,"
+        "PROBE_START_TIME = :PROBE_START_TIME,"
+        "CLEANUP_START_TIME = :CLEANUP_START_TIME,"
+        "START_START_TIME = :START_START_TIME,"
+        "SHUTDOWN_TIME = :SHUTDOWN_TIME,"
+
+        "MOUNT_TYPE = :MOUNT_TYPE,"
+        "DRIVE_STATUS = :DRIVE_STATUS,"
+
+        "CURRENT_VID = :CURRENT_VID,"
+        "CURRENT_ACTIVITY = :CURRENT_ACTIVITY,"
+        "CURRENT_ACTIVITY_WEIGHT = :CURRENT_ACTIVITY_WEIGHT,"
+        "CURRENT_TAPE_POOL = :CURRENT_TAPE_POOL,"
+        "CURRENT_VO = :CURRENT_VO,"
+
+        "LAST_UPDATE_USER_NAME = :LAST_UPDATE_USER_NAME,"
+        "LAST_UPDATE_HOST_NAME = :LAST_UPDATE_HOST_NAME,"
+        "LAST_UPDATE_TIME = :LAST_UPDATE_TIME "
+      "WHERE "
+        "DRIVE_NAME = :DRIVE_NAME";
+
+    // A single connection and prepared statement for all the drives
+    auto conn = m_connPool.getConn();
+    auto stmt = conn.createStmt(sql);
+    for (const auto &tapeDrive: tapeDrives) {
+      settingSqlTapeDriveStatusValues(&stmt, tapeDrive);
+      stmt.executeNonQuery();
+    }
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
+std::map<std::string, uint64_t> RdbmsCatalogue::getDiskSpaceReservations() const {
+  try {
+    std::map<std::string, uint64_t> reservations;
+    const char *const sql =
+      "SELECT "
+        "DISK_SYSTEM_NAME AS DISK_SYSTEM_NAME,"
+        "SUM(RESERVED_BYTES) AS RESERVED_BYTES "
+      "FROM "
+        "TAPE_DRIVE "
+      "GROUP BY "
+        "DISK_SYSTEM_NAME";
+
+    auto conn = m_connPool.getConn();
+    auto stmt = conn.createStmt(sql);
+    auto rset = stmt.executeQuery();
+
+    while (rset.next()) {
+      reservations[rset.columnString("DISK_SYSTEM_NAME")] = rset.columnUint64("RESERVED_BYTES");
+    }
+    return reservations;
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
+bool RdbmsCatalogue::reserveDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName,
+  const uint64_t bytes, const uint64_t maxReservedBytes) {
+  try {
+    auto conn = m_connPool.getConn();
+    rdbms::AutoRollback autoRollback(conn);
+    beginDiskSpaceReservation(conn, diskSystemName);
+
+    // The reservations of the other drives for the disk system cannot change until we commit
+    uint64_t reservedBytes = 0;
+    {
+      const char *const sql =
+        "SELECT "
+          "SUM(RESERVED_BYTES) AS RESERVED_BYTES "
+        "FROM "
+          "TAPE_DRIVE "
+        "WHERE "
+          "DISK_SYSTEM_NAME = :DISK_SYSTEM_NAME";
+      auto stmt = conn.createStmt(sql);
+      stmt.bindString(":DISK_SYSTEM_NAME", diskSystemName);
+      auto rset = stmt.executeQuery();
+      if (rset.next() && !rset.columnIsNull("RESERVED_BYTES")) {
+        reservedBytes = rset.columnUint64("RESERVED_BYTES");
+      }
+    }
+    if (reservedBytes + bytes > maxReservedBytes) {
+      return false;
+    }
+
+    const char *const sql =
+      "UPDATE TAPE_DRIVE "
+      "SET "
+        "DISK_SYSTEM_NAME = :DISK_SYSTEM_NAME,"
+        "RESERVED_BYTES = RESERVED_BYTES + :BYTES "
+      "WHERE "
+        "DRIVE_NAME = :DRIVE_NAME";
+    auto stmt = conn.createStmt(sql);
+    stmt.bindString(":DISK_SYSTEM_NAME", diskSystemName);
+    stmt.bindUint64(":BYTES", bytes);
+    stmt.bindString(":DRIVE_NAME", tapeDriveName);
+    stmt.executeNonQuery();
+
+    conn.commit();
+    autoRollback.cancel();
+    return true;
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
+bool RdbmsCatalogue::releaseDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName,
+  const uint64_t bytes) {
+  try {
+    // A single conditional update: the reservation never becomes negative
+    const char *const sql =
+      "UPDATE TAPE_DRIVE "
+      "SET "
+        "DISK_SYSTEM_NAME = :DISK_SYSTEM_NAME,"
+        "RESERVED_BYTES = RESERVED_BYTES - :BYTES "
+      "WHERE "
+        "DRIVE_NAME = :DRIVE_NAME AND "
+        "RESERVED_BYTES >= :MIN_RESERVED_BYTES";
+    auto conn = m_connPool.getConn();
+    auto stmt = conn.createStmt(sql);
+    stmt.bindString(":DISK_SYSTEM_NAME", diskSystemName);
+    stmt.bindUint64(":BYTES", bytes);
+    stmt.bindUint64(":MIN_RESERVED_BYTES", bytes);
+    stmt.bindString(":DRIVE_NAME", tapeDriveName);
+    stmt.executeNonQuery();
+    return 0 != stmt.getNbAffectedRows();
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
 void RdbmsCatalogue::createDriveConfig(const std::string &tapeDriveName, const std::string &category,
   const std::string &keyName, const std::string &value, const std::string &source) {
   try {
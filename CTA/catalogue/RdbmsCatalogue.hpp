@@ -24,6 +24,7 @@
 #include "rdbms/ConnPool.hpp"
 #include "rdbms/Login.hpp"
 #include "InsertFileRecycleLog.hpp"
+#include "TapeStatisticsDeltas.hpp"
 
 #include <memory>
 
@@ -604,7 +605,7 @@ public:
   uint64_t getNbFilesOnTape(rdbms::Conn &conn, const std::string &vid) const;
 
   /**
-   * Delete all the tape files of the VID passed in parameter
+   * Delete all the tape files of the VID passed in parameter and reset its file statistics
    * @param conn the database connection
    * @param vid the vid in which we want to remove all the tape files
    */
@@ -617,6 +618,24 @@ public:
    */
   void setTapeDirty(rdbms::Conn &conn, const std::string &vid) const;
 
+  /**
+   * Applies the changes of the file statistics of tapes caused by the tape files added or removed in the current
+   * transaction. A statistic that would become negative (the tape statistics were not up to date) is set to 0.
+   * @param conn the database connection
+   * @param deltas the changes of the statistics per tape
+   */
+  void updateTapeStatistics(rdbms::Conn &conn, const TapeStatisticsDeltas &deltas) const;
+
+  /**
+   * Returns the changes of the file statistics of tapes caused by writing tape files, including the old copies of
+   * their archive files moved to the file recycle log
+   * @param fileEvents the tape files written
+   * @param recycledFiles the old copies of the archive files moved to the file recycle log
+   * @return the changes of the statistics per tape
+   */
+  static TapeStatisticsDeltas getTapeStatisticsDeltas(const std::set<TapeFileWritten> &fileEvents,
+    const std::list<InsertFileRecycleLog> &recycledFiles);
+
   /**
    * Reset the counters of a tape
    * @param conn the database connection
@@ -1479,7 +1498,8 @@ protected:
   uint64_t getExpectedNbArchiveRoutes(rdbms::Conn &conn, const StorageClass &storageClass) const;
 
   /**
-   * Inserts the specified tape file into the Tape table.
+   * Inserts the specified tape file into the Tape table, moving the previous tape file with the same copy number (if
+   * any) to the file recycle log. The file statistics of the tapes are updated accordingly.
    *
    * @param conn The database connection.
    * @param tapeFile The tape file.
@@ -1551,16 +1571,24 @@ protected:
   std::unique_ptr<ArchiveFileRow> getArchiveFileRowById(rdbms::Conn &conn, const uint64_t id) const;
 
   /**
-   * Returns the specified archive file.   A nullptr pointer is returned if
-   * there are no corresponding rows in the TAPE_FILE table.
+   * Creates the query selecting the specified archive file together with its
+   * tape files on ACTIVE tapes.
    *
    * @param conn The database connection.
    * @param archiveFileId The identifier of the archive file.
+   * @return The statement of the query, with its parameters bound.
+   */
+  rdbms::Stmt createGetArchiveFileToRetrieveStmt(rdbms::Conn &conn, const uint64_t archiveFileId) const;
+
+  /**
+   * Returns the archive file read from the result set of the query created by
+   * createGetArchiveFileToRetrieveStmt().  A nullptr pointer is returned if
+   * there are no corresponding rows in the TAPE_FILE table.
+   *
+   * @param rset The result set.
    * @return The archive file or nullptr.
    */
-  std::unique_ptr<common::dataStructures::ArchiveFile> getArchiveFileToRetrieveByArchiveFileId(
-    rdbms::Conn &conn,
-    const uint64_t archiveFileId) const;
+  std::unique_ptr<common::dataStructures::ArchiveFile> getArchiveFileToRetrieve(rdbms::Rset &rset) const;
 
   /**
    * Returns a cached version of the (possibly empty) activities to weight map
@@ -1625,7 +1653,8 @@ protected:
     const std::string &diskFileId) const;
 
   /**
-   * Returns the mount policies for the specified requester and requester group.
+   * Creates the query selecting the mount policies for the specified requester
+   * and requester group.
    *
    * @param conn The database connection.
    * @param diskInstanceName The name of the disk instance to which the
@@ -1634,14 +1663,23 @@ protected:
    * be unique within its disk instance.
    * @param requesterGroupName The name of the requester group which is only
    * guaranteed to be unique within its disk instance.
-   * @return The mount policies.
+   * @return The statement of the query, with its parameters bound.
    */
-  RequesterAndGroupMountPolicies getMountPolicies(
+  rdbms::Stmt createGetMountPoliciesStmt(
     rdbms::Conn &conn,
     const std::string &diskInstanceName,
     const std::string &requesterName,
     const std::string &requesterGroupName) const;
 
+  /**
+   * Returns the mount policies read from the result set of the query created
+   * by createGetMountPoliciesStmt().
+   *
+   * @param rset The result set.
+   * @return The mount policies.
+   */
+  RequesterAndGroupMountPolicies getRequesterAndGroupMountPolicies(rdbms::Rset &rset) const;
+
   /**
    * Creates a temporary table from the list of disk file IDs provided in the search criteria.
    *
@@ -2010,27 +2048,20 @@ protected:
   void deleteArchiveFile(rdbms::Conn & conn, const common::dataStructures::DeleteArchiveRequest & request);
 
   /**
-   * Delete the TapeFile from the TAPE_FILE table
+   * Delete the TapeFile from the TAPE_FILE table and update the file statistics of their tapes
    * @param conn the database connection
    * @param request the DeleteArchiveRequest that contains the archiveFileId to delete the corresponding tape files
    */
   void deleteTapeFiles(rdbms::Conn & conn, const common::dataStructures::DeleteArchiveRequest & request);
 
   /**
-   * Delete the TapeFiles associated to an ArchiveFile from the TAPE_FILE table
+   * Delete the TapeFiles associated to an ArchiveFile from the TAPE_FILE table and update the file statistics of
+   * their tapes
    * @param conn the database connection
    * @param file the file that contains the tape files to delete
    */
   void deleteTapeFiles(rdbms::Conn & conn, const common::dataStructures::ArchiveFile &file);
 
-   /**
-   * Set the DIRTY flag to true
-   * @param conn the database connection
-   * @param archiveFileId	the ArchiveFile that is going to be deleted and hence dirty the tape because
-   * the tape files will be removed from this tape
-   */
-  void setTapeDirty(rdbms::Conn & conn, const uint64_t & archiveFileId) const;
-
   /**
    * Delete the archiveFile and the associated tape files from the recycle-bin
    * @param archiveFileId the archiveFileId of the archive file to delete
@@ -2077,6 +2108,14 @@ protected:
    */
   virtual void deleteTapeFilesAndArchiveFileFromRecycleBin(rdbms::Conn & conn, const uint64_t archiveFileId, log::LogContext & lc) = 0;
 
+  /**
+   * Starts the transaction of a disk space reservation and locks the disk system, so that the concurrent
+   * reservations for the same disk system are serialized until the transaction is committed or rolled back.
+   * @param conn the database connection
+   * @param diskSystemName the name of the disk system
+   */
+  virtual void beginDiskSpaceReservation(rdbms::Conn & conn, const std::string & diskSystemName) = 0;
+
   /**
    * Delete the tape files from the TAPE_FILE recycle-bin
    * @param conn the database connection
@@ -2163,6 +2202,16 @@ protected:
 
   void modifyTapeDrive(const common::dataStructures::TapeDrive &tapeDrive) override;
 
+  void modifyTapeDriveStatuses(const std::list<common::dataStructures::TapeDrive> &tapeDrives) override;
+
+  std::map<std::string, uint64_t> getDiskSpaceReservations() const override;
+
+  bool reserveDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName, const uint64_t bytes,
+    const uint64_t maxReservedBytes) override;
+
+  bool releaseDiskSpace(const std::string &tapeDriveName, const std::string &diskSystemName,
+    const uint64_t bytes) override;
+
   void deleteTapeDrive(const std::string &tapeDriveName) override;
 
   void createDriveConfig(const std::string &tapeDriveName, const std::string &category,
@@ -2200,7 +2249,8 @@ protected:
   mutable TimeBasedCache<std::string, std::list<common::dataStructures::MountPolicy>> m_allMountPoliciesCache;
 
   /**
-   * Cached versions of virtual organization for specific tapepools
+   * Cached versions of virtual organization for specific tapepools (including
+   * the user error of an unknown tapepool)
    */
   mutable TimeBasedCache<std::string, common::dataStructures::VirtualOrganization> m_tapepoolVirtualOrganizationCache;
 
@@ -2225,6 +2275,11 @@ protected:
 private:
   void settingSqlTapeDriveValues(cta::rdbms::Stmt *stmt, const common::dataStructures::TapeDrive &tapeDrive) const;
 
+  /**
+   * Binds the values of the statuses reported by the tape servers, see modifyTapeDriveStatuses().
+   */
+  void settingSqlTapeDriveStatusValues(cta::rdbms::Stmt *stmt, const common::dataStructures::TapeDrive &tapeDrive) const;
+
 }; // class RdbmsCatalogue
 
 } // namespace catalogue
@@ -0,0 +1,74 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <map>
+#include <stdint.h>
+#include <string>
+
+namespace cta { namespace catalogue {
+
+  /**
+   * The changes of the file statistics of tapes (the NB_MASTER_FILES, MASTER_DATA_IN_BYTES, NB_COPY_NB_1,
+   * COPY_NB_1_IN_BYTES, NB_COPY_NB_GT_1 and COPY_NB_GT_1_IN_BYTES columns of the TAPE table) caused by the tape files
+   * added or removed in a transaction. They are applied to the TAPE table in the same transaction, so that the
+   * statistics do not need to be recomputed from the TAPE_FILE table.
+   */
+  class TapeStatisticsDeltas {
+  public:
+    /**
+     * The change of the statistics of one tape, the sizes are the ones of the archive files.
+     */
+    struct Delta {
+      int64_t nbCopyNb1 = 0;
+      int64_t copyNb1InBytes = 0;
+      int64_t nbCopyNbGt1 = 0;
+      int64_t copyNbGt1InBytes = 0;
+
+      bool empty() const {
+        return !nbCopyNb1 && !copyNb1InBytes && !nbCopyNbGt1 && !copyNbGt1InBytes;
+      }
+    };
+
+    void addTapeFile(const std::string &vid, const uint64_t copyNb, const uint64_t sizeInBytes) {
+      update(vid, copyNb, 1, sizeInBytes);
+    }
+
+    void removeTapeFile(const std::string &vid, const uint64_t copyNb, const uint64_t sizeInBytes) {
+      update(vid, copyNb, -1, -static_cast<int64_t>(sizeInBytes));
+    }
+
+    const std::map<std::string, Delta> & getDeltas() const {
+      return m_deltas;
+    }
+
+  private:
+    void update(const std::string &vid, const uint64_t copyNb, const int64_t nbFiles, const int64_t inBytes) {
+      auto & delta = m_deltas[vid];
+      if (1 == copyNb) {
+        delta.nbCopyNb1 += nbFiles;
+        delta.copyNb1InBytes += inBytes;
+      } else {
+        delta.nbCopyNbGt1 += nbFiles;
+        delta.copyNbGt1InBytes += inBytes;
+      }
+    }
+
+    std::map<std::string, Delta> m_deltas;
+  };
+
+}}
@@ -18,17 +18,32 @@
 #pragma once
 
 #include "catalogue/ValueAndTimeBasedCacheInfo.hpp"
+#include "common/exception/UserError.hpp"
 #include "common/make_unique.hpp"
+#include "common/threading/CondVar.hpp"
 #include "common/threading/Mutex.hpp"
 #include "common/threading/MutexLocker.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <exception>
 #include <map>
+#include <memory>
+#include <stdint.h>
 #include <time.h>
 
 namespace cta {
 namespace catalogue {
 
+/**
+ * A cache of values which expire after a given age.
+ *
+ * The cache is never locked while a value is being fetched. When a value has
+ * expired, the first caller to notice refreshes it while the other callers
+ * keep being served the stale value (stale-while-revalidate). Only missing
+ * and invalidated values make the callers wait, and then only the callers of
+ * the same key, for the single fetch in progress for that key.
+ */
 template <typename Key, typename Value> class TimeBasedCache {
 public:
 
@@ -36,8 +51,12 @@ public:
    * Constructor.
    *
    * @param m Maximum age of a cached value in seconds.
+   * @param cacheUserErrors Set to true to also cache the user errors thrown by
+   * the fetch of a value (negative caching). They are then rethrown to the
+   * callers until they expire or the cache is invalidated.
    */
-  TimeBasedCache(const time_t m): m_maxAgeSecs(m) {
+  TimeBasedCache(const time_t m, const bool cacheUserErrors = false):
+    m_maxAgeSecs(m), m_cacheUserErrors(cacheUserErrors) {
   }
 
   /**
@@ -49,42 +68,112 @@ public:
     const time_t now = time(nullptr);
 
     threading::MutexLocker cacheLock(m_mutex);
-    const auto cacheItor = m_cache.find(key);
-    const bool cacheHit = m_cache.end() != cacheItor;
+    auto &entryPtr = m_cache[key];
+    if(!entryPtr) entryPtr = cta::make_unique<CacheEntry>();
+    // Entries are never removed from the map, so this reference remains valid
+    // while the mutex is released.
+    CacheEntry &entry = *entryPtr;
+    const bool firstTime = !entry.hasValue();
 
-    if(cacheHit) {
-      auto &cachedValue = *(cacheItor->second);
-      const time_t ageSecs = now - cachedValue.timestamp;
+    while(true) {
+      if(entry.hasValue() && !entry.invalidated) {
+        const time_t ageSecs = now - entry.timestamp;
+        if(m_maxAgeSecs >= ageSecs) { // Cached value is fresh
+          m_freshHits++;
+          return entry.get("Fresh value found in cache");
+        }
+        if(entry.refreshing) { // Cached value is stale and someone else is refreshing it
+          m_staleHits++;
+          return entry.get("Stale value found in cache while being refreshed");
+        }
+        break; // Cached value is stale: refresh it
+      }
+      if(!entry.refreshing) break; // No usable value: fetch it
+      // Wait for the fetch in progress
+      m_refreshDone.wait(cacheLock);
+    }
 
-      if (m_maxAgeSecs >= ageSecs) { // Cached value is fresh
-        return ValueAndTimeBasedCacheInfo<Value>(cachedValue.value, "Fresh value found in cache");
-      } else { // Cached value is stale
-        cachedValue.value = getNonCachedValue();
-        cachedValue.timestamp = ::time(nullptr);
+    // We are the refresher of this entry
+    m_misses++;
+    entry.refreshing = true;
+    const uint64_t generation = entry.generation;
+    cacheLock.unlock();
 
-        return ValueAndTimeBasedCacheInfo<Value>(cachedValue.value, "Stale value found and replaced in cache");
+    std::shared_ptr<const Value> newValue;
+    std::exception_ptr newUserError;
+    const auto refreshStart = std::chrono::steady_clock::now();
+    try {
+      newValue = std::make_shared<const Value>(getNonCachedValue());
+    } catch(exception::UserError &) {
+      if(!m_cacheUserErrors) {
+        refreshFailed(entry);
+        throw;
       }
-    } else { // No cache hit
-      const auto emplaceResult = m_cache.emplace(std::make_pair(key,
-        cta::make_unique<TimestampedValue>(now, getNonCachedValue())));
-      return ValueAndTimeBasedCacheInfo<Value>(emplaceResult.first->second->value, "First time value entered into cache");
+      newUserError = std::current_exception();
+    } catch(...) {
+      refreshFailed(entry);
+      throw;
     }
+    recordRefreshLatency(std::chrono::steady_clock::now() - refreshStart);
+
+    cacheLock.lock();
+    entry.value = newValue;
+    entry.userError = newUserError;
+    entry.timestamp = ::time(nullptr);
+    // An invalidation during the fetch means that the fetched value may already be obsolete
+    entry.invalidated = (generation != entry.generation);
+    entry.refreshing = false;
+    m_refreshDone.broadcast();
+    return entry.get(firstTime ? "First time value entered into cache" : "Stale value found and replaced in cache");
   }
 
   /**
    * Invalidates the cache.  This method should be called when it is known that
    * the values being cached have probably been changed.  For example an
    * operator has just modfied the mount policies and this is what is being
-   * cached.
+   * cached.  Invalidated values are never served stale: the next caller
+   * fetches them again.
    */
   void invalidate() {
     threading::MutexLocker cacheLock(m_mutex);
     for(auto &cacheMaplet: m_cache) {
-      auto &cachedValue = *(cacheMaplet.second);
-      cachedValue.timestamp = 0;
+      auto &entry = *(cacheMaplet.second);
+      entry.invalidated = true;
+      entry.generation++;
     }
   }
 
+  /**
+   * Counters of the cache activity.
+   */
+  struct Statistics {
+    /** Number of lookups served with a fresh value */
+    uint64_t freshHits;
+    /** Number of lookups served with a stale value while it was being refreshed */
+    uint64_t staleHits;
+    /** Number of fetches of a value (missing, expired or invalidated) */
+    uint64_t misses;
+    /** Number of fetches which failed (not counting cached user errors) */
+    uint64_t failedRefreshes;
+    /** Cumulated and maximum duration of the successful fetches */
+    double totalRefreshSecs;
+    double maxRefreshSecs;
+  };
+
+  /**
+   * Returns the counters of the cache activity since its creation.
+   */
+  Statistics getStatistics() const {
+    Statistics ret;
+    ret.freshHits = m_freshHits;
+    ret.staleHits = m_staleHits;
+    ret.misses = m_misses;
+    ret.failedRefreshes = m_failedRefreshes;
+    ret.totalRefreshSecs = m_totalRefreshUsecs / 1000000.0;
+    ret.maxRefreshSecs = m_maxRefreshUsecs / 1000000.0;
+    return ret;
+  }
+
 private:
 
   /**
@@ -93,45 +182,106 @@ private:
   time_t m_maxAgeSecs;
 
   /**
-   * Mutex to protect the cache.
+   * True if user errors thrown when fetching a value should be cached.
+   */
+  const bool m_cacheUserErrors;
+
+  /**
+   * Mutex to protect the cache.  It is never held while fetching a value.
    */
   threading::Mutex m_mutex;
 
   /**
-   * A timestamped value.
+   * Signaled (with m_mutex) each time a fetch completes.
    */
-  struct TimestampedValue {
+  threading::CondVar m_refreshDone;
+
+  /**
+   * A cache entry: the last fetched value (or user error) and its state.
+   */
+  struct CacheEntry {
 
     /**
-     * Constructor.
+     * True if there is a value or a cached user error.
      */
-    TimestampedValue(): timestamp(0) {
+    bool hasValue() const {
+      return value || userError;
     }
 
     /**
-     * Constructor.
-     *
-     * @param t The timestamp.
-     * @param v The value.
+     * Returns the value with the specified cache info, or throws the cached
+     * user error.
      */
-    TimestampedValue(const time_t t, const Value &v): timestamp(t), value(v) {
+    ValueAndTimeBasedCacheInfo<Value> get(const std::string &cacheInfo) const {
+      if(userError) std::rethrow_exception(userError);
+      return ValueAndTimeBasedCacheInfo<Value>(*value, cacheInfo);
     }
 
     /**
-     * The timestamp.
+     * The value.
      */
-    time_t timestamp;
+    std::shared_ptr<const Value> value;
 
     /**
-     * The value.
+     * The user error thrown by the last fetch, when user errors are cached.
+     */
+    std::exception_ptr userError;
+
+    /**
+     * The time of the last fetch.
+     */
+    time_t timestamp = 0;
+
+    /**
+     * True if the cache was invalidated since the last fetch.
      */
-    Value value;
-  }; // struct TimestampedValue
+    bool invalidated = false;
+
+    /**
+     * True while a thread is fetching the value.
+     */
+    bool refreshing = false;
+
+    /**
+     * Incremented at each invalidation.
+     */
+    uint64_t generation = 0;
+  }; // struct CacheEntry
+
+  /**
+   * Releases the entry after a failed fetch, keeping its previous value.
+   */
+  void refreshFailed(CacheEntry &entry) {
+    m_failedRefreshes++;
+    threading::MutexLocker cacheLock(m_mutex);
+    entry.refreshing = false;
+    m_refreshDone.broadcast();
+  }
+
+  /**
+   * Accounts the duration of a successful fetch.
+   */
+  void recordRefreshLatency(const std::chrono::steady_clock::duration &d) {
+    const uint64_t usecs = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    m_totalRefreshUsecs += usecs;
+    uint64_t previousMax = m_maxRefreshUsecs;
+    while(usecs > previousMax && !m_maxRefreshUsecs.compare_exchange_weak(previousMax, usecs)) {}
+  }
 
   /**
    * The cache.
    */
-  std::map<Key, std::unique_ptr<TimestampedValue> > m_cache;
+  std::map<Key, std::unique_ptr<CacheEntry> > m_cache;
+
+  /**
+   * Activity counters.
+   */
+  std::atomic<uint64_t> m_freshHits{0};
+  std::atomic<uint64_t> m_staleHits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_failedRefreshes{0};
+  std::atomic<uint64_t> m_totalRefreshUsecs{0};
+  std::atomic<uint64_t> m_maxRefreshUsecs{0};
 }; // class TimeBasedCache
 
 } // namespace catalogue
@@ -0,0 +1,105 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catalogue/TimeBasedCache.hpp"
+
+#include <gtest/gtest.h>
+#include <future>
+#include <thread>
+
+namespace unitTests {
+
+TEST(cta_catalogue_TimeBasedCache, freshValueAndInvalidate) {
+  using namespace cta::catalogue;
+
+  TimeBasedCache<std::string, int> cache(3600);
+  int nbFetches = 0;
+  auto fetch = [&] { return ++nbFetches; };
+
+  ASSERT_EQ(1, cache.getCachedValue("key", fetch).value);
+  ASSERT_EQ(1, cache.getCachedValue("key", fetch).value);
+  ASSERT_EQ(1, nbFetches);
+
+  cache.invalidate();
+  ASSERT_EQ(2, cache.getCachedValue("key", fetch).value);
+  ASSERT_EQ(2, nbFetches);
+
+  const auto stats = cache.getStatistics();
+  ASSERT_EQ(1U, stats.freshHits);
+  ASSERT_EQ(2U, stats.misses);
+  ASSERT_EQ(0U, stats.staleHits);
+}
+
+TEST(cta_catalogue_TimeBasedCache, staleValueServedWhileRefreshing) {
+  using namespace cta::catalogue;
+
+  // A maximum age of -1 makes every cached value stale
+  TimeBasedCache<std::string, int> cache(-1);
+  ASSERT_EQ(1, cache.getCachedValue("key", [] { return 1; }).value);
+
+  // Block a refresh and check that other callers get the stale value meanwhile
+  std::promise<void> refreshStarted;
+  std::promise<void> releaseRefresh;
+  auto releaseRefreshFuture = releaseRefresh.get_future();
+  auto refresher = std::async(std::launch::async, [&] {
+    return cache.getCachedValue("key", [&] {
+      refreshStarted.set_value();
+      releaseRefreshFuture.wait();
+      return 2;
+    }).value;
+  });
+  refreshStarted.get_future().wait();
+  const auto staleValue = cache.getCachedValue("key", [] { return 3; });
+  ASSERT_EQ(1, staleValue.value);
+  ASSERT_EQ("Stale value found in cache while being refreshed", staleValue.cacheInfo);
+  releaseRefresh.set_value();
+  ASSERT_EQ(2, refresher.get());
+  ASSERT_EQ(1U, cache.getStatistics().staleHits);
+}
+
+TEST(cta_catalogue_TimeBasedCache, failedRefreshKeepsPreviousValue) {
+  using namespace cta::catalogue;
+
+  TimeBasedCache<std::string, int> cache(-1);
+  ASSERT_EQ(1, cache.getCachedValue("key", [] { return 1; }).value);
+  ASSERT_THROW(cache.getCachedValue("key", []() -> int { throw cta::exception::Exception("DB down"); }),
+    cta::exception::Exception);
+  ASSERT_EQ(1U, cache.getStatistics().failedRefreshes);
+  ASSERT_EQ(2, cache.getCachedValue("key", [] { return 2; }).value);
+}
+
+TEST(cta_catalogue_TimeBasedCache, negativeCaching) {
+  using namespace cta::catalogue;
+
+  int nbFetches = 0;
+  auto fetch = [&]() -> int { nbFetches++; throw cta::exception::UserError("No such key"); };
+
+  TimeBasedCache<std::string, int> negativeCache(3600, true);
+  ASSERT_THROW(negativeCache.getCachedValue("key", fetch), cta::exception::UserError);
+  ASSERT_THROW(negativeCache.getCachedValue("key", fetch), cta::exception::UserError);
+  ASSERT_EQ(1, nbFetches);
+  negativeCache.invalidate();
+  ASSERT_EQ(4, negativeCache.getCachedValue("key", [] { return 4; }).value);
+
+  nbFetches = 0;
+  TimeBasedCache<std::string, int> cache(3600);
+  ASSERT_THROW(cache.getCachedValue("key", fetch), cta::exception::UserError);
+  ASSERT_THROW(cache.getCachedValue("key", fetch), cta::exception::UserError);
+  ASSERT_EQ(2, nbFetches);
+}
+
+} // namespace unitTests
@@ -0,0 +1,215 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/checksum/Adler32.hpp"
+
+#include <zlib.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace cta {
+namespace checksum {
+
+namespace {
+
+/** Largest prime smaller than 65536 */
+const uint32_t ADLER32_BASE = 65521;
+
+/**
+ * Largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1, i.e. the number
+ * of bytes which can be summed before the 32 bit accumulators must be reduced.
+ */
+const size_t ADLER32_NMAX = 5552;
+
+/** Number of bytes consumed by one iteration of the vectorised loops */
+const size_t ADLER32_SIMD_BLOCK = 32;
+
+/**
+ * Scalar processing of the bytes which do not fill a complete SIMD block.
+ */
+inline uint32_t adler32Tail(uint32_t s1, uint32_t s2, const uint8_t *buf, size_t len) {
+  while (len) {
+    size_t n = len < ADLER32_NMAX ? len : ADLER32_NMAX;
+    len -= n;
+    while (n--) {
+      s1 += *buf++;
+      s2 += s1;
+    }
+    s1 %= ADLER32_BASE;
+    s2 %= ADLER32_BASE;
+  }
+  return s1 | (s2 << 16);
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// adler32_sw
+//-----------------------------------------------------------------------------
+uint32_t adler32_sw(const uint32_t adlerInit, const void *const start, const size_t cnt) {
+  return adler32Tail(adlerInit & 0xFFFF, adlerInit >> 16, (const uint8_t *)start, cnt);
+}
+
+#if defined(__x86_64__)
+
+//-----------------------------------------------------------------------------
+// adler32_ssse3
+//-----------------------------------------------------------------------------
+__attribute__((target("ssse3")))
+uint32_t adler32_ssse3(const uint32_t adlerInit, const void *const start, const size_t cnt) {
+  uint32_t s1 = adlerInit & 0xFFFF;
+  uint32_t s2 = adlerInit >> 16;
+  const uint8_t *buf = (const uint8_t *)start;
+  size_t blocks = cnt / ADLER32_SIMD_BLOCK;
+  const size_t tail = cnt - blocks * ADLER32_SIMD_BLOCK;
+
+  // Weights of each byte in the contribution to s2 within one block
+  const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+  const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi16(1);
+
+  while (blocks) {
+    size_t n = ADLER32_NMAX / ADLER32_SIMD_BLOCK;
+    if (n > blocks) n = blocks;
+    blocks -= n;
+
+    // v_ps accumulates the successive values of s1, each of which contributes
+    // ADLER32_SIMD_BLOCK times to s2.
+    __m128i v_ps = _mm_set_epi32(0, 0, 0, s1 * n);
+    __m128i v_s2 = _mm_set_epi32(0, 0, 0, s2);
+    __m128i v_s1 = _mm_setzero_si128();
+    do {
+      const __m128i bytes1 = _mm_loadu_si128((const __m128i *)buf);
+      const __m128i bytes2 = _mm_loadu_si128((const __m128i *)(buf + 16));
+      v_ps = _mm_add_epi32(v_ps, v_s1);
+      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+      v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+      v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+      buf += ADLER32_SIMD_BLOCK;
+    } while (--n);
+    v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+    // Horizontal sums of the 4 lanes
+    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+    s1 += (uint32_t)_mm_cvtsi128_si32(v_s1);
+    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+    s2 = (uint32_t)_mm_cvtsi128_si32(v_s2);
+
+    s1 %= ADLER32_BASE;
+    s2 %= ADLER32_BASE;
+  }
+  return adler32Tail(s1, s2, buf, tail);
+}
+
+//-----------------------------------------------------------------------------
+// adler32_avx2
+//-----------------------------------------------------------------------------
+__attribute__((target("avx2")))
+uint32_t adler32_avx2(const uint32_t adlerInit, const void *const start, const size_t cnt) {
+  uint32_t s1 = adlerInit & 0xFFFF;
+  uint32_t s2 = adlerInit >> 16;
+  const uint8_t *buf = (const uint8_t *)start;
+  size_t blocks = cnt / ADLER32_SIMD_BLOCK;
+  const size_t tail = cnt - blocks * ADLER32_SIMD_BLOCK;
+
+  const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                       16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi16(1);
+
+  while (blocks) {
+    size_t n = ADLER32_NMAX / ADLER32_SIMD_BLOCK;
+    if (n > blocks) n = blocks;
+    blocks -= n;
+
+    __m256i v_ps = _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, s1 * n);
+    __m256i v_s2 = _mm256_set_epi32(0, 0, 0, 0, 0, 0, 0, s2);
+    __m256i v_s1 = _mm256_setzero_si256();
+    do {
+      const __m256i bytes = _mm256_loadu_si256((const __m256i *)buf);
+      v_ps = _mm256_add_epi32(v_ps, v_s1);
+      v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(bytes, zero));
+      v_s2 = _mm256_add_epi32(v_s2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, tap), ones));
+      buf += ADLER32_SIMD_BLOCK;
+    } while (--n);
+    v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+
+    // Fold the two 128 bit halves, then sum the 4 remaining lanes
+    __m128i h_s1 = _mm_add_epi32(_mm256_castsi256_si128(v_s1), _mm256_extracti128_si256(v_s1, 1));
+    h_s1 = _mm_add_epi32(h_s1, _mm_shuffle_epi32(h_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+    h_s1 = _mm_add_epi32(h_s1, _mm_shuffle_epi32(h_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+    s1 += (uint32_t)_mm_cvtsi128_si32(h_s1);
+    __m128i h_s2 = _mm_add_epi32(_mm256_castsi256_si128(v_s2), _mm256_extracti128_si256(v_s2, 1));
+    h_s2 = _mm_add_epi32(h_s2, _mm_shuffle_epi32(h_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+    h_s2 = _mm_add_epi32(h_s2, _mm_shuffle_epi32(h_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+    s2 = (uint32_t)_mm_cvtsi128_si32(h_s2);
+
+    s1 %= ADLER32_BASE;
+    s2 %= ADLER32_BASE;
+  }
+  return adler32Tail(s1, s2, buf, tail);
+}
+
+#else
+
+//-----------------------------------------------------------------------------
+// adler32_ssse3 (not available on this architecture)
+//-----------------------------------------------------------------------------
+uint32_t adler32_ssse3(const uint32_t adlerInit, const void *const start, const size_t cnt) {
+  return adler32_sw(adlerInit, start, cnt);
+}
+
+//-----------------------------------------------------------------------------
+// adler32_avx2 (not available on this architecture)
+//-----------------------------------------------------------------------------
+uint32_t adler32_avx2(const uint32_t adlerInit, const void *const start, const size_t cnt) {
+  return adler32_sw(adlerInit, start, cnt);
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+// adler32Update
+//-----------------------------------------------------------------------------
+uint32_t adler32Update(const uint32_t adlerInit, const void *const start, const size_t cnt) {
+  typedef uint32_t (*Adler32Impl)(const uint32_t, const void *const, const size_t);
+  static const Adler32Impl impl = []() -> Adler32Impl {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return adler32_avx2;
+    if (__builtin_cpu_supports("ssse3")) return adler32_ssse3;
+#endif
+    return adler32_sw;
+  }();
+  return impl(adlerInit, start, cnt);
+}
+
+//-----------------------------------------------------------------------------
+// adler32Combine
+//-----------------------------------------------------------------------------
+uint32_t adler32Combine(const uint32_t adler1, const uint32_t adler2, const size_t len2) {
+  return ::adler32_combine(adler1, adler2, len2);
+}
+
+} // namespace checksum
+} // namespace cta
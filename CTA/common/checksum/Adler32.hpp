@@ -0,0 +1,93 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace cta {
+namespace checksum {
+
+/**
+ * Set of Adler-32 functions. All of them produce the same values as zlib's
+ * adler32() and can be freely mixed with it.
+ */
+
+/**
+ * Initial value for computing an Adler-32 checksum.
+ */
+const uint32_t ADLER32_INIT = 1;
+
+/**
+ * Compute by software (scalar loop) the Adler-32 of the given block.
+ *
+ * @param adlerInit The previous Adler-32 (ADLER32_INIT for fresh).
+ * @param start     The starting address of the data bytes.
+ * @param cnt       The number of data bytes.
+ * @return The updated Adler-32.
+ */
+uint32_t adler32_sw(const uint32_t adlerInit, const void *const start, const size_t cnt);
+
+/**
+ * Compute the Adler-32 of the given block using SSSE3 instructions. Must only
+ * be called if the processor supports SSSE3 (see adler32Update()).
+ *
+ * @param adlerInit The previous Adler-32 (ADLER32_INIT for fresh).
+ * @param start     The starting address of the data bytes.
+ * @param cnt       The number of data bytes.
+ * @return The updated Adler-32.
+ */
+uint32_t adler32_ssse3(const uint32_t adlerInit, const void *const start, const size_t cnt);
+
+/**
+ * Compute the Adler-32 of the given block using AVX2 instructions. Must only
+ * be called if the processor supports AVX2 (see adler32Update()).
+ *
+ * @param adlerInit The previous Adler-32 (ADLER32_INIT for fresh).
+ * @param start     The starting address of the data bytes.
+ * @param cnt       The number of data bytes.
+ * @return The updated Adler-32.
+ */
+uint32_t adler32_avx2(const uint32_t adlerInit, const void *const start, const size_t cnt);
+
+/**
+ * Compute the Adler-32 of the given block. The fastest implementation
+ * supported by the processor is selected once, at the first call.
+ *
+ * @param adlerInit The previous Adler-32 (ADLER32_INIT for fresh).
+ * @param start     The starting address of the data bytes.
+ * @param cnt       The number of data bytes.
+ * @return The updated Adler-32.
+ */
+uint32_t adler32Update(const uint32_t adlerInit, const void *const start, const size_t cnt);
+
+/**
+ * Combine two Adler-32 checksums computed independently. If adler1 is the
+ * checksum of block A and adler2 the checksum of block B (computed starting
+ * from ADLER32_INIT), the result is the checksum of A followed by B. This
+ * allows computing the checksum of the blocks of a file in different threads.
+ *
+ * @param adler1 The Adler-32 of the first block.
+ * @param adler2 The Adler-32 of the second block.
+ * @param len2   The length in bytes of the second block.
+ * @return The Adler-32 of the concatenation.
+ */
+uint32_t adler32Combine(const uint32_t adler1, const uint32_t adler2, const size_t len2);
+
+} // namespace checksum
+} // namespace cta
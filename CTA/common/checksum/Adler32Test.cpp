@@ -0,0 +1,79 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/checksum/Adler32.hpp"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <vector>
+
+namespace unitTests {
+
+namespace {
+  std::vector<uint8_t> makeBuffer(size_t size) {
+    std::vector<uint8_t> buffer(size);
+    uint32_t seed = 0x12345678;
+    for (auto & b: buffer) {
+      seed = seed * 1103515245 + 12345;
+      b = seed >> 24;
+    }
+    return buffer;
+  }
+}
+
+TEST(cta_checksum_Adler32, allImplementationsMatchZlib) {
+  using namespace cta::checksum;
+  // Cover empty buffers, sizes smaller than a SIMD block, unaligned starts and
+  // buffers larger than the reduction interval (NMAX).
+  const auto buffer = makeBuffer(3 * 5552 + 1000);
+  for (size_t offset: {0, 1, 7}) {
+    for (size_t size: {0, 1, 31, 32, 33, 100, 5552, 5553, 11104, 3 * 5552 + 1}) {
+      const uint8_t * data = buffer.data() + offset;
+      const uint32_t expected = ::adler32(::adler32(0L, Z_NULL, 0), data, size);
+      ASSERT_EQ(expected, adler32_sw(ADLER32_INIT, data, size));
+      ASSERT_EQ(expected, adler32Update(ADLER32_INIT, data, size));
+      if (__builtin_cpu_supports("ssse3")) {
+        ASSERT_EQ(expected, adler32_ssse3(ADLER32_INIT, data, size));
+      }
+      if (__builtin_cpu_supports("avx2")) {
+        ASSERT_EQ(expected, adler32_avx2(ADLER32_INIT, data, size));
+      }
+    }
+  }
+}
+
+TEST(cta_checksum_Adler32, allFFBytes) {
+  using namespace cta::checksum;
+  // Worst case for the accumulators
+  const std::vector<uint8_t> buffer(1024 * 1024, 0xFF);
+  const uint32_t expected = ::adler32(::adler32(0L, Z_NULL, 0), buffer.data(), buffer.size());
+  ASSERT_EQ(expected, adler32Update(ADLER32_INIT, buffer.data(), buffer.size()));
+  ASSERT_EQ(expected, adler32_sw(ADLER32_INIT, buffer.data(), buffer.size()));
+}
+
+TEST(cta_checksum_Adler32, combine) {
+  using namespace cta::checksum;
+  const auto buffer = makeBuffer(100000);
+  const uint32_t whole = adler32Update(ADLER32_INIT, buffer.data(), buffer.size());
+  const uint32_t first = adler32Update(ADLER32_INIT, buffer.data(), 40000);
+  const uint32_t second = adler32Update(ADLER32_INIT, buffer.data() + 40000, 60000);
+  ASSERT_EQ(whole, adler32Combine(first, second, 60000));
+  ASSERT_EQ(whole, adler32Update(first, buffer.data() + 40000, 60000));
+}
+
+} // namespace unitTests
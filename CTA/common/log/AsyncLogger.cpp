@@ -0,0 +1,447 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/log/AsyncLogger.hpp"
+#include "common/threading/MutexLocker.hpp"
+#include "common/threading/RingQueue.hpp"
+
+#include <new>
+#include <pthread.h>
+#include <set>
+#include <sys/time.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cta {
+namespace log {
+
+namespace {
+  /**
+   * Source of the identifiers of the asynchronous loggers.
+   */
+  std::atomic<uint64_t> g_nextAsyncLoggerId(0);
+
+  /**
+   * The asynchronous loggers of the process, quiesced during a fork().
+   */
+  struct ForkRegistry {
+    threading::Mutex mutex;
+    std::set<AsyncLogger *> loggers;
+  };
+
+  ForkRegistry & forkRegistry() {
+    static ForkRegistry registry;
+    return registry;
+  }
+
+  pthread_once_t g_forkHandlersOnce = PTHREAD_ONCE_INIT;
+
+  /**
+   * Maximum wait of a thread for room in its queue before checking it again,
+   * in milliseconds. The background thread normally wakes it up earlier.
+   */
+  const uint64_t c_roomAvailableWaitMs = 100;
+
+  /**
+   * Reinitialises, in the child process, a mutex locked before the fork(): the
+   * mutexes check their owner, and the forking thread has a new identity in the
+   * child.
+   */
+  void reinitialiseInChild(threading::Mutex & mutex) {
+    new (&mutex) threading::Mutex;
+  }
+}
+
+//------------------------------------------------------------------------------
+// AsyncLogger::ThreadQueue
+//------------------------------------------------------------------------------
+struct AsyncLogger::ThreadQueue {
+  explicit ThreadQueue(const size_t capacity): ring(capacity), producerGone(false) {}
+
+  /**
+   * The messages of the thread, pushed by the thread and popped by the
+   * background thread.
+   */
+  threading::SpscRing<CapturedMsg> ring;
+
+  /**
+   * Set when the thread exits: the queue is discarded once drained.
+   */
+  std::atomic<bool> producerGone;
+};
+
+//------------------------------------------------------------------------------
+// AsyncLogger::ThreadQueueRegistry
+//------------------------------------------------------------------------------
+struct AsyncLogger::ThreadQueueRegistry {
+  struct Entry {
+    uint64_t loggerId;
+    int pid;
+    std::shared_ptr<ThreadQueue> queue;
+  };
+
+  std::vector<Entry> entries;
+
+  ~ThreadQueueRegistry() {
+    for (auto & entry: entries) {
+      entry.queue->producerGone = true;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// constructor
+//------------------------------------------------------------------------------
+AsyncLogger::AsyncLogger(std::unique_ptr<Logger> logger, const size_t threadQueueCapacity,
+  const OverflowPolicy overflowPolicy):
+  Logger(logger->m_hostName, logger->m_programName, logger->m_logMask),
+  m_logger(std::move(logger)), m_threadQueueCapacity(threadQueueCapacity), m_overflowPolicy(overflowPolicy),
+  m_id(g_nextAsyncLoggerId++), m_queuesVersion(0), m_threadPid(0), m_msgQueued(new threading::CondVar),
+  m_msgsWritten(new threading::CondVar), m_roomAvailable(new threading::CondVar), m_backgroundThreadSleeping(false),
+  m_flushingThreads(0), m_blockedThreads(0), m_stopRequested(false), m_queuedMsgs(0), m_writtenMsgs(0),
+  m_droppedMsgs(0), m_queuesSnapshotVersion(0) {
+  m_logFormat = m_logger->m_logFormat.load();
+  pthread_once(&g_forkHandlersOnce, &AsyncLogger::registerForkHandlers);
+  {
+    threading::MutexLocker ml(forkRegistry().mutex);
+    forkRegistry().loggers.insert(this);
+  }
+  startBackgroundThreadIfNeeded(getpid());
+}
+
+//------------------------------------------------------------------------------
+// destructor
+//------------------------------------------------------------------------------
+AsyncLogger::~AsyncLogger() {
+  {
+    threading::MutexLocker ml(forkRegistry().mutex);
+    forkRegistry().loggers.erase(this);
+  }
+  if (m_threadPid == getpid()) {
+    {
+      threading::MutexLocker ml(m_mutex);
+      m_stopRequested = true;
+      m_msgQueued->signal();
+    }
+    m_thread->join();
+  } else {
+    // We are in the child of a fork() that did not log: the thread object
+    // belongs to the parent process.
+    m_thread.release();
+  }
+}
+
+//------------------------------------------------------------------------------
+// prepareForFork
+//------------------------------------------------------------------------------
+void AsyncLogger::prepareForFork() {
+  flush();
+  m_logger->prepareForFork();
+}
+
+//-----------------------------------------------------------------------------
+// operator()
+//-----------------------------------------------------------------------------
+void AsyncLogger::operator() (
+  const int priority,
+  const std::string &msg,
+  const std::list<Param> &params) {
+
+  // Ignore messages whose priority is not of interest
+  if(priority > m_logMask) {
+    return;
+  }
+
+  try {
+    CapturedMsg capturedMsg;
+    gettimeofday(&capturedMsg.timeStamp, NULL);
+    capturedMsg.pid = getpid();
+    capturedMsg.tid = syscall(__NR_gettid);
+    capturedMsg.priority = priority;
+    capturedMsg.msg = msg;
+    capturedMsg.params = params;
+
+    startBackgroundThreadIfNeeded(capturedMsg.pid);
+    ThreadQueue & queue = getThreadQueue(capturedMsg.pid);
+    if (!queue.ring.tryPush(std::move(capturedMsg))) {
+      if (OverflowPolicy::DROP == m_overflowPolicy) {
+        m_droppedMsgs++;
+        return;
+      }
+      // Wait for the background thread to make room in the queue. It cannot be
+      // sleeping as the queue is full.
+      m_blockedThreads++;
+      {
+        threading::MutexLocker ml(m_mutex);
+        while (!queue.ring.tryPush(std::move(capturedMsg))) {
+          m_roomAvailable->timedWait(ml, c_roomAvailableWaitMs);
+        }
+      }
+      m_blockedThreads--;
+    }
+    m_queuedMsgs++;
+    wakeUpBackgroundThread();
+  } catch (...) {
+    // Failures are silently ignored in order to not impact the processing.
+  }
+}
+
+//------------------------------------------------------------------------------
+// flush
+//------------------------------------------------------------------------------
+void AsyncLogger::flush() {
+  const uint64_t queuedMsgs = m_queuedMsgs;
+  if (m_writtenMsgs >= queuedMsgs || m_threadPid != getpid()) {
+    return;
+  }
+  // The background thread notifies the flushing threads after writing messages
+  // if it sees them registered, or we see its progress before sleeping.
+  m_flushingThreads++;
+  {
+    threading::MutexLocker ml(m_mutex);
+    while (m_writtenMsgs < queuedMsgs) {
+      m_msgsWritten->wait(ml);
+    }
+  }
+  m_flushingThreads--;
+}
+
+//------------------------------------------------------------------------------
+// getDroppedMessagesCount
+//------------------------------------------------------------------------------
+uint64_t AsyncLogger::getDroppedMessagesCount() const {
+  return m_droppedMsgs;
+}
+
+//-----------------------------------------------------------------------------
+// writeMsgToUnderlyingLoggingSystem
+//-----------------------------------------------------------------------------
+void AsyncLogger::writeMsgToUnderlyingLoggingSystem(const std::string &header, const std::string &body) {
+  m_logger->writeMsgToUnderlyingLoggingSystem(header, body);
+}
+
+//------------------------------------------------------------------------------
+// getThreadQueue
+//------------------------------------------------------------------------------
+AsyncLogger::ThreadQueue & AsyncLogger::getThreadQueue(const int pid) {
+  static thread_local ThreadQueueRegistry registry;
+  for (auto & entry: registry.entries) {
+    if (entry.loggerId == m_id && entry.pid == pid) {
+      return *entry.queue;
+    }
+  }
+  auto queue = std::make_shared<ThreadQueue>(m_threadQueueCapacity);
+  {
+    threading::MutexLocker ml(m_mutex);
+    m_queues.push_back(queue);
+    m_queuesVersion++;
+  }
+  registry.entries.push_back({m_id, pid, queue});
+  return *queue;
+}
+
+//------------------------------------------------------------------------------
+// startBackgroundThreadIfNeeded
+//------------------------------------------------------------------------------
+void AsyncLogger::startBackgroundThreadIfNeeded(const int pid) {
+  if (m_threadPid == pid) {
+    return;
+  }
+  threading::MutexLocker ml(m_mutex);
+  if (m_threadPid == pid) {
+    return;
+  }
+  if (m_thread) {
+    // We are in the child of a fork(): the thread object belongs to the parent
+    // process, which also writes the messages queued before the fork.
+    m_thread.release();
+    m_queues.clear();
+    m_queuesVersion++;
+    m_queuedMsgs = 0;
+    m_writtenMsgs = 0;
+    m_droppedMsgs = 0;
+  }
+  m_stopRequested = false;
+  m_backgroundThreadSleeping = false;
+  m_thread.reset(new std::thread(&AsyncLogger::run, this));
+  m_threadPid = pid;
+}
+
+//------------------------------------------------------------------------------
+// run
+//------------------------------------------------------------------------------
+void AsyncLogger::run() {
+  uint64_t reportedDroppedMsgs = 0;
+  while (true) {
+    // All the messages are queued before the stop request, so a pass started
+    // after it that finds nothing to write is the last one.
+    const bool stopRequested = m_stopRequested;
+    uint64_t writtenMsgs;
+    {
+      // A fork() waits for the writes in progress.
+      threading::MutexLocker wml(m_writeMutex);
+      writtenMsgs = writeQueuedMsgs();
+
+      const uint64_t droppedMsgs = m_droppedMsgs;
+      if (droppedMsgs != reportedDroppedMsgs) {
+        std::list<Param> params = {Param("droppedMessages", droppedMsgs - reportedDroppedMsgs)};
+        struct timeval timeStamp;
+        gettimeofday(&timeStamp, NULL);
+        try {
+          writeCapturedMsg(WARNING, "In AsyncLogger::run(): dropped log messages as the queue of the logging thread was full",
+            params, timeStamp, getpid(), syscall(__NR_gettid));
+        } catch (...) {}
+        reportedDroppedMsgs = droppedMsgs;
+      }
+    }
+
+    if (m_flushingThreads) {
+      threading::MutexLocker ml(m_mutex);
+      m_msgsWritten->broadcast();
+    }
+    if (writtenMsgs) {
+      continue;
+    }
+    if (stopRequested) {
+      break;
+    }
+
+    // Sleep until a message is queued. The producers wake us up if they see us
+    // sleeping, or we see their message counted.
+    threading::MutexLocker ml(m_mutex);
+    m_backgroundThreadSleeping = true;
+    while (!m_stopRequested && m_queuedMsgs <= m_writtenMsgs) {
+      m_msgQueued->wait(ml);
+    }
+    m_backgroundThreadSleeping = false;
+  }
+}
+
+//------------------------------------------------------------------------------
+// writeQueuedMsgs
+//------------------------------------------------------------------------------
+uint64_t AsyncLogger::writeQueuedMsgs() {
+  if (m_queuesVersion != m_queuesSnapshotVersion) {
+    threading::MutexLocker ml(m_mutex);
+    m_queuesSnapshot = m_queues;
+    m_queuesSnapshotVersion = m_queuesVersion;
+  }
+  uint64_t writtenMsgs = 0;
+  CapturedMsg capturedMsg;
+  for (auto queue = m_queuesSnapshot.begin(); queue != m_queuesSnapshot.end(); ) {
+    // Read before draining: the last messages of an exited thread are not lost.
+    const bool producerGone = (*queue)->producerGone;
+    // Take at most a queue worth of messages, so that a busy thread does not
+    // starve the others.
+    size_t i = 0;
+    for (; i < m_threadQueueCapacity && (*queue)->ring.tryPop(capturedMsg); i++) {
+      try {
+        writeCapturedMsg(capturedMsg.priority, capturedMsg.msg, capturedMsg.params, capturedMsg.timeStamp,
+          capturedMsg.pid, capturedMsg.tid);
+      } catch (...) {
+        // Failures are silently ignored in order to not impact the processing.
+      }
+      writtenMsgs++;
+      m_writtenMsgs++;
+    }
+    if (i && m_blockedThreads) {
+      threading::MutexLocker ml(m_mutex);
+      m_roomAvailable->broadcast();
+    }
+    if (producerGone && !(*queue)->ring.size()) {
+      threading::MutexLocker ml(m_mutex);
+      for (auto q = m_queues.begin(); q != m_queues.end(); q++) {
+        if (*q == *queue) {
+          m_queues.erase(q);
+          break;
+        }
+      }
+      queue = m_queuesSnapshot.erase(queue);
+    } else {
+      queue++;
+    }
+  }
+  return writtenMsgs;
+}
+
+//------------------------------------------------------------------------------
+// wakeUpBackgroundThread
+//------------------------------------------------------------------------------
+void AsyncLogger::wakeUpBackgroundThread() {
+  if (m_backgroundThreadSleeping) {
+    threading::MutexLocker ml(m_mutex);
+    m_msgQueued->signal();
+  }
+}
+
+//------------------------------------------------------------------------------
+// registerForkHandlers
+//------------------------------------------------------------------------------
+void AsyncLogger::registerForkHandlers() {
+  pthread_atfork(&AsyncLogger::prepareAllForFork, &AsyncLogger::resumeAllInParent, &AsyncLogger::resumeAllInChild);
+}
+
+//------------------------------------------------------------------------------
+// prepareAllForFork
+//------------------------------------------------------------------------------
+void AsyncLogger::prepareAllForFork() {
+  // The locks are released by the resume handlers, in both processes.
+  forkRegistry().mutex.lock();
+  for (auto logger: forkRegistry().loggers) {
+    // The background thread is not inside the wrapped logger once we hold the
+    // write mutex, and is sleeping or about to once we hold the mutex.
+    logger->m_writeMutex.lock();
+    logger->m_mutex.lock();
+  }
+}
+
+//------------------------------------------------------------------------------
+// resumeAllInParent
+//------------------------------------------------------------------------------
+void AsyncLogger::resumeAllInParent() {
+  for (auto logger: forkRegistry().loggers) {
+    logger->m_mutex.unlock();
+    logger->m_writeMutex.unlock();
+  }
+  forkRegistry().mutex.unlock();
+}
+
+//------------------------------------------------------------------------------
+// resumeAllInChild
+//------------------------------------------------------------------------------
+void AsyncLogger::resumeAllInChild() {
+  for (auto logger: forkRegistry().loggers) {
+    // The threads waiting on the condition variables in the parent do not
+    // exist here: the old condition variables cannot be used nor destroyed
+    // (they are leaked).
+    logger->m_msgQueued.release();
+    logger->m_msgQueued.reset(new threading::CondVar);
+    logger->m_msgsWritten.release();
+    logger->m_msgsWritten.reset(new threading::CondVar);
+    logger->m_roomAvailable.release();
+    logger->m_roomAvailable.reset(new threading::CondVar);
+    logger->m_backgroundThreadSleeping = false;
+    logger->m_flushingThreads = 0;
+    logger->m_blockedThreads = 0;
+    reinitialiseInChild(logger->m_mutex);
+    reinitialiseInChild(logger->m_writeMutex);
+  }
+  reinitialiseInChild(forkRegistry().mutex);
+}
+
+} // namespace log
+} // namespace cta
@@ -0,0 +1,281 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "common/log/Logger.hpp"
+#include "common/threading/CondVar.hpp"
+#include "common/threading/Mutex.hpp"
+
+#include <memory>
+#include <sys/time.h>
+#include <thread>
+#include <vector>
+
+namespace cta {
+namespace log {
+
+/**
+ * A logger that moves the formatting and the writing of the messages out of
+ * the logging threads.
+ *
+ * operator() only captures the message (time stamp, thread ID and
+ * parameters) into a bounded lock-free queue owned by the calling thread. A
+ * background thread drains the queues of all the threads, formats the
+ * messages and writes them with the underlying logging system of the wrapped
+ * logger. The messages of a given thread are written in order, the messages of
+ * different threads can be interleaved differently from their time stamps.
+ *
+ * When the queue of a thread is full, the message is either dropped (the
+ * number of dropped messages is then logged by the background thread) or the
+ * thread waits for room in the queue, depending on the overflow policy.
+ *
+ * The log mask and the log format are the ones of the asynchronous logger,
+ * the ones of the wrapped logger are not used. The background thread is
+ * restarted by the first message logged after a fork(). The loggers are
+ * quiesced during a fork() (see pthread_atfork()): the background thread is not
+ * writing and holds no lock when the process is duplicated, so that the child
+ * process can log.
+ */
+class AsyncLogger: public Logger {
+public:
+
+  /**
+   * What to do with a message when the queue of the logging thread is full.
+   */
+  enum class OverflowPolicy {
+    DROP, ///< Drop the message.
+    BLOCK ///< Wait until the background thread makes room for the message.
+  };
+
+  /**
+   * Default capacity of the per-thread queues, in messages.
+   */
+  static const size_t c_defaultThreadQueueCapacity = 1024;
+
+  /**
+   * Constructor
+   *
+   * @param logger The logger whose underlying logging system will be used.
+   * Its host name, program name and log mask are taken over.
+   * @param threadQueueCapacity The maximum number of messages waiting to be
+   * written for each logging thread.
+   * @param overflowPolicy What to do with a message when the queue of the
+   * logging thread is full.
+   */
+  AsyncLogger(std::unique_ptr<Logger> logger, const size_t threadQueueCapacity = c_defaultThreadQueueCapacity,
+    const OverflowPolicy overflowPolicy = OverflowPolicy::DROP);
+
+  /**
+   * Destructor. Writes all the messages still queued.
+   */
+  ~AsyncLogger();
+
+  /**
+   * Prepares the logger object for a call to fork(): all the queued messages
+   * are written, so that they are not lost in the parent nor duplicated in the
+   * child.
+   */
+  void prepareForFork() override;
+
+  /**
+   * Captures a message to be written by the background thread. Like for
+   * the other loggers, no exception is ever thrown.
+   *
+   * @param priority the priority of the message as defined by the syslog API.
+   * @param msg the message.
+   * @param params optional parameters of the message.
+   */
+  void operator() (
+    const int priority,
+    const std::string &msg,
+    const std::list<Param> &params = std::list<Param>()) override;
+
+  /**
+   * Waits until all the messages logged before the call are written (or
+   * dropped).
+   */
+  void flush();
+
+  /**
+   * Returns the number of messages dropped because the queue of the logging
+   * thread was full.
+   */
+  uint64_t getDroppedMessagesCount() const;
+
+protected:
+
+  /**
+   * Writes a formatted message with the underlying logging system of the
+   * wrapped logger. Only called by the background thread.
+   *
+   * @param header The header of the message to be logged.
+   * @param body The body of the message to be logged.
+   */
+  void writeMsgToUnderlyingLoggingSystem(const std::string &header, const std::string &body) override;
+
+private:
+
+  /**
+   * A message captured by a logging thread.
+   */
+  struct CapturedMsg {
+    int priority;
+    std::string msg;
+    std::list<Param> params;
+    struct timeval timeStamp;
+    int pid;
+    int tid;
+  };
+
+  /**
+   * The queue of a logging thread (defined in the .cpp).
+   */
+  struct ThreadQueue;
+
+  /**
+   * The queues of the current thread for all the asynchronous loggers
+   * (defined in the .cpp).
+   */
+  struct ThreadQueueRegistry;
+
+  /**
+   * Returns the queue of the calling thread, creating and registering it
+   * on the first call (in this process).
+   */
+  ThreadQueue & getThreadQueue(const int pid);
+
+  /**
+   * Starts the background thread if it is not running in this process (first
+   * message after a fork()).
+   */
+  void startBackgroundThreadIfNeeded(const int pid);
+
+  /**
+   * The loop of the background thread.
+   */
+  void run();
+
+  /**
+   * Writes all the messages currently queued.
+   *
+   * @return the number of messages written.
+   */
+  uint64_t writeQueuedMsgs();
+
+  /**
+   * Wakes up the background thread if it is sleeping.
+   */
+  void wakeUpBackgroundThread();
+
+  /**
+   * The pthread_atfork() handlers, applied to all the asynchronous loggers.
+   * The prepare handler waits for the background threads to complete their
+   * current writes and takes their locks, which are released on both sides of
+   * the fork.
+   */
+  static void prepareAllForFork();
+  static void resumeAllInParent();
+  static void resumeAllInChild();
+
+  /**
+   * Registers the pthread_atfork() handlers, once per process.
+   */
+  static void registerForkHandlers();
+
+  /**
+   * The wrapped logger.
+   */
+  std::unique_ptr<Logger> m_logger;
+
+  /**
+   * The capacity of the per-thread queues.
+   */
+  const size_t m_threadQueueCapacity;
+
+  /**
+   * The overflow policy.
+   */
+  const OverflowPolicy m_overflowPolicy;
+
+  /**
+   * The identifier of this logger in the per-thread registries (the address
+   * of a destroyed logger can be reused).
+   */
+  const uint64_t m_id;
+
+  /**
+   * Mutex protecting the list of queues, the start of the background thread
+   * and the sleeps of the background, flushing and blocked threads.
+   */
+  threading::Mutex m_mutex;
+
+  /**
+   * Mutex held by the background thread while it writes messages (and is
+   * therefore inside the wrapped logger). Taken before m_mutex.
+   */
+  threading::Mutex m_writeMutex;
+
+  /**
+   * The queues of the logging threads.
+   */
+  std::vector<std::shared_ptr<ThreadQueue>> m_queues;
+
+  /**
+   * Incremented when a queue is added, so that the background thread only
+   * copies the list of queues when it changed.
+   */
+  std::atomic<uint64_t> m_queuesVersion;
+
+  /**
+   * The background thread, and the process in which it runs.
+   */
+  std::unique_ptr<std::thread> m_thread;
+  std::atomic<int> m_threadPid;
+
+  /**
+   * Condition variables for the sleeps of the background thread, of the
+   * flushing threads and of the threads waiting for room in their queue (BLOCK
+   * overflow policy). They are replaced in the child of a fork(), as the
+   * threads waiting on them in the parent do not exist there.
+   */
+  std::unique_ptr<threading::CondVar> m_msgQueued;
+  std::unique_ptr<threading::CondVar> m_msgsWritten;
+  std::unique_ptr<threading::CondVar> m_roomAvailable;
+  std::atomic<bool> m_backgroundThreadSleeping;
+  std::atomic<uint64_t> m_flushingThreads;
+  std::atomic<uint64_t> m_blockedThreads;
+  std::atomic<bool> m_stopRequested;
+
+  /**
+   * Counters of messages, used for flushing.
+   */
+  std::atomic<uint64_t> m_queuedMsgs;
+  std::atomic<uint64_t> m_writtenMsgs;
+  std::atomic<uint64_t> m_droppedMsgs;
+
+  /**
+   * The copy of the list of queues used by the background thread, and the
+   * version of the list it was copied from.
+   */
+  std::vector<std::shared_ptr<ThreadQueue>> m_queuesSnapshot;
+  uint64_t m_queuesSnapshotVersion;
+
+}; // class AsyncLogger
+
+} // namespace log
+} // namespace cta
@@ -0,0 +1,157 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/log/AsyncLogger.hpp"
+#include "common/log/StringLogger.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <future>
+#include <signal.h>
+#include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace cta::log;
+
+namespace unitTests {
+
+namespace {
+  /**
+   * A string logger that holds its first write until released.
+   */
+  class HeldStringLogger: public StringLogger {
+  public:
+    HeldStringLogger(std::shared_future<void> release):
+      StringLogger("dummy", "cta_log_AsyncLogger", DEBUG), m_release(release) {}
+  protected:
+    void writeMsgToUnderlyingLoggingSystem(const std::string &header, const std::string &body) override {
+      m_release.wait();
+      StringLogger::writeMsgToUnderlyingLoggingSystem(header, body);
+    }
+    std::shared_future<void> m_release;
+  };
+}
+
+TEST(cta_log_AsyncLogger, messagesOfAllThreadsAreWrittenInOrder) {
+  StringLogger * stringLogger = new StringLogger("dummy", "cta_log_AsyncLogger", DEBUG);
+  AsyncLogger asyncLogger(std::unique_ptr<Logger>(stringLogger), 16, AsyncLogger::OverflowPolicy::BLOCK);
+  const int threads = 4;
+  const int msgsPerThread = 1000;
+  std::list<std::thread> loggingThreads;
+  for (int t = 0; t < threads; t++) {
+    loggingThreads.emplace_back([&asyncLogger, t]() {
+      for (int i = 0; i < msgsPerThread; i++) {
+        asyncLogger(INFO, "Message", {Param("thread", t), Param("index", i)});
+      }
+    });
+  }
+  for (auto & t: loggingThreads) t.join();
+  asyncLogger(DEBUG, "Last message");
+  asyncLogger.flush();
+  ASSERT_EQ(0U, asyncLogger.getDroppedMessagesCount());
+  const std::string log = stringLogger->getLog();
+  for (int t = 0; t < threads; t++) {
+    size_t previous = 0;
+    for (int i = 0; i < msgsPerThread; i++) {
+      std::stringstream expected;
+      expected << "thread=\"" << t << "\" index=\"" << i << "\"";
+      const size_t position = log.find(expected.str());
+      ASSERT_NE(std::string::npos, position);
+      ASSERT_LE(previous, position);
+      previous = position;
+    }
+  }
+  ASSERT_NE(std::string::npos, log.find("Last message"));
+}
+
+TEST(cta_log_AsyncLogger, dropsAndReportsMessagesWhenQueueIsFull) {
+  std::promise<void> release;
+  HeldStringLogger * stringLogger = new HeldStringLogger(release.get_future().share());
+  AsyncLogger asyncLogger(std::unique_ptr<Logger>(stringLogger), 4, AsyncLogger::OverflowPolicy::DROP);
+  // The background thread holds at most one message while the queue is
+  // full, so at least 100 - 4 - 1 messages are dropped.
+  for (int i = 0; i < 100; i++) {
+    asyncLogger(INFO, "Message", {Param("index", i)});
+  }
+  ASSERT_LE(95U, asyncLogger.getDroppedMessagesCount());
+  release.set_value();
+  asyncLogger.flush();
+  const std::string log = stringLogger->getLog();
+  ASSERT_NE(std::string::npos, log.find("index=\"0\""));
+  ASSERT_EQ(std::string::npos, log.find("index=\"99\""));
+  asyncLogger(INFO, "Next message");
+  asyncLogger.flush();
+  ASSERT_NE(std::string::npos, stringLogger->getLog().find("droppedMessages=\""));
+}
+
+TEST(cta_log_AsyncLogger, logMaskAndFormatOfTheAsyncLogger) {
+  StringLogger * stringLogger = new StringLogger("dummy", "cta_log_AsyncLogger", DEBUG);
+  AsyncLogger asyncLogger(std::unique_ptr<Logger>(stringLogger), AsyncLogger::c_defaultThreadQueueCapacity);
+  asyncLogger.setLogMask(INFO);
+  asyncLogger.setLogFormat(Logger::LogFormat::JSON);
+  asyncLogger(DEBUG, "Filtered message");
+  asyncLogger(INFO, "JSON message", {Param("vid", "V00001")});
+  asyncLogger.flush();
+  const std::string log = stringLogger->getLog();
+  ASSERT_EQ(std::string::npos, log.find("Filtered message"));
+  ASSERT_NE(std::string::npos, log.find("\"message\":\"JSON message\",\"vid\":\"V00001\"}"));
+}
+
+TEST(cta_log_AsyncLogger, childProcessCanLogAfterForkWhileThreadsLog) {
+  StringLogger * stringLogger = new StringLogger("dummy", "cta_log_AsyncLogger", DEBUG);
+  AsyncLogger asyncLogger(std::unique_ptr<Logger>(stringLogger), 4, AsyncLogger::OverflowPolicy::BLOCK);
+  std::atomic<bool> stop(false);
+  std::list<std::thread> loggingThreads;
+  for (int t = 0; t < 4; t++) {
+    loggingThreads.emplace_back([&asyncLogger, &stop, t]() {
+      for (int i = 0; !stop; i++) {
+        asyncLogger(INFO, "Message", {Param("thread", t), Param("index", i)});
+      }
+    });
+  }
+  for (int f = 0; f < 20; f++) {
+    asyncLogger.prepareForFork();
+    const pid_t pid = ::fork();
+    ASSERT_NE(-1, pid);
+    if (!pid) {
+      // The background thread was not holding any lock at the time of the fork.
+      asyncLogger(INFO, "Child message");
+      asyncLogger.flush();
+      ::_exit(std::string::npos == stringLogger->getLog().find("Child message") ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+    int status = 0;
+    pid_t rc = 0;
+    for (int i = 0; i < 1000 && !rc; i++) {
+      rc = ::waitpid(pid, &status, WNOHANG);
+      if (!rc) ::usleep(10 * 1000);
+    }
+    if (!rc) {
+      ::kill(pid, SIGKILL);
+      ::waitpid(pid, &status, 0);
+    }
+    ASSERT_EQ(pid, rc) << "Child process deadlocked";
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(EXIT_SUCCESS, WEXITSTATUS(status));
+  }
+  stop = true;
+  for (auto & t: loggingThreads) t.join();
+  asyncLogger.flush();
+}
+
+} // namespace unitTests
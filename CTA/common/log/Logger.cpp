@@ -30,7 +30,7 @@ namespace log {
 // constructor
 //------------------------------------------------------------------------------
 Logger::Logger(const std::string &hostName, const std::string &programName, const int logMask):
-  m_hostName(hostName), m_programName(programName), m_logMask(logMask),
+  m_hostName(hostName), m_programName(programName), m_logMask(logMask), m_logFormat(LogFormat::DEFAULT),
   m_priorityToText(generatePriorityToTextMap()) {}
 
 //------------------------------------------------------------------------------
@@ -54,10 +54,29 @@ void Logger::operator() (
   const std::string &msg,
   const std::list<Param> &params) {
 
-  const std::string rawParams;
+  // Ignore messages whose priority is not of interest
+  if(priority > m_logMask) {
+    return;
+  }
+
   struct timeval timeStamp;
   gettimeofday(&timeStamp, NULL);
   const int pid = getpid();
+  const int tid = syscall(__NR_gettid);
+
+  writeCapturedMsg(priority, msg, params, timeStamp, pid, tid);
+}
+
+//-----------------------------------------------------------------------------
+// writeCapturedMsg
+//-----------------------------------------------------------------------------
+void Logger::writeCapturedMsg(
+  const int priority,
+  const std::string &msg,
+  const std::list<Param> &params,
+  const struct timeval &timeStamp,
+  const int pid,
+  const int tid) {
 
   // Ignore messages whose priority is not of interest
   if(priority > m_logMask) {
@@ -76,8 +95,14 @@ void Logger::operator() (
   // Safe to get a reference to the textual representation of the priority
   const std::string &priorityText = priorityTextPair->second;
 
+  if(LogFormat::JSON == m_logFormat) {
+    writeMsgToUnderlyingLoggingSystem("",
+      createJsonMsg(timeStamp, m_hostName, m_programName, priorityText, msg, params, pid, tid));
+    return;
+  }
+
   const std::string header = createMsgHeader(timeStamp, m_hostName, m_programName, pid);
-  const std::string body = createMsgBody(priority, priorityText, msg, params, rawParams, m_programName, pid);
+  const std::string body = createMsgBody(priorityText, msg, params, pid, tid);
 
   writeMsgToUnderlyingLoggingSystem(header, body);
 }
@@ -145,6 +170,27 @@ void Logger::setLogMask(const int logMask) {
   m_logMask = logMask;
 }
 
+//------------------------------------------------------------------------------
+// setLogFormat
+//------------------------------------------------------------------------------
+void Logger::setLogFormat(const std::string &logFormat) {
+  if("default" == logFormat) {
+    setLogFormat(LogFormat::DEFAULT);
+  } else if("json" == logFormat) {
+    setLogFormat(LogFormat::JSON);
+  } else {
+    throw exception::Exception(std::string("Failed to set log format: unknown format ") + logFormat +
+      ", expected default or json");
+  }
+}
+
+//------------------------------------------------------------------------------
+// setLogFormat
+//------------------------------------------------------------------------------
+void Logger::setLogFormat(const LogFormat logFormat) {
+  m_logFormat = logFormat;
+}
+
 //-----------------------------------------------------------------------------
 // createMsgHeader
 //-----------------------------------------------------------------------------
@@ -172,20 +218,24 @@ std::string Logger::createMsgHeader(
 // createMsgBody
 //-----------------------------------------------------------------------------
 std::string Logger::createMsgBody(
-  const int priority,
   const std::string &priorityText,
   const std::string &msg,
   const std::list<Param> &params,
-  const std::string &rawParams,
-  const std::string &programName,
-  const int pid) {
-  std::ostringstream os;
-
-  const int tid = syscall(__NR_gettid);
+  const int pid,
+  const int tid) {
+  std::string body;
+  body.reserve(128 + msg.size() + 32 * params.size());
 
   // Append the log level, the thread id and the message text
-  os << "LVL=\"" << priorityText << "\" PID=\"" << pid << "\" TID=\"" << tid << "\" MSG=\"" <<
-    msg << "\" ";
+  body += "LVL=\"";
+  body += priorityText;
+  body += "\" PID=\"";
+  body += std::to_string(pid);
+  body += "\" TID=\"";
+  body += std::to_string(tid);
+  body += "\" MSG=\"";
+  body += msg;
+  body += "\" ";
 
   // Process parameters
   for(auto itor = params.cbegin(); itor != params.cend(); itor++) {
@@ -193,20 +243,92 @@ std::string Logger::createMsgBody(
 
     // Check the parameter name, if it's an empty string set the value to
     // "Undefined".
-    const std::string name = param.getName() == "" ? "Undefined" :
-      cleanString(param.getName(), true);
-
-    // Process the parameter value
-    const std::string value = cleanString(param.getValue(), false);
+    if(param.getName().empty()) {
+      body += "Undefined";
+    } else {
+      body += cleanString(param.getName(), true);
+    }
 
     // Write the name and value to the buffer
-    os << name << "=\"" << value << "\" ";
+    body += "=\"";
+    body += cleanString(param.getValue(), false);
+    body += "\" ";
   }
 
-  // Append raw parameters
-  os << rawParams;
+  return body;
+}
 
-  return os.str();
+//-----------------------------------------------------------------------------
+// createJsonMsg
+//-----------------------------------------------------------------------------
+std::string Logger::createJsonMsg(
+  const struct timeval &timeStamp,
+  const std::string &hostName,
+  const std::string &programName,
+  const std::string &priorityText,
+  const std::string &msg,
+  const std::list<Param> &params,
+  const int pid,
+  const int tid) {
+  std::string json;
+  json.reserve(256 + msg.size() + 32 * params.size());
+
+  char buf[80];
+  snprintf(buf, sizeof(buf), "%ld.%06ld", (long)timeStamp.tv_sec, (long)timeStamp.tv_usec);
+  json += "{\"epoch_time\":";
+  json += buf;
+  struct tm localTime;
+  localtime_r(&(timeStamp.tv_sec), &localTime);
+  strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S%z", &localTime);
+  json += ",\"local_time\":\"";
+  json += buf;
+  json += "\",\"hostname\":";
+  appendJsonString(json, hostName);
+  json += ",\"program\":";
+  appendJsonString(json, programName);
+  json += ",\"log_level\":\"";
+  json += priorityText;
+  json += "\",\"pid\":";
+  json += std::to_string(pid);
+  json += ",\"tid\":";
+  json += std::to_string(tid);
+  json += ",\"message\":";
+  appendJsonString(json, msg);
+
+  for(auto itor = params.cbegin(); itor != params.cend(); itor++) {
+    json += ',';
+    appendJsonString(json, itor->getName().empty() ? "Undefined" : cleanString(itor->getName(), true));
+    json += ':';
+    appendJsonString(json, itor->getValue());
+  }
+  json += '}';
+
+  return json;
+}
+
+//-----------------------------------------------------------------------------
+// appendJsonString
+//-----------------------------------------------------------------------------
+void Logger::appendJsonString(std::string &json, const std::string &s) {
+  json += '"';
+  for(const char c: s) {
+    switch(c) {
+    case '"':  json += "\\\""; break;
+    case '\\': json += "\\\\"; break;
+    case '\n': json += "\\n"; break;
+    case '\r': json += "\\r"; break;
+    case '\t': json += "\\t"; break;
+    default:
+      if(static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c));
+        json += buf;
+      } else {
+        json += c;
+      }
+    }
+  }
+  json += '"';
 }
 
 } // namespace log
@@ -85,6 +85,12 @@ namespace log {
 class Logger {
 public:
 
+  /**
+   * The asynchronous logger formats the messages it captures and writes them
+   * with the underlying logging system of the logger it wraps.
+   */
+  friend class AsyncLogger;
+
   /**
    * Constructor
    *
@@ -130,6 +136,28 @@ public:
     const std::string &msg,
     const std::list<Param> &params = std::list<Param>());
 
+  /**
+   * The formats of the log messages.
+   */
+  enum class LogFormat {
+    DEFAULT, ///< A header followed by the parameters as name="value" pairs.
+    JSON     ///< One JSON object per message (no header).
+  };
+
+  /**
+   * Sets the format of the log messages.
+   *
+   * @param logFormat The log format, "default" or "json".
+   */
+  void setLogFormat(const std::string &logFormat);
+
+  /**
+   * Sets the format of the log messages.
+   *
+   * @param logFormat The log format.
+   */
+  void setLogFormat(const LogFormat logFormat);
+
   /**
    * Sets the log mask.
    *
@@ -184,11 +212,40 @@ protected:
    */
   virtual void writeMsgToUnderlyingLoggingSystem(const std::string &header, const std::string &body) = 0;
 
+  /**
+   * Writes a message that was captured earlier, possibly by another thread,
+   * into the logging system. The time stamp, the process ID and the thread ID
+   * of the message are the ones of the capture. This allows AsyncLogger to
+   * format and write the messages in a background thread.
+   *
+   * Note that operator() is implemented by capturing the message and
+   * immediately calling this method.
+   *
+   * @param priority the priority of the message as defined by the syslog API.
+   * @param msg the message.
+   * @param params the parameters of the message.
+   * @param timeStamp the time stamp of the message.
+   * @param pid the process ID of the process that logged the message.
+   * @param tid the ID of the thread that logged the message.
+   */
+  void writeCapturedMsg(
+    const int priority,
+    const std::string &msg,
+    const std::list<Param> &params,
+    const struct timeval &timeStamp,
+    const int pid,
+    const int tid);
+
   /**
    * The log mask.
    */
   std::atomic<int> m_logMask;
 
+  /**
+   * The format of the log messages.
+   */
+  std::atomic<LogFormat> m_logFormat;
+
   /**
    * Map from syslog integer priority to textual representation.
    */
@@ -237,22 +294,51 @@ private:
   /**
    * Creates and returns the body of a log message.
    *
-   * @param priority the priority of the message as defined by the syslog API.
+   * @param priorityText the textual representation of the priority.
    * @param msg the message.
    * @param params the parameters of the message.
-   * @param rawParams preprocessed parameters of the message.
-   * @param programName the program name of the log message.
    * @param pid the pid of the log message.
+   * @param tid the thread id of the log message.
    * @return The message body;
    */
   static std::string createMsgBody(
-    const int priority,
     const std::string &priorityText,
     const std::string &msg,
     const std::list<Param> &params,
-    const std::string &rawParams,
+    const int pid,
+    const int tid);
+
+  /**
+   * Creates and returns a log message in JSON format. The message carries
+   * all the information of the header, so it is not preceded by one.
+   *
+   * @param timeStamp The time stamp of the message.
+   * @param hostName The name of the host.
+   * @param programName the program name of the log message.
+   * @param priorityText the textual representation of the priority.
+   * @param msg the message.
+   * @param params the parameters of the message.
+   * @param pid the pid of the log message.
+   * @param tid the thread id of the log message.
+   * @return The message in JSON format.
+   */
+  static std::string createJsonMsg(
+    const struct timeval &timeStamp,
+    const std::string &hostName,
     const std::string &programName,
-    const int pid);
+    const std::string &priorityText,
+    const std::string &msg,
+    const std::list<Param> &params,
+    const int pid,
+    const int tid);
+
+  /**
+   * Appends the specified string to a JSON document as a JSON string.
+   *
+   * @param json The JSON document.
+   * @param s The string to append.
+   */
+  static void appendJsonString(std::string &json, const std::string &s);
 
 }; // class Logger
 
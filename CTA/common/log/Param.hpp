@@ -20,6 +20,7 @@
 #include <sstream>
 #include <string.h>
 #include <cstdio>
+#include <type_traits>
 
 namespace cta {
 namespace log {
@@ -36,14 +37,13 @@ public:
    *
    * @param name The name of the parameter.
    * @param value The value of the parameter that will be converted to a string
-   * using std::ostringstream.
+   * using std::ostringstream (std::to_string for integers).
    */
   template <typename T> Param(const std::string &name, const T &value) throw():
-    m_name(name) {
-    std::ostringstream oss;
-    oss << value;
-    m_value = oss.str();
-  }
+    m_name(name), m_value(toString(value)) {}
+
+  Param(const std::string & name, const std::string & value) throw():
+    m_name(name), m_value(value) {}
     
   Param(const std::string & name, const uint8_t & value) throw():
   m_name(name) {
@@ -74,9 +74,7 @@ public:
    */
   template <typename T>
   void setValue (const T &value) throw() {
-    std::stringstream oss;
-    oss << value;
-    m_value = oss.str();
+    m_value = toString(value);
   }
 
   /**
@@ -91,6 +89,31 @@ public:
 
 protected:
 
+  /**
+   * Converts a value to a string. Integers (except the character types, that
+   * are streamed as characters) skip the construction of a stream, as
+   * parameters are created for every log message.
+   */
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value &&
+    !std::is_same<T, signed char>::value && !std::is_same<T, unsigned char>::value, std::string>::type
+  toString(const T &value) {
+    return std::to_string(value);
+  }
+
+  template <typename T>
+  static typename std::enable_if<!std::is_integral<T>::value || std::is_same<T, char>::value ||
+    std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value, std::string>::type
+  toString(const T &value) {
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+  }
+
+  static std::string toString(const std::string &value) {
+    return value;
+  }
+
   /**
    * Name of the parameter
    */
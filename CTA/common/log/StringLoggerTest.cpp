@@ -16,6 +16,7 @@
  */
 
 #include "StringLogger.hpp"
+#include "common/exception/Exception.hpp"
 
 #include <gtest/gtest.h>
 
@@ -28,4 +29,15 @@ namespace unitTests {
     sl(INFO, jat);
     ASSERT_NE(std::string::npos, sl.getLog().find(jat));
   }
+
+  TEST(cta_log_StringLogger, jsonFormat) {
+    StringLogger sl("dummy", "cta_log_StringLogger", DEBUG);
+    sl.setLogFormat("json");
+    sl(INFO, "Just a \"test\"", {Param("fileId", 1234), Param("path", "/eos/a\tb")});
+    const std::string log = sl.getLog();
+    ASSERT_EQ(0U, log.find("{\"epoch_time\":"));
+    ASSERT_NE(std::string::npos, log.find("\"hostname\":\"dummy\",\"program\":\"cta_log_StringLogger\",\"log_level\":\"INFO\""));
+    ASSERT_NE(std::string::npos, log.find("\"message\":\"Just a \\\"test\\\"\",\"fileId\":\"1234\",\"path\":\"/eos/a\\tb\"}\n"));
+    ASSERT_THROW(sl.setLogFormat("xml"), cta::exception::Exception);
+  }
 }
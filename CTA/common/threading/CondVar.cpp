@@ -20,6 +20,9 @@
 #include "common/threading/MutexLocker.hpp"
 #include "common/utils/utils.hpp"
 
+#include <errno.h>
+#include <time.h>
+
 namespace cta {
 namespace threading {
 
@@ -27,7 +30,15 @@ namespace threading {
 // constructor
 //------------------------------------------------------------------------------
 CondVar::CondVar() {
-  const int initRc = pthread_cond_init(&m_cond, nullptr);
+  // The timed waits are measured on the monotonic clock, so that they are not
+  // affected by changes of the system time.
+  pthread_condattr_t attr;
+  if(0 != pthread_condattr_init(&attr)) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed: Failed to initialise condition variable attributes");
+  }
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  const int initRc = pthread_cond_init(&m_cond, &attr);
+  pthread_condattr_destroy(&attr);
   if(0 != initRc) {
     throw exception::Exception(std::string(__FUNCTION__) + " failed: Failed to initialise condition variable");
   }
@@ -55,6 +66,33 @@ void CondVar::wait(MutexLocker &locker) {
   }
 }
 
+//------------------------------------------------------------------------------
+// timedWait
+//------------------------------------------------------------------------------
+bool CondVar::timedWait(MutexLocker &locker, const uint64_t timeoutMs) {
+  if(!locker.m_locked) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed: Underlying mutex is not locked.");
+  }
+
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += timeoutMs / 1000;
+  deadline.tv_nsec += (timeoutMs % 1000) * 1000 * 1000;
+  if(deadline.tv_nsec >= 1000 * 1000 * 1000) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000 * 1000 * 1000;
+  }
+  const int waitRc = pthread_cond_timedwait(&m_cond, &locker.m_mutex.m_mutex, &deadline);
+  if(ETIMEDOUT == waitRc) {
+    return false;
+  }
+  if(0 != waitRc) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed: pthread_cond_timedwait failed:" +
+      utils::errnoToString(waitRc));
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // signal
 //------------------------------------------------------------------------------
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <stdint.h>
 #include <pthread.h>
 
 namespace cta {
@@ -69,6 +70,15 @@ public:
    */
   void wait(MutexLocker &);
 
+  /**
+   * Waits on the specified MutexLocker and its corresponding Mutex, for at
+   * most the specified time. Like wait(), it can return spuriously.
+   *
+   * @param timeoutMs The maximum time to wait, in milliseconds.
+   * @return false if the timeout expired, true otherwise.
+   */
+  bool timedWait(MutexLocker &, const uint64_t timeoutMs);
+
   /**
    * Unblocks at least one waiting thread.
    */
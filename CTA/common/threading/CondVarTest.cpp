@@ -201,4 +201,53 @@ TEST_F(cta_threading_CondVarTest, waitAndBroadcast) {
   evenCounter.wait();
 }
 
+TEST_F(cta_threading_CondVarTest, timedWaitTimesOut) {
+  using namespace cta::threading;
+
+  cta::threading::Mutex mutex;
+  cta::threading::CondVar cond;
+  cta::threading::MutexLocker locker(mutex);
+
+  ASSERT_FALSE(cond.timedWait(locker, 10));
+}
+
+class SignallingThread: public cta::threading::Thread {
+public:
+
+  SignallingThread(cta::threading::CondVar &cond, cta::threading::Mutex &m, bool &signalled):
+    m_cond(cond), m_mutex(m), m_signalled(signalled) {
+  }
+
+  void run() override {
+    cta::threading::MutexLocker locker(m_mutex);
+    m_signalled = true;
+    m_cond.signal();
+  }
+
+private:
+
+  cta::threading::CondVar &m_cond;
+  cta::threading::Mutex &m_mutex;
+  bool &m_signalled;
+}; // class SignallingThread
+
+TEST_F(cta_threading_CondVarTest, timedWaitAndSignal) {
+  using namespace cta::threading;
+
+  cta::threading::Mutex mutex;
+  cta::threading::CondVar cond;
+  bool signalled = false;
+  SignallingThread signallingThread(cond, mutex, signalled);
+
+  {
+    cta::threading::MutexLocker locker(mutex);
+    signallingThread.start();
+    while(!signalled) {
+      ASSERT_TRUE(cond.timedWait(locker, 60 * 1000));
+    }
+  }
+
+  signallingThread.wait();
+}
+
 } // namespace unitTests
@@ -0,0 +1,351 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+#include "common/threading/CondVar.hpp"
+#include "common/threading/MutexLocker.hpp"
+
+namespace cta {
+namespace threading {
+
+namespace ringQueueDetails {
+  /** Size of a cache line, used to keep producer and consumer indices apart */
+  const size_t CACHE_LINE_SIZE = 64;
+
+  /** Smallest power of 2 greater or equal to n (and at least 2) */
+  inline size_t roundUpToPowerOf2(size_t n) {
+    size_t ret = 2;
+    while (ret < n) ret <<= 1;
+    return ret;
+  }
+
+  /** Hint to the processor that we are spinning */
+  inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause");
+#endif
+  }
+}
+
+/**
+ * A bounded, lock-free, single-producer single-consumer ring. At most one
+ * thread may push at a time and at most one thread may pop at a time (several
+ * threads may take turns if they are serialized externally, e.g. by a mutex).
+ * The capacity is rounded up to a power of 2.
+ */
+template<class C>
+class SpscRing {
+public:
+  explicit SpscRing(const size_t capacity):
+    m_capacity(ringQueueDetails::roundUpToPowerOf2(capacity)), m_mask(m_capacity - 1),
+    m_cells(new C[m_capacity]), m_tail(0), m_headCache(0), m_head(0), m_tailCache(0) {}
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing & operator=(const SpscRing &) = delete;
+
+  /**
+   * Push an element if there is room for it
+   * @return false if the ring is full
+   */
+  bool tryPush(const C & e) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (!hasRoom(tail)) return false;
+    m_cells[tail & m_mask] = e;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Move an element in if there is room for it (e is left untouched otherwise)
+   * @return false if the ring is full
+   */
+  bool tryPush(C && e) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (!hasRoom(tail)) return false;
+    m_cells[tail & m_mask] = std::move(e);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop (move out) an element if there is one
+   * @return false if the ring is empty
+   */
+  bool tryPop(C & e) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tailCache) {
+      m_tailCache = m_tail.load(std::memory_order_acquire);
+      if (head == m_tailCache) return false;
+    }
+    e = std::move(m_cells[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Number of elements in the ring (a snapshot when called concurrently) */
+  size_t size() const {
+    const size_t head = m_head.load(std::memory_order_acquire);
+    return m_tail.load(std::memory_order_acquire) - head;
+  }
+
+  /** Maximum number of elements */
+  size_t capacity() const { return m_capacity; }
+
+private:
+  /** Producer side: whether the slot at tail is free */
+  bool hasRoom(const size_t tail) {
+    if (tail - m_headCache == m_capacity) {
+      m_headCache = m_head.load(std::memory_order_acquire);
+      if (tail - m_headCache == m_capacity) return false;
+    }
+    return true;
+  }
+
+  const size_t m_capacity;
+  const size_t m_mask;
+  std::unique_ptr<C[]> m_cells;
+  char m_padding0[ringQueueDetails::CACHE_LINE_SIZE];
+  /** Producer side: next slot to write and last seen consumer position */
+  std::atomic<size_t> m_tail;
+  size_t m_headCache;
+  char m_padding1[ringQueueDetails::CACHE_LINE_SIZE];
+  /** Consumer side: next slot to read and last seen producer position */
+  std::atomic<size_t> m_head;
+  size_t m_tailCache;
+  char m_padding2[ringQueueDetails::CACHE_LINE_SIZE];
+};
+
+/**
+ * A bounded, lock-free, multi-producer multi-consumer ring (D. Vyukov's
+ * algorithm: each cell carries a sequence number telling whether it is ready
+ * to be written or read for a given lap). It is also the ring to use for
+ * multi-producer single-consumer hops. The capacity is rounded up to a power
+ * of 2.
+ */
+template<class C>
+class MpmcRing {
+public:
+  explicit MpmcRing(const size_t capacity):
+    m_capacity(ringQueueDetails::roundUpToPowerOf2(capacity)), m_mask(m_capacity - 1),
+    m_cells(new Cell[m_capacity]), m_enqueuePos(0), m_dequeuePos(0) {
+    for (size_t i = 0; i < m_capacity; i++) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcRing(const MpmcRing &) = delete;
+  MpmcRing & operator=(const MpmcRing &) = delete;
+
+  /**
+   * Push an element if there is room for it
+   * @return false if the ring is full
+   */
+  bool tryPush(const C & e) {
+    Cell * cell;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &m_cells[pos & m_mask];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+      if (!dif) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = e;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop an element if there is one
+   * @return false if the ring is empty
+   */
+  bool tryPop(C & e) {
+    Cell * cell;
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &m_cells[pos & m_mask];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (!dif) {
+        if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = m_dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    e = cell->data;
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Number of elements in the ring (a snapshot when called concurrently) */
+  size_t size() const {
+    const size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+    const size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+  }
+
+  /** Maximum number of elements */
+  size_t capacity() const { return m_capacity; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    C data;
+  };
+  const size_t m_capacity;
+  const size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+  char m_padding0[ringQueueDetails::CACHE_LINE_SIZE];
+  std::atomic<size_t> m_enqueuePos;
+  char m_padding1[ringQueueDetails::CACHE_LINE_SIZE];
+  std::atomic<size_t> m_dequeuePos;
+  char m_padding2[ringQueueDetails::CACHE_LINE_SIZE];
+};
+
+/**
+ * A bounded blocking queue built on top of a lock-free ring. Pushes and pops
+ * go through the ring without taking any lock. Only when the ring is empty
+ * (for a pop) or full (for a push), after a short spin, does the caller fall
+ * back to sleeping on a condition variable. Wake ups are only issued when a
+ * thread is known to be sleeping, so the uncontended path makes no system call.
+ * It is a drop-in replacement for BlockingQueue where an upper bound on the
+ * number of queued elements is known.
+ */
+template<class C, class Ring = MpmcRing<C> >
+class BlockingRingQueue {
+public:
+  typedef struct valueRemainingPair {C value; size_t remaining;} valueRemainingPair;
+
+  /**
+   * Constructor
+   * @param capacity the maximum number of elements in the queue. Pushing on a
+   * full queue blocks until an element is popped.
+   */
+  explicit BlockingRingQueue(const size_t capacity):
+    m_ring(capacity), m_sleepingConsumers(0), m_sleepingProducers(0) {}
+
+  BlockingRingQueue(const BlockingRingQueue &) = delete;
+  BlockingRingQueue & operator=(const BlockingRingQueue &) = delete;
+
+  /**
+   * Copy e into the queue, blocking if it is full
+   * @param e
+   */
+  void push(const C & e) {
+    if (!m_ring.tryPush(e)) {
+      MutexLocker ml(m_mutex);
+      m_sleepingProducers.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!m_ring.tryPush(e)) m_notFull.wait(ml);
+      m_sleepingProducers.fetch_sub(1);
+    }
+    wakeUp(m_sleepingConsumers, m_notEmpty);
+  }
+
+  /**
+   * Return the next value of the queue and remove it, blocking while the
+   * queue is empty
+   */
+  C pop() {
+    C ret;
+    for (size_t i = 0; i < SPIN_COUNT; i++) {
+      if (m_ring.tryPop(ret)) {
+        wakeUp(m_sleepingProducers, m_notFull);
+        return ret;
+      }
+      ringQueueDetails::cpuRelax();
+    }
+    {
+      MutexLocker ml(m_mutex);
+      m_sleepingConsumers.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (!m_ring.tryPop(ret)) m_notEmpty.wait(ml);
+      m_sleepingConsumers.fetch_sub(1);
+    }
+    wakeUp(m_sleepingProducers, m_notFull);
+    return ret;
+  }
+
+  /**
+   * Pop an element if one is immediately available
+   * @return false if the queue was empty
+   */
+  bool tryPop(C & e) {
+    if (!m_ring.tryPop(e)) return false;
+    wakeUp(m_sleepingProducers, m_notFull);
+    return true;
+  }
+
+  /**
+   * Pop the next element AND return it with the number of elements remaining
+   * in the queue. The count is exact only in the absence of concurrent pushes.
+   */
+  valueRemainingPair popGetSize() {
+    valueRemainingPair ret;
+    ret.value = pop();
+    ret.remaining = m_ring.size();
+    return ret;
+  }
+
+  /**
+   * Return the number of elements currently in the queue
+   */
+  size_t size() const {
+    return m_ring.size();
+  }
+
+private:
+  /** Number of attempts at popping before going to sleep */
+  static const size_t SPIN_COUNT = 100;
+
+  /**
+   * Wake up the sleepers of the other side, if any. The fence pairs with the
+   * one taken by a sleeper after registering: either the sleeper sees our
+   * change to the ring, or we see it registered.
+   */
+  void wakeUp(const std::atomic<size_t> & sleepers, CondVar & cond) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed)) {
+      MutexLocker ml(m_mutex);
+      cond.broadcast();
+    }
+  }
+
+  Ring m_ring;
+  std::atomic<size_t> m_sleepingConsumers;
+  std::atomic<size_t> m_sleepingProducers;
+  Mutex m_mutex;
+  CondVar m_notEmpty;
+  CondVar m_notFull;
+};
+
+} // namespace threading
+} // namespace cta
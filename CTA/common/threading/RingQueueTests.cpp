@@ -0,0 +1,102 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/threading/RingQueue.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace unitTests {
+
+TEST(cta_threading, SpscRing_fifoAndBounds) {
+  cta::threading::SpscRing<int> ring(3);
+  ASSERT_EQ(4U, ring.capacity());
+  for (int i = 0; i < 4; i++) ASSERT_TRUE(ring.tryPush(i));
+  ASSERT_FALSE(ring.tryPush(4));
+  ASSERT_EQ(4U, ring.size());
+  int v;
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(ring.tryPop(v));
+    ASSERT_EQ(i, v);
+  }
+  ASSERT_FALSE(ring.tryPop(v));
+  ASSERT_EQ(0U, ring.size());
+}
+
+TEST(cta_threading, MpmcRing_fifoAndBounds) {
+  cta::threading::MpmcRing<int> ring(2);
+  ASSERT_TRUE(ring.tryPush(1));
+  ASSERT_TRUE(ring.tryPush(2));
+  ASSERT_FALSE(ring.tryPush(3));
+  int v;
+  ASSERT_TRUE(ring.tryPop(v));
+  ASSERT_EQ(1, v);
+  ASSERT_TRUE(ring.tryPush(3));
+  ASSERT_TRUE(ring.tryPop(v));
+  ASSERT_EQ(2, v);
+  ASSERT_TRUE(ring.tryPop(v));
+  ASSERT_EQ(3, v);
+  ASSERT_FALSE(ring.tryPop(v));
+}
+
+TEST(cta_threading, BlockingRingQueue_spscOrdering) {
+  // A small queue forces both sides to go through the blocking fallback.
+  cta::threading::BlockingRingQueue<int, cta::threading::SpscRing<int> > queue(4);
+  const int elements = 100000;
+  std::thread producer([&queue]() {
+    for (int i = 0; i < elements; i++) queue.push(i);
+  });
+  for (int i = 0; i < elements; i++) {
+    ASSERT_EQ(i, queue.pop());
+  }
+  producer.join();
+  ASSERT_EQ(0U, queue.size());
+}
+
+TEST(cta_threading, BlockingRingQueue_mpsc) {
+  cta::threading::BlockingRingQueue<uint64_t> queue(8);
+  const uint64_t producers = 4;
+  const uint64_t elementsPerProducer = 50000;
+  std::vector<std::thread> threads;
+  for (uint64_t p = 0; p < producers; p++) {
+    threads.emplace_back([&queue, p]() {
+      for (uint64_t i = 1; i <= elementsPerProducer; i++) queue.push(p * elementsPerProducer + i);
+    });
+  }
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < producers * elementsPerProducer; i++) sum += queue.pop();
+  for (auto & t: threads) t.join();
+  const uint64_t n = producers * elementsPerProducer;
+  ASSERT_EQ(n * (n + 1) / 2, sum);
+  uint64_t v;
+  ASSERT_FALSE(queue.tryPop(v));
+}
+
+TEST(cta_threading, BlockingRingQueue_popGetSize) {
+  cta::threading::BlockingRingQueue<int> queue(10);
+  queue.push(1);
+  queue.push(2);
+  auto ret = queue.popGetSize();
+  ASSERT_EQ(1, ret.value);
+  ASSERT_EQ(1U, ret.remaining);
+  ret = queue.popGetSize();
+  ASSERT_EQ(2, ret.value);
+  ASSERT_EQ(0U, ret.remaining);
+}
+
+} // namespace unitTests
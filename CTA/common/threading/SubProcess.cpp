@@ -22,9 +22,13 @@
 #include <iostream>
 #include <sys/signal.h>
 #include <sys/wait.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <spawn.h>
+#include <algorithm>
+#include <chrono>
 
 namespace {
 class ScopedPosixSpawnFileActions{
@@ -75,6 +79,14 @@ m_childComplete(false) {
       "In Subprocess::Subprocess failed to create the stderr pipe");
   cta::exception::Errnum::throwOnNonZero(::pipe2(stdinPipe,O_NONBLOCK), 
       "In Subprocess::Subprocess failed to create the stdin pipe");
+  // The child gets blocking pipes: its output is not truncated when a pipe is
+  // full, wait() drains them.
+  cta::exception::Errnum::throwOnMinusOne(::fcntl(stdoutPipe[writeSide], F_SETFL, 0),
+      "In Subprocess::Subprocess failed to make the stdout pipe blocking");
+  cta::exception::Errnum::throwOnMinusOne(::fcntl(stderrPipe[writeSide], F_SETFL, 0),
+      "In Subprocess::Subprocess failed to make the stderr pipe blocking");
+  cta::exception::Errnum::throwOnMinusOne(::fcntl(stdinPipe[readSide], F_SETFL, 0),
+      "In Subprocess::Subprocess failed to make the stdin pipe blocking");
   // Prepare the actions to be taken on file descriptors
   ScopedPosixSpawnFileActions fileActions;
   // We will be the child process. Close the read sides of the pipes.
@@ -158,7 +170,60 @@ int SubProcess::killSignal() {
 }
 
 void SubProcess::wait() {
-  ::waitpid(m_child, &m_childStatus, 0);
+  drainOutputs(-1);
+  reap(-1);
+}
+
+bool SubProcess::wait(uint64_t timeoutMs) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+  // The child can close its outputs and still run: its exit is waited for within the same time.
+  if (drainOutputs(timeoutMs) && reap(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(
+      deadline - std::chrono::steady_clock::now()).count()))) {
+    return true;
+  }
+  this->kill(SIGKILL);
+  reap(-1);
+  return false;
+}
+
+bool SubProcess::drainOutputs(int64_t timeoutMs) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+  // The child is done writing when both pipes are closed on its side.
+  struct pollfd fds[2] = {{m_stdoutFd, POLLIN, 0}, {m_stderrFd, POLLIN, 0}};
+  std::string * outputs[2] = {&m_stdout, &m_stderr};
+  char buff[1000];
+  while (fds[0].fd >= 0 || fds[1].fd >= 0) {
+    int64_t remainingMs = -1;
+    if (timeoutMs >= 0) {
+      remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now()).count();
+      if (remainingMs <= 0) return false;
+    }
+    ::poll(fds, 2, (int)std::min<int64_t>(remainingMs, 1000));
+    for (size_t i = 0; i < 2; i++) {
+      if (fds[i].fd < 0 || !fds[i].revents) continue;
+      int rc = ::read(fds[i].fd, buff, sizeof(buff));
+      if (rc > 0) {
+        outputs[i]->append(buff, rc);
+      } else if (!rc || (errno != EAGAIN && errno != EINTR)) {
+        // Stop polling this pipe, reap() closes it.
+        fds[i].fd = -1;
+      }
+    }
+  }
+  return true;
+}
+
+bool SubProcess::reap(int64_t timeoutMs) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+  while (true) {
+    pid_t rc = ::waitpid(m_child, &m_childStatus, timeoutMs < 0 ? 0 : WNOHANG);
+    if (rc > 0 || (rc < 0 && errno != EINTR)) break;
+    if (!rc) {
+      if (std::chrono::steady_clock::now() >= deadline) return false;
+      ::usleep(10 * 1000);
+    }
+  }
   char buff[1000];
   int rc;
   while (0<(rc=::read(m_stdoutFd, buff, sizeof(buff)))) {
@@ -170,6 +235,7 @@ void SubProcess::wait() {
   }
   ::close(m_stderrFd);
   m_childComplete = true;
+  return true;
 }
 
 std::string SubProcess::stdout() {
@@ -187,7 +253,7 @@ std::string SubProcess::stderr() {
 SubProcess::~SubProcess() {
   if(!m_childComplete) {
     this->kill(SIGKILL);
-    this->wait();
+    reap(-1);
   }
 }
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <list>
+#include <stdint.h>
 #include <string>
 
 namespace cta { namespace threading {
@@ -30,6 +31,12 @@ public:
   SubProcess(const std::string & program, const std::list<std::string> &argv, const std::string & str = "");
   ~SubProcess();
   void wait(void);
+  /**
+   * Waits for the child at most timeoutMs milliseconds, collecting its output
+   * meanwhile. On timeout, the child is killed with SIGKILL.
+   * @return true if the child completed in time.
+   */
+  bool wait(uint64_t timeoutMs);
   std::string stdout();
   std::string stderr();
   void kill(int signal);
@@ -37,6 +44,18 @@ public:
   bool wasKilled();
   int killSignal();
 private:
+  /**
+   * Collects the output of the child until it closes its pipes.
+   * @param timeoutMs the maximum time to wait, negative for no limit.
+   * @return false on timeout.
+   */
+  bool drainOutputs(int64_t timeoutMs);
+  /**
+   * Waits for the child to exit and collects its remaining output.
+   * @param timeoutMs the maximum time to wait, negative for no limit.
+   * @return false on timeout, the child being left running.
+   */
+  bool reap(int64_t timeoutMs);
   int m_stdoutFd;
   int m_stderrFd;
   pid_t m_child;
@@ -33,7 +33,7 @@ namespace cta {
 namespace disk {
 
 DiskFileFactory::DiskFileFactory(const std::string & xrootPrivateKeyFile, uint16_t xrootTimeout,
-  cta::disk::RadosStriperPool & striperPool):
+  cta::disk::RadosStriperPool & striperPool, uint32_t xrootAsyncRequests):
   m_NoURLLocalFile("^(localhost:|)(/.*)$"),
   m_NoURLRemoteFile("^([^:]*:)(.*)$"),
   m_NoURLRadosStriperFile("^localhost:([^/]+)/(.*)$"),
@@ -43,6 +43,7 @@ DiskFileFactory::DiskFileFactory(const std::string & xrootPrivateKeyFile, uint16
   m_xrootPrivateKeyFile(xrootPrivateKeyFile),
   m_xrootPrivateKeyLoaded(false),
   m_xrootTimeout(xrootTimeout),
+  m_xrootAsyncRequests(xrootAsyncRequests),
   m_striperPool(striperPool) {}
 
 const CryptoPP::RSA::PrivateKey & DiskFileFactory::xrootPrivateKey() {
@@ -126,7 +127,7 @@ ReadFile * DiskFileFactory::createReadFile(const std::string& path) {
   // Xroot URL?
   regexResult = m_URLXrootFile.exec(path);
   if (regexResult.size()) {
-    return new XrootReadFile(regexResult[1], m_xrootTimeout);
+    return new XrootReadFile(regexResult[1], m_xrootTimeout, m_xrootAsyncRequests);
   }
   // radosStriper URL?
   regexResult = m_URLCephFile.exec(path);
@@ -171,7 +172,7 @@ WriteFile * DiskFileFactory::createWriteFile(const std::string& path) {
   // Xroot URL?
   regexResult = m_URLXrootFile.exec(path);
   if (regexResult.size()) {
-    return new XrootWriteFile(regexResult[1], m_xrootTimeout);
+    return new XrootWriteFile(regexResult[1], m_xrootTimeout, m_xrootAsyncRequests);
   }
   // radosStriper URL?
   regexResult = m_URLCephFile.exec(path);
@@ -205,6 +206,42 @@ WriteFile * DiskFileFactory::createWriteFile(const std::string& path) {
       std::string("In DiskFileFactory::createWriteFile failed to parse URL: ")+path);
 }
 
+//==============================================================================
+// READ FILE
+//==============================================================================
+namespace {
+  /**
+   * The default asynchronous read: the read is done when it is started.
+   */
+  class CompletedRead: public ReadFile::AsyncRead {
+  public:
+    explicit CompletedRead(size_t readSize): m_readSize(readSize) {}
+    size_t wait() override { return m_readSize; }
+  private:
+    const size_t m_readSize;
+  };
+
+  /**
+   * The default asynchronous write: the write is done when it is started.
+   */
+  class CompletedWrite: public WriteFile::AsyncWrite {
+  public:
+    void wait() override {}
+  };
+}
+
+std::unique_ptr<ReadFile::AsyncRead> ReadFile::asyncRead(void *data, const size_t size) const {
+  return std::unique_ptr<AsyncRead>(new CompletedRead(read(data, size)));
+}
+
+//==============================================================================
+// WRITE FILE
+//==============================================================================
+std::unique_ptr<WriteFile::AsyncWrite> WriteFile::asyncWrite(const void *data, const size_t size) {
+  write(data, size);
+  return std::unique_ptr<AsyncWrite>(new CompletedWrite());
+}
+
 //==============================================================================
 // LOCAL READ FILE
 //==============================================================================  
@@ -356,8 +393,8 @@ XrootC2FSReadFile::XrootC2FSReadFile(const std::string &url,
     +m_URL+" opaqueBlock="+opaqueBloc.str());
 }
 
-XrootReadFile::XrootReadFile(const std::string &xrootUrl, uint16_t timeout):
-  XrootBaseReadFile(timeout) {
+XrootReadFile::XrootReadFile(const std::string &xrootUrl, uint16_t timeout, uint32_t maxAsyncRequests):
+  XrootBaseReadFile(timeout, maxAsyncRequests) {
   // Setup parent's variables
   m_readPosition = 0;
   m_URL = xrootUrl;
@@ -376,6 +413,49 @@ size_t XrootBaseReadFile::read(void *data, const size_t size) const {
   return ret;
 }
 
+std::unique_ptr<ReadFile::AsyncRead> XrootBaseReadFile::asyncRead(void *data, const size_t size) const {
+  std::unique_ptr<XrootAsyncRead> ret(new XrootAsyncRead(m_URL));
+  // The read position moves by the requested size: only the last read of the
+  // file can be short.
+  XrdCl::XRootDStatus status = m_xrootFile.Read(m_readPosition, size, data, &ret->m_responseHandler, m_timeout);
+  try {
+    XrootClEx::throwOnError(status,
+      std::string("In XrootReadFile::asyncRead failed XrdCl::File::Read() on ")+m_URL);
+  } catch (cta::exception::Exception &) {
+    // The response handler will not be called.
+    ret->m_responseHandler.m_readPromise.set_exception(std::current_exception());
+  }
+  m_readPosition += size;
+  return std::move(ret);
+}
+
+XrootBaseReadFile::XrootAsyncRead::XrootAsyncRead(const std::string & URL):
+  m_responseHandler(URL), m_readFuture(m_responseHandler.m_readPromise.get_future()) {}
+
+size_t XrootBaseReadFile::XrootAsyncRead::wait() {
+  return m_readFuture.get();
+}
+
+XrootBaseReadFile::XrootAsyncRead::~XrootAsyncRead() {
+  // XrdCl could still write to the buffer if we did not wait for the response.
+  if (m_readFuture.valid()) m_readFuture.wait();
+}
+
+void XrootBaseReadFile::XrootAsyncRead::ReadResponseHandler::HandleResponse(XrdCl::XRootDStatus *status,
+    XrdCl::AnyObject *response) {
+  try {
+    std::unique_ptr<XrdCl::XRootDStatus> statusPtr(status);
+    std::unique_ptr<XrdCl::AnyObject> responsePtr(response);
+    XrootClEx::throwOnError(*status,
+      std::string("In XrootReadFile::asyncRead failed XrdCl::File::Read() on ")+m_URL);
+    XrdCl::ChunkInfo *chunk = nullptr;
+    response->Get(chunk);
+    m_readPromise.set_value(chunk->length);
+  } catch (...) {
+    m_readPromise.set_exception(std::current_exception());
+  }
+}
+
 size_t XrootBaseReadFile::size() const {
   const bool forceStat=true;
   XrdCl::StatInfo *statInfo(NULL);
@@ -457,8 +537,8 @@ XrootC2FSWriteFile::XrootC2FSWriteFile(const std::string &url,
     +m_URL);
 }
 
-XrootWriteFile::XrootWriteFile(const std::string& xrootUrl, uint16_t timeout):
-  XrootBaseWriteFile(timeout) {
+XrootWriteFile::XrootWriteFile(const std::string& xrootUrl, uint16_t timeout, uint32_t maxAsyncRequests):
+  XrootBaseWriteFile(timeout, maxAsyncRequests) {
   // Setup parent's variables
   m_URL = xrootUrl;
   // and simply open
@@ -476,6 +556,45 @@ void XrootBaseWriteFile::write(const void *data, const size_t size)  {
   m_writePosition += size;
 }
 
+std::unique_ptr<WriteFile::AsyncWrite> XrootBaseWriteFile::asyncWrite(const void *data, const size_t size) {
+  std::unique_ptr<XrootAsyncWrite> ret(new XrootAsyncWrite(m_URL));
+  XrdCl::XRootDStatus status = m_xrootFile.Write(m_writePosition, size, data, &ret->m_responseHandler, m_timeout);
+  try {
+    XrootClEx::throwOnError(status,
+      std::string("In XrootWriteFile::asyncWrite failed XrdCl::File::Write() on ")+m_URL);
+  } catch (cta::exception::Exception &) {
+    // The response handler will not be called.
+    ret->m_responseHandler.m_writePromise.set_exception(std::current_exception());
+  }
+  m_writePosition += size;
+  return std::move(ret);
+}
+
+XrootBaseWriteFile::XrootAsyncWrite::XrootAsyncWrite(const std::string & URL):
+  m_responseHandler(URL), m_writeFuture(m_responseHandler.m_writePromise.get_future()) {}
+
+void XrootBaseWriteFile::XrootAsyncWrite::wait() {
+  m_writeFuture.get();
+}
+
+XrootBaseWriteFile::XrootAsyncWrite::~XrootAsyncWrite() {
+  // XrdCl could still read from the buffer if we did not wait for the response.
+  if (m_writeFuture.valid()) m_writeFuture.wait();
+}
+
+void XrootBaseWriteFile::XrootAsyncWrite::WriteResponseHandler::HandleResponse(XrdCl::XRootDStatus *status,
+    XrdCl::AnyObject *response) {
+  try {
+    std::unique_ptr<XrdCl::XRootDStatus> statusPtr(status);
+    std::unique_ptr<XrdCl::AnyObject> responsePtr(response);
+    XrootClEx::throwOnError(*status,
+      std::string("In XrootWriteFile::asyncWrite failed XrdCl::File::Write() on ")+m_URL);
+    m_writePromise.set_value();
+  } catch (...) {
+    m_writePromise.set_exception(std::current_exception());
+  }
+}
+
 void XrootBaseWriteFile::setChecksum(uint32_t checksum) {
   // Noop: this is only implemented for rados striper
 }
@@ -53,9 +53,11 @@ namespace cta {
         typedef cta::utils::Regex Regex;
       public:
         DiskFileFactory(const std::string & xrootPrivateKey, uint16_t xrootTimeout, 
-          cta::disk::RadosStriperPool & striperPool);
-        ReadFile * createReadFile(const std::string & path);
-        WriteFile * createWriteFile(const std::string & path);
+          cta::disk::RadosStriperPool & striperPool, uint32_t xrootAsyncRequests = 1);
+        virtual ~DiskFileFactory() {}
+        /** Virtual so that the unit tests can provide their own files */
+        virtual ReadFile * createReadFile(const std::string & path);
+        virtual WriteFile * createWriteFile(const std::string & path);
       private:
         Regex m_NoURLLocalFile;
         Regex m_NoURLRemoteFile;
@@ -67,6 +69,7 @@ namespace cta {
         CryptoPP::RSA::PrivateKey m_xrootPrivateKey;
         bool m_xrootPrivateKeyLoaded;
         const uint16_t m_xrootTimeout;
+        const uint32_t m_xrootAsyncRequests;
         cta::disk::RadosStriperPool & m_striperPool;
         
       public:
@@ -90,6 +93,36 @@ namespace cta {
          */
         virtual size_t read(void *data, const size_t size) const = 0;
         
+        /**
+         * A read started by asyncRead(). The destructor waits for the read
+         * to complete.
+         */
+        class AsyncRead {
+        public:
+          /**
+           * Waits for the read to complete.
+           * @return The amount of data actually copied. Zero at end of file.
+           */
+          virtual size_t wait() = 0;
+          virtual ~AsyncRead() {}
+        };
+        
+        /**
+         * Starts reading data from the file. Successive reads get successive
+         * parts of the file, but can complete in any order. The default
+         * implementation reads synchronously.
+         * @param data: pointer to the data buffer, not to be used before the
+         * read completes
+         * @param size: size of the buffer
+         * @return The read in flight.
+         */
+        virtual std::unique_ptr<AsyncRead> asyncRead(void *data, const size_t size) const;
+        
+        /**
+         * The number of reads worth keeping in flight for this file.
+         */
+        virtual size_t maxAsyncRequests() const { return 1; }
+        
         /**
          * Destructor of the ReadFile class. It closes the corresponding file descriptor.
          */
@@ -116,6 +149,35 @@ namespace cta {
          */
         virtual void write(const void *data, const size_t size) = 0;
         
+        /**
+         * A write started by asyncWrite(). The destructor waits for the write
+         * to complete.
+         */
+        class AsyncWrite {
+        public:
+          /**
+           * Waits for the write to complete. Throws if it failed.
+           */
+          virtual void wait() = 0;
+          virtual ~AsyncWrite() {}
+        };
+        
+        /**
+         * Starts writing a block of data after the ones already written. The
+         * writes can complete in any order. The default implementation writes
+         * synchronously.
+         * @param data: buffer to copy the data from, not to be modified before
+         * the write completes
+         * @param size: size of the buffer
+         * @return The write in flight.
+         */
+        virtual std::unique_ptr<AsyncWrite> asyncWrite(const void *data, const size_t size);
+        
+        /**
+         * The number of writes worth keeping in flight for this file.
+         */
+        virtual size_t maxAsyncRequests() const { return 1; }
+        
         /**
          * Set the checksum as an extended attribute (only needed for Ceph storage).
          */
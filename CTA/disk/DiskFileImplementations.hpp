@@ -74,9 +74,12 @@ namespace cta {
       //==============================================================================  
       class XrootBaseReadFile: public ReadFile {
       public:
-        XrootBaseReadFile(uint16_t timeout): m_timeout(timeout) {}
+        XrootBaseReadFile(uint16_t timeout, uint32_t maxAsyncRequests = 1):
+          m_timeout(timeout), m_maxAsyncRequests(maxAsyncRequests) {}
         virtual size_t size() const;
         virtual size_t read(void *data, const size_t size) const;
+        std::unique_ptr<AsyncRead> asyncRead(void *data, const size_t size) const override;
+        size_t maxAsyncRequests() const override { return m_maxAsyncRequests; }
         virtual ~XrootBaseReadFile() throw();
       protected:
         // Access to parent's protected member...
@@ -85,12 +88,32 @@ namespace cta {
         mutable XrdCl::File m_xrootFile;
         mutable uint64_t m_readPosition;
         const uint16_t m_timeout;
+        const uint32_t m_maxAsyncRequests;
         typedef cta::exception::XrootCl XrootClEx;
+        /**
+         * A read sent with XrdCl::File::Read(), completed by its response handler
+         */
+        class XrootAsyncRead: public AsyncRead {
+        public:
+          XrootAsyncRead(const std::string & URL);
+          size_t wait() override;
+          ~XrootAsyncRead();
+          class ReadResponseHandler: public XrdCl::ResponseHandler {
+          public:
+            ReadResponseHandler(const std::string & URL): m_URL(URL) {}
+            void HandleResponse(XrdCl::XRootDStatus *status, XrdCl::AnyObject *response) override;
+            const std::string m_URL;
+            std::promise<size_t> m_readPromise;
+          };
+          ReadResponseHandler m_responseHandler;
+        private:
+          std::future<size_t> m_readFuture;
+        };
       };
       
       class XrootReadFile: public XrootBaseReadFile {
       public:
-        XrootReadFile(const std::string &xrootUrl, uint16_t timeout = 0);
+        XrootReadFile(const std::string &xrootUrl, uint16_t timeout = 0, uint32_t maxAsyncRequests = 1);
       };
       
       class XrootC2FSReadFile: public XrootBaseReadFile {
@@ -106,8 +129,11 @@ namespace cta {
       
       class XrootBaseWriteFile: public WriteFile {
       public:
-        XrootBaseWriteFile(uint16_t timeout): m_writePosition(0), m_timeout(timeout), m_closeTried(false) {}
+        XrootBaseWriteFile(uint16_t timeout, uint32_t maxAsyncRequests = 1): m_writePosition(0), m_timeout(timeout),
+          m_maxAsyncRequests(maxAsyncRequests), m_closeTried(false) {}
         virtual void write(const void *data, const size_t size);
+        std::unique_ptr<AsyncWrite> asyncWrite(const void *data, const size_t size) override;
+        size_t maxAsyncRequests() const override { return m_maxAsyncRequests; }
         virtual void setChecksum(uint32_t checksum);
         virtual void close();
         virtual ~XrootBaseWriteFile() throw();        
@@ -117,13 +143,33 @@ namespace cta {
         XrdCl::File m_xrootFile;
         uint64_t m_writePosition;
         const uint16_t m_timeout;
+        const uint32_t m_maxAsyncRequests;
         typedef cta::exception::XrootCl XrootClEx;
         bool m_closeTried;      
+        /**
+         * A write sent with XrdCl::File::Write(), completed by its response handler
+         */
+        class XrootAsyncWrite: public AsyncWrite {
+        public:
+          XrootAsyncWrite(const std::string & URL);
+          void wait() override;
+          ~XrootAsyncWrite();
+          class WriteResponseHandler: public XrdCl::ResponseHandler {
+          public:
+            WriteResponseHandler(const std::string & URL): m_URL(URL) {}
+            void HandleResponse(XrdCl::XRootDStatus *status, XrdCl::AnyObject *response) override;
+            const std::string m_URL;
+            std::promise<void> m_writePromise;
+          };
+          WriteResponseHandler m_responseHandler;
+        private:
+          std::future<void> m_writeFuture;
+        };
       };
       
       class XrootWriteFile: public XrootBaseWriteFile {
       public:
-        XrootWriteFile(const std::string &xrootUrl, uint16_t timeout = 0);
+        XrootWriteFile(const std::string &xrootUrl, uint16_t timeout = 0, uint32_t maxAsyncRequests = 1);
       };
       
       class XrootC2FSWriteFile: public XrootBaseWriteFile {
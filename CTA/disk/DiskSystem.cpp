@@ -24,6 +24,14 @@
 #include "common/utils/utils.hpp"
 #include "JSONFreeSpace.hpp"
 #include "common/json/object/JSONObjectException.hpp"
+#include "common/SmartFd.hpp"
+#include "common/Timer.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace cta {
 namespace disk {
@@ -73,79 +81,355 @@ std::string DiskSystemList::getFetchEosFreeSpaceScript() const{
   return m_fetchEosFreeSpaceScript;
 }
 
+//------------------------------------------------------------------------------
+// DiskSystemList::setFreeSpaceCacheFile()
+//------------------------------------------------------------------------------
+void DiskSystemList::setFreeSpaceCacheFile(const std::string& path){
+  m_freeSpaceCacheFile = path;
+}
+
+//------------------------------------------------------------------------------
+// DiskSystemList::getFreeSpaceCacheFile()
+//------------------------------------------------------------------------------
+std::string DiskSystemList::getFreeSpaceCacheFile() const{
+  return m_freeSpaceCacheFile;
+}
+
 //------------------------------------------------------------------------------
 // DiskSystemFreeSpaceList::fetchFileSystemFreeSpace()
 //------------------------------------------------------------------------------
 void DiskSystemFreeSpaceList::fetchDiskSystemFreeSpace(const std::set<std::string>& diskSystems, log::LogContext & lc) {
+  // Check the disk systems exist before querying anything.
+  for (auto const & ds: diskSystems) m_systemList.at(ds);
+  //Key = diskSystemName, Value = failureReason
+  std::map<std::string, cta::exception::Exception> failedToFetchDiskSystems;
+  std::set<std::string> staleDiskSystems = diskSystems;
+  removeFreshDiskSystems(staleDiskSystems, failedToFetchDiskSystems);
+  const std::string & cacheFile = m_systemList.getFreeSpaceCacheFile();
+  cta::SmartFd cacheFd;
+  auto openCacheFile = [&]() {
+    cacheFd.reset(::open(cacheFile.c_str(), O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0644));
+    if (-1 == cacheFd.get()) {
+      cta::log::ScopedParamContainer spc(lc);
+      spc.add("freeSpaceCacheFile", cacheFile)
+         .add("errorMessage", utils::errnoToString(errno));
+      lc.log(log::WARNING, "In DiskSystemFreeSpaceList::fetchDiskSystemFreeSpace(): failed to open the free space cache file, "
+          "querying the disk systems directly.");
+    }
+  };
+  if (staleDiskSystems.size() && !cacheFile.empty()) openCacheFile();
+  while (staleDiskSystems.size()) {
+    if (-1 == cacheFd.get()) {
+      queryDiskSystemsFreeSpace(staleDiskSystems, failedToFetchDiskSystems, lc);
+      break;
+    }
+    // The file is replaced as a whole when written: it can be read without holding the lock.
+    readFreeSpaceCacheFile(cacheFd.get());
+    removeFreshDiskSystems(staleDiskSystems, failedToFetchDiskSystems);
+    if (staleDiskSystems.empty()) break;
+    if (::flock(cacheFd.get(), LOCK_EX | LOCK_NB)) {
+      if (EWOULDBLOCK != errno) {
+        exception::Errnum::throwOnMinusOne(-1,
+            "In DiskSystemFreeSpaceList::fetchDiskSystemFreeSpace(): failed to flock() the free space cache file");
+      }
+      // Another process is refreshing the disk systems: rather than waiting for it, use the values fetched before
+      // and only query the disk systems which have none.
+      for (auto ds = staleDiskSystems.begin(); ds != staleDiskSystems.end(); ) {
+        if (count(*ds)) ds = staleDiskSystems.erase(ds);
+        else ds++;
+      }
+      queryDiskSystemsFreeSpace(staleDiskSystems, failedToFetchDiskSystems, lc);
+      break;
+    }
+    // The file could have been replaced by another process between our open and our lock: the lock is then held on
+    // the old file, so start again with the new one.
+    struct stat fdStat, pathStat;
+    exception::Errnum::throwOnMinusOne(::fstat(cacheFd.get(), &fdStat),
+        "In DiskSystemFreeSpaceList::fetchDiskSystemFreeSpace(): failed to stat the free space cache file");
+    if (::stat(cacheFile.c_str(), &pathStat) || fdStat.st_dev != pathStat.st_dev || fdStat.st_ino != pathStat.st_ino) {
+      openCacheFile();
+      continue;
+    }
+    queryDiskSystemsFreeSpace(staleDiskSystems, failedToFetchDiskSystems, lc);
+    try {
+      writeFreeSpaceCacheFile();
+    } catch (exception::Exception & ex) {
+      cta::log::ScopedParamContainer spc(lc);
+      spc.add("freeSpaceCacheFile", cacheFile)
+         .add("exceptionMessage", ex.getMessageValue());
+      lc.log(log::WARNING, "In DiskSystemFreeSpaceList::fetchDiskSystemFreeSpace(): failed to write the free space cache file.");
+    }
+    // Closing the file releases the lock.
+    break;
+  }
+  if(failedToFetchDiskSystems.size()){
+    cta::disk::DiskSystemFreeSpaceListException ex;
+    ex.m_failedDiskSystems = failedToFetchDiskSystems;
+    throw ex;
+  }
+}
+
+//------------------------------------------------------------------------------
+// DiskSystemFreeSpaceList::removeFreshDiskSystems()
+//------------------------------------------------------------------------------
+void DiskSystemFreeSpaceList::removeFreshDiskSystems(std::set<std::string>& diskSystems,
+    std::map<std::string, cta::exception::Exception>& failedToFetchDiskSystems) {
+  const time_t now = ::time(nullptr);
+  for (auto ds = diskSystems.begin(); ds != diskSystems.end(); ) {
+    const DiskSystem & diskSystem = m_systemList.at(*ds);
+    auto entry = find(*ds);
+    auto failure = m_failedFetches.find(*ds);
+    if (entry != end() && entry->second.fetchTime + (time_t)diskSystem.refreshInterval > now) {
+      // The targeted free space could have been changed since the fetch.
+      entry->second.targetedFreeSpace = diskSystem.targetedFreeSpace;
+      ds = diskSystems.erase(ds);
+    } else if (failure != m_failedFetches.end() &&
+        failure->second.fetchTime + (time_t)std::max(diskSystem.refreshInterval, diskSystem.sleepTime) > now) {
+      // The disk system failed to answer recently: do not wait for it again before its sleep time.
+      std::ostringstream reason;
+      reason << "In DiskSystemFreeSpaceList::removeFreshDiskSystems(): the free space query failed " << now - failure->second.fetchTime
+             << "s ago: " << failure->second.reason;
+      failedToFetchDiskSystems[*ds] = cta::disk::FetchEosFreeSpaceException(reason.str());
+      ds = diskSystems.erase(ds);
+    } else {
+      ds++;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// DiskSystemFreeSpaceList::queryDiskSystemsFreeSpace()
+//------------------------------------------------------------------------------
+void DiskSystemFreeSpaceList::queryDiskSystemsFreeSpace(const std::set<std::string>& diskSystems,
+    std::map<std::string, cta::exception::Exception>& failedToFetchDiskSystems, log::LogContext& lc) {
   // The real deal: go fetch the file system's free space.
   cta::utils::Regex eosDiskSystem("^eos:(.*):(.*)$");
   // For testing purposes
   cta::utils::Regex constantFreeSpaceDiskSystem("^constantFreeSpace:(.*)");
-  //Key = diskSystemName, Value = failureReason
-  std::map<std::string, cta::exception::Exception> failedToFetchDiskSystems;
+  auto setFreeSpace = [this](const std::string & ds, uint64_t freeSpace) {
+    DiskSystemFreeSpace & entry = operator [](ds);
+    entry.freeSpace = freeSpace;
+    entry.fetchTime = ::time(nullptr);
+    entry.targetedFreeSpace = m_systemList.at(ds).targetedFreeSpace;
+    m_failedFetches.erase(ds);
+  };
+  auto setFailure = [this, &failedToFetchDiskSystems](const std::string & ds, const cta::exception::Exception & ex) {
+    failedToFetchDiskSystems[ds] = ex;
+    m_failedFetches[ds] = {::time(nullptr), ex.getMessageValue()};
+  };
+  // All the queries share the same time budget, the fallbacks included.
+  cta::utils::Timer t;
+  auto remainingMs = [&t]() -> uint64_t {
+    const int64_t elapsedMs = t.usecs() / 1000;
+    return elapsedMs < (int64_t)c_freeSpaceQueryTimeoutMs ? c_freeSpaceQueryTimeoutMs - elapsedMs : 0;
+  };
+  // Start the queries of all the disk systems, then collect their results.
+  struct EosQuery {
+    std::string diskSystem;
+    std::string instanceAddress;
+    std::string spaceName;
+    std::unique_ptr<threading::SubProcess> script;
+    std::unique_ptr<threading::SubProcess> eos;
+  };
+  std::list<EosQuery> eosQueries;
+  const std::string scriptPath = m_systemList.getFetchEosFreeSpaceScript();
   for (auto const & ds: diskSystems) {
-    uint64_t freeSpace = 0;
     try {
-      std::vector<std::string> regexResult;
       auto & currentDiskSystem = m_systemList.at(ds);
-      regexResult = eosDiskSystem.exec(currentDiskSystem.freeSpaceQueryURL);
+      std::vector<std::string> regexResult = eosDiskSystem.exec(currentDiskSystem.freeSpaceQueryURL);
       if (regexResult.size()) {
+        eosQueries.push_back({ds, regexResult.at(1), regexResult.at(2), nullptr, nullptr});
         //Script, then EOS free space query
-        if(!m_systemList.getFetchEosFreeSpaceScript().empty()){
-          //Script is provided
+        if (!scriptPath.empty()) {
           try {
             cta::disk::JSONDiskSystem jsoncDiskSystem(currentDiskSystem);
-            freeSpace = fetchEosFreeSpaceWithScript(m_systemList.getFetchEosFreeSpaceScript(),jsoncDiskSystem.getJSON(),lc);
-            goto found;
-          } catch(const cta::disk::FetchEosFreeSpaceScriptException &ex){
+            eosQueries.back().script = startEosFreeSpaceScript(scriptPath, jsoncDiskSystem.getJSON());
+            continue;
+          } catch (const cta::disk::FetchEosFreeSpaceScriptException &ex) {
             cta::log::ScopedParamContainer spc(lc);
             spc.add("exceptionMsg",ex.getMessageValue());
-            std::string errorMsg = "In DiskSystemFreeSpaceList::fetchDiskSystemFreeSpace(), unable to get the EOS free space with the script " 
-                    + m_systemList.getFetchEosFreeSpaceScript() + ". Will run eos space ls -m to fetch the free space for backpressure";
-            lc.log(cta::log::INFO,errorMsg);
+            lc.log(cta::log::INFO, "In DiskSystemFreeSpaceList::queryDiskSystemsFreeSpace(), unable to start the script " +
+                scriptPath + ". Will run eos space ls -m to fetch the free space for backpressure");
           }
         }
-        freeSpace = fetchEosFreeSpace(regexResult.at(1), regexResult.at(2), lc);
-        goto found;
-      } 
-      regexResult = constantFreeSpaceDiskSystem.exec(m_systemList.at(ds).freeSpaceQueryURL);
+        eosQueries.back().eos = startEosFreeSpaceQuery(regexResult.at(1));
+        continue;
+      }
+      regexResult = constantFreeSpaceDiskSystem.exec(currentDiskSystem.freeSpaceQueryURL);
       if (regexResult.size()) {
-        freeSpace = fetchConstantFreeSpace(regexResult.at(1), lc);
-        goto found;
+        setFreeSpace(ds, fetchConstantFreeSpace(regexResult.at(1), lc));
+        continue;
       }
-      throw cta::disk::FetchEosFreeSpaceException("In DiskSystemFreeSpaceList::fetchDiskSystemFreeSpace(): could not interpret free space query URL.");
+      throw cta::disk::FetchEosFreeSpaceException("In DiskSystemFreeSpaceList::queryDiskSystemsFreeSpace(): could not interpret free space query URL.");
     } catch (const cta::disk::FetchEosFreeSpaceException &ex) {
-      failedToFetchDiskSystems[ds] = ex;
+      setFailure(ds, ex);
     }
-  found:
-    DiskSystemFreeSpace & entry = operator [](ds);
-    entry.freeSpace = freeSpace;
-    entry.fetchTime = ::time(nullptr);
-    entry.targetedFreeSpace = m_systemList.at(ds).targetedFreeSpace;
   }
-  if(failedToFetchDiskSystems.size()){
-    cta::disk::DiskSystemFreeSpaceListException ex;
-    ex.m_failedDiskSystems = failedToFetchDiskSystems;
-    throw ex;
+  // Collect the scripts, and fall back to eos space ls -m for the failed ones if there is time left.
+  for (auto & q: eosQueries) {
+    if (!q.script) continue;
+    try {
+      setFreeSpace(q.diskSystem, getEosFreeSpaceFromScript(*q.script, scriptPath, remainingMs(), lc));
+      continue;
+    } catch (const cta::disk::FetchEosFreeSpaceScriptException &ex) {
+      if (!remainingMs()) {
+        setFailure(q.diskSystem, cta::disk::FetchEosFreeSpaceException(ex.getMessageValue()));
+        continue;
+      }
+      cta::log::ScopedParamContainer spc(lc);
+      spc.add("exceptionMsg",ex.getMessageValue());
+      std::string errorMsg = "In DiskSystemFreeSpaceList::queryDiskSystemsFreeSpace(), unable to get the EOS free space with the script "
+              + scriptPath + ". Will run eos space ls -m to fetch the free space for backpressure";
+      lc.log(cta::log::INFO,errorMsg);
+    }
+    try {
+      q.eos = startEosFreeSpaceQuery(q.instanceAddress);
+    } catch (const cta::disk::FetchEosFreeSpaceException &ex) {
+      setFailure(q.diskSystem, ex);
+    }
+  }
+  for (auto & q: eosQueries) {
+    if (!q.eos) continue;
+    try {
+      setFreeSpace(q.diskSystem, getEosFreeSpace(*q.eos, q.instanceAddress, q.spaceName, remainingMs(), lc));
+    } catch (const cta::disk::FetchEosFreeSpaceException &ex) {
+      setFailure(q.diskSystem, ex);
+    }
   }
 }
 
 //------------------------------------------------------------------------------
-// DiskSystemFreeSpaceList::fetchFileSystemFreeSpace()
+// DiskSystemFreeSpaceList::readFreeSpaceCacheFile()
+//------------------------------------------------------------------------------
+void DiskSystemFreeSpaceList::readFreeSpaceCacheFile(int fd) {
+  // One line per disk system: fetch time, free space and name, separated by spaces. The free space of a failed query
+  // is replaced by "failed", and the name is followed by a tab and the failure reason.
+  std::string content;
+  char buff[4096];
+  ssize_t rc;
+  off_t offset = 0;
+  while (0 < (rc = ::pread(fd, buff, sizeof(buff), offset))) {
+    content.append(buff, rc);
+    offset += rc;
+  }
+  exception::Errnum::throwOnMinusOne(rc,
+      "In DiskSystemFreeSpaceList::readFreeSpaceCacheFile(): failed to read the free space cache file");
+  std::istringstream contentIss(content);
+  std::string line;
+  while (std::getline(contentIss, line)) {
+    std::istringstream lineIss(line);
+    time_t fetchTime;
+    std::string freeSpace;
+    std::string ds;
+    std::string reason;
+    lineIss >> fetchTime >> freeSpace;
+    lineIss.get();
+    const bool failed = (freeSpace == "failed");
+    if (failed) {
+      std::getline(lineIss, ds, '\t');
+      std::getline(lineIss, reason);
+    } else {
+      std::getline(lineIss, ds);
+    }
+    if (lineIss.fail() || ds.empty() || (!failed && !utils::isValidUInt(freeSpace))) continue;
+    // Ignore the disk systems we do not know.
+    const DiskSystem * diskSystem;
+    try {
+      diskSystem = &m_systemList.at(ds);
+    } catch (std::out_of_range &) {
+      continue;
+    }
+    // Keep the latest result, success or failure.
+    auto entry = find(ds);
+    if (entry != end() && entry->second.fetchTime >= fetchTime) continue;
+    auto failure = m_failedFetches.find(ds);
+    if (failure != m_failedFetches.end() && failure->second.fetchTime >= fetchTime) continue;
+    if (failed) {
+      m_failedFetches[ds] = {fetchTime, reason};
+      if (entry != end()) erase(entry);
+    } else {
+      DiskSystemFreeSpace & newEntry = operator [](ds);
+      newEntry.freeSpace = utils::toUint64(freeSpace);
+      newEntry.fetchTime = fetchTime;
+      newEntry.targetedFreeSpace = diskSystem->targetedFreeSpace;
+      if (failure != m_failedFetches.end()) m_failedFetches.erase(failure);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// DiskSystemFreeSpaceList::writeFreeSpaceCacheFile()
+//------------------------------------------------------------------------------
+void DiskSystemFreeSpaceList::writeFreeSpaceCacheFile() {
+  // We read the file before under the same lock: our entries include the ones of the other processes.
+  std::ostringstream content;
+  for (auto const & entry: *this) {
+    content << entry.second.fetchTime << " " << entry.second.freeSpace << " " << entry.first << "\n";
+  }
+  for (auto const & failure: m_failedFetches) {
+    std::string reason = failure.second.reason;
+    std::replace(reason.begin(), reason.end(), '\n', ' ');
+    content << failure.second.fetchTime << " failed " << failure.first << "\t" << reason << "\n";
+  }
+  const std::string contentStr = content.str();
+  // The new content is written to a temporary file which then replaces the cache file, so that the readers see either
+  // the old or the new content.
+  const std::string & cacheFile = m_systemList.getFreeSpaceCacheFile();
+  std::string tmpPath = cacheFile + ".XXXXXX";
+  cta::SmartFd tmpFd(::mkostemp(&tmpPath[0], O_CLOEXEC));
+  exception::Errnum::throwOnMinusOne(tmpFd.get(),
+      "In DiskSystemFreeSpaceList::writeFreeSpaceCacheFile(): failed to create the new free space cache file");
+  try {
+    exception::Errnum::throwOnMinusOne(::fchmod(tmpFd.get(), 0644),
+        "In DiskSystemFreeSpaceList::writeFreeSpaceCacheFile(): failed to chmod the new free space cache file");
+    size_t written = 0;
+    while (written < contentStr.size()) {
+      ssize_t rc = ::pwrite(tmpFd.get(), contentStr.data() + written, contentStr.size() - written, written);
+      exception::Errnum::throwOnMinusOne(rc,
+          "In DiskSystemFreeSpaceList::writeFreeSpaceCacheFile(): failed to write the new free space cache file");
+      written += rc;
+    }
+    exception::Errnum::throwOnMinusOne(::rename(tmpPath.c_str(), cacheFile.c_str()),
+        "In DiskSystemFreeSpaceList::writeFreeSpaceCacheFile(): failed to replace the free space cache file");
+  } catch (...) {
+    ::unlink(tmpPath.c_str());
+    throw;
+  }
+}
+
 //------------------------------------------------------------------------------
-uint64_t DiskSystemFreeSpaceList::fetchEosFreeSpace(const std::string& instanceAddress, const std::string &spaceName, log::LogContext & lc) {
-  threading::SubProcess sp("/usr/bin/eos", {"/usr/bin/eos", std::string("root://")+instanceAddress, "space", "ls", "-m"});
-  sp.wait();
+// DiskSystemFreeSpaceList::startEosFreeSpaceQuery()
+//------------------------------------------------------------------------------
+std::unique_ptr<threading::SubProcess> DiskSystemFreeSpaceList::startEosFreeSpaceQuery(const std::string& instanceAddress) {
+  try {
+    return std::unique_ptr<threading::SubProcess>(new threading::SubProcess("/usr/bin/eos",
+        {"/usr/bin/eos", std::string("root://")+instanceAddress, "space", "ls", "-m"}));
+  } catch (exception::Exception & ex) {
+    ex.getMessage() << " instanceAddress: " << instanceAddress;
+    throw cta::disk::FetchEosFreeSpaceException(ex.getMessage().str());
+  }
+}
+
+//------------------------------------------------------------------------------
+// DiskSystemFreeSpaceList::getEosFreeSpace()
+//------------------------------------------------------------------------------
+uint64_t DiskSystemFreeSpaceList::getEosFreeSpace(threading::SubProcess& sp, const std::string& instanceAddress,
+    const std::string &spaceName, uint64_t timeoutMs, log::LogContext & lc) {
+  if (!sp.wait(timeoutMs)) {
+    exception::Exception ex("In DiskSystemFreeSpaceList::getEosFreeSpace(): eos space ls -m did not complete within the ");
+    ex.getMessage() << c_freeSpaceQueryTimeoutMs << "ms given to the free space queries, instanceAddress: " << instanceAddress;
+    throw cta::disk::FetchEosFreeSpaceException(ex.getMessage().str());
+  }
   try {
     exception::Errnum::throwOnNonZero(sp.exitValue(),
-        std::string("In DiskSystemFreeSpaceList::fetchEosFreeSpace(), failed to call \"eos root://") + 
+        std::string("In DiskSystemFreeSpaceList::getEosFreeSpace(), failed to call \"eos root://") + 
         instanceAddress + " space ls -m\"");
   } catch (exception::Exception & ex) {
     ex.getMessage() << " instanceAddress: " << instanceAddress << " stderr: " << sp.stderr();
     throw cta::disk::FetchEosFreeSpaceException(ex.getMessage().str());
   }
   if (sp.wasKilled()) {
-    exception::Exception ex("In DiskSystemFreeSpaceList::fetchEosFreeSpace(): eos space ls -m killed by signal: ");
+    exception::Exception ex("In DiskSystemFreeSpaceList::getEosFreeSpace(): eos space ls -m killed by signal: ");
     ex.getMessage() << utils::toString(sp.killSignal());
     throw cta::disk::FetchEosFreeSpaceException(ex.getMessage().str());
   }
@@ -162,7 +446,7 @@ uint64_t DiskSystemFreeSpaceList::fetchEosFreeSpace(const std::string& instanceA
       goto spaceNameFound;
     }
   } while (!spStdoutIss.eof());
-  throw cta::disk::FetchEosFreeSpaceException("In DiskSystemFreeSpaceList::fetchEosFreeSpace(): could not find the \""+spaceName+"\" in the eos space ls -m result.");
+  throw cta::disk::FetchEosFreeSpaceException("In DiskSystemFreeSpaceList::getEosFreeSpace(): could not find the \""+spaceName+"\" in the eos space ls -m result.");
   
 spaceNameFound:
   // Look for the parameters in the result line.
@@ -170,7 +454,7 @@ spaceNameFound:
   auto rwSpaceRes = rwSpaceRegex.exec(defaultSpaceLine);
   if (rwSpaceRes.empty())
     throw cta::disk::FetchEosFreeSpaceException(
-        "In DiskSystemFreeSpaceList::fetchEosFreeSpace(): failed to parse parameter sum.stat.statfs.capacity?configstatus@rw.");
+        "In DiskSystemFreeSpaceList::getEosFreeSpace(): failed to parse parameter sum.stat.statfs.capacity?configstatus@rw.");
   return utils::toUint64(rwSpaceRes.at(1));
 }
 
@@ -182,20 +466,37 @@ uint64_t DiskSystemFreeSpaceList::fetchConstantFreeSpace(const std::string& inst
 }
 
 //------------------------------------------------------------------------------
-// DiskSystemFreeSpaceList::fetchEosFreeSpaceWithScript()
+// DiskSystemFreeSpaceList::startEosFreeSpaceScript()
+//------------------------------------------------------------------------------
+std::unique_ptr<threading::SubProcess> DiskSystemFreeSpaceList::startEosFreeSpaceScript(const std::string& scriptPath,
+    const std::string& jsonInput) {
+  try {
+    return std::unique_ptr<threading::SubProcess>(new threading::SubProcess(scriptPath, {scriptPath}, jsonInput));
+  } catch (exception::Exception & ex) {
+    ex.getMessage() << " scriptPath: " << scriptPath;
+    throw cta::disk::FetchEosFreeSpaceScriptException(ex.getMessage().str());
+  }
+}
+
+//------------------------------------------------------------------------------
+// DiskSystemFreeSpaceList::getEosFreeSpaceFromScript()
 //------------------------------------------------------------------------------
-uint64_t DiskSystemFreeSpaceList::fetchEosFreeSpaceWithScript(const std::string& scriptPath, const std::string& jsonInput, log::LogContext& lc){
-  cta::threading::SubProcess sp(scriptPath,{scriptPath},jsonInput);
-  sp.wait();
+uint64_t DiskSystemFreeSpaceList::getEosFreeSpaceFromScript(threading::SubProcess& sp, const std::string& scriptPath,
+    uint64_t timeoutMs, log::LogContext& lc){
+  if (!sp.wait(timeoutMs)) {
+    exception::Exception ex("In DiskSystemFreeSpaceList::getEosFreeSpaceFromScript(): " + scriptPath + " did not complete within the ");
+    ex.getMessage() << c_freeSpaceQueryTimeoutMs << "ms given to the free space queries";
+    throw cta::disk::FetchEosFreeSpaceScriptException(ex.getMessage().str());
+  }
   try {
-    std::string errMsg = "In DiskSystemFreeSpaceList::fetchEosFreeSpaceWithScript(), failed to call \"" + scriptPath;
+    std::string errMsg = "In DiskSystemFreeSpaceList::getEosFreeSpaceFromScript(), failed to call \"" + scriptPath;
     exception::Errnum::throwOnNonZero(sp.exitValue(),errMsg);
   } catch (exception::Exception & ex) {
     ex.getMessage() << " scriptPath: " << scriptPath << " stderr: " << sp.stderr();
     throw cta::disk::FetchEosFreeSpaceScriptException(ex.getMessage().str());
   }
   if (sp.wasKilled()) {
-    std::string errMsg = "In DiskSystemFreeSpaceList::fetchEosFreeSpaceWithScript(): " + scriptPath + " killed by signal: ";
+    std::string errMsg = "In DiskSystemFreeSpaceList::getEosFreeSpaceFromScript(): " + scriptPath + " killed by signal: ";
     exception::Exception ex(errMsg);
     ex.getMessage() << utils::toString(sp.killSignal());
     throw cta::disk::FetchEosFreeSpaceScriptException(ex.getMessage().str());
@@ -206,11 +507,11 @@ uint64_t DiskSystemFreeSpaceList::fetchEosFreeSpaceWithScript(const std::string&
   std::string stdoutScript = spStdoutIss.str();
   try {
     jsonFreeSpace.buildFromJSON(stdoutScript);
-    std::string logMessage = "In DiskSystemFreeSpaceList::fetchEosFreeSpaceWithScript(), freeSpace returned from the script is: " + std::to_string(jsonFreeSpace.m_freeSpace); 
+    std::string logMessage = "In DiskSystemFreeSpaceList::getEosFreeSpaceFromScript(), freeSpace returned from the script is: " + std::to_string(jsonFreeSpace.m_freeSpace); 
     lc.log(log::DEBUG,logMessage);
     return jsonFreeSpace.m_freeSpace;
   } catch(const cta::exception::JSONObjectException &ex){
-    std::string errMsg = "In DiskSystemFreeSpaceList::fetchEosFreeSpaceWithScript(): the json received from the script "+ scriptPath + 
+    std::string errMsg = "In DiskSystemFreeSpaceList::getEosFreeSpaceFromScript(): the json received from the script "+ scriptPath + 
             " json=" + stdoutScript + " could not be used to get the FreeSpace, the json to receive from the script should have the following format: " +
             jsonFreeSpace.getExpectedJSONToBuildObject() + ".";
     throw cta::disk::FetchEosFreeSpaceScriptException(errMsg);
@@ -22,10 +22,13 @@
 #include "common/log/LogContext.hpp"
 #include <string>
 #include <list>
+#include <memory>
 #include <set>
 #include <common/exception/Exception.hpp>
 
-namespace cta { namespace disk {
+namespace cta {
+namespace threading { class SubProcess; }
+namespace disk {
 
 /**
  * Description of a disk system as defined by operators.
@@ -68,6 +71,12 @@ public:
   /** Sets the fetch EOS free space script path. This script will be used by the backpressure */
   void setFetchEosFreeSpaceScript(const std::string & path);
   
+  /** Get the path of the file sharing the fetched free space between the processes of the host (empty for none) */
+  std::string getFreeSpaceCacheFile() const;
+  
+  /** Sets the path of the file sharing the fetched free space between the processes of the host */
+  void setFreeSpaceCacheFile(const std::string & path);
+  
 private:
   struct PointerAndRegex {
     PointerAndRegex(const DiskSystem & dsys, const std::string &re): ds(dsys), regex(re) {}
@@ -77,6 +86,7 @@ private:
   
   mutable std::list<PointerAndRegex> m_pointersAndRegexes;
   std::string m_fetchEosFreeSpaceScript;
+  std::string m_freeSpaceCacheFile;
   
 };
 
@@ -96,13 +106,47 @@ public:
 class DiskSystemFreeSpaceList: public std::map<std::string, DiskSystemFreeSpace> {
 public:
   DiskSystemFreeSpaceList(DiskSystemList &diskSystemList): m_systemList(diskSystemList) {}
+  /**
+   * Fetches the free space of the disk systems whose entry is older than their refresh interval. The disk systems
+   * are queried in parallel, and all the queries are given at most c_freeSpaceQueryTimeoutMs. A disk system whose
+   * query failed is not queried again before its sleep time (or its refresh interval if longer): it is reported as
+   * failed instead. When the disk system list has a free space cache file, the results obtained by any process of the
+   * host are reused, and only one process at a time queries the stale disk systems. The other processes do not wait
+   * for it: they use the previous values, or query the disk systems without one themselves.
+   * @throws DiskSystemFreeSpaceListException listing the disk systems that could not be queried.
+   */
   void fetchDiskSystemFreeSpace(const std::set<std::string> &diskSystems, log::LogContext & lc);
   const DiskSystemList &getDiskSystemList() { return m_systemList; }
+  static const uint64_t c_freeSpaceQueryTimeoutMs = 30000;
 private:
   DiskSystemList &m_systemList;
-  uint64_t fetchEosFreeSpace(const std::string & instanceAddress, const std::string & spaceName,log::LogContext & lc);
+  /** The last failed query of the disk systems without a more recent successful one */
+  struct FailedFetch {
+    time_t fetchTime;
+    std::string reason;
+  };
+  std::map<std::string, FailedFetch> m_failedFetches;
+  /**
+   * Removes the disk systems with an entry fetched less than a refresh interval ago, and the ones whose query failed
+   * less than a sleep time ago, which are added to the failed disk systems.
+   */
+  void removeFreshDiskSystems(std::set<std::string> &diskSystems,
+    std::map<std::string, cta::exception::Exception> &failedDiskSystems);
+  /** Queries the disk systems in parallel, filling the entries of the successful ones */
+  void queryDiskSystemsFreeSpace(const std::set<std::string> &diskSystems,
+    std::map<std::string, cta::exception::Exception> &failedDiskSystems, log::LogContext & lc);
+  /** Reads the entries and failures of the cache file, keeping the ones of known disk systems newer than ours */
+  void readFreeSpaceCacheFile(int fd);
+  /** Replaces the cache file with one holding our entries and failures */
+  void writeFreeSpaceCacheFile();
+  std::unique_ptr<threading::SubProcess> startEosFreeSpaceQuery(const std::string & instanceAddress);
+  uint64_t getEosFreeSpace(threading::SubProcess & query, const std::string & instanceAddress,
+    const std::string & spaceName, uint64_t timeoutMs, log::LogContext & lc);
   uint64_t fetchConstantFreeSpace(const std::string & instanceAddress, log::LogContext & lc);
-  uint64_t fetchEosFreeSpaceWithScript(const std::string & scriptPath, const std::string & jsonInput, log::LogContext &lc);
+  std::unique_ptr<threading::SubProcess> startEosFreeSpaceScript(const std::string & scriptPath,
+    const std::string & jsonInput);
+  uint64_t getEosFreeSpaceFromScript(threading::SubProcess & query, const std::string & scriptPath,
+    uint64_t timeoutMs, log::LogContext &lc);
 };
 
 }} // namespace cta::common
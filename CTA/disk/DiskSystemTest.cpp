@@ -21,6 +21,11 @@
 #include "catalogue/Catalogue.hpp"
 #include "catalogue/InMemoryCatalogue.hpp"
 
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <unistd.h>
+
 namespace unitTests {
   
   class DiskSystemTest: public ::testing::Test {
@@ -158,4 +163,127 @@ namespace unitTests {
     ASSERT_EQ(200,diskSystemFreeSpaceList.at(constantFreeSpaceDiskSystem.name).freeSpace);
 
   }
+  
+  TEST_F(DiskSystemTest, fetchDiskSystemFreeSpaceHonoursRefreshIntervalAndCacheFile) {
+    cta::log::LogContext lc(m_dummyLog);
+    char path[]="/tmp/testDiskSystemFreeSpaceCache-XXXXXX";
+    ::close(::mkstemp(path));
+    
+    cta::disk::DiskSystem constantFreeSpaceDiskSystem;
+    constantFreeSpaceDiskSystem.name = "ConstantFreeSpaceDiskSystem";
+    constantFreeSpaceDiskSystem.fileRegexp = "/home/test/buffer";
+    constantFreeSpaceDiskSystem.freeSpaceQueryURL = "constantFreeSpace:200";
+    constantFreeSpaceDiskSystem.refreshInterval = 3600;
+    constantFreeSpaceDiskSystem.targetedFreeSpace = 1;
+    constantFreeSpaceDiskSystem.sleepTime = 1;
+    constantFreeSpaceDiskSystem.comment = "Comment";
+    cta::disk::DiskSystemList diskSystemList {constantFreeSpaceDiskSystem};
+    diskSystemList.setFreeSpaceCacheFile(path);
+    const std::set<std::string> diskSystemsToFetch {constantFreeSpaceDiskSystem.name};
+    
+    cta::disk::DiskSystemFreeSpaceList diskSystemFreeSpaceList(diskSystemList);
+    diskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc);
+    ASSERT_EQ(200,diskSystemFreeSpaceList.at(constantFreeSpaceDiskSystem.name).freeSpace);
+    
+    // Within the refresh interval, the disk system is not queried again, neither for this list nor for the other
+    // lists sharing the cache file.
+    diskSystemList.front().freeSpaceQueryURL = "constantFreeSpace:300";
+    diskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc);
+    ASSERT_EQ(200,diskSystemFreeSpaceList.at(constantFreeSpaceDiskSystem.name).freeSpace);
+    cta::disk::DiskSystemFreeSpaceList sharingDiskSystemFreeSpaceList(diskSystemList);
+    sharingDiskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc);
+    ASSERT_EQ(200,sharingDiskSystemFreeSpaceList.at(constantFreeSpaceDiskSystem.name).freeSpace);
+    
+    cta::disk::DiskSystemList diskSystemListWithoutCache {diskSystemList.front()};
+    cta::disk::DiskSystemFreeSpaceList notSharingDiskSystemFreeSpaceList(diskSystemListWithoutCache);
+    notSharingDiskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc);
+    ASSERT_EQ(300,notSharingDiskSystemFreeSpaceList.at(constantFreeSpaceDiskSystem.name).freeSpace);
+    
+    // After the refresh interval, the disk system is queried again.
+    diskSystemList.front().refreshInterval = 0;
+    sharingDiskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc);
+    ASSERT_EQ(300,sharingDiskSystemFreeSpaceList.at(constantFreeSpaceDiskSystem.name).freeSpace);
+    ::unlink(path);
+  }
+  
+  TEST_F(DiskSystemTest, fetchDiskSystemFreeSpaceRemembersFailuresForTheSleepTime) {
+    cta::log::LogContext lc(m_dummyLog);
+    char path[]="/tmp/testDiskSystemFreeSpaceCache-XXXXXX";
+    ::close(::mkstemp(path));
+    
+    cta::disk::DiskSystem failingDiskSystem;
+    failingDiskSystem.name = "FailingDiskSystem";
+    failingDiskSystem.fileRegexp = "/home/test/buffer";
+    failingDiskSystem.freeSpaceQueryURL = "unknownQueryMethod:200";
+    failingDiskSystem.refreshInterval = 0;
+    failingDiskSystem.targetedFreeSpace = 1;
+    failingDiskSystem.sleepTime = 3600;
+    failingDiskSystem.comment = "Comment";
+    cta::disk::DiskSystemList diskSystemList {failingDiskSystem};
+    diskSystemList.setFreeSpaceCacheFile(path);
+    const std::set<std::string> diskSystemsToFetch {failingDiskSystem.name};
+    
+    cta::disk::DiskSystemFreeSpaceList diskSystemFreeSpaceList(diskSystemList);
+    ASSERT_THROW(diskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc),
+      cta::disk::DiskSystemFreeSpaceListException);
+    
+    // Within the sleep time, the failure is reported without querying the disk system, also to the lists sharing the
+    // cache file.
+    diskSystemList.front().freeSpaceQueryURL = "constantFreeSpace:200";
+    cta::disk::DiskSystemFreeSpaceList sharingDiskSystemFreeSpaceList(diskSystemList);
+    try {
+      sharingDiskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc);
+      FAIL() << "The failure of the previous query should have been reported";
+    } catch (const cta::disk::DiskSystemFreeSpaceListException& ex) {
+      ASSERT_EQ(1,ex.m_failedDiskSystems.count(failingDiskSystem.name));
+    }
+    
+    // After the sleep time, the disk system is queried again.
+    diskSystemList.front().sleepTime = 0;
+    sharingDiskSystemFreeSpaceList.fetchDiskSystemFreeSpace(diskSystemsToFetch,lc);
+    ASSERT_EQ(200,sharingDiskSystemFreeSpaceList.at(failingDiskSystem.name).freeSpace);
+    ::unlink(path);
+  }
+  
+  TEST_F(DiskSystemTest, fetchDiskSystemFreeSpaceDoesNotWaitForAnotherProcessRefreshing) {
+    cta::log::LogContext lc(m_dummyLog);
+    char path[]="/tmp/testDiskSystemFreeSpaceCache-XXXXXX";
+    ::close(::mkstemp(path));
+    
+    cta::disk::DiskSystem knownDiskSystem;
+    knownDiskSystem.name = "KnownDiskSystem";
+    knownDiskSystem.fileRegexp = "/home/test/buffer";
+    knownDiskSystem.freeSpaceQueryURL = "constantFreeSpace:200";
+    knownDiskSystem.refreshInterval = 3600;
+    knownDiskSystem.targetedFreeSpace = 1;
+    knownDiskSystem.sleepTime = 1;
+    knownDiskSystem.comment = "Comment";
+    cta::disk::DiskSystem newDiskSystem = knownDiskSystem;
+    newDiskSystem.name = "NewDiskSystem";
+    newDiskSystem.freeSpaceQueryURL = "constantFreeSpace:400";
+    cta::disk::DiskSystemList diskSystemList {knownDiskSystem, newDiskSystem};
+    diskSystemList.setFreeSpaceCacheFile(path);
+    
+    cta::disk::DiskSystemFreeSpaceList diskSystemFreeSpaceList(diskSystemList);
+    diskSystemFreeSpaceList.fetchDiskSystemFreeSpace({knownDiskSystem.name},lc);
+    
+    // Another process holds the lock while refreshing the (now stale) disk systems: the previous value is used, and the
+    // disk system without any value is queried directly.
+    diskSystemList.front().refreshInterval = 0;
+    diskSystemList.front().freeSpaceQueryURL = "constantFreeSpace:300";
+    int refreshingFd = ::open(path, O_RDWR);
+    ASSERT_NE(-1, refreshingFd);
+    ASSERT_EQ(0, ::flock(refreshingFd, LOCK_EX));
+    cta::disk::DiskSystemFreeSpaceList sharingDiskSystemFreeSpaceList(diskSystemList);
+    sharingDiskSystemFreeSpaceList.fetchDiskSystemFreeSpace({knownDiskSystem.name, newDiskSystem.name},lc);
+    ASSERT_EQ(200,sharingDiskSystemFreeSpaceList.at(knownDiskSystem.name).freeSpace);
+    ASSERT_EQ(400,sharingDiskSystemFreeSpaceList.at(newDiskSystem.name).freeSpace);
+    
+    // Once the lock is released, the stale disk system is refreshed.
+    ::close(refreshingFd);
+    cta::disk::DiskSystemFreeSpaceList refreshingDiskSystemFreeSpaceList(diskSystemList);
+    refreshingDiskSystemFreeSpaceList.fetchDiskSystemFreeSpace({knownDiskSystem.name},lc);
+    ASSERT_EQ(300,refreshingDiskSystemFreeSpaceList.at(knownDiskSystem.name).freeSpace);
+    ::unlink(path);
+  }
 }
@@ -16,6 +16,7 @@
  */
 
 #include "Agent.hpp"
+#include "AgentReference.hpp"
 #include "AgentRegister.hpp"
 #include "RootEntry.hpp"
 #include "GenericObject.hpp"
@@ -115,6 +116,12 @@ void cta::objectstore::Agent::removeAndUnregisterSelf(log::LogContext & lc) {
     }
     throw AgentStillOwnsObjects(exSs.str());
   }
+  // Delete the ownership journals (which are empty by now), including the ones
+  // which could have been left behind by the previous merges.
+  std::vector<std::string> journals(m_payload.ownershipjournals().begin(), m_payload.ownershipjournals().end());
+  journals.insert(journals.end(), m_payload.obsoleteownershipjournals().begin(),
+      m_payload.obsoleteownershipjournals().end());
+  if (journals.size()) m_objectStore.multiRemove(journals);
   // First delete ourselves
   remove();
   log::ScopedParamContainer params(lc);
@@ -135,6 +142,8 @@ void cta::objectstore::Agent::removeAndUnregisterSelf(log::LogContext & lc) {
 
 bool cta::objectstore::Agent::isEmpty() {
   checkPayloadReadable();
+  if (m_payload.ownershipjournals_size())
+    return getOwnershipSet().empty();
   if (m_payload.ownedobjects_size())
     return false;
   return true;
@@ -202,19 +211,102 @@ void cta::objectstore::Agent::garbageCollect(const std::string& presumedOwner, A
 
 void cta::objectstore::Agent::addToOwnership(std::string name) {
   checkPayloadWritable();
+  foldOwnershipJournals();
   std::string * owned = m_payload.mutable_ownedobjects()->Add();
   *owned = name;
 }
 
 void cta::objectstore::Agent::removeFromOwnership(std::string name) {
   checkPayloadWritable();
+  foldOwnershipJournals();
   serializers::removeString(m_payload.mutable_ownedobjects(), name);
 }
 
+std::string cta::objectstore::Agent::recordOwnershipDelta(const AgentOwnershipDelta& delta,
+    AgentReference& agentReference) {
+  checkPayloadWritable();
+  removeObsoleteOwnershipJournals();
+  if (delta.empty()) return "";
+  // Find the last journals to merge with the new one. The ownership list, if any
+  // (old agent or direct changes), is merged with all the journals into the first one.
+  size_t firstMerged = m_payload.ownershipjournals_size();
+  uint64_t mergedSize = delta.size();
+  if (m_payload.ownedobjects_size()) {
+    firstMerged = 0;
+  } else {
+    while (firstMerged && m_payload.ownershipjournalsizes(firstMerged - 1) <= c_ownershipJournalMergeFactor * mergedSize) {
+      firstMerged--;
+      mergedSize += m_payload.ownershipjournalsizes(firstMerged);
+    }
+  }
+  AgentOwnershipDelta mergedDelta;
+  for (const auto & oo: m_payload.ownedobjects()) mergedDelta.add(oo);
+  for (auto & j: fetchOwnershipJournals(firstMerged)) mergedDelta.append(j.getDelta());
+  mergedDelta.append(delta);
+  // Nothing is owned before the first journal: the removals are moot.
+  if (!firstMerged) mergedDelta.removedObjects.clear();
+  // Create the new journal before referencing it.
+  std::string journalAddress;
+  if (!mergedDelta.empty()) {
+    journalAddress = agentReference.nextId("AgentOwnershipJournal");
+    AgentOwnershipJournal journal(journalAddress, m_objectStore);
+    journal.initialize();
+    journal.setOwner(getAddressIfSet());
+    journal.setBackupOwner(getAddressIfSet());
+    journal.setDelta(mergedDelta);
+    journal.insert();
+  }
+  // The merged journals will be deleted once the agent is committed without them.
+  for (size_t i = firstMerged; i < (size_t)m_payload.ownershipjournals_size(); i++)
+    *m_payload.mutable_obsoleteownershipjournals()->Add() = m_payload.ownershipjournals(i);
+  m_payload.mutable_ownershipjournals()->DeleteSubrange(firstMerged, m_payload.ownershipjournals_size() - firstMerged);
+  m_payload.mutable_ownershipjournalsizes()->Truncate(firstMerged);
+  m_payload.mutable_ownedobjects()->Clear();
+  if (!mergedDelta.empty()) {
+    *m_payload.mutable_ownershipjournals()->Add() = journalAddress;
+    m_payload.mutable_ownershipjournalsizes()->Add(mergedDelta.size());
+  }
+  return journalAddress;
+}
+
+void cta::objectstore::Agent::foldOwnershipJournals() {
+  checkPayloadWritable();
+  if (!m_payload.ownershipjournals_size()) return;
+  resetOwnership(getOwnershipSet());
+}
+
+void cta::objectstore::Agent::removeObsoleteOwnershipJournals() {
+  checkPayloadWritable();
+  if (!m_payload.obsoleteownershipjournals_size()) return;
+  std::vector<std::string> journals(m_payload.obsoleteownershipjournals().begin(),
+      m_payload.obsoleteownershipjournals().end());
+  // The journals already deleted (before a failure to commit) are reported and ignored.
+  m_objectStore.multiRemove(journals);
+  m_payload.mutable_obsoleteownershipjournals()->Clear();
+}
+
+std::list<cta::objectstore::AgentOwnershipJournal> cta::objectstore::Agent::fetchOwnershipJournals(size_t first) {
+  checkPayloadReadable();
+  std::list<AgentOwnershipJournal> ret;
+  for (size_t i = first; i < (size_t)m_payload.ownershipjournals_size(); i++)
+    ret.emplace_back(m_payload.ownershipjournals(i), m_objectStore);
+  if (ret.empty()) return ret;
+  // The journals are never modified, so they can be fetched without lock, in a single batch.
+  auto fetchResults = AgentOwnershipJournal::multiLockfreeFetch(m_objectStore, ret);
+  for (auto & fr: fetchResults) {
+    if (fr) std::rethrow_exception(fr);
+  }
+  return ret;
+}
+
 std::list<std::string> 
   cta::objectstore::Agent::getOwnershipList() {
   checkPayloadReadable();
   std::list<std::string> ret;
+  if (m_payload.ownershipjournals_size()) {
+    for (auto & oo: getOwnershipSet()) ret.push_back(oo);
+    return ret;
+  }
   for (int i=0; i<m_payload.ownedobjects_size(); i++) {
     ret.push_back(m_payload.ownedobjects(i));
   }
@@ -226,11 +318,18 @@ std::set<std::string> cta::objectstore::Agent::getOwnershipSet() {
   std::set<std::string> ret;
   for (const auto &oo: m_payload.ownedobjects())
     ret.insert(oo);
+  for (auto & j: fetchOwnershipJournals())
+    j.getDelta().applyTo(ret);
   return ret;
 }
 
 void cta::objectstore::Agent::resetOwnership(const std::set<std::string>& ownershipSet) {
   checkPayloadWritable();
+  // The journals are superseded by the new ownership list.
+  for (const auto &j: m_payload.ownershipjournals())
+    *m_payload.mutable_obsoleteownershipjournals()->Add() = j;
+  m_payload.mutable_ownershipjournals()->Clear();
+  m_payload.mutable_ownershipjournalsizes()->Clear();
   m_payload.mutable_ownedobjects()->Clear();
   for (const auto &oo: ownershipSet)
     *m_payload.mutable_ownedobjects()->Add() = oo;
@@ -238,9 +337,16 @@ void cta::objectstore::Agent::resetOwnership(const std::set<std::string>& owners
 
 size_t cta::objectstore::Agent::getOwnershipListSize() {
   checkPayloadReadable();
+  if (m_payload.ownershipjournals_size())
+    return getOwnershipSet().size();
   return m_payload.ownedobjects_size();
 }
 
+size_t cta::objectstore::Agent::getOwnershipJournalsCount() {
+  checkPayloadReadable();
+  return m_payload.ownershipjournals_size();
+}
+
 
 void cta::objectstore::Agent::bumpHeartbeat() {
   checkPayloadWritable();
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "ObjectOps.hpp"
+#include "AgentOwnershipJournal.hpp"
 #include "objectstore/cta.pb.h"
 #include "common/Timer.hpp"
 #include <cxxabi.h>
@@ -37,6 +38,16 @@ class Sorter;
  * a ContextHandles
  * In all the agent is the case class for all actions.
  * It handles (in the base class):
+ *
+ * The ownership is recorded in the ownership list of the agent object, followed
+ * by journals in separate objects (AgentOwnershipJournal). The batches of
+ * ownership changes of the AgentReference each create a journal, so that the
+ * agent object does not have to be rewritten with the full ownership. The last
+ * journals are merged when they are not significantly smaller than the ones
+ * before them, which keeps a logarithmic number of journals. The direct
+ * ownership changes below (garbage collection, AgentWrapper) first fold the
+ * journals into the ownership list. The ownership should be read with the
+ * agent locked, as the journals merged by a batch are deleted by the next one.
  */
 
 class Agent: public ObjectOps<serializers::Agent, serializers::Agent_t> {
@@ -73,6 +84,38 @@ private:
   
   void removeFromOwnership(std::string name);
 
+  /**
+   * Records a change of the ownership in a new journal, merged with the last
+   * journals when they are not significantly bigger. The journal is created
+   * immediately: if the agent cannot be committed, the caller has to remove it.
+   * @param delta the change of the ownership.
+   * @param agentReference used to generate the journal's address.
+   * @return the address of the new journal, empty if none was created.
+   */
+  std::string recordOwnershipDelta(const AgentOwnershipDelta & delta, AgentReference & agentReference);
+
+  /**
+   * Folds the ownership journals into the ownership list of the agent, before
+   * modifying it directly.
+   */
+  void foldOwnershipJournals();
+
+  /**
+   * Deletes the journals merged in the previously committed versions of the agent.
+   */
+  void removeObsoleteOwnershipJournals();
+
+  /**
+   * Fetches (lock free) the ownership journals, in order.
+   */
+  std::list<AgentOwnershipJournal> fetchOwnershipJournals(size_t first = 0);
+
+  /**
+   * A journal is merged with the next ones when it is up to this number of
+   * times bigger than them.
+   */
+  static const uint64_t c_ownershipJournalMergeFactor = 2;
+
 public:
   std::list<std::string> getOwnershipList();
   
@@ -81,6 +124,8 @@ public:
   void resetOwnership(const std::set<std::string>& ownershipSet);
   
   size_t getOwnershipListSize();
+
+  size_t getOwnershipJournalsCount();
   
   std::string dump();
   
@@ -0,0 +1,133 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AgentOwnershipJournal.hpp"
+#include "GenericObject.hpp"
+#include <google/protobuf/util/json_util.h>
+
+namespace cta { namespace objectstore {
+
+//------------------------------------------------------------------------------
+// AgentOwnershipJournal::AgentOwnershipJournal()
+//------------------------------------------------------------------------------
+AgentOwnershipJournal::AgentOwnershipJournal(const std::string& address, Backend& os):
+  ObjectOps<serializers::AgentOwnershipJournal, serializers::AgentOwnershipJournal_t>(os, address) { }
+
+//------------------------------------------------------------------------------
+// AgentOwnershipJournal::AgentOwnershipJournal()
+//------------------------------------------------------------------------------
+AgentOwnershipJournal::AgentOwnershipJournal(GenericObject& go):
+  ObjectOps<serializers::AgentOwnershipJournal, serializers::AgentOwnershipJournal_t>(go.objectStore()) {
+  // Here we transplant the generic object into the new object
+  go.transplantHeader(*this);
+  // And interpret the header.
+  getPayloadFromHeader();
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipJournal::initialize()
+//------------------------------------------------------------------------------
+void AgentOwnershipJournal::initialize() {
+  // Setup underlying object
+  ObjectOps<serializers::AgentOwnershipJournal, serializers::AgentOwnershipJournal_t>::initialize();
+  m_payloadInterpreted = true;
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipJournal::garbageCollect()
+//------------------------------------------------------------------------------
+void AgentOwnershipJournal::garbageCollect(const std::string &presumedOwner, AgentReference & agentReference,
+    log::LogContext & lc, cta::catalogue::Catalogue & catalogue) {
+  // The journals are never in the ownership of an agent: they are deleted with their agent.
+  log::ScopedParamContainer params(lc);
+  params.add("agentOwnershipJournal", getAddressIfSet())
+        .add("currentOwner", getOwner())
+        .add("presumedOwner", presumedOwner);
+  lc.log(log::ERR, "In AgentOwnershipJournal::garbageCollect(): agent ownership journal should not require garbage collection.");
+  throw exception::Exception("In AgentOwnershipJournal::garbageCollect(): agent ownership journal should not require garbage collection");
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipDelta::add()
+//------------------------------------------------------------------------------
+void AgentOwnershipDelta::add(const std::string& objectAddress) {
+  removedObjects.erase(objectAddress);
+  addedObjects.insert(objectAddress);
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipDelta::remove()
+//------------------------------------------------------------------------------
+void AgentOwnershipDelta::remove(const std::string& objectAddress) {
+  addedObjects.erase(objectAddress);
+  removedObjects.insert(objectAddress);
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipDelta::append()
+//------------------------------------------------------------------------------
+void AgentOwnershipDelta::append(const AgentOwnershipDelta& laterDelta) {
+  for (const auto & oa: laterDelta.removedObjects) remove(oa);
+  for (const auto & oa: laterDelta.addedObjects) add(oa);
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipDelta::applyTo()
+//------------------------------------------------------------------------------
+void AgentOwnershipDelta::applyTo(std::set<std::string>& ownershipSet) const {
+  for (const auto & oa: removedObjects) ownershipSet.erase(oa);
+  ownershipSet.insert(addedObjects.begin(), addedObjects.end());
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipJournal::setDelta()
+//------------------------------------------------------------------------------
+void AgentOwnershipJournal::setDelta(const AgentOwnershipDelta& delta) {
+  checkPayloadWritable();
+  m_payload.mutable_addedobjects()->Clear();
+  m_payload.mutable_removedobjects()->Clear();
+  m_payload.mutable_addedobjects()->Reserve(delta.addedObjects.size());
+  for (const auto & oa: delta.addedObjects) *m_payload.mutable_addedobjects()->Add() = oa;
+  m_payload.mutable_removedobjects()->Reserve(delta.removedObjects.size());
+  for (const auto & oa: delta.removedObjects) *m_payload.mutable_removedobjects()->Add() = oa;
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipJournal::getDelta()
+//------------------------------------------------------------------------------
+AgentOwnershipDelta AgentOwnershipJournal::getDelta() {
+  checkPayloadReadable();
+  AgentOwnershipDelta ret;
+  ret.addedObjects.insert(m_payload.addedobjects().begin(), m_payload.addedobjects().end());
+  ret.removedObjects.insert(m_payload.removedobjects().begin(), m_payload.removedobjects().end());
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+// AgentOwnershipJournal::dump()
+//------------------------------------------------------------------------------
+std::string AgentOwnershipJournal::dump() {
+  checkPayloadReadable();
+  google::protobuf::util::JsonPrintOptions options;
+  options.add_whitespace = true;
+  options.always_print_primitive_fields = true;
+  std::string headerDump;
+  google::protobuf::util::MessageToJsonString(m_payload, &headerDump, options);
+  return headerDump;
+}
+
+}}
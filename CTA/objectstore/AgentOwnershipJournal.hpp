@@ -0,0 +1,71 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2015-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "ObjectOps.hpp"
+#include "objectstore/cta.pb.h"
+#include <set>
+#include <string>
+
+namespace cta { namespace objectstore {
+
+class Backend;
+class GenericObject;
+
+/**
+ * The net change of the ownership of an agent, as recorded by a journal. An
+ * object address is at most in one of the two sets.
+ */
+struct AgentOwnershipDelta {
+  std::set<std::string> addedObjects;
+  std::set<std::string> removedObjects;
+  void add(const std::string & objectAddress);
+  void remove(const std::string & objectAddress);
+  /**
+   * Appends the changes of a later delta to this one.
+   */
+  void append(const AgentOwnershipDelta & laterDelta);
+  /**
+   * Applies the delta to an ownership set.
+   */
+  void applyTo(std::set<std::string> & ownershipSet) const;
+  bool empty() const { return addedObjects.empty() && removedObjects.empty(); }
+  size_t size() const { return addedObjects.size() + removedObjects.size(); }
+};
+
+/**
+ * A journal of changes to the ownership of an agent. The journals are written
+ * once by the agent (their owner) and never modified afterwards: they are
+ * merged into new journals and then deleted. They can hence be fetched without
+ * lock. See Agent for the replay of the journals.
+ */
+class AgentOwnershipJournal: public ObjectOps<serializers::AgentOwnershipJournal, serializers::AgentOwnershipJournal_t> {
+public:
+  AgentOwnershipJournal(const std::string & address, Backend & os);
+  AgentOwnershipJournal(GenericObject & go);
+  void initialize();
+  void garbageCollect(const std::string &presumedOwner, AgentReference & agentReference, log::LogContext & lc,
+    cta::catalogue::Catalogue & catalogue) override;
+
+  void setDelta(const AgentOwnershipDelta & delta);
+  AgentOwnershipDelta getDelta();
+
+  std::string dump();
+};
+
+}}
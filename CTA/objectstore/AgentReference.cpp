@@ -167,7 +167,6 @@ void AgentReference::queueAndExecuteAction(std::shared_ptr<Action> action, objec
         ::exit(EXIT_FAILURE);
       }
       double agentFetchTime = t.secs(utils::Timer::resetCounter);
-      size_t agentOwnershipSizeBefore = ag.getOwnershipListSize();
       size_t operationsCount = q->queue.size() + 1;
       bool ownershipModification = false;
       // First, determine if any action is an ownership modification
@@ -181,28 +180,42 @@ void AgentReference::queueAndExecuteAction(std::shared_ptr<Action> action, objec
           }
         }
       }
-      std::set<std::string> ownershipSet;
-      // If necessary, we will dump the ownership list into a set, manipulate it in memory,
-      // and then recreate it.
-      if (ownershipModification) ownershipSet = ag.getOwnershipSet();
+      // The ownership modifications are accumulated into a delta, recorded in a new
+      // ownership journal: the ownership itself is neither read nor rewritten.
+      AgentOwnershipDelta ownershipDelta;
       // First we apply our own modification
-      appyAction(*action, ag, ownershipSet, lc);
+      appyAction(*action, ag, ownershipDelta, lc);
       // Then those of other threads
       for (auto a: q->queue) {
         threading::MutexLocker ml(a->mutex);
-        appyAction(*a, ag, ownershipSet, lc);
+        appyAction(*a, ag, ownershipDelta, lc);
       }
-      // Record the new ownership if needed.
-      if (ownershipModification) ag.resetOwnership(ownershipSet);
-      size_t agentOwnershipSizeAfter = ag.getOwnershipListSize();
+      // Record the ownership change if needed.
+      std::string newOwnershipJournal;
+      if (ownershipModification) newOwnershipJournal = ag.recordOwnershipDelta(ownershipDelta, *this);
       double agentUpdateTime = t.secs(utils::Timer::resetCounter);
       // and commit
-      ag.commit();
+      try {
+        ag.commit();
+      } catch (...) {
+        // The new journal is not referenced by the agent: remove it.
+        if (newOwnershipJournal.size()) {
+          try {
+            backend.remove(newOwnershipJournal);
+          } catch (cta::exception::Exception & ex) {
+            log::ScopedParamContainer params(lc);
+            params.add("ownershipJournal", newOwnershipJournal)
+                  .add("exceptionMessage", ex.getMessageValue());
+            lc.log(log::ERR, "In AgentReference::queueAndExecuteAction(): failed to remove the ownership journal of a failed agent commit.");
+          }
+        }
+        throw;
+      }
       double agentCommitTime = t.secs(utils::Timer::resetCounter);
       if (ownershipModification && false) { // Log disabled to not log too much.
         log::ScopedParamContainer params(lc);
-        params.add("agentOwnershipSizeBefore", agentOwnershipSizeBefore)
-              .add("agentOwnershipSizeAfter", agentOwnershipSizeAfter)
+        params.add("ownershipDeltaSize", ownershipDelta.size())
+              .add("ownershipJournalsCount", ag.getOwnershipJournalsCount())
               .add("operationsCount", operationsCount)
               .add("agentLockTime", agentLockTime)
               .add("agentFetchTime", agentFetchTime)
@@ -237,11 +250,11 @@ void AgentReference::queueAndExecuteAction(std::shared_ptr<Action> action, objec
 }
 
 void AgentReference::appyAction(Action& action, objectstore::Agent& agent, 
-    std::set<std::string> & ownershipSet, log::LogContext &lc) {
+    AgentOwnershipDelta & ownershipDelta, log::LogContext &lc) {
   switch (action.op) {
   case AgentOperation::Add:
   {
-    ownershipSet.insert(action.objectAddress);
+    ownershipDelta.add(action.objectAddress);
     log::ScopedParamContainer params(lc);
     params.add("ownedObject", action.objectAddress);
     lc.log(log::DEBUG, "In AgentReference::appyAction(): added object to ownership.");
@@ -250,7 +263,7 @@ void AgentReference::appyAction(Action& action, objectstore::Agent& agent,
   case AgentOperation::AddBatch:
   {
     for (const auto & oa: action.objectAddressSet) {
-      ownershipSet.insert(oa);
+      ownershipDelta.add(oa);
       log::ScopedParamContainer params(lc);
       params.add("ownedObject", oa);
       lc.log(log::DEBUG, "In AgentReference::appyAction(): added object to ownership (by batch).");
@@ -260,7 +273,7 @@ void AgentReference::appyAction(Action& action, objectstore::Agent& agent,
   }
   case AgentOperation::Remove:
   {
-    ownershipSet.erase(action.objectAddress);
+    ownershipDelta.remove(action.objectAddress);
     log::ScopedParamContainer params(lc);
     params.add("ownedObject", action.objectAddress);
     lc.log(log::DEBUG, "In AgentReference::appyAction(): removed object from ownership.");
@@ -269,7 +282,7 @@ void AgentReference::appyAction(Action& action, objectstore::Agent& agent,
   case AgentOperation::RemoveBatch:
   {
     for (const auto & oa: action.objectAddressSet) {
-      ownershipSet.erase(oa);
+      ownershipDelta.remove(oa);
       log::ScopedParamContainer params(lc);
       params.add("ownedObject", oa);
       lc.log(log::DEBUG, "In AgentReference::appyAction(): removed object from ownership (by batch).");
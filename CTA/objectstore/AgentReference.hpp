@@ -33,6 +33,7 @@
 namespace cta { namespace objectstore {
 
 class Agent;
+struct AgentOwnershipDelta;
 
 /**
  * A class allowing the passing of the address of an Agent object, plus a thread safe
@@ -153,12 +154,12 @@ private:
   
   /**
    * Helper function applying the action to the already fetched agent.
-   * Ownership operations are done on the pre-extracted ownershipSet.
+   * Ownership operations are accumulated in ownershipDelta.
    * @param action
    * @param agent
    */
   void appyAction(Action& action, objectstore::Agent& agent, 
-    std::set<std::string> & ownershipSet, log::LogContext &lc);
+    AgentOwnershipDelta & ownershipDelta, log::LogContext &lc);
   
   /**
    * The global function actually doing the job: creates a queue if needed, add
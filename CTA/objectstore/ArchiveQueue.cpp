@@ -110,7 +110,6 @@ void ArchiveQueue::rebuild() {
   // As a side note, we do not go as far as validating the pointers to jobs within th
   // shards, as this is already handled as access goes.
   std::list<ArchiveQueueShard> shards;
-  std::list<std::unique_ptr<ArchiveQueueShard::AsyncLockfreeFetcher>> shardsFetchers;
   
   // Get the summaries structures ready
   ValueCountMapUint64 priorityMap(m_payload.mutable_prioritymap());
@@ -121,17 +120,17 @@ void ArchiveQueue::rebuild() {
   mountPolicyNameMap.clear();
   for (auto & sa: m_payload.archivequeueshards()) {
     shards.emplace_back(ArchiveQueueShard(sa.address(), m_objectStore));
-    shardsFetchers.emplace_back(shards.back().asyncLockfreeFetch());
   }
   auto s = shards.begin();
-  auto sf = shardsFetchers.begin();
+  auto shardsFetchResults = ArchiveQueueShard::multiLockfreeFetch(m_objectStore, shards);
+  auto sf = shardsFetchResults.begin();
   uint64_t totalJobs=0;
   uint64_t totalBytes=0;
   time_t oldestJobCreationTime=std::numeric_limits<time_t>::max();
   while (s != shards.end()) {
     // Each shard could be gone
     try {
-      (*sf)->wait();
+      if (*sf) std::rethrow_exception(*sf);
     } catch (Backend::NoSuchObject & ex) {
       // Remove the shard from the list
       auto aqs = m_payload.mutable_archivequeueshards()->begin();
@@ -199,20 +198,19 @@ void ArchiveQueue::recomputeOldestJobCreationTime(){
   checkPayloadWritable();
   
   std::list<ArchiveQueueShard> shards;
-  std::list<std::unique_ptr<ArchiveQueueShard::AsyncLockfreeFetcher>> shardsFetchers;
   
   for (auto & sa: m_payload.archivequeueshards()) {
     shards.emplace_back(ArchiveQueueShard(sa.address(), m_objectStore));
-    shardsFetchers.emplace_back(shards.back().asyncLockfreeFetch());
   }
   
   auto s = shards.begin();
-  auto sf = shardsFetchers.begin();
+  auto shardsFetchResults = ArchiveQueueShard::multiLockfreeFetch(m_objectStore, shards);
+  auto sf = shardsFetchResults.begin();
   time_t oldestJobCreationTime=std::numeric_limits<time_t>::max();
   while (s != shards.end()) {
     // Each shard could be gone
     try {
-      (*sf)->wait();
+      if (*sf) std::rethrow_exception(*sf);
     } catch (Backend::NoSuchObject & ex) {
       // Remove the shard from the list
       auto aqs = m_payload.mutable_archivequeueshards()->begin();
@@ -435,19 +433,18 @@ ArchiveQueue::AdditionSummary ArchiveQueue::addJobsIfNecessaryAndCommit(std::lis
   checkPayloadWritable();
   // First get all the shards of the queue to understand which jobs to add.
   std::list<ArchiveQueueShard> shards;
-  std::list<std::unique_ptr<ArchiveQueueShard::AsyncLockfreeFetcher>> shardsFetchers;
   
   for (auto & sa: m_payload.archivequeueshards()) {
     shards.emplace_back(ArchiveQueueShard(sa.address(), m_objectStore));
-    shardsFetchers.emplace_back(shards.back().asyncLockfreeFetch());
   }
   std::list<std::list<JobDump>> shardsDumps;
   auto s = shards.begin();
-  auto sf = shardsFetchers.begin();
+  auto shardsFetchResults = ArchiveQueueShard::multiLockfreeFetch(m_objectStore, shards);
+  auto sf = shardsFetchResults.begin();
   
   while (s!= shards.end()) {
     try {
-      (*sf)->wait();
+      if (*sf) std::rethrow_exception(*sf);
     } catch (Backend::NoSuchObject & ex) {
       goto nextShard;
     }
@@ -556,16 +553,15 @@ auto ArchiveQueue::dumpJobs() -> std::list<JobDump> {
   // Go read the shards in parallel...
   std::list<JobDump> ret;
   std::list<ArchiveQueueShard> shards;
-  std::list<std::unique_ptr<ArchiveQueueShard::AsyncLockfreeFetcher>> shardsFetchers;
   for (auto & sa: m_payload.archivequeueshards()) {
     shards.emplace_back(ArchiveQueueShard(sa.address(), m_objectStore));
-    shardsFetchers.emplace_back(shards.back().asyncLockfreeFetch());
   }
   auto s = shards.begin();
-  auto sf = shardsFetchers.begin();
+  auto shardsFetchResults = ArchiveQueueShard::multiLockfreeFetch(m_objectStore, shards);
+  auto sf = shardsFetchResults.begin();
   while (s != shards.end()) {
     try {
-      (*sf)->wait();
+      if (*sf) std::rethrow_exception(*sf);
     } catch (Backend::NoSuchObject & ex) {
       // We are possibly in read only mode, so we cannot rebuild.
       // Just skip this shard.
@@ -583,25 +579,59 @@ auto ArchiveQueue::dumpJobs() -> std::list<JobDump> {
 auto ArchiveQueue::getCandidateList(uint64_t maxBytes, uint64_t maxFiles, std::set<std::string> archiveRequestsToSkip) -> CandidateJobList {
   checkPayloadReadable();
   CandidateJobList ret;
-  for (auto & aqsp: m_payload.archivequeueshards()) {
-    // We need to go through all shard poiters unconditionnaly to count what is left (see else part)
-    if (ret.candidateBytes < maxBytes && ret.candidateFiles < maxFiles) {
-      // Fetch the shard
-      ArchiveQueueShard aqs(aqsp.address(), m_objectStore);
-      aqs.fetchNoLock();
-      auto shardCandidates = aqs.getCandidateJobList(maxBytes - ret.candidateBytes, maxFiles - ret.candidateFiles, archiveRequestsToSkip);
-      ret.candidateBytes += shardCandidates.candidateBytes;
-      ret.candidateFiles += shardCandidates.candidateFiles;
-      // We overwrite the remaining values each time as the previous
-      // shards have exhaustied their candidate lists.
-      ret.remainingBytesAfterCandidates = shardCandidates.remainingBytesAfterCandidates;
-      ret.remainingFilesAfterCandidates = shardCandidates.remainingFilesAfterCandidates;
-      ret.candidates.splice(ret.candidates.end(), shardCandidates.candidates);
-    } else {
-      // We are done with finding candidates. We just need to count what is left in the non-visited shards.
-      ret.remainingBytesAfterCandidates += aqsp.shardbytescount();
-      ret.remainingFilesAfterCandidates += aqsp.shardjobscount();
+  // The shards are fetched ahead of their processing: the fetches of all the shards the pointer counts say we will
+  // visit are launched in parallel up front. When jobs are skipped, the pointer counts overestimate the candidates,
+  // so we also keep the next shard in flight while the current one is being processed.
+  const int shardCount = m_payload.archivequeueshards_size();
+  std::vector<std::unique_ptr<ArchiveQueueShard>> shards(shardCount);
+  std::vector<std::unique_ptr<ArchiveQueueShard::AsyncLockfreeFetcher>> shardFetchers(shardCount);
+  int fetchesLaunched = 0;
+  uint64_t expectedBytes = 0, expectedFiles = 0;
+  auto launchNextShardFetch = [&]() {
+    auto & aqsp = m_payload.archivequeueshards(fetchesLaunched);
+    shards[fetchesLaunched].reset(new ArchiveQueueShard(aqsp.address(), m_objectStore));
+    shardFetchers[fetchesLaunched].reset(shards[fetchesLaunched]->asyncLockfreeFetch());
+    expectedBytes += aqsp.shardbytescount();
+    expectedFiles += aqsp.shardjobscount();
+    fetchesLaunched++;
+  };
+  const bool skipping = archiveRequestsToSkip.size() > 0;
+  // Shards fetched ahead but not needed after all (or not reached due to an error) are still in flight:
+  // let them complete before their objects go away.
+  auto drainShardFetches = [&]() {
+    for (auto & sf: shardFetchers) if (sf) try { sf->wait(); } catch (...) {}
+  };
+  try {
+    while (fetchesLaunched < shardCount && expectedBytes < maxBytes && expectedFiles < maxFiles) launchNextShardFetch();
+    for (int i = 0; i < shardCount; i++) {
+      auto & aqsp = m_payload.archivequeueshards(i);
+      // We need to go through all shard pointers unconditionnaly to count what is left (see else part)
+      if (ret.candidateBytes < maxBytes && ret.candidateFiles < maxFiles) {
+        // Get the shard, fetched ahead if possible
+        if (fetchesLaunched == i) launchNextShardFetch();
+        if (skipping && fetchesLaunched == i + 1 && fetchesLaunched < shardCount) launchNextShardFetch();
+        std::unique_ptr<ArchiveQueueShard::AsyncLockfreeFetcher> shardFetcher(std::move(shardFetchers[i]));
+        shardFetcher->wait();
+        auto shardCandidates = shards[i]->getCandidateJobList(maxBytes - ret.candidateBytes, maxFiles - ret.candidateFiles,
+            archiveRequestsToSkip);
+        shards[i].reset(nullptr);
+        ret.candidateBytes += shardCandidates.candidateBytes;
+        ret.candidateFiles += shardCandidates.candidateFiles;
+        // We overwrite the remaining values each time as the previous
+        // shards have exhaustied their candidate lists.
+        ret.remainingBytesAfterCandidates = shardCandidates.remainingBytesAfterCandidates;
+        ret.remainingFilesAfterCandidates = shardCandidates.remainingFilesAfterCandidates;
+        ret.candidates.splice(ret.candidates.end(), shardCandidates.candidates);
+      } else {
+        // We are done with finding candidates. We just need to count what is left in the non-visited shards.
+        ret.remainingBytesAfterCandidates += aqsp.shardbytescount();
+        ret.remainingFilesAfterCandidates += aqsp.shardjobscount();
+      }
     }
+    drainShardFetches();
+  } catch (...) {
+    drainShardFetches();
+    throw;
   }
   return ret;
 }
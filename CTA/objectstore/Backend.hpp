@@ -20,7 +20,9 @@
 #include "common/exception/Exception.hpp"
 #include <string>
 #include <list>
+#include <vector>
 #include <functional>
+#include <exception>
 
 namespace cta { namespace objectstore {
   
@@ -218,7 +220,41 @@ public:
    * @return pointer to a newly created AsyncDeleter
    */
   virtual AsyncLockfreeFetcher * asyncLockfreeFetch(const std::string & name) = 0;
-  
+
+  /**
+   * The outcome of one operation in a batch: exception is nullptr on success
+   * and content is only set by reads.
+   */
+  struct BatchResult {
+    std::string content;
+    std::exception_ptr exception;
+  };
+
+  /**
+   * Reads (lockfree) the content of several objects. All the reads are in flight
+   * at the same time, so the batch costs about one round trip instead of one per
+   * object. Failures do not interrupt the batch: missing (or empty) objects get
+   * a NoSuchObject exception in their result.
+   * @param names names of the objects
+   * @return the results, in the same order as names
+   */
+  virtual std::vector<BatchResult> multiRead(const std::vector<std::string> & names) = 0;
+
+  /**
+   * Creates several objects, with the same semantics as create() for each of them.
+   * @param objects the (name, content) pairs of the objects to create
+   * @return the results, in the same order as objects
+   */
+  virtual std::vector<BatchResult> multiCreate(const std::vector<std::pair<std::string, std::string>> & objects) = 0;
+
+  /**
+   * Deletes several objects, with the same semantics as remove() for each of them.
+   * Missing objects get a NoSuchObject exception in their result.
+   * @param names names of the objects
+   * @return the results, in the same order as names
+   */
+  virtual std::vector<BatchResult> multiRemove(const std::vector<std::string> & names) = 0;
+
   /**
    * Base class for the representation of the parameters of the BackendStore.
    */
@@ -1335,6 +1335,154 @@ std::string BackendRados::AsyncLockfreeFetcher::wait() {
 }
 
 
+std::vector<Backend::BatchResult> BackendRados::multiRead(const std::vector<std::string>& names) {
+  std::vector<BatchResult> ret(names.size());
+  // Post all the reads, then collect them. Each read gets its own completion, buffer and
+  // return value.
+  struct PendingRead {
+    librados::AioCompletion * completion = nullptr;
+    librados::bufferlist bl;
+    int rval = 0;
+  };
+  std::vector<PendingRead> pendingReads(names.size());
+  RadosTimeoutLogger rtl;
+  for (size_t i = 0; i < names.size(); i++) {
+    auto & pr = pendingReads[i];
+    try {
+      librados::ObjectReadOperation rop;
+      rop.read(0, std::numeric_limits<int32_t>::max(), &pr.bl, &pr.rval);
+      pr.completion = librados::Rados::aio_create_completion(nullptr, nullptr, nullptr);
+      int rc;
+      cta::exception::Errnum::throwOnReturnedErrnoOrThrownStdException([&]() {
+        rc = getRadosCtx().aio_operate(names[i], pr.completion, &rop, nullptr);
+        return 0;
+      }, "In BackendRados::multiRead(): failed getRadosCtx().aio_operate()");
+      if (rc) {
+        throw cta::exception::Errnum(-rc, std::string("In BackendRados::multiRead(): failed to launch aio_operate(): ") + names[i]);
+      }
+    } catch (...) {
+      ret[i].exception = std::current_exception();
+      if (pr.completion) pr.completion->release();
+      pr.completion = nullptr;
+    }
+  }
+  for (size_t i = 0; i < names.size(); i++) {
+    auto & pr = pendingReads[i];
+    if (!pr.completion) continue;
+    pr.completion->wait_for_complete();
+    int rc = pr.completion->get_return_value();
+    pr.completion->release();
+    try {
+      if (!rc && pr.rval < 0) rc = pr.rval;
+      if (rc < 0) {
+        cta::exception::Errnum errnum(-rc, std::string("In BackendRados::multiRead(): could not read object: ") + names[i]);
+        if (errnum.errorNumber() == ENOENT) throw Backend::NoSuchObject(errnum.getMessageValue());
+        throw Backend::CouldNotFetch(errnum.getMessageValue());
+      }
+      // Transient empty object can exist (due to locking)
+      // They are regarded as not-existing.
+      if (!pr.bl.length()) {
+        throw NoSuchObject("In BackendRados::multiRead(): considering empty object (name=" + names[i] + ") as non-existing");
+      }
+      pr.bl.copy(0, pr.bl.length(), ret[i].content);
+    } catch (...) {
+      ret[i].exception = std::current_exception();
+    }
+  }
+  rtl.logIfNeeded("In BackendRados::multiRead(): batch of aio_operate(read)", std::to_string(names.size()) + " objects");
+  return ret;
+}
+
+std::vector<Backend::BatchResult> BackendRados::multiCreate(const std::vector<std::pair<std::string, std::string> >& objects) {
+  std::vector<BatchResult> ret(objects.size());
+  std::vector<librados::AioCompletion *> completions(objects.size(), nullptr);
+  RadosTimeoutLogger rtl;
+  for (size_t i = 0; i < objects.size(); i++) {
+    try {
+      if (objects[i].second.empty())
+        throw exception::Exception("In BackendRados::multiCreate: trying to create an empty object: " + objects[i].first);
+      librados::ObjectWriteOperation wop;
+      const bool createExclusive = true;
+      wop.create(createExclusive);
+      ceph::bufferlist bl;
+      bl.append(objects[i].second.c_str(), objects[i].second.size());
+      wop.write_full(bl);
+      completions[i] = librados::Rados::aio_create_completion(nullptr, nullptr, nullptr);
+      int rc;
+      cta::exception::Errnum::throwOnReturnedErrnoOrThrownStdException([&]() {
+        rc = getRadosCtx().aio_operate(objects[i].first, completions[i], &wop);
+        return 0;
+      }, "In BackendRados::multiCreate(): failed getRadosCtx().aio_operate()");
+      if (rc) {
+        throw cta::exception::Errnum(-rc, std::string("In BackendRados::multiCreate(): failed to launch aio_operate(): ") + objects[i].first);
+      }
+    } catch (...) {
+      ret[i].exception = std::current_exception();
+      if (completions[i]) completions[i]->release();
+      completions[i] = nullptr;
+    }
+  }
+  for (size_t i = 0; i < objects.size(); i++) {
+    if (!completions[i]) continue;
+    completions[i]->wait_for_complete();
+    int rc = completions[i]->get_return_value();
+    completions[i]->release();
+    try {
+      if (-EEXIST == rc) {
+        // We might have raced with the locking of a non existing object (see create()).
+        // Let the synchronous version handle the wait and retry.
+        create(objects[i].first, objects[i].second);
+      } else if (rc) {
+        throw cta::exception::Errnum(-rc, std::string("In BackendRados::multiCreate(): failed to create exclusively or write: ") + objects[i].first);
+      }
+    } catch (...) {
+      ret[i].exception = std::current_exception();
+    }
+  }
+  rtl.logIfNeeded("In BackendRados::multiCreate(): batch of aio_operate(create+write_full)", std::to_string(objects.size()) + " objects");
+  return ret;
+}
+
+std::vector<Backend::BatchResult> BackendRados::multiRemove(const std::vector<std::string>& names) {
+  std::vector<BatchResult> ret(names.size());
+  std::vector<librados::AioCompletion *> completions(names.size(), nullptr);
+  RadosTimeoutLogger rtl;
+  for (size_t i = 0; i < names.size(); i++) {
+    try {
+      completions[i] = librados::Rados::aio_create_completion(nullptr, nullptr, nullptr);
+      int rc;
+      cta::exception::Errnum::throwOnReturnedErrnoOrThrownStdException([&]() {
+        rc = getRadosCtx().aio_remove(names[i], completions[i]);
+        return 0;
+      }, "In BackendRados::multiRemove(): failed getRadosCtx().aio_remove()");
+      if (rc) {
+        throw cta::exception::Errnum(-rc, std::string("In BackendRados::multiRemove(): failed to launch aio_remove(): ") + names[i]);
+      }
+    } catch (...) {
+      ret[i].exception = std::current_exception();
+      if (completions[i]) completions[i]->release();
+      completions[i] = nullptr;
+    }
+  }
+  for (size_t i = 0; i < names.size(); i++) {
+    if (!completions[i]) continue;
+    completions[i]->wait_for_complete();
+    int rc = completions[i]->get_return_value();
+    completions[i]->release();
+    try {
+      if (rc) {
+        cta::exception::Errnum errnum(-rc, std::string("In BackendRados::multiRemove(): failed to remove: ") + names[i]);
+        if (errnum.errorNumber() == ENOENT) throw Backend::NoSuchObject(errnum.getMessageValue());
+        throw errnum;
+      }
+    } catch (...) {
+      ret[i].exception = std::current_exception();
+    }
+  }
+  rtl.logIfNeeded("In BackendRados::multiRemove(): batch of aio_remove()", std::to_string(names.size()) + " objects");
+  return ret;
+}
+
 std::string BackendRados::Parameters::toStr() {
   std::stringstream ret;
   ret << "userId=" << m_userId << " pool=" << m_pool;
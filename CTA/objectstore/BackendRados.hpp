@@ -424,6 +424,12 @@ public:
   };
   
   Backend::AsyncLockfreeFetcher* asyncLockfreeFetch(const std::string& name) override;
+
+  std::vector<BatchResult> multiRead(const std::vector<std::string> & names) override;
+
+  std::vector<BatchResult> multiCreate(const std::vector<std::pair<std::string, std::string>> & objects) override;
+
+  std::vector<BatchResult> multiRemove(const std::vector<std::string> & names) override;
   
   class Parameters: public Backend::Parameters {
     friend class BackendRados;
@@ -215,6 +215,43 @@ TEST_P(BackendAbstractTest, AsyncIOInterfaceMultithread) {
   }
 }
 
+TEST_P(BackendAbstractTest, BatchInterface) {
+  const size_t objectCount = 50;
+  std::vector<std::pair<std::string, std::string>> objects;
+  std::vector<std::string> names;
+  for (size_t i=0; i<objectCount; i++) {
+    names.emplace_back("testBatchObject" + std::to_string(i));
+    objects.emplace_back(names.back(), "value" + std::to_string(i));
+    try {m_os->remove(names.back());} catch(...){}
+  }
+  // Create all the objects. Re-creating one of them should only fail for this object.
+  for (auto & r: m_os->multiCreate(objects)) ASSERT_FALSE(r.exception);
+  ASSERT_TRUE(m_os->multiCreate({objects.front()}).front().exception);
+  // Read them back, with a missing object in the middle of the batch.
+  std::vector<std::string> readNames(names);
+  readNames.insert(readNames.begin() + objectCount / 2, "testBatchObjectMissing");
+  auto readResults = m_os->multiRead(readNames);
+  ASSERT_EQ(objectCount + 1, readResults.size());
+  for (size_t i=0; i<readNames.size(); i++) {
+    if (i == objectCount / 2) {
+      ASSERT_THROW(std::rethrow_exception(readResults[i].exception), cta::objectstore::Backend::NoSuchObject);
+    } else {
+      ASSERT_FALSE(readResults[i].exception);
+      ASSERT_EQ(m_os->read(readNames[i]), readResults[i].content);
+    }
+  }
+  // Remove them all. The missing object is reported as such.
+  auto removeResults = m_os->multiRemove(readNames);
+  for (size_t i=0; i<readNames.size(); i++) {
+    if (i == objectCount / 2) {
+      ASSERT_THROW(std::rethrow_exception(removeResults[i].exception), cta::objectstore::Backend::NoSuchObject);
+    } else {
+      ASSERT_FALSE(removeResults[i].exception);
+      ASSERT_FALSE(m_os->exists(readNames[i]));
+    }
+  }
+}
+
 TEST_P(BackendAbstractTest, ParametersInterface) {
   //std::cout << "Type=" << m_os->typeName() << std::endl;
   std::unique_ptr<cta::objectstore::Backend::Parameters> params(
@@ -222,6 +259,31 @@ TEST_P(BackendAbstractTest, ParametersInterface) {
   //std::cout << params->toStr() << std::endl;
 }
 
+TEST(BackendVFS, WorkerPoolNotStarvedByBlockedWorkers) {
+  // More asynchronous updates than the pool has worker threads (64) wait for a
+  // lock held here. A lock free fetch submitted after them should still complete.
+  cta::objectstore::BackendVFS os(__LINE__, __FILE__);
+  const std::string lockedObjectName = "lockedObject";
+  const std::string freeObjectName = "freeObject";
+  const size_t updateCount = 100;
+  os.create(lockedObjectName, "");
+  os.create(freeObjectName, "free");
+  std::unique_ptr<cta::objectstore::Backend::ScopedLock> lock(os.lockExclusive(lockedObjectName));
+  std::function<std::string(const std::string &)> updaterCallback=[](const std::string &s)->std::string{return s + "X";};
+  std::list<std::unique_ptr<cta::objectstore::Backend::AsyncUpdater>> updaters;
+  for (size_t i=0; i<updateCount; i++) {
+    updaters.emplace_back(os.asyncUpdate(lockedObjectName, updaterCallback));
+  }
+  std::unique_ptr<cta::objectstore::Backend::AsyncLockfreeFetcher> fetcher(os.asyncLockfreeFetch(freeObjectName));
+  auto fetch = std::async(std::launch::async, [&fetcher](){ return fetcher->wait(); });
+  // Do not hang if the fetch is starved: release the lock in any case.
+  EXPECT_EQ(std::future_status::ready, fetch.wait_for(std::chrono::seconds(10)));
+  lock->release();
+  ASSERT_EQ("free", fetch.get());
+  for (auto & u: updaters) u->wait();
+  ASSERT_EQ(std::string(updateCount, 'X'), os.read(lockedObjectName));
+}
+
 static cta::objectstore::BackendVFS osVFS(__LINE__, __FILE__);
 #ifdef TEST_RADOS
 static cta::log::DummyLogger dl("", "");
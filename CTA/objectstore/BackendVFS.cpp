@@ -36,6 +36,7 @@
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <algorithm>
 #ifdef LOW_LEVEL_TRACING
 #include <iostream>
 #endif
@@ -44,7 +45,10 @@
 
 namespace cta { namespace objectstore {
 
-BackendVFS::BackendVFS(int line, const char *file) : m_deleteOnExit(true) {
+const size_t BackendVFS::c_maxWorkerThreads = 64;
+
+BackendVFS::BackendVFS(int line, const char *file) : m_deleteOnExit(true),
+  m_workerPool(new WorkerPool(c_maxWorkerThreads)) {
   // Create the directory for storage
   char tplt[] = "/tmp/jobStoreVFSXXXXXX";
   mkdtemp(tplt);
@@ -61,7 +65,7 @@ BackendVFS::BackendVFS(int line, const char *file) : m_deleteOnExit(true) {
 }
 
 BackendVFS::BackendVFS(std::string path):
-  m_root(path), m_deleteOnExit(false) {}
+  m_root(path), m_deleteOnExit(false), m_workerPool(new WorkerPool(c_maxWorkerThreads)) {}
 
 void BackendVFS::noDeleteOnExit() {
   m_deleteOnExit = false;
@@ -87,6 +91,8 @@ int deleteFileOrDirectory(const char* fpath,
 }
 
 BackendVFS::~BackendVFS() {
+  // Let the pending asynchronous operations complete before anything else goes away.
+  m_workerPool.reset();
   if (m_deleteOnExit) {
     // Delete the created directories recursively
     nftw (m_root.c_str(), deleteFileOrDirectory, 100, FTW_DEPTH);
@@ -284,6 +290,8 @@ BackendVFS::ScopedLock * BackendVFS::lockHelper(std::string name, int type, uint
     }
   }
 
+  // A worker of the pool waiting for the lock lets the queued jobs proceed.
+  WorkerPool::BlockedSection blockedSection(m_workerPool.get());
   if(timeout_us) {
     utils::Timer t;
     while (::flock(ret->m_fd, type | LOCK_NB)) {
@@ -337,8 +345,8 @@ BackendVFS::ScopedLock * BackendVFS::lockShared(std::string name, uint64_t timeo
 
 BackendVFS::AsyncCreator::AsyncCreator(BackendVFS& be, const std::string& name, const std::string& value):
   m_backend(be), m_name(name), m_value(value),
-  m_job(std::async(std::launch::async, 
-    [&](){
+  m_job(m_backend.m_workerPool->submit(
+    [this](){
       std::string path = m_backend.m_root + "/" + m_name;
       std::string lockPath = m_backend.m_root + "/." + m_name + ".lock";
       bool fileCreated = false;
@@ -351,7 +359,7 @@ BackendVFS::AsyncCreator::AsyncCreator(BackendVFS& be, const std::string& name,
             "In AsyncCreator::AsyncCreator::lambda, failed to open the file");
         fileCreated = true;
         #ifdef LOW_LEVEL_TRACING
-          ::printf("In BackendVFS::create(): created object %s, tid=%li\n", name.c_str(), ::syscall(SYS_gettid));
+          ::printf("In BackendVFS::create(): created object %s, tid=%li\n", m_name.c_str(), ::syscall(SYS_gettid));
         #endif
         cta::exception::Errnum::throwOnMinusOne(
             ::write(fd, m_value.c_str(), m_value.size()),
@@ -363,9 +371,9 @@ BackendVFS::AsyncCreator::AsyncCreator(BackendVFS& be, const std::string& name,
         int fdLock = ::open(lockPath.c_str(), O_WRONLY | O_CREAT | O_EXCL, S_IRWXU | S_IRWXG | S_IRWXO);
         lockCreated = true;
         cta::exception::Errnum::throwOnMinusOne(fdLock,
-            std::string("In AsyncCreator::AsyncCreator::lambda, failed to create the lock file: ") + name);
+            std::string("In AsyncCreator::AsyncCreator::lambda, failed to create the lock file: ") + m_name);
         cta::exception::Errnum::throwOnMinusOne(::close(fdLock),
-            std::string("In AsyncCreator::AsyncCreator::lambda, failed to close the lock file: ") + name);
+            std::string("In AsyncCreator::AsyncCreator::lambda, failed to close the lock file: ") + m_name);
       } catch (...) {
         if (fileCreated) unlink(path.c_str());
         if (lockCreated) unlink(lockPath.c_str());
@@ -387,8 +395,8 @@ void BackendVFS::AsyncCreator::wait() {
 
 BackendVFS::AsyncUpdater::AsyncUpdater(BackendVFS & be, const std::string& name, std::function<std::string(const std::string&)>& update):
   m_backend(be), m_name(name), m_update(update),
-  m_job(std::async(std::launch::async, 
-    [&](){
+  m_job(m_backend.m_workerPool->submit(
+    [this](){
       std::unique_ptr<ScopedLock> sl;
       try { // locking already throws proper exceptions for no such file.
         sl.reset(m_backend.lockExclusive(m_name));
@@ -456,8 +464,8 @@ void BackendVFS::AsyncUpdater::wait() {
 
 BackendVFS::AsyncDeleter::AsyncDeleter(BackendVFS & be, const std::string& name):
   m_backend(be), m_name(name),
-  m_job(std::async(std::launch::async, 
-    [&](){
+  m_job(m_backend.m_workerPool->submit(
+    [this](){
       std::unique_ptr<ScopedLock> sl;
       try { // locking already throws proper exceptions for no such file.
         sl.reset(m_backend.lockExclusive(m_name));
@@ -496,31 +504,150 @@ void BackendVFS::AsyncDeleter::wait() {
 }
 
 BackendVFS::AsyncLockfreeFetcher::AsyncLockfreeFetcher(BackendVFS& be, const std::string& name):
-  m_backend(be), m_name(name) {
-  cta::threading::Thread::start();
-}
-
-void BackendVFS::AsyncLockfreeFetcher::run() {
-  threading::MutexLocker ml(m_mutex);
-  try {
-    m_value = m_backend.read(m_name);
-  } catch (...) {
-    m_exception = std::current_exception();
-  }
-}
+  m_backend(be), m_name(name),
+  m_job(m_backend.m_workerPool->submit(
+    [this](){
+      m_value = m_backend.read(m_name);
+      ANNOTATE_HAPPENS_BEFORE(&m_job);
+    }))
+{}
 
 Backend::AsyncLockfreeFetcher* BackendVFS::asyncLockfreeFetch(const std::string& name) {
   return new AsyncLockfreeFetcher(*this, name);
 }
 
 std::string BackendVFS::AsyncLockfreeFetcher::wait() {
-  cta::threading::Thread::wait();
-  threading::MutexLocker ml(m_mutex);
-  if (m_exception)
-    std::rethrow_exception(m_exception);
+  m_job.get();
+  ANNOTATE_HAPPENS_AFTER(&m_job);
+  ANNOTATE_HAPPENS_BEFORE_FORGET_ALL(&m_job);
   return m_value;
 }
 
+thread_local BackendVFS::WorkerPool * BackendVFS::WorkerPool::t_currentPool = nullptr;
+
+BackendVFS::WorkerPool::WorkerPool(size_t maxThreads): m_maxThreads(maxThreads) {}
+
+BackendVFS::WorkerPool::~WorkerPool() {
+  // No job can be submitted anymore, but a running job can still start a thread
+  // when it blocks: stop and wait for the threads until no new one appears.
+  size_t stoppedThreads = 0;
+  while (true) {
+    size_t threadCount;
+    {
+      threading::MutexLocker ml(m_mutex);
+      threadCount = m_threads.size();
+    }
+    if (stoppedThreads == threadCount) break;
+    for (size_t i=stoppedThreads; i<threadCount; i++) m_jobQueue.push(nullptr);
+    for (size_t i=stoppedThreads; i<threadCount; i++) {
+      WorkerThread * t;
+      {
+        threading::MutexLocker ml(m_mutex);
+        t = m_threads[i].get();
+      }
+      t->wait();
+    }
+    stoppedThreads = threadCount;
+  }
+}
+
+std::future<void> BackendVFS::WorkerPool::submit(std::function<void()> job) {
+  std::unique_ptr<std::packaged_task<void()>> task(new std::packaged_task<void()>(std::move(job)));
+  auto ret = task->get_future();
+  {
+    threading::MutexLocker ml(m_mutex);
+    if (m_idleThreads) {
+      m_idleThreads--;
+    } else if (m_threads.size() - m_blockedThreads < m_maxThreads) {
+      m_threads.emplace_back(new WorkerThread(*this));
+    } else {
+      m_pendingJobs++;
+    }
+  }
+  m_jobQueue.push(task.release());
+  return ret;
+}
+
+BackendVFS::WorkerPool::BlockedSection::BlockedSection(WorkerPool * pool) {
+  if (!pool || t_currentPool != pool) return;
+  m_pool = pool;
+  threading::MutexLocker ml(m_pool->m_mutex);
+  m_pool->m_blockedThreads++;
+  // Hand a queued job to a new thread rather than let it wait for the lock.
+  if (m_pool->m_pendingJobs) {
+    m_pool->m_pendingJobs--;
+    m_pool->m_threads.emplace_back(new WorkerThread(*m_pool));
+  }
+}
+
+BackendVFS::WorkerPool::BlockedSection::~BlockedSection() {
+  if (!m_pool) return;
+  threading::MutexLocker ml(m_pool->m_mutex);
+  m_pool->m_blockedThreads--;
+}
+
+void BackendVFS::WorkerPool::WorkerThread::run() {
+  t_currentPool = &m_pool;
+  while (true) {
+    std::unique_ptr<std::packaged_task<void()>> task(m_pool.m_jobQueue.pop());
+    if (!task) break;
+    // The packaged task stores the job's exception, if any, in the future.
+    (*task)();
+    threading::MutexLocker ml(m_pool.m_mutex);
+    if (m_pool.m_pendingJobs) {
+      m_pool.m_pendingJobs--;
+    } else {
+      m_pool.m_idleThreads++;
+    }
+  }
+}
+
+const size_t BackendVFS::c_maxBatchThreads = 16;
+
+void BackendVFS::runBatch(std::vector<BatchResult>& results, const std::function<void(size_t)>& op) {
+  // Each job handles a strided subset of the batch.
+  const size_t threadCount = std::min(results.size(), c_maxBatchThreads);
+  std::list<std::future<void>> jobs;
+  for (size_t t = 0; t < threadCount; t++) {
+    jobs.emplace_back(m_workerPool->submit([&results, &op, t, threadCount]() {
+      for (size_t i = t; i < results.size(); i += threadCount) {
+        try {
+          op(i);
+        } catch (...) {
+          results[i].exception = std::current_exception();
+        }
+      }
+    }));
+  }
+  for (auto & j: jobs) j.get();
+}
+
+std::vector<Backend::BatchResult> BackendVFS::multiRead(const std::vector<std::string>& names) {
+  std::vector<BatchResult> ret(names.size());
+  runBatch(ret, [&](size_t i) { ret[i].content = read(names[i]); });
+  return ret;
+}
+
+std::vector<Backend::BatchResult> BackendVFS::multiCreate(const std::vector<std::pair<std::string, std::string> >& objects) {
+  std::vector<BatchResult> ret(objects.size());
+  runBatch(ret, [&](size_t i) { create(objects[i].first, objects[i].second); });
+  return ret;
+}
+
+std::vector<Backend::BatchResult> BackendVFS::multiRemove(const std::vector<std::string>& names) {
+  std::vector<BatchResult> ret(names.size());
+  runBatch(ret, [&](size_t i) {
+    try {
+      remove(names[i]);
+    } catch (cta::exception::Errnum & ex) {
+      if (ENOENT == ex.errorNumber())
+        throw Backend::NoSuchObject("In BackendVFS::multiRemove(): no such object: " + names[i]);
+      throw;
+    }
+  });
+  return ret;
+}
+
 std::string BackendVFS::Parameters::toStr() {
   std::stringstream ret;
   ret << "path=" << m_path;
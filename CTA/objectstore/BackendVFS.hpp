@@ -19,8 +19,13 @@
 
 #include "Backend.hpp"
 #include "common/threading/Thread.hpp"
+#include "common/threading/BlockingQueue.hpp"
+#include "common/threading/Mutex.hpp"
 #include <future>
 #include <functional>
+#include <list>
+#include <memory>
+#include <vector>
 
 namespace cta { namespace objectstore {
 /**
@@ -91,7 +96,7 @@ public:
   ScopedLock * lockShared(std::string name, uint64_t timeout_us=0) override;
 
   /**
-   * A class mimicking AIO using C++ async tasks
+   * A class mimicking AIO using jobs executed by the worker pool
    */
   class AsyncCreator: public Backend::AsyncCreator {
   public:
@@ -109,7 +114,7 @@ public:
   };
   
   /**
-   * A class mimicking AIO using C++ async tasks
+   * A class mimicking AIO using jobs executed by the worker pool
    */
   class AsyncUpdater: public Backend::AsyncUpdater {
   public:
@@ -127,7 +132,7 @@ public:
   };
 
   /**
-   * A class mimicking AIO using C++ async tasks
+   * A class mimicking AIO using jobs executed by the worker pool
    */
   class AsyncDeleter: public Backend::AsyncDeleter {
   public:
@@ -143,9 +148,9 @@ public:
   };
   
   /**
-   * A class mimicking AIO using C++ async tasks
+   * A class mimicking AIO using jobs executed by the worker pool
    */
-  class AsyncLockfreeFetcher: public Backend::AsyncLockfreeFetcher, public cta::threading::Thread  {
+  class AsyncLockfreeFetcher: public Backend::AsyncLockfreeFetcher {
   public:
     AsyncLockfreeFetcher(BackendVFS & be, const std::string & name);
     std::string wait() override;
@@ -156,12 +161,8 @@ public:
     const std::string m_name;
     /** The fetched value */
     std::string m_value;
-    /** The exception we might receive */
-    std::exception_ptr m_exception = nullptr;
-    /** A mutex to make helgrind happy */
-    cta::threading::Mutex m_mutex;
-    /** The thread that will both do the job and allow synchronization with the caller. */
-    void run() override;
+     /** The future that will both do the job and allow synchronization with the caller. */
+    std::future<void> m_job;
   };
   
   Backend::AsyncCreator* asyncCreate(const std::string& name, const std::string& value) override;
@@ -172,6 +173,12 @@ public:
   
   Backend::AsyncLockfreeFetcher* asyncLockfreeFetch(const std::string& name) override;
 
+  std::vector<BatchResult> multiRead(const std::vector<std::string> & names) override;
+
+  std::vector<BatchResult> multiCreate(const std::vector<std::pair<std::string, std::string>> & objects) override;
+
+  std::vector<BatchResult> multiRemove(const std::vector<std::string> & names) override;
+
   class Parameters: public Backend::Parameters {
     friend class BackendVFS;
   public:
@@ -205,9 +212,77 @@ public:
 
 
 private:
+  /**
+   * A bounded pool of reusable worker threads executing the asynchronous
+   * operations (instead of one short lived thread per operation). Threads are
+   * started on demand, when no worker is idle, up to the maximum. Jobs are
+   * queued beyond that.
+   * The workers blocked in a lock (see BlockedSection) do not count against the
+   * maximum: a worker entering a lock starts a thread for a queued job, so the
+   * jobs do not wait behind locks which could be held by their submitters. The
+   * pool can then exceed the maximum by the number of workers blocked at the
+   * same time. All the threads are kept until the pool is destroyed.
+   */
+  class WorkerPool {
+  public:
+    WorkerPool(size_t maxThreads);
+    ~WorkerPool();
+    /**
+     * Queues a job for execution
+     * @param job the job
+     * @return a future allowing to wait for the job (and get its exception)
+     */
+    std::future<void> submit(std::function<void()> job);
+    /**
+     * Marks the current thread as blocked for the lifetime of the object, if it
+     * is a worker of the pool. Has no effect in any other thread.
+     */
+    class BlockedSection {
+    public:
+      BlockedSection(WorkerPool * pool);
+      ~BlockedSection();
+    private:
+      WorkerPool * m_pool = nullptr;
+    };
+  private:
+    class WorkerThread: private cta::threading::Thread {
+    public:
+      WorkerThread(WorkerPool & pool): m_pool(pool) { start(); }
+      void wait() { cta::threading::Thread::wait(); }
+    private:
+      WorkerPool & m_pool;
+      void run() override;
+    };
+    const size_t m_maxThreads;
+    /** The jobs. A nullptr job instructs a worker to exit. */
+    cta::threading::BlockingQueue<std::packaged_task<void()> *> m_jobQueue;
+    /** Protects the thread list and the counters */
+    cta::threading::Mutex m_mutex;
+    std::vector<std::unique_ptr<WorkerThread>> m_threads;
+    /** Number of workers waiting for a job and not promised to one yet */
+    size_t m_idleThreads = 0;
+    /** Number of workers in a BlockedSection */
+    size_t m_blockedThreads = 0;
+    /** Number of queued jobs no worker is promised to yet */
+    size_t m_pendingJobs = 0;
+    /** The pool the current thread is a worker of, if any */
+    static thread_local WorkerPool * t_currentPool;
+  };
+
   std::string m_root;
   bool m_deleteOnExit;
+  /** Maximum number of worker threads for the asynchronous operations */
+  static const size_t c_maxWorkerThreads;
+  /** The pool executing the asynchronous operations. Declared last so it is created
+   * after (and destroyed before) the rest of the backend. */
+  std::unique_ptr<WorkerPool> m_workerPool;
   ScopedLock * lockHelper(std::string name, int type, uint64_t timeout_us);
+  /**
+   * Runs op(i) for every index of results, spread over at most c_maxBatchThreads
+   * jobs of the worker pool. Exceptions thrown by op(i) are stored in results[i].
+   */
+  void runBatch(std::vector<BatchResult> & results, const std::function<void(size_t)> & op);
+  static const size_t c_maxBatchThreads;
 };
 
 
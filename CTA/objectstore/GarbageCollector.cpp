@@ -208,47 +208,31 @@ void GarbageCollector::OwnedObjectSorter::fetchOwnedObjects(Agent& agent, std::l
   // Parallel fetch (lock free) all the objects to assess their status (check ownership,
   // type and decide to which queue they will go.
   std::list<std::shared_ptr<GenericObject>> ownedObjects;
-  std::map<GenericObject *, std::unique_ptr<GenericObject::AsyncLockfreeFetcher>> ownedObjectsFetchers;
   // This will be the list of objects we failed to garbage collect. This means the garbage collection
   // will be partial (looping?).
   std::list<std::string> skippedObjects;
   // This will be the list of objects that are simply gone. We will still need to remove the from the ownership
   // list of agent.
   std::list<std::string> goneObjects;
-  // 1 launch the async fetch of all the objects.
+  // 1 fetch all the objects in one batch.
   for (auto & obj : ownedObjectAddresses) {
     // Fetch generic objects
     ownedObjects.emplace_back(new GenericObject(obj, objectStore));
-    try {
-      ownedObjectsFetchers[ownedObjects.back().get()].reset(ownedObjects.back()->asyncLockfreeFetch());
-    } catch (cta::exception::Exception & ex) {
-      // We failed to lauch the fetch. This is unepected (absence of object will come later). We will not be able
-      // to garbage collect this object.
-      skippedObjects.emplace_back(obj);
-      // Cleanup object reference. We will skip on this object. That means the garbage collection will
-      // be left incomplete
-      ownedObjectsFetchers.erase(ownedObjects.back().get());
-      ownedObjects.pop_back();
-      // Log the error.
-      log::ScopedParamContainer params(lc);
-      params.add("objectAddress", obj)
-            .add("exceptionMessage", ex.getMessageValue());
-      lc.log(log::ERR, "In GarbageCollector::OwnedObjectSorter::fetchOwnedObjects(): "
-          "failed to asyncLockfreeFetch(): skipping object. Garbage collection will be incomplete.");
-    }
   }
+  auto ownedObjectsFetchResults = GenericObject::multiLockfreeFetch(objectStore, ownedObjects);
   
   // 2 find out the result of the fetches
   bool ownershipUdated=false;
+  auto ofr = ownedObjectsFetchResults.begin();
   for (auto & obj : ownedObjects) {
     log::ScopedParamContainer params2(lc);
     params2.add("objectAddress", obj->getAddressIfSet());
     try {
-      ownedObjectsFetchers.at(obj.get())->wait();
+      auto fetchResult = *(ofr++);
+      if (fetchResult) std::rethrow_exception(fetchResult);
     } catch (Backend::NoSuchObject & ex) {
       goneObjects.push_back(obj->getAddressIfSet());
       lc.log(log::INFO, "In GarbageCollector::OwnedObjectSorter::fetchOwnedObjects(): skipping garbage collection of now gone object.");
-      ownedObjectsFetchers.erase(obj.get());
       agent.removeFromOwnership(obj->getAddressIfSet());
       ownershipUdated=true;
       continue;
@@ -257,12 +241,10 @@ void GarbageCollector::OwnedObjectSorter::fetchOwnedObjects(Agent& agent, std::l
       skippedObjects.push_back(obj->getAddressIfSet());
       params2.add("exceptionMessage", ex.getMessageValue());
       lc.log(log::ERR, "In GarbageCollector::OwnedObjectSorter::fetchOwnedObjects(): "
-          "failed to AsyncLockfreeFetch::wait(): skipping object. Garbage collection will be incomplete.");
-      ownedObjectsFetchers.erase(obj.get());
+          "failed to lockfree fetch: skipping object. Garbage collection will be incomplete.");
       continue;
     }
     // This object passed the cut, we can record it for next round.
-    ownedObjectsFetchers.erase(obj.get());
     fetchedObjects.emplace_back(obj);
   }
   // The generic objects we are interested in are now also stored in fetchedObjects.
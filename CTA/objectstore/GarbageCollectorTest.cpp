@@ -162,6 +162,88 @@ TEST(ObjectStore, GarbageCollectorRegister) {
   ASSERT_NO_THROW(re.removeIfEmpty(lc));
 }
 
+TEST(ObjectStore, GarbageCollectorOwnershipJournals) {
+  // We will need a log object 
+#ifdef STDOUT_LOGGING
+  cta::log::StdoutLogger dl("dummy", "unitTest");
+#else
+  cta::log::DummyLogger dl("dummy", "unitTest");
+#endif
+  cta::log::LogContext lc(dl);
+  cta::catalogue::DummyCatalogue catalogue;
+  // Here we check that the ownership recorded in journals by the agent reference
+  // is recovered by the garbage collector.
+  cta::objectstore::BackendVFS be;
+  cta::objectstore::AgentReference agentRef("unitTestGarbageCollector", dl);
+  // Create the root entry
+  cta::objectstore::RootEntry re(be);
+  re.initialize();
+  re.insert();
+  // Create the agent register
+    cta::objectstore::EntryLogSerDeser el("user0",
+      "unittesthost", time(NULL));
+  cta::objectstore::ScopedExclusiveLock rel(re);
+  re.addOrGetAgentRegisterPointerAndCommit(agentRef, el, lc);
+  rel.release();
+  cta::objectstore::AgentReference agrA("unitTestAgentA", dl);
+  cta::objectstore::Agent agA(agrA.getAgentAddress(), be);
+  agA.initialize();
+  agA.setTimeout_us(0);
+  agA.insertAndRegisterSelf(lc);
+  // Create agent registers owned by agA, one ownership batch each, and then
+  // release one in five of them.
+  std::set<std::string> ownedObjects;
+  std::list<std::string> releasedObjects;
+  for (size_t i=0; i<100; i++) {
+    std::string arName = agrA.nextId("AgentRegister");
+    cta::objectstore::AgentRegister ar(arName, be);
+    ar.initialize();
+    ar.setOwner(agrA.getAgentAddress());
+    agrA.addToOwnership(arName, be);
+    ar.insert();
+    ownedObjects.insert(arName);
+    if (!(i % 5)) releasedObjects.push_back(arName);
+  }
+  for (auto & arName: releasedObjects) {
+    agrA.removeFromOwnership(arName, be);
+    be.remove(arName);
+    ownedObjects.erase(arName);
+  }
+  // The merges keep a logarithmic number of journals.
+  {
+    cta::objectstore::ScopedSharedLock agAl(agA);
+    agA.fetch();
+    ASSERT_EQ(ownedObjects, agA.getOwnershipSet());
+    ASSERT_LE(1, agA.getOwnershipJournalsCount());
+    ASSERT_GE(8, agA.getOwnershipJournalsCount());
+  }
+  // Create the garbage colletor and run it twice.
+  cta::objectstore::AgentReference gcAgentRef("unitTestGarbageCollector", dl);
+  cta::objectstore::Agent gcAgent(gcAgentRef.getAgentAddress(), be);
+  gcAgent.initialize();
+  gcAgent.setTimeout_us(0);
+  gcAgent.insertAndRegisterSelf(lc);
+  {
+    cta::objectstore::GarbageCollector gc(be, gcAgentRef, catalogue);
+    gc.runOnePass(lc);
+    gc.runOnePass(lc);
+  }
+  for (auto & arName: ownedObjects) ASSERT_FALSE(be.exists(arName));
+  ASSERT_FALSE(be.exists(agrA.getAgentAddress()));
+  // Unregister gc's agent
+  cta::objectstore::ScopedExclusiveLock gcal(gcAgent);
+  gcAgent.fetch();
+  gcAgent.removeAndUnregisterSelf(lc);
+  // The journals were deleted with the agents (the last ones merged by gc's
+  // agent are only obsolete until its next commit or its removal).
+  for (auto & objectName: be.list()) ASSERT_EQ(std::string::npos, objectName.find("AgentOwnershipJournal"));
+  // We should not be able to remove the agent register (as it should be empty)
+  rel.lock(re);
+  re.fetch();
+  ASSERT_NO_THROW(re.removeAgentRegisterAndCommit(lc));
+  ASSERT_NO_THROW(re.removeIfEmpty(lc));
+}
+
 TEST(ObjectStore, GarbageCollectorArchiveQueue) {
   // We will need a log object 
 #ifdef STDOUT_LOGGING
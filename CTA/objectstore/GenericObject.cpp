@@ -18,6 +18,7 @@
 #include "GenericObject.hpp"
 #include "AgentRegister.hpp"
 #include "Agent.hpp"
+#include "AgentOwnershipJournal.hpp"
 #include "ArchiveRequest.hpp"
 #include "DriveRegister.hpp"
 #include "RootEntry.hpp"
@@ -179,6 +180,9 @@ std::string GenericObject::dump() {
     case serializers::Agent_t:
       bodyDump = dumpWithType<Agent>(this);
       break;
+    case serializers::AgentOwnershipJournal_t:
+      bodyDump = dumpWithType<AgentOwnershipJournal>(this);
+      break;
     case serializers::DriveRegister_t:
       bodyDump = dumpWithType<DriveRegister>(this);
       break;
@@ -28,6 +28,8 @@
 #include "common/exception/NonRetryableError.hpp"
 #include "common/range.hpp"
 #include "common/log/TimingList.hpp"
+#include "common/threading/RWLockRdLocker.hpp"
+#include "common/threading/RWLockWrLocker.hpp"
 #include <random>
 
 namespace cta { namespace objectstore {
@@ -365,84 +367,81 @@ std::string Helpers::selectBestRetrieveQueue(const std::set<std::string>& candid
     objectstore::Backend & objectstore, bool forceDisabledTape) {
   // We will build the retrieve stats of the non-disable candidate vids here
   std::list<SchedulerDatabase::RetrieveQueueStatistics> candidateVidsStats;
-  // A promise we create so we can make users wait on it.
-  // Take the global lock
-  cta::threading::MutexLocker grqsmLock(g_retrieveQueueStatisticsMutex);
-  // Create a promise just in case
-  // Find the vids to be fetched (if any).
+  auto addIfUsable = [&](const RetrieveQueueStatisticsWithTime & entry) {
+    if (entry.tapeStatus.state == common::dataStructures::Tape::ACTIVE || (entry.tapeStatus.isDisabled() && forceDisabledTape))
+      candidateVidsStats.emplace_back(entry.stats);
+  };
+  // Vids for which we refresh the cache and vids for which we wait on a refresh by another thread.
+  std::set<std::string> vidsToRefresh;
+  std::set<std::string> vidsToWaitFor;
+  std::list<std::shared_future<void>> updateFutures;
+  // A single promise covers all the entries we refresh, as they are refreshed together.
+  std::promise<void> updatePromise;
+  std::shared_future<void> updateFuture(updatePromise.get_future());
+  const time_t now = time(nullptr);
   for (auto & v: candidateVids) {
+    auto & shard = getRetrieveQueueStatisticsShard(v);
+    {
+      // Fast path, under the read lock: fresh entries are used as is. Stale entries being refreshed by another
+      // thread are used too, rather than waiting for the refresh.
+      threading::RWLockRdLocker rdLock(shard.lock);
+      auto e = shard.entries.find(v);
+      if (e != shard.entries.end() && e->second.updateTime &&
+          (e->second.updating || now - e->second.updateTime <= c_retrieveQueueCacheMaxAge)) {
+        logUpdateCacheIfNeeded(false, e->second, "Cache hit, updating=" + std::to_string(e->second.updating));
+        addIfUsable(e->second);
+        continue;
+      }
+    }
+    // Miss or stale entry: take the write lock and claim the refresh, unless another thread did it in the meantime.
+    threading::RWLockWrLocker wrLock(shard.lock);
+    auto & entry = shard.entries[v];
+    if (entry.updateTime && (entry.updating || now - entry.updateTime <= c_retrieveQueueCacheMaxAge)) {
+      addIfUsable(entry);
+    } else if (entry.updating) {
+      // The entry is being created by another thread: we will wait for it.
+      logUpdateCacheIfNeeded(false, entry, "Entry being created by another thread");
+      vidsToWaitFor.insert(v);
+      updateFutures.emplace_back(entry.updateFuture);
+    } else {
+      logUpdateCacheIfNeeded(false, entry, "Cache miss or stale entry, cache needs to be updated");
+      entry.updating = true;
+      entry.updateFuture = updateFuture;
+      vidsToRefresh.insert(v);
+    }
+  }
+  // Refresh all the entries we claimed at once, without holding any lock.
+  if (vidsToRefresh.size()) {
     try {
-      // Out of range or outdated will be updated the same way.
-      // If an update is in progress, we wait on it, and get the result after.
-      // We have to release the global lock while doing so.
-      if (g_retrieveQueueStatistics.at(v).updating) {
-        logUpdateCacheIfNeeded(false,g_retrieveQueueStatistics.at(v),"g_retrieveQueueStatistics.at(v).updating");
-        // Cache is updating, we wait on update.
-        auto updateFuture = g_retrieveQueueStatistics.at(v).updateFuture;
-        grqsmLock.unlock();
-        updateFuture.wait();
-        grqsmLock.lock();
-        if(g_retrieveQueueStatistics.at(v).tapeStatus.state == common::dataStructures::Tape::ACTIVE || (g_retrieveQueueStatistics.at(v).tapeStatus.isDisabled() && forceDisabledTape)) {
-          logUpdateCacheIfNeeded(false,g_retrieveQueueStatistics.at(v),"g_retrieveQueueStatistics.at(v).tapeStatus.state == common::dataStructures::Tape::ACTIVE || (g_retrieveQueueStatistics.at(v).tapeStatus.isDisabled() && forceDisabledTape)");
-          candidateVidsStats.emplace_back(g_retrieveQueueStatistics.at(v).stats);
-        }
-      } else {
-        // We have a cache hit, check it's not stale.
-        time_t timeSinceLastUpdate = time(nullptr) - g_retrieveQueueStatistics.at(v).updateTime;
-        if (timeSinceLastUpdate > c_retrieveQueueCacheMaxAge){
-          logUpdateCacheIfNeeded(false,g_retrieveQueueStatistics.at(v),"timeSinceLastUpdate ("+std::to_string(timeSinceLastUpdate)+")> c_retrieveQueueCacheMaxAge ("
-                  +std::to_string(c_retrieveQueueCacheMaxAge)+"), cache needs to be updated");
-          throw std::out_of_range("");
+      refreshRetrieveQueueStatisticsCache(vidsToRefresh, catalogue, objectstore);
+    } catch (...) {
+      // Release the entries so the next caller will retry, and pass the failure to the threads waiting on us.
+      for (auto & v: vidsToRefresh) {
+        auto & shard = getRetrieveQueueStatisticsShard(v);
+        threading::RWLockWrLocker wrLock(shard.lock);
+        auto e = shard.entries.find(v);
+        if (e == shard.entries.end()) continue;
+        if (!e->second.updateTime) {
+          shard.entries.erase(e);
+        } else {
+          e->second.updating = false;
+          e->second.updateFuture = std::shared_future<void>();
         }
-
-        logUpdateCacheIfNeeded(false,g_retrieveQueueStatistics.at(v),"Cache is not updated, timeSinceLastUpdate ("+std::to_string(timeSinceLastUpdate)+
-        ") <= c_retrieveQueueCacheMaxAge ("+std::to_string(c_retrieveQueueCacheMaxAge)+")");
-        // We're lucky: cache hit (and not stale)
-        if (g_retrieveQueueStatistics.at(v).tapeStatus.state == common::dataStructures::Tape::ACTIVE || (g_retrieveQueueStatistics.at(v).tapeStatus.isDisabled() && forceDisabledTape))
-          candidateVidsStats.emplace_back(g_retrieveQueueStatistics.at(v).stats);
-      }
-    } catch (std::out_of_range &) {
-      // We need to update the entry in the cache (miss or stale, we handle the same way).
-      // We just update one vid at a time as doing several in parallel would be quite
-      // hairy lock-wise (but give a slight performance boost).
-      g_retrieveQueueStatistics[v].updating = true;
-      std::promise<void> updatePromise;
-      g_retrieveQueueStatistics[v].updateFuture = updatePromise.get_future();
-      // Give other threads a chance to access the cache for other vids.
-      grqsmLock.unlock();
-      // Get the informations (stages, so we don't access the global variable without the mutex.
-      auto tapeStatus=catalogue.getTapesByVid({v});
-      // Build a minimal service  retrieve file queue criteria to query queues.
-      common::dataStructures::RetrieveFileQueueCriteria rfqc;
-      common::dataStructures::TapeFile tf;
-      tf.copyNb = 1;
-      tf.vid = v;
-      rfqc.archiveFile.tapeFiles.push_back(tf);
-      auto queuesStats=Helpers::getRetrieveQueueStatistics(rfqc, {v}, objectstore);
-      // We now have the data we need. Update the cache.
-      grqsmLock.lock();
-      g_retrieveQueueStatistics[v].updating=false;
-      g_retrieveQueueStatistics[v].updateFuture=std::shared_future<void>();
-      // Check we got the expected vid (and size of stats).
-      if (queuesStats.size()!=1)
-        throw cta::exception::Exception("In Helpers::selectBestRetrieveQueue(): unexpected size for queueStats.");
-      if (queuesStats.front().vid!=v)
-        throw cta::exception::Exception("In Helpers::selectBestRetrieveQueue(): unexpected vid in queueStats.");
-      if (tapeStatus.size()!=1)
-        throw cta::exception::Exception("In Helpers::selectBestRetrieveQueue(): unexpected size for tapeStatus.");
-      if (tapeStatus.begin()->first!=v)
-        throw cta::exception::Exception("In Helpers::selectBestRetrieveQueue(): unexpected vid in tapeStatus.");
-      g_retrieveQueueStatistics[v].stats = queuesStats.front();
-      g_retrieveQueueStatistics[v].tapeStatus = tapeStatus.at(v);
-      g_retrieveQueueStatistics[v].updateTime = time(nullptr);
-      logUpdateCacheIfNeeded(true,g_retrieveQueueStatistics[v]);
-      // Signal to potential waiters
-      updatePromise.set_value();
-      // Update our own candidate list if needed.
-      if (g_retrieveQueueStatistics.at(v).tapeStatus.state == common::dataStructures::Tape::ACTIVE || (g_retrieveQueueStatistics.at(v).tapeStatus.isDisabled() && forceDisabledTape)) {
-        candidateVidsStats.emplace_back(g_retrieveQueueStatistics.at(v).stats);
       }
+      updatePromise.set_exception(std::current_exception());
+      throw;
     }
+    updatePromise.set_value();
+  }
+  // Wait for the entries refreshed by other threads (get() rethrows their failure, if any).
+  for (auto & f: updateFutures) f.get();
+  vidsToRefresh.insert(vidsToWaitFor.begin(), vidsToWaitFor.end());
+  for (auto & v: vidsToRefresh) {
+    auto & shard = getRetrieveQueueStatisticsShard(v);
+    threading::RWLockRdLocker rdLock(shard.lock);
+    auto e = shard.entries.find(v);
+    // The entry can only have disappeared if the cache was flushed in the meantime.
+    if (e != shard.entries.end()) addIfUsable(e->second);
   }
   // We now have all the candidates listed (if any).
   if (candidateVidsStats.empty())
@@ -468,6 +467,48 @@ std::string Helpers::selectBestRetrieveQueue(const std::set<std::string>& candid
   return *it;
 }
 
+//------------------------------------------------------------------------------
+// Helpers::refreshRetrieveQueueStatisticsCache()
+//------------------------------------------------------------------------------
+void Helpers::refreshRetrieveQueueStatisticsCache(const std::set<std::string>& vids, cta::catalogue::Catalogue& catalogue,
+    objectstore::Backend& objectstore) {
+  // One catalogue query for all the tapes.
+  auto tapeStatus = catalogue.getTapesByVid(vids);
+  // Build a minimal service retrieve file queue criteria to query queues.
+  common::dataStructures::RetrieveFileQueueCriteria rfqc;
+  for (auto & v: vids) {
+    common::dataStructures::TapeFile tf;
+    tf.copyNb = 1;
+    tf.vid = v;
+    rfqc.archiveFile.tapeFiles.push_back(tf);
+  }
+  auto queuesStats = Helpers::getRetrieveQueueStatistics(rfqc, vids, objectstore);
+  // Check we got the expected vids (and size of stats) before touching the cache.
+  if (queuesStats.size() != vids.size())
+    throw cta::exception::Exception("In Helpers::refreshRetrieveQueueStatisticsCache(): unexpected size for queueStats.");
+  if (tapeStatus.size() != vids.size())
+    throw cta::exception::Exception("In Helpers::refreshRetrieveQueueStatisticsCache(): unexpected size for tapeStatus.");
+  for (auto & qs: queuesStats) {
+    if (!vids.count(qs.vid))
+      throw cta::exception::Exception("In Helpers::refreshRetrieveQueueStatisticsCache(): unexpected vid in queueStats.");
+    if (!tapeStatus.count(qs.vid))
+      throw cta::exception::Exception("In Helpers::refreshRetrieveQueueStatisticsCache(): unexpected vid in tapeStatus.");
+  }
+  // We now have the data we need. Update the cache.
+  const time_t now = time(nullptr);
+  for (auto & qs: queuesStats) {
+    auto & shard = getRetrieveQueueStatisticsShard(qs.vid);
+    threading::RWLockWrLocker wrLock(shard.lock);
+    auto & entry = shard.entries[qs.vid];
+    entry.stats = qs;
+    entry.tapeStatus = tapeStatus.at(qs.vid);
+    entry.updateTime = now;
+    entry.updating = false;
+    entry.updateFuture = std::shared_future<void>();
+    logUpdateCacheIfNeeded(true, entry);
+  }
+}
+
 //------------------------------------------------------------------------------
 // Helpers::updateRetrieveQueueStatisticsCache()
 //------------------------------------------------------------------------------
@@ -476,40 +517,50 @@ void Helpers::updateRetrieveQueueStatisticsCache(const std::string& vid, uint64_
   // We will also not update the update time, to force an update after a while.
   // If we update the entry while another thread is updating it, this is harmless (cache users will
   // anyway wait, and just not profit from our update.
-  threading::MutexLocker ml(g_retrieveQueueStatisticsMutex);
-  try {
-    g_retrieveQueueStatistics.at(vid).stats.filesQueued=files;
-    g_retrieveQueueStatistics.at(vid).stats.bytesQueued=bytes;
-    g_retrieveQueueStatistics.at(vid).stats.currentPriority = priority;
-    logUpdateCacheIfNeeded(false,g_retrieveQueueStatistics.at(vid));
-  } catch (std::out_of_range &) {
+  auto & shard = getRetrieveQueueStatisticsShard(vid);
+  threading::RWLockWrLocker wrLock(shard.lock);
+  auto e = shard.entries.find(vid);
+  if (e != shard.entries.end()) {
+    e->second.stats.filesQueued=files;
+    e->second.stats.bytesQueued=bytes;
+    e->second.stats.currentPriority = priority;
+    logUpdateCacheIfNeeded(false,e->second);
+  } else {
     // The entry is missing. We just create it.
-    g_retrieveQueueStatistics[vid].stats.bytesQueued=bytes;
-    g_retrieveQueueStatistics[vid].stats.filesQueued=files;
-    g_retrieveQueueStatistics[vid].stats.currentPriority=priority;
-    g_retrieveQueueStatistics[vid].stats.vid=vid;
-    g_retrieveQueueStatistics[vid].tapeStatus.state = common::dataStructures::Tape::ACTIVE;
-    g_retrieveQueueStatistics[vid].tapeStatus.full=false;
-    g_retrieveQueueStatistics[vid].updating = false;
-    g_retrieveQueueStatistics[vid].updateTime = time(nullptr);
-    logUpdateCacheIfNeeded(true,g_retrieveQueueStatistics[vid]);
+    auto & entry = shard.entries[vid];
+    entry.stats.bytesQueued=bytes;
+    entry.stats.filesQueued=files;
+    entry.stats.currentPriority=priority;
+    entry.stats.vid=vid;
+    entry.tapeStatus.state = common::dataStructures::Tape::ACTIVE;
+    entry.tapeStatus.full=false;
+    entry.updating = false;
+    entry.updateTime = time(nullptr);
+    logUpdateCacheIfNeeded(true,entry);
   }
 }
 
+//------------------------------------------------------------------------------
+// Helpers::flushRetrieveQueueStatisticsCache()
+//------------------------------------------------------------------------------
 void Helpers::flushRetrieveQueueStatisticsCache(){
-  threading::MutexLocker ml(g_retrieveQueueStatisticsMutex);
-  g_retrieveQueueStatistics.clear();
+  for (auto & shard: g_retrieveQueueStatistics) {
+    threading::RWLockWrLocker wrLock(shard.lock);
+    shard.entries.clear();
+  }
 }
 
 //------------------------------------------------------------------------------
-// Helpers::g_retrieveQueueStatistics
+// Helpers::getRetrieveQueueStatisticsShard()
 //------------------------------------------------------------------------------
-std::map<std::string, Helpers::RetrieveQueueStatisticsWithTime> Helpers::g_retrieveQueueStatistics;
+Helpers::RetrieveQueueStatisticsShard & Helpers::getRetrieveQueueStatisticsShard(const std::string& vid) {
+  return g_retrieveQueueStatistics[std::hash<std::string>()(vid) % c_retrieveQueueStatisticsShards];
+}
 
 //------------------------------------------------------------------------------
-// Helpers::g_retrieveQueueStatisticsMutex
+// Helpers::g_retrieveQueueStatistics
 //------------------------------------------------------------------------------
-cta::threading::Mutex Helpers::g_retrieveQueueStatisticsMutex;
+Helpers::RetrieveQueueStatisticsShard Helpers::g_retrieveQueueStatistics[Helpers::c_retrieveQueueStatisticsShards];
 
 //------------------------------------------------------------------------------
 // Helpers::getRetrieveQueueStatistics()
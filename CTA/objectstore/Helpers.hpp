@@ -20,6 +20,7 @@
 #include "scheduler/SchedulerDatabase.hpp"
 #include "common/threading/Mutex.hpp"
 #include "common/threading/MutexLocker.hpp"
+#include "common/threading/RWLock.hpp"
 #include "catalogue/Catalogue.hpp"
 #include "scheduler/OStoreDB/OStoreDB.hpp"
 #include "JobQueueType.hpp"
@@ -106,20 +107,39 @@ public:
   static void flushRetrieveQueueStatisticsCache();
 
 private:
-  /** Lock for the retrieve queues stats */
-  static cta::threading::Mutex g_retrieveQueueStatisticsMutex;
   /** A struct holding together RetrieveQueueStatistics, tape status and an update time. */
   struct RetrieveQueueStatisticsWithTime {
     cta::SchedulerDatabase::RetrieveQueueStatistics stats;
     cta::common::dataStructures::Tape tapeStatus;
-    bool updating;
-    /** The shared future will allow all updating safely an entry of the cache while
-     * releasing the global mutex to allow threads interested in other VIDs to carry on.*/
+    /** True while a thread refreshes the entry. Other threads keep using the previous value if any. */
+    bool updating = false;
+    /** Threads needing an entry which has no value yet wait on this future. It is shared by all the
+     * entries refreshed together, and holds the exception if the refresh failed. */
     std::shared_future<void> updateFuture;
-    time_t updateTime;
+    /** Time of the last update, 0 if the entry has no value yet. */
+    time_t updateTime = 0;
   };
-  /** The stats for the queues */
-  static std::map<std::string, RetrieveQueueStatisticsWithTime> g_retrieveQueueStatistics;
+  /**
+   * A shard of the retrieve queue statistics cache. The cache is read far more often than it is
+   * updated, so each shard is protected by a read-write lock, and vids are spread over the shards
+   * to avoid all the threads queueing on the same lock.
+   */
+  struct RetrieveQueueStatisticsShard {
+    cta::threading::RWLock lock;
+    std::map<std::string, RetrieveQueueStatisticsWithTime> entries;
+  };
+  /** Number of shards of the retrieve queue statistics cache */
+  static const size_t c_retrieveQueueStatisticsShards = 32;
+  /** The stats for the queues, sharded by vid */
+  static RetrieveQueueStatisticsShard g_retrieveQueueStatistics[c_retrieveQueueStatisticsShards];
+  /** Returns the shard holding the entry of a vid */
+  static RetrieveQueueStatisticsShard & getRetrieveQueueStatisticsShard(const std::string & vid);
+  /**
+   * Fetches the tape status (in a single catalogue query) and the queue statistics of a set of
+   * vids, and stores them in the cache.
+   */
+  static void refreshRetrieveQueueStatisticsCache(const std::set<std::string> & vids,
+    cta::catalogue::Catalogue & catalogue, objectstore::Backend & objectstore);
   /** Time between cache updates */
   static const time_t c_retrieveQueueCacheMaxAge = 10;
   static void logUpdateCacheIfNeeded(const bool entryCreation,const RetrieveQueueStatisticsWithTime& tapeStatistic, std::string message="");
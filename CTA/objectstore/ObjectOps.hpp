@@ -23,6 +23,8 @@
 #include "common/log/LogContext.hpp"
 #include "catalogue/Catalogue.hpp"
 #include <memory>
+#include <list>
+#include <vector>
 #include <stdint.h>
 #include <cryptopp/base64.h>
 
@@ -461,10 +463,7 @@ public:
       // Current simplification: the parsing of the header/payload is synchronous.
       // This could be delegated to the backend.
       auto objData = m_asyncLockfreeFetcher->wait();
-      m_obj.m_noLock = true;
-      m_obj.m_existingObject = true;
-      m_obj.getHeaderFromObjectData(objData);
-      m_obj.getPayloadFromHeader();
+      m_obj.interpretLockfreeFetchedData(objData);
     }
   private:
     ObjectOps & m_obj;
@@ -479,6 +478,46 @@ public:
     return ret.release();
   }
   
+  /**
+   * Lock free fetch of several objects with a single batched backend read
+   * (instead of one round trip per object). The collection holds the objects
+   * themselves or shared pointers to them.
+   * @param objectStore the backend holding the objects
+   * @param objects the objects to fetch
+   * @return one entry per object, in the same order: nullptr if the object was
+   * fetched, the exception (typically Backend::NoSuchObject) otherwise.
+   */
+  template <class ObjectType>
+  static std::vector<std::exception_ptr> multiLockfreeFetch(Backend & objectStore, std::list<ObjectType> & objects) {
+    std::vector<ObjectOps *> objectPointers;
+    for (auto & o: objects) objectPointers.emplace_back(&o);
+    return multiLockfreeFetch(objectStore, objectPointers);
+  }
+
+  template <class ObjectType>
+  static std::vector<std::exception_ptr> multiLockfreeFetch(Backend & objectStore, std::list<std::shared_ptr<ObjectType>> & objects) {
+    std::vector<ObjectOps *> objectPointers;
+    for (auto & o: objects) objectPointers.emplace_back(o.get());
+    return multiLockfreeFetch(objectStore, objectPointers);
+  }
+
+  static std::vector<std::exception_ptr> multiLockfreeFetch(Backend & objectStore, const std::vector<ObjectOps *> & objects) {
+    std::vector<std::string> names;
+    for (auto o: objects) names.emplace_back(o->getAddressIfSet());
+    auto readResults = objectStore.multiRead(names);
+    std::vector<std::exception_ptr> ret;
+    for (size_t i = 0; i < objects.size(); i++) {
+      ret.emplace_back(readResults[i].exception);
+      if (ret.back()) continue;
+      try {
+        objects[i]->interpretLockfreeFetchedData(readResults[i].content);
+      } catch (...) {
+        ret.back() = std::current_exception();
+      }
+    }
+    return ret;
+  }
+  
   class AsyncInserter {
     friend class ObjectOps;
     AsyncInserter(ObjectOps & obj): m_obj(obj) {}
@@ -554,6 +593,16 @@ protected:
     m_payloadInterpreted = true;
   }
   
+  /**
+   * Sets the object as fetched without lock from the given object data.
+   */
+  void interpretLockfreeFetchedData(const std::string & objData) {
+    m_noLock = true;
+    m_existingObject = true;
+    getHeaderFromObjectData(objData);
+    getPayloadFromHeader();
+  }
+
   virtual void getHeaderFromObjectData(const std::string & objData) {
     if (!m_header.ParseFromString(objData)) {
       // Use the tolerant parser to assess the situation.
@@ -89,7 +89,6 @@ void RetrieveQueue::rebuild() {
   // As a side note, we do not go as far as validating the pointers to jobs within the
   // shards, as this is already handled as access goes.
   std::list<RetrieveQueueShard> shards;
-  std::list<std::unique_ptr<RetrieveQueueShard::AsyncLockfreeFetcher>> shardsFetchers;
   
   // Get the summaries structures ready
   ValueCountMapUint64 priorityMap(m_payload.mutable_prioritymap());
@@ -100,17 +99,17 @@ void RetrieveQueue::rebuild() {
   mountPolicyNameMap.clear();
   for (auto & sa: m_payload.retrievequeueshards()) {
     shards.emplace_back(RetrieveQueueShard(sa.address(), m_objectStore));
-    shardsFetchers.emplace_back(shards.back().asyncLockfreeFetch());
   }
   auto s = shards.begin();
-  auto sf = shardsFetchers.begin();
+  auto shardsFetchResults = RetrieveQueueShard::multiLockfreeFetch(m_objectStore, shards);
+  auto sf = shardsFetchResults.begin();
   uint64_t totalJobs=0;
   uint64_t totalBytes=0;
   time_t oldestJobCreationTime=std::numeric_limits<time_t>::max();
   while (s != shards.end()) {
     // Each shard could be gone
     try {
-      (*sf)->wait();
+      if (*sf) std::rethrow_exception(*sf);
     } catch (Backend::NoSuchObject & ex) {
       // Remove the shard from the list
       auto aqs = m_payload.mutable_retrievequeueshards()->begin();
@@ -526,19 +525,18 @@ auto RetrieveQueue::addJobsIfNecessaryAndCommit(std::list<JobToAdd> & jobsToAdd,
   checkPayloadWritable();
   // First get all the shards of the queue to understand which jobs to add.
   std::list<RetrieveQueueShard> shards;
-  std::list<std::unique_ptr<RetrieveQueueShard::AsyncLockfreeFetcher>> shardsFetchers;
   
   for (auto & sp: m_payload.retrievequeueshards()) {
     shards.emplace_back(RetrieveQueueShard(sp.address(), m_objectStore));
-    shardsFetchers.emplace_back(shards.back().asyncLockfreeFetch());
   }
   std::list<std::list<JobDump>> shardsDumps;
   auto s = shards.begin();
-  auto sf = shardsFetchers.begin();
+  auto shardsFetchResults = RetrieveQueueShard::multiLockfreeFetch(m_objectStore, shards);
+  auto sf = shardsFetchResults.begin();
   
   while (s!= shards.end()) {
     try {
-      (*sf)->wait();
+      if (*sf) std::rethrow_exception(*sf);
     } catch (Backend::NoSuchObject & ex) {
       goto nextShard;
     }
@@ -609,16 +607,15 @@ auto RetrieveQueue::dumpJobs() -> std::list<JobDump> {
   // Go read the shards in parallel...
   std::list<JobDump> ret;
   std::list<RetrieveQueueShard> shards;
-  std::list<std::unique_ptr<RetrieveQueueShard::AsyncLockfreeFetcher>> shardsFetchers;
   for (auto & sa: m_payload.retrievequeueshards()) {
     shards.emplace_back(RetrieveQueueShard(sa.address(), m_objectStore));
-    shardsFetchers.emplace_back(shards.back().asyncLockfreeFetch());
   }
   auto s = shards.begin();
-  auto sf = shardsFetchers.begin();
+  auto shardsFetchResults = RetrieveQueueShard::multiLockfreeFetch(m_objectStore, shards);
+  auto sf = shardsFetchResults.begin();
   while (s != shards.end()) {
     try {
-      (*sf)->wait();
+      if (*sf) std::rethrow_exception(*sf);
     } catch (Backend::NoSuchObject & ex) {
       // We are possibly in read only mode, so we cannot rebuild.
       // Just skip this shard.
@@ -636,26 +633,59 @@ auto RetrieveQueue::dumpJobs() -> std::list<JobDump> {
 auto RetrieveQueue::getCandidateList(uint64_t maxBytes, uint64_t maxFiles, const std::set<std::string> & retrieveRequestsToSkip, const std::set<std::string> & diskSystemsToSkip) -> CandidateJobList {
   checkPayloadReadable();
   CandidateJobList ret;
-  for(auto & rqsp: m_payload.retrievequeueshards()) {
-    // We need to go through all shard pointers unconditionnaly to count what is left (see else part)
-    if (ret.candidateBytes < maxBytes && ret.candidateFiles < maxFiles) {
-      // Fetch the shard
-      RetrieveQueueShard rqs(rqsp.address(), m_objectStore);
-      rqs.fetchNoLock();
-      auto shardCandidates = rqs.getCandidateJobList(maxBytes - ret.candidateBytes, maxFiles - ret.candidateFiles,
-          retrieveRequestsToSkip, diskSystemsToSkip);
-      ret.candidateBytes += shardCandidates.candidateBytes;
-      ret.candidateFiles += shardCandidates.candidateFiles;
-      // We overwrite the remaining values each time as the previous
-      // shards have exhaustied their candidate lists.
-      ret.remainingBytesAfterCandidates = shardCandidates.remainingBytesAfterCandidates;
-      ret.remainingFilesAfterCandidates = shardCandidates.remainingFilesAfterCandidates;
-      ret.candidates.splice(ret.candidates.end(), shardCandidates.candidates);
-    } else {
-      // We are done with finding candidates. We just need to count what is left in the non-visited shards.
-      ret.remainingBytesAfterCandidates += rqsp.shardbytescount();
-      ret.remainingFilesAfterCandidates += rqsp.shardjobscount();
+  // The shards are fetched ahead of their processing: the fetches of all the shards the pointer counts say we will
+  // visit are launched in parallel up front. When jobs are skipped, the pointer counts overestimate the candidates,
+  // so we also keep the next shard in flight while the current one is being processed.
+  const int shardCount = m_payload.retrievequeueshards_size();
+  std::vector<std::unique_ptr<RetrieveQueueShard>> shards(shardCount);
+  std::vector<std::unique_ptr<RetrieveQueueShard::AsyncLockfreeFetcher>> shardFetchers(shardCount);
+  int fetchesLaunched = 0;
+  uint64_t expectedBytes = 0, expectedFiles = 0;
+  auto launchNextShardFetch = [&]() {
+    auto & rqsp = m_payload.retrievequeueshards(fetchesLaunched);
+    shards[fetchesLaunched].reset(new RetrieveQueueShard(rqsp.address(), m_objectStore));
+    shardFetchers[fetchesLaunched].reset(shards[fetchesLaunched]->asyncLockfreeFetch());
+    expectedBytes += rqsp.shardbytescount();
+    expectedFiles += rqsp.shardjobscount();
+    fetchesLaunched++;
+  };
+  const bool skipping = retrieveRequestsToSkip.size() || diskSystemsToSkip.size();
+  // Shards fetched ahead but not needed after all (or not reached due to an error) are still in flight:
+  // let them complete before their objects go away.
+  auto drainShardFetches = [&]() {
+    for (auto & sf: shardFetchers) if (sf) try { sf->wait(); } catch (...) {}
+  };
+  try {
+    while (fetchesLaunched < shardCount && expectedBytes < maxBytes && expectedFiles < maxFiles) launchNextShardFetch();
+    for (int i = 0; i < shardCount; i++) {
+      auto & rqsp = m_payload.retrievequeueshards(i);
+      // We need to go through all shard pointers unconditionnaly to count what is left (see else part)
+      if (ret.candidateBytes < maxBytes && ret.candidateFiles < maxFiles) {
+        // Get the shard, fetched ahead if possible
+        if (fetchesLaunched == i) launchNextShardFetch();
+        if (skipping && fetchesLaunched == i + 1 && fetchesLaunched < shardCount) launchNextShardFetch();
+        std::unique_ptr<RetrieveQueueShard::AsyncLockfreeFetcher> shardFetcher(std::move(shardFetchers[i]));
+        shardFetcher->wait();
+        auto shardCandidates = shards[i]->getCandidateJobList(maxBytes - ret.candidateBytes, maxFiles - ret.candidateFiles,
+            retrieveRequestsToSkip, diskSystemsToSkip);
+        shards[i].reset(nullptr);
+        ret.candidateBytes += shardCandidates.candidateBytes;
+        ret.candidateFiles += shardCandidates.candidateFiles;
+        // We overwrite the remaining values each time as the previous
+        // shards have exhaustied their candidate lists.
+        ret.remainingBytesAfterCandidates = shardCandidates.remainingBytesAfterCandidates;
+        ret.remainingFilesAfterCandidates = shardCandidates.remainingFilesAfterCandidates;
+        ret.candidates.splice(ret.candidates.end(), shardCandidates.candidates);
+      } else {
+        // We are done with finding candidates. We just need to count what is left in the non-visited shards.
+        ret.remainingBytesAfterCandidates += rqsp.shardbytescount();
+        ret.remainingFilesAfterCandidates += rqsp.shardjobscount();
+      }
     }
+    drainShardFetches();
+  } catch (...) {
+    drainShardFetches();
+    throw;
   }
   return ret;
 }
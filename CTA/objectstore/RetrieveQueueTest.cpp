@@ -289,4 +289,72 @@ TEST(ObjectStore, RetrieveQueueActivityCounts) {
   ASSERT_FALSE(rq.exists()); 
 }
 
+
+TEST(ObjectStore, RetrieveQueueCandidateListAcrossShards) {
+  cta::objectstore::BackendVFS be;
+  cta::log::DummyLogger dl("dummy", "dummyLogger");
+  cta::log::LogContext lc(dl);
+  cta::objectstore::AgentReference agentRef("unitTest", dl);
+  const size_t totalJobs = 200, shardSize=20;
+  std::list<cta::objectstore::RetrieveQueue::JobToAdd> jobsToAdd;
+  for (size_t i=0; i<totalJobs; i++) {
+    cta::objectstore::RetrieveQueue::JobToAdd jta;
+    jta.copyNb = 1;
+    jta.fSeq = i;
+    jta.fileSize = 1000;
+    jta.policy.retrieveMinRequestAge = 10;
+    jta.policy.retrievePriority = 1;
+    jta.startTime = ::time(nullptr);
+    std::stringstream address;
+    address << "someRequest-" << i;
+    jta.retrieveRequestAddress = address.str();
+    jobsToAdd.push_back(jta);
+  }
+  std::string retrieveQueueAddress = agentRef.nextId("RetrieveQueue");
+  cta::objectstore::RetrieveQueue rq(retrieveQueueAddress, be);
+  rq.initialize("V12345");
+  rq.setShardSize(shardSize);
+  rq.insert();
+  {
+    cta::objectstore::ScopedExclusiveLock rql(rq);
+    rq.fetch();
+    rq.addJobsAndCommit(jobsToAdd, agentRef, lc);
+  }
+  rq.fetchNoLock();
+  ASSERT_LT(1, rq.getShardCount());
+  // Shards are fetched ahead in parallel: the candidates must still come in order, whether all the shards
+  // are needed or only some of them, and the non-visited shards must be counted as remaining.
+  for (uint64_t maxFiles: {totalJobs, totalJobs / 2 + 5, (uint64_t)1}) {
+    auto candidateJobs = rq.getCandidateList(std::numeric_limits<uint64_t>::max(), maxFiles, std::set<std::string>(),
+        std::set<std::string>());
+    ASSERT_EQ(maxFiles, candidateJobs.candidateFiles);
+    ASSERT_EQ(totalJobs - maxFiles, candidateJobs.remainingFilesAfterCandidates);
+    uint64_t expectedFseq = 0;
+    for (auto &j: candidateJobs.candidates) {
+      std::stringstream address;
+      address << "someRequest-" << expectedFseq++;
+      ASSERT_EQ(address.str(), j.address);
+    }
+  }
+  // Skip the first half of the jobs, so that the pointer counts overestimate what the first shards give.
+  std::set<std::string> jobsToSkip;
+  for (size_t i=0; i<totalJobs / 2; i++) {
+    std::stringstream address;
+    address << "someRequest-" << i;
+    jobsToSkip.insert(address.str());
+  }
+  auto candidateJobs = rq.getCandidateList(std::numeric_limits<uint64_t>::max(), 10, jobsToSkip, std::set<std::string>());
+  ASSERT_EQ(10, candidateJobs.candidateFiles);
+  ASSERT_EQ("someRequest-100", candidateJobs.candidates.front().address);
+  // Clean up.
+  {
+    cta::objectstore::ScopedExclusiveLock rql(rq);
+    rq.fetch();
+    std::list<std::string> jobsToRemove;
+    for (auto & j: jobsToAdd) jobsToRemove.emplace_back(j.retrieveRequestAddress);
+    rq.removeJobsAndCommit(jobsToRemove);
+    rq.removeIfEmpty(lc);
+  }
+  ASSERT_FALSE(rq.exists());
+}
 }
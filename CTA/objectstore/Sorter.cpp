@@ -17,10 +17,43 @@
 #include "Sorter.hpp"
 #include "Helpers.hpp"
 #include "common/threading/MutexLocker.hpp"
+#include "common/threading/Thread.hpp"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 
 namespace cta { namespace objectstore {
 
+namespace {
+
+/**
+ * A helper thread of Sorter::flushAllInParallel(), with its own log context.
+ */
+class QueueFlushThread: public threading::Thread {
+public:
+  QueueFlushThread(std::function<void(log::LogContext &)> work, const log::LogContext & lc): m_work(work), m_lc(lc) {}
+  void run() override { m_work(m_lc); }
+private:
+  std::function<void(log::LogContext &)> m_work;
+  log::LogContext m_lc;
+};
+
+/**
+ * Passes the failure of the flush of a queue to the jobs of its list which did not get a result yet.
+ */
+template <typename JobQueueInfo>
+void setJobsException(std::list<std::shared_ptr<JobQueueInfo>> & jobs, std::exception_ptr failure) {
+  for(auto & job: jobs){
+    try{
+      std::get<1>(job->jobToQueue).set_exception(failure);
+    } catch(const std::future_error &){
+      // The job was queued, or failed on its own, before the failure.
+    }
+  }
+}
+
+} // anonymous namespace
+
 /* SORTER CLASS */  
 
 Sorter::Sorter(AgentReference& agentReference, Backend& objectstore, catalogue::Catalogue& catalogue):m_agentReference(agentReference),m_objectstore(objectstore),m_catalogue(catalogue){
@@ -35,11 +68,12 @@ void Sorter::executeArchiveAlgorithm(const std::string tapePool, std::string& qu
   typedef ContainerAlgorithms<ArchiveQueue,SpecificQueue> Algo;
   Algo algo(m_objectstore,m_agentReference);
   typename Algo::InsertedElement::list jobsToAdd;
-  std::map<uint64_t,std::shared_ptr<ArchiveJobQueueInfo>> succeededJobs;
+  // The jobs of a queue can belong to different requests: they are identified by request and copy number.
+  std::map<std::pair<std::string, uint32_t>,std::shared_ptr<ArchiveJobQueueInfo>> succeededJobs;
   std::string previousOwner;
   for(auto& jobToAdd: jobs){
     SorterArchiveJob job = std::get<0>(jobToAdd->jobToQueue);
-    succeededJobs[job.jobDump.copyNb] = jobToAdd;
+    succeededJobs[std::make_pair(job.archiveRequest->getAddressIfSet(), job.jobDump.copyNb)] = jobToAdd;
     previousOwner = job.previousOwner->getAgentAddress();
     jobsToAdd.push_back({ job.archiveRequest.get() ,job.jobDump.copyNb,job.archiveFile, job.mountPolicy,cta::nullopt });
   }
@@ -54,9 +88,9 @@ void Sorter::executeArchiveAlgorithm(const std::string tapePool, std::string& qu
         params.add("fileId",failedAR.element->archiveFile.archiveFileID);
         lc.log(log::WARNING,"In Sorter::executeArchiveAlgorithm(), queueing impossible, job do not exist in the objectstore.");
       } catch(const cta::exception::Exception &e){
-        uint32_t copyNb = failedAR.element->copyNb;
-        std::get<1>(succeededJobs[copyNb]->jobToQueue).set_exception(std::current_exception());
-        succeededJobs.erase(copyNb);
+        auto jobKey = std::make_pair(failedAR.element->archiveRequest->getAddressIfSet(), failedAR.element->copyNb);
+        std::get<1>(succeededJobs[jobKey]->jobToQueue).set_exception(std::current_exception());
+        succeededJobs.erase(jobKey);
       }
     }
   }
@@ -373,6 +407,94 @@ void Sorter::flushAll(log::LogContext& lc){
   while(flushOneArchive(lc)){}
 }
 
+void Sorter::flushAllInParallel(log::LogContext& lc, const size_t maxParallelQueueFlushes){
+  // Take all the lists out of the sorter, so that its mutex is not held while queueing.
+  MapArchive archiveQueues;
+  MapRetrieve retrieveQueues;
+  {
+    threading::MutexLocker locker(m_mutex);
+    archiveQueues.swap(m_archiveQueuesAndRequests);
+    retrieveQueues.swap(m_retrieveQueuesAndRequests);
+  }
+  // One flush per destination queue, with its result.
+  struct QueueFlush {
+    std::string containerIdentifier;
+    JobQueueType jobQueueType;
+    std::function<void(log::LogContext &)> flush;
+    std::function<void(std::exception_ptr)> fail;
+    std::exception_ptr failure;
+  };
+  std::vector<QueueFlush> queueFlushes;
+  for(auto & kv: retrieveQueues){
+    if(kv.second.empty()) continue;
+    queueFlushes.push_back({std::get<0>(kv.first), std::get<1>(kv.first),
+      [this, &kv](log::LogContext & flushLc){ queueRetrieveRequests(std::get<0>(kv.first), std::get<1>(kv.first), kv.second, flushLc); },
+      [&kv](std::exception_ptr failure){ setJobsException(kv.second, failure); },
+      nullptr});
+  }
+  for(auto & kv: archiveQueues){
+    if(kv.second.empty()) continue;
+    queueFlushes.push_back({std::get<0>(kv.first), std::get<1>(kv.first),
+      [this, &kv](log::LogContext & flushLc){ queueArchiveRequests(std::get<0>(kv.first), std::get<1>(kv.first), kv.second, flushLc); },
+      [&kv](std::exception_ptr failure){ setJobsException(kv.second, failure); },
+      nullptr});
+  }
+  
+  // The workers take the next queue to flush until there is none left.
+  std::atomic<size_t> nextQueueFlush(0);
+  auto worker = [&queueFlushes, &nextQueueFlush](log::LogContext & workerLc){
+    for(size_t i = nextQueueFlush++; i < queueFlushes.size(); i = nextQueueFlush++){
+      try{
+        queueFlushes[i].flush(workerLc);
+      } catch(...){
+        queueFlushes[i].failure = std::current_exception();
+      }
+    }
+  };
+  std::list<std::unique_ptr<QueueFlushThread>> helperThreads;
+  const size_t nbWorkers = std::min(std::max(maxParallelQueueFlushes, (size_t)1), queueFlushes.size());
+  for(size_t i = 1; i < nbWorkers; i++){
+    std::unique_ptr<QueueFlushThread> helperThread(new QueueFlushThread(worker, lc));
+    try{
+      helperThread->start();
+    } catch(const cta::exception::Exception &ex){
+      // The queues will be flushed by the threads already started.
+      log::ScopedParamContainer params(lc);
+      params.add("exceptionMessage", ex.getMessageValue());
+      lc.log(log::WARNING, "In Sorter::flushAllInParallel(): failed to start a helper thread.");
+      break;
+    }
+    helperThreads.emplace_back(std::move(helperThread));
+  }
+  worker(lc);
+  for(auto & helperThread: helperThreads){
+    helperThread->wait();
+  }
+  
+  // Aggregate the errors. The jobs of the failed queues get the error of their queue, so that the callers waiting
+  // for them do not wait forever.
+  std::string failureMessages;
+  size_t nbFailures = 0;
+  for(auto & queueFlush: queueFlushes){
+    if(!queueFlush.failure) continue;
+    try{
+      std::rethrow_exception(queueFlush.failure);
+    } catch(const cta::exception::Exception &ex){
+      failureMessages += " " + queueFlush.containerIdentifier + "/" + toString(queueFlush.jobQueueType) + ": " + ex.getMessageValue();
+    } catch(const std::exception &ex){
+      failureMessages += " " + queueFlush.containerIdentifier + "/" + toString(queueFlush.jobQueueType) + ": " + ex.what();
+    } catch(...){
+      failureMessages += " " + queueFlush.containerIdentifier + "/" + toString(queueFlush.jobQueueType) + ": unknown exception";
+    }
+    queueFlush.fail(queueFlush.failure);
+    nbFailures++;
+  }
+  if(nbFailures){
+    throw QueueFlushFailure("In Sorter::flushAllInParallel(): failed to flush " + std::to_string(nbFailures) + " of "
+      + std::to_string(queueFlushes.size()) + " queues:" + failureMessages);
+  }
+}
+
 /* END OF SORTER CLASS */
 
 
@@ -49,6 +49,12 @@ class SorterRetrieveRequestAccessor;
 class Sorter {
 public:  
   CTA_GENERATE_EXCEPTION_CLASS(RetrieveRequestHasNoCopies);
+  CTA_GENERATE_EXCEPTION_CLASS(QueueFlushFailure);
+
+  /**
+   * Default maximum number of queues flushed at the same time by flushAllInParallel()
+   */
+  static const size_t c_defaultMaxParallelQueueFlushes = 8;
   
   Sorter(AgentReference& agentReference,Backend &objectstore, catalogue::Catalogue& catalogue);
   ~Sorter();
@@ -176,6 +182,18 @@ public:
    * If an exception happens while queueing a job, the promise associated will get the exception.
    */
   void flushAll(log::LogContext& lc);
+
+  /**
+   * This method queues all the jobs that are in the sorter's MapArchive and MapRetrieve maps like flushAll(), but the
+   * destination queues, which are independent objects, are flushed in parallel by a bounded pool of threads (the calling
+   * thread being one of them). Each list<ArchiveJobQueueInfo> or list<RetrieveJobQueueInfo> is flushed by one thread.
+   * The jobs of the queues that failed to be flushed get the failure in their promise, and a QueueFlushFailure listing
+   * all of these queues is thrown once all the other queues have been flushed.
+   * @param lc the LogContext for logging
+   * @param maxParallelQueueFlushes the maximum number of queues flushed at the same time
+   * If an exception happens while queueing a job, the promise associated will get the exception.
+   */
+  void flushAllInParallel(log::LogContext& lc, const size_t maxParallelQueueFlushes = c_defaultMaxParallelQueueFlushes);
   
 private:
   AgentReference &m_agentReference;
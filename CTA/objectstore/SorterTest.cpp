@@ -984,4 +984,119 @@ TEST(ObjectStore,SorterInsertRetrieveRequestNotFetched){
   
 }
 
+TEST(ObjectStore,SorterFlushAllInParallel){
+  
+  using namespace cta::objectstore;
+  
+  //cta::log::StdoutLogger dl("dummy", "unitTest");
+  cta::log::DummyLogger dl("dummy", "unitTest");
+  cta::log::LogContext lc(dl);
+  // We need a dummy catalogue
+  cta::catalogue::DummyCatalogue catalogue;
+  cta::objectstore::BackendVFS be;
+  // Create the root entry
+  cta::objectstore::RootEntry re(be);
+  re.initialize();
+  re.insert();
+  // Create the agent register
+  cta::objectstore::EntryLogSerDeser el("user0",
+      "unittesthost", time(NULL));
+  cta::objectstore::ScopedExclusiveLock rel(re);
+  // Create the agent for objects creation
+  cta::objectstore::AgentReference agentRef("unitTestCreateEnv", dl);
+  // Finish root creation.
+  re.addOrGetAgentRegisterPointerAndCommit(agentRef, el, lc);
+  rel.release();
+  // continue agent creation.
+  cta::objectstore::Agent agent(agentRef.getAgentAddress(), be);
+  agent.initialize();
+  agent.setTimeout_us(0);
+  agent.insertAndRegisterSelf(lc);
+
+  //Create the agent of the Sorter
+  cta::objectstore::AgentReference agentRefSorter("agentRefSorter", dl);
+  cta::objectstore::Agent agentSorter(agentRefSorter.getAgentAddress(), be);
+  agentSorter.initialize();
+  agentSorter.setTimeout_us(0);
+  agentSorter.insertAndRegisterSelf(lc);
+  
+  /**
+   * Creation of Archive Requests, each of them going to a different tape pool
+   */
+  const uint64_t nbTapePools = 10;
+  Sorter sorter(agentRefSorter,be,catalogue);
+  cta::common::dataStructures::MountPolicy mp;
+  mp.creationLog = cta::common::dataStructures::EntryLog("user0", "host0", time(nullptr));
+  for(uint64_t i = 0; i < nbTapePools; i++){
+    std::string archiveRequestID = agentRef.nextId("ArchiveRequest");
+    agentRef.addToOwnership(archiveRequestID,be);
+    cta::objectstore::ArchiveRequest ar(archiveRequestID,be);
+    ar.initialize();
+    cta::common::dataStructures::ArchiveFile aFile;
+    aFile.archiveFileID = i;
+    aFile.diskFileId = "eos://diskFile";
+    aFile.checksumBlob.insert(cta::checksum::ADLER32, "1234");
+    aFile.creationTime = 0;
+    aFile.reconciliationTime = 0;
+    aFile.diskFileInfo = cta::common::dataStructures::DiskFileInfo();
+    aFile.diskInstance = "eoseos";
+    aFile.fileSize = 667;
+    aFile.storageClass = "sc";
+    ar.setArchiveFile(aFile);
+    const std::string tapePool = "TapePool" + std::to_string(i);
+    ar.addJob(1, tapePool, agentRef.getAgentAddress(), 1, 1, 1);
+    ar.setMountPolicy(mp);
+    ar.setArchiveReportURL("");
+    ar.setArchiveErrorReportURL("");
+    ar.setRequester(cta::common::dataStructures::RequesterIdentity("user0", "group0"));
+    ar.setSrcURL("root://eoseos/myFile");
+    ar.setEntryLog(cta::common::dataStructures::EntryLog("user0", "host0", time(nullptr)));
+    ar.insert();
+    
+    SorterArchiveRequest request;
+    request.archiveJobs.emplace_back();
+    SorterArchiveJob& job = request.archiveJobs.back();
+    job.archiveRequest = std::make_shared<cta::objectstore::ArchiveRequest>(ar);
+    job.archiveFile = aFile;
+    job.jobDump.copyNb = 1;
+    job.jobDump.tapePool = tapePool;
+    job.jobDump.owner = agentRef.getAgentAddress();
+    job.jobDump.status = serializers::ArchiveJobStatus::AJS_ToTransferForUser;
+    job.jobQueueType = JobQueueType::JobsToTransferForUser;
+    job.mountPolicy = mp;
+    job.previousOwner = &agentRef;
+    sorter.insertArchiveRequest(request,agentRef,lc);
+  }
+  
+  cta::objectstore::Sorter::MapArchive allArchiveJobs = sorter.getAllArchive();
+  std::list<std::future<void>> allFuturesArchive;
+  ASSERT_EQ(nbTapePools,allArchiveJobs.size());
+  for(auto& kv: allArchiveJobs){
+    for(auto& job: kv.second){
+      allFuturesArchive.emplace_back(std::get<1>(job->jobToQueue).get_future());
+    }
+  }
+  
+  ASSERT_NO_THROW(sorter.flushAllInParallel(lc, 4));
+  
+  for(auto& future: allFuturesArchive){
+    ASSERT_NO_THROW(future.get());
+  }
+  ASSERT_EQ(0,sorter.getAllArchive().size());
+  
+  {
+    //Each tape pool got its job
+    typedef ContainerAlgorithms<ArchiveQueue, ArchiveQueueToTransferForUser> Algo;
+    Algo algo(be,agentRef);
+    typename Algo::PopCriteria criteria;
+    criteria.files = 2;
+    criteria.bytes = 2000;
+    for(uint64_t i = 0; i < nbTapePools; i++){
+      typename Algo::PoppedElementsBatch elements = algo.popNextBatch("TapePool" + std::to_string(i),criteria,lc);
+      ASSERT_EQ(1,elements.elements.size());
+      ASSERT_EQ(i,elements.elements.front().archiveFile.archiveFileID);
+    }
+  }
+}
+
 }
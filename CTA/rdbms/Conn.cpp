@@ -123,6 +123,28 @@ Stmt Conn::createStmt(const std::string &sql) {
   }
 }
 
+//------------------------------------------------------------------------------
+// executeQueries
+//------------------------------------------------------------------------------
+std::vector<Rset> Conn::executeQueries(const std::vector<Stmt *> &stmts) {
+  if(nullptr != m_connAndStmts && nullptr != m_connAndStmts->conn) {
+    std::vector<wrapper::StmtWrapper *> stmtWrappers;
+    stmtWrappers.reserve(stmts.size());
+    for(auto stmt: stmts) {
+      stmtWrappers.push_back(&stmt->getStmt());
+    }
+    auto rsetWrappers = m_connAndStmts->conn->executeQueries(stmtWrappers);
+    std::vector<Rset> rsets;
+    rsets.reserve(rsetWrappers.size());
+    for(auto &rsetWrapper: rsetWrappers) {
+      rsets.emplace_back(std::move(rsetWrapper));
+    }
+    return rsets;
+  } else {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed: Conn does not contain a connection");
+  }
+}
+
 //------------------------------------------------------------------------------
 // executeNonQuery
 //------------------------------------------------------------------------------
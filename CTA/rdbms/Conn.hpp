@@ -24,6 +24,7 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace cta {
 namespace rdbms {
@@ -123,6 +124,22 @@ public:
    */
   Stmt createStmt(const std::string &sql);
 
+  /**
+   * Executes the specified queries and returns their result sets in the same
+   * order.
+   *
+   * The queries must not depend on each other.  Depending on the database
+   * technology they are sent to the database server together, in which case
+   * they cost a single round trip.  The statements must stay alive until
+   * their result sets are destroyed.
+   *
+   * @param stmts The statements of the queries, created by this connection and
+   * with their parameters bound.
+   * @return The result sets of the queries, in the same order as the
+   * statements.
+   */
+  std::vector<Rset> executeQueries(const std::vector<Stmt *> &stmts);
+
   /**
    * Executes the statement.
    *
@@ -35,7 +35,7 @@ struct ConnAndStmts {
   /**
    * Constructor.
    */
-  ConnAndStmts() {
+  ConnAndStmts(): poolSlot(0) {
   }
 
   /**
@@ -50,7 +50,8 @@ struct ConnAndStmts {
    */
   ConnAndStmts(ConnAndStmts &&other):
     conn(std::move(other.conn)),
-    stmtPool(std::move(other.stmtPool)) {
+    stmtPool(std::move(other.stmtPool)),
+    poolSlot(other.poolSlot) {
   }
 
   /**
@@ -91,6 +92,11 @@ struct ConnAndStmts {
    */
   std::unique_ptr<StmtPool> stmtPool;
 
+  /**
+   * The slot of the connection pool to which the connection belongs.
+   */
+  uint64_t poolSlot;
+
 }; // class ConnAndStmts
 
 } // namespace rdbms
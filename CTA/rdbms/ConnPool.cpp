@@ -26,54 +26,115 @@
 namespace cta {
 namespace rdbms {
 
+namespace {
+  /**
+   * Source of the numbers of the threads taking connections.
+   */
+  std::atomic<uint64_t> g_nextThreadNb(0);
+
+  /**
+   * Returns the number of the calling thread, used to choose the slot from
+   * which the thread starts searching for a connection.
+   */
+  uint64_t getThreadNb() {
+    static thread_local const uint64_t threadNb = g_nextThreadNb++;
+    return threadNb;
+  }
+}
+
 //------------------------------------------------------------------------------
 // constructor
 //------------------------------------------------------------------------------
 ConnPool::ConnPool(const Login &login, const uint64_t maxNbConns):
   m_connFactory(wrapper::ConnFactoryFactory::create(login)),
   m_maxNbConns(maxNbConns),
-  m_nbConnsOnLoan(0){
+  m_slots(new Slot[maxNbConns]),
+  m_nbWaitingThreads(0) {
+}
+
+//------------------------------------------------------------------------------
+// destructor
+//------------------------------------------------------------------------------
+ConnPool::~ConnPool() {
+  for(uint64_t slot = 0; slot < m_maxNbConns; slot++) {
+    delete m_slots[slot].idleConn.exchange(nullptr);
+  }
 }
 
 //------------------------------------------------------------------------------
 // getConn
 //------------------------------------------------------------------------------
 Conn ConnPool::getConn() {
-  threading::MutexLocker locker(m_connsAndStmtsMutex);
-
   if(0 == m_maxNbConns) {
     throw ConnPoolConfiguredWithZeroConns(std::string(__FUNCTION__) +
       " failed: ConnPool is configured with zero connections");
   }
 
-  while(m_connsAndStmts.size() == 0 && m_nbConnsOnLoan == m_maxNbConns) {
-    m_connsAndStmtsCv.wait(locker);
+  const uint64_t firstSlot = getThreadNb() % m_maxNbConns;
+  uint64_t slot = 0;
+  std::unique_ptr<ConnAndStmts> connAndStmts;
+  if(!tryTakeSlot(firstSlot, slot, connAndStmts)) {
+    // The threads returning connections wake us up if they see us waiting, or
+    // we see their connection when trying again
+    threading::MutexLocker locker(m_waitingThreadsMutex);
+    m_nbWaitingThreads++;
+    while(!tryTakeSlot(firstSlot, slot, connAndStmts)) {
+      m_connReturnedCv.wait(locker);
+    }
+    m_nbWaitingThreads--;
   }
 
-  if(m_connsAndStmts.size() == 0) {
-    auto connAndStmts = cta::make_unique<ConnAndStmts>();
-    connAndStmts->conn = m_connFactory->create();
-    connAndStmts->stmtPool = cta::make_unique<StmtPool>();
-    m_connsAndStmts.push_back(std::move(connAndStmts));
+  if(nullptr != connAndStmts && connAndStmts->conn->isOpen()) {
+    return Conn(std::move(connAndStmts), this);
   }
 
-  std::unique_ptr<ConnAndStmts> connAndStmts = std::move(m_connsAndStmts.front());
-  m_connsAndStmts.pop_front();
-  m_nbConnsOnLoan++;
-  if(connAndStmts->conn->isOpen()) {
-    return Conn(std::move(connAndStmts), this);
-  } else {
+  // The slot has no connection or its connection is closed
+  try {
+    connAndStmts.reset();
     auto newConnAndStmts = cta::make_unique<ConnAndStmts>();
     newConnAndStmts->conn = m_connFactory->create();
     newConnAndStmts->stmtPool = cta::make_unique<StmtPool>();
+    newConnAndStmts->poolSlot = slot;
     return Conn(std::move(newConnAndStmts), this);
+  } catch(...) {
+    m_slots[slot].hasConn = false;
+    notifyWaitingThreads();
+    throw;
+  }
+}
+
+//------------------------------------------------------------------------------
+// tryTakeSlot
+//------------------------------------------------------------------------------
+bool ConnPool::tryTakeSlot(const uint64_t firstSlot, uint64_t &slot, std::unique_ptr<ConnAndStmts> &connAndStmts) {
+  for(uint64_t i = 0; i < m_maxNbConns; i++) {
+    Slot &s = m_slots[(firstSlot + i) % m_maxNbConns];
+    if(nullptr != s.idleConn.load()) {
+      ConnAndStmts *const idleConn = s.idleConn.exchange(nullptr);
+      if(nullptr != idleConn) {
+        slot = idleConn->poolSlot;
+        connAndStmts.reset(idleConn);
+        return true;
+      }
+    }
+  }
+  for(uint64_t i = 0; i < m_maxNbConns; i++) {
+    const uint64_t candidate = (firstSlot + i) % m_maxNbConns;
+    bool hasConn = false;
+    if(!m_slots[candidate].hasConn.load() && m_slots[candidate].hasConn.compare_exchange_strong(hasConn, true)) {
+      slot = candidate;
+      connAndStmts.reset();
+      return true;
+    }
   }
+  return false;
 }
 
 //------------------------------------------------------------------------------
 // returnConn
 //------------------------------------------------------------------------------
 void ConnPool::returnConn(std::unique_ptr<ConnAndStmts> connAndStmts) {
+  const uint64_t slot = connAndStmts->poolSlot;
   try {
     // If the connection is open
     if(connAndStmts->conn->isOpen()) {
@@ -90,20 +151,8 @@ void ConnPool::returnConn(std::unique_ptr<ConnAndStmts> connAndStmts) {
         } catch(...) {
           // Ignore any exceptions
         }
-
-        // A closed connection is rare and usually means the underlying TCP/IP
-        // connection, if there is one, has been lost.  Delete all the connections
-        // currently in the pool because their underlying TCP/IP connections may
-        // also have been lost.
-        threading::MutexLocker locker(m_connsAndStmtsMutex);
-        while(!m_connsAndStmts.empty()) {
-          m_connsAndStmts.pop_front();
-        }
-        if(0 == m_nbConnsOnLoan) {
-          throw exception::Exception("Would have reached -1 connections on loan");
-        }
-        m_nbConnsOnLoan--;
-        m_connsAndStmtsCv.signal();
+        connAndStmts.reset();
+        releaseSlotAndIdleConns(slot);
         return;
       }
 
@@ -111,35 +160,50 @@ void ConnPool::returnConn(std::unique_ptr<ConnAndStmts> connAndStmts) {
       // this is the default value of a newly created connection
       connAndStmts->conn->setAutocommitMode(AutocommitMode::AUTOCOMMIT_ON);
 
-      threading::MutexLocker locker(m_connsAndStmtsMutex);
-      if(0 == m_nbConnsOnLoan) {
-        throw exception::Exception("Would have reached -1 connections on loan");
-      }
-      m_nbConnsOnLoan--;
-      m_connsAndStmts.push_back(std::move(connAndStmts));
-      m_connsAndStmtsCv.signal();
+      m_slots[slot].idleConn = connAndStmts.release();
+      notifyWaitingThreads();
 
     // Else the connection is closed
     } else {
-
-      // A closed connection is rare and usually means the underlying TCP/IP
-      // connection, if there is one, has been lost.  Delete all the connections
-      // currently in the pool because their underlying TCP/IP connections may
-      // also have been lost.
-      threading::MutexLocker locker(m_connsAndStmtsMutex);
-      while(!m_connsAndStmts.empty()) {
-        m_connsAndStmts.pop_front();
-      }
-      if(0 == m_nbConnsOnLoan) {
-        throw exception::Exception("Would have reached -1 connections on loan");
-      }
-      m_nbConnsOnLoan--;
-      m_connsAndStmtsCv.signal();
+      connAndStmts.reset();
+      releaseSlotAndIdleConns(slot);
     }
   } catch(exception::Exception &ex) {
+    if(nullptr != connAndStmts) {
+      connAndStmts.reset();
+      releaseSlotAndIdleConns(slot);
+    }
     throw exception::Exception(std::string(__FUNCTION__) + " failed: " + ex.getMessage().str());
   }
 }
 
+//------------------------------------------------------------------------------
+// releaseSlotAndIdleConns
+//------------------------------------------------------------------------------
+void ConnPool::releaseSlotAndIdleConns(const uint64_t slot) {
+  m_slots[slot].hasConn = false;
+  for(uint64_t i = 0; i < m_maxNbConns; i++) {
+    std::unique_ptr<ConnAndStmts> idleConn(m_slots[i].idleConn.exchange(nullptr));
+    if(nullptr != idleConn) {
+      idleConn.reset();
+      m_slots[i].hasConn = false;
+    }
+  }
+  if(0 < m_nbWaitingThreads) {
+    threading::MutexLocker locker(m_waitingThreadsMutex);
+    m_connReturnedCv.broadcast();
+  }
+}
+
+//------------------------------------------------------------------------------
+// notifyWaitingThreads
+//------------------------------------------------------------------------------
+void ConnPool::notifyWaitingThreads() {
+  if(0 < m_nbWaitingThreads) {
+    threading::MutexLocker locker(m_waitingThreadsMutex);
+    m_connReturnedCv.signal();
+  }
+}
+
 } // namespace rdbms
 } // namespace cta
@@ -25,7 +25,7 @@
 #include "rdbms/wrapper/ConnWrapper.hpp"
 #include "rdbms/wrapper/ConnFactory.hpp"
 
-#include <list>
+#include <atomic>
 #include <memory>
 
 namespace cta {
@@ -49,6 +49,13 @@ public:
    */
   ConnPool(const Login &login, const uint64_t maxNbConns);
 
+  /**
+   * Destructor.
+   *
+   * Deletes the connections idle within the pool.
+   */
+  ~ConnPool();
+
   CTA_GENERATE_EXCEPTION_CLASS(ConnPoolConfiguredWithZeroConns);
 
   /**
@@ -60,6 +67,11 @@ public:
    * with maxNbConns set to 0 then calling this method with throw a
    * ConnPoolConfiguredWithZeroConns exception.
    *
+   * Taking and returning a connection does not take any lock unless a thread
+   * is waiting for a connection.  Each thread starts its search from a slot
+   * of its own, so that it tends to take back the connection it used last,
+   * together with the statements it prepared.
+   *
    * @return A connection from the pool.
    * @throw ConnPoolConfiguredWithZeroConns If this pool was configured with
    * maxNbConns set to 0.
@@ -98,25 +110,74 @@ private:
   uint64_t m_maxNbConns;
 
   /**
-   * The number of database connections currently on loan.
+   * A slot of the pool.  A slot holds at most one database connection, either
+   * idle within the slot or on loan.
    */
-  uint64_t m_nbConnsOnLoan;
+  struct Slot {
+    Slot(): idleConn(nullptr), hasConn(false) {}
+
+    /**
+     * The connection of the slot if it is idle, else nullptr.
+     */
+    std::atomic<ConnAndStmts *> idleConn;
+
+    /**
+     * True if the slot has a connection, idle or on loan.
+     */
+    std::atomic<bool> hasConn;
+  };
 
   /**
-   * Mutex used to serialize access to the database connections within the pool.
+   * Takes an idle connection, or else reserves a slot without a connection.
+   * The search starts from the specified slot.
+   *
+   * @param firstSlot The slot from which to start the search.
+   * @param slot Output parameter: the slot taken.
+   * @param connAndStmts Output parameter: the idle connection taken, or
+   * nullptr if a slot without a connection was reserved.
+   * @return True if a slot was taken, false if all the connections are on
+   * loan.
    */
-  threading::Mutex m_connsAndStmtsMutex;
+  bool tryTakeSlot(const uint64_t firstSlot, uint64_t &slot, std::unique_ptr<ConnAndStmts> &connAndStmts);
 
   /**
-   * Condition variable used by threads returning connections to the pool to
-   * notify threads waiting for connections.
+   * Releases the specified slot, whose connection is deleted, together with
+   * the connections idle within the pool.
+   *
+   * A closed connection is rare and usually means the underlying TCP/IP
+   * connection, if there is one, has been lost.  The connections idle within
+   * the pool are deleted because their underlying TCP/IP connections may also
+   * have been lost.
+   *
+   * @param slot The slot.
+   */
+  void releaseSlotAndIdleConns(const uint64_t slot);
+
+  /**
+   * Wakes up a thread waiting for a connection, if any.
    */
-  threading::CondVar m_connsAndStmtsCv;
+  void notifyWaitingThreads();
 
   /**
-   * The database connections within the pool.
+   * The slots of the pool, m_maxNbConns of them.
+   */
+  std::unique_ptr<Slot[]> m_slots;
+
+  /**
+   * The number of threads waiting for a connection.
+   */
+  std::atomic<uint64_t> m_nbWaitingThreads;
+
+  /**
+   * Mutex used by the threads waiting for a connection.
+   */
+  threading::Mutex m_waitingThreadsMutex;
+
+  /**
+   * Condition variable used by threads returning connections to the pool to
+   * notify threads waiting for connections.
    */
-  std::list<std::unique_ptr<ConnAndStmts> > m_connsAndStmts;
+  threading::CondVar m_connReturnedCv;
 }; // class ConnPool
 
 } // namespace rdbms
@@ -19,7 +19,10 @@
 #include "rdbms/ConnPool.hpp"
 #include "rdbms/Login.hpp"
 
+#include <atomic>
 #include <gtest/gtest.h>
+#include <list>
+#include <thread>
 
 namespace unitTests {
 
@@ -79,4 +82,34 @@ TEST_F(cta_rdbms_ConnPoolTest, moveConstructor) {
   Conn conn2(std::move(conn));
 }
 
+TEST_F(cta_rdbms_ConnPoolTest, getPooledConn_concurrently) {
+  using namespace cta::rdbms;
+
+  const Login login(Login::DBTYPE_SQLITE, "", "", "file::memory:?cache=shared", "", 0);
+  const uint64_t maxNbConns = 2;
+  ConnPool pool(login, maxNbConns);
+
+  std::atomic<uint64_t> nbConnsOnLoan(0);
+  std::atomic<uint64_t> maxNbConnsOnLoan(0);
+  std::list<std::thread> threads;
+  for(uint64_t t = 0; t < 8; t++) {
+    threads.emplace_back([&pool, &nbConnsOnLoan, &maxNbConnsOnLoan]() {
+      for(uint64_t i = 0; i < 100; i++) {
+        Conn conn = pool.getConn();
+        const uint64_t nbOnLoan = ++nbConnsOnLoan;
+        uint64_t maxNbOnLoan = maxNbConnsOnLoan;
+        while(nbOnLoan > maxNbOnLoan && !maxNbConnsOnLoan.compare_exchange_weak(maxNbOnLoan, nbOnLoan)) {
+        }
+        nbConnsOnLoan--;
+      }
+    });
+  }
+  for(auto &thread: threads) {
+    thread.join();
+  }
+
+  ASSERT_LE(1, maxNbConnsOnLoan);
+  ASSERT_GE(maxNbConns, maxNbConnsOnLoan);
+}
+
 } // namespace unitTests
@@ -181,4 +181,34 @@ TEST_P(cta_rdbms_ConnTest, createSameTableInTwoSeparateInMemoryDatabases_execute
   }
 }
 
+TEST_P(cta_rdbms_ConnTest, executeQueries) {
+  using namespace cta::rdbms;
+
+  const Login login(Login::DBTYPE_SQLITE, "", "", "file::memory:?cache=shared", "", 0);
+  const uint64_t maxNbConns = 1;
+  ConnPool connPool(login, maxNbConns);
+  auto conn = connPool.getConn();
+
+  conn.executeNonQuery("CREATE TABLE CONN_TEST(ID INTEGER)");
+  conn.executeNonQuery("INSERT INTO CONN_TEST(ID) VALUES(1)");
+  conn.executeNonQuery("INSERT INTO CONN_TEST(ID) VALUES(2)");
+
+  auto stmt1 = conn.createStmt("SELECT ID AS ID FROM CONN_TEST WHERE ID >= :ID ORDER BY ID");
+  stmt1.bindUint64(":ID", 1);
+  auto stmt2 = conn.createStmt("SELECT ID AS ID FROM CONN_TEST WHERE ID > :ID ORDER BY ID");
+  stmt2.bindUint64(":ID", 1);
+  auto rsets = conn.executeQueries({&stmt1, &stmt2});
+  ASSERT_EQ(2, rsets.size());
+
+  ASSERT_TRUE(rsets.at(0).next());
+  ASSERT_EQ(1, rsets.at(0).columnUint64("ID"));
+  ASSERT_TRUE(rsets.at(0).next());
+  ASSERT_EQ(2, rsets.at(0).columnUint64("ID"));
+  ASSERT_FALSE(rsets.at(0).next());
+
+  ASSERT_TRUE(rsets.at(1).next());
+  ASSERT_EQ(2, rsets.at(1).columnUint64("ID"));
+  ASSERT_FALSE(rsets.at(1).next());
+}
+
 } // namespace unitTests
@@ -301,6 +301,71 @@ uint64_t Stmt::getNbAffectedRows() const {
   }
 }
 
+//-----------------------------------------------------------------------------
+// bindUint64Array
+//-----------------------------------------------------------------------------
+void Stmt::bindUint64Array(const std::string &paramName, const std::vector<optional<uint64_t>> &paramValues) {
+  try {
+    if(nullptr != m_stmt) {
+      return m_stmt->bindUint64Array(paramName, paramValues);
+    } else {
+      throw exception::Exception("Stmt does not contain a cached statement");
+    }
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + " failed: " + ex.getMessage().str());
+    throw;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// bindStringArray
+//-----------------------------------------------------------------------------
+void Stmt::bindStringArray(const std::string &paramName,
+  const std::vector<optional<std::string>> &paramValues) {
+  try {
+    if(nullptr != m_stmt) {
+      return m_stmt->bindStringArray(paramName, paramValues);
+    } else {
+      throw exception::Exception("Stmt does not contain a cached statement");
+    }
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + " failed: " + ex.getMessage().str());
+    throw;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// bindBlobArray
+//-----------------------------------------------------------------------------
+void Stmt::bindBlobArray(const std::string &paramName, const std::vector<std::string> &paramValues) {
+  try {
+    if(nullptr != m_stmt) {
+      return m_stmt->bindBlobArray(paramName, paramValues);
+    } else {
+      throw exception::Exception("Stmt does not contain a cached statement");
+    }
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + " failed: " + ex.getMessage().str());
+    throw;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// executeArrayNonQuery
+//-----------------------------------------------------------------------------
+uint64_t Stmt::executeArrayNonQuery() {
+  try {
+    if(nullptr != m_stmt) {
+      return m_stmt->executeArrayNonQuery();
+    } else {
+      throw exception::Exception("Stmt does not contain a cached statement");
+    }
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + " failed: " + ex.getMessage().str());
+    throw;
+  }
+}
+
 //-----------------------------------------------------------------------------
 // getStmt
 //-----------------------------------------------------------------------------
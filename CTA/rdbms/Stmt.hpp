@@ -24,6 +24,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace cta {
 namespace rdbms {
@@ -198,6 +199,45 @@ public:
    */
   uint64_t getNbAffectedRows() const;
 
+  /**
+   * Binds an array of values to an SQL parameter.  The ith value is the one of
+   * the ith row of the next call to executeArrayNonQuery().
+   *
+   * @param paramName The name of the parameter.
+   * @param paramValues The values to be bound.
+   */
+  void bindUint64Array(const std::string &paramName, const std::vector<optional<uint64_t>> &paramValues);
+
+  /**
+   * Binds an array of values to an SQL parameter of type optional-string.  The
+   * ith value is the one of the ith row of the next call to
+   * executeArrayNonQuery().
+   *
+   * @param paramName The name of the parameter.
+   * @param paramValues The values to be bound.
+   */
+  void bindStringArray(const std::string &paramName, const std::vector<optional<std::string>> &paramValues);
+
+  /**
+   * Binds an array of values to an SQL parameter of type binary string (byte
+   * array).  The ith value is the one of the ith row of the next call to
+   * executeArrayNonQuery().
+   *
+   * @param paramName The name of the parameter.
+   * @param paramValues The values to be bound.
+   */
+  void bindBlobArray(const std::string &paramName, const std::vector<std::string> &paramValues);
+
+  /**
+   * Executes the statement once for each row of the bound arrays.  MySQL and
+   * SQLite execute an INSERT ... VALUES(...) statement as a series of multi-row
+   * INSERT statements, each one sized to the limits of the database.  The
+   * arrays are unbound afterwards.
+   *
+   * @return The total number of rows affected.
+   */
+  uint64_t executeArrayNonQuery();
+
   /**
    * Returns a reference to the underlying statement object that is not pool
    * aware.
@@ -32,22 +32,13 @@ Stmt StmtPool::getStmt(wrapper::ConnWrapper &conn, const std::string &sql) {
   auto itor = m_stmts.find(sql);
 
   // If there is no prepared statement in the cache
-  if(itor == m_stmts.end()) {
+  if(itor == m_stmts.end() || itor->second.empty()) {
     auto stmt = conn.createStmt(sql);
     return Stmt(std::move(stmt), *this);
   } else {
-    auto &stmtList = itor->second;
-    if(stmtList.empty()) {
-      throw exception::Exception(std::string(__FUNCTION__) + " failed: Unexpected empty list of cached statements");
-    }
-    auto stmt = std::move(stmtList.front());
-    stmtList.pop_front();
-
-    // If there are no more cached prepared statements then remove the empty list from the cache
-    if(stmtList.empty()) {
-      m_stmts.erase(itor);
-    }
-
+    auto &stmts = itor->second;
+    auto stmt = std::move(stmts.back());
+    stmts.pop_back();
     return Stmt(std::move(stmt), *this);
   }
 }
@@ -60,8 +51,7 @@ uint64_t StmtPool::getNbStmts() const {
 
   uint64_t nbStmts = 0;
   for(const auto &maplet: m_stmts) {
-    auto &stmtList = maplet.second;
-    nbStmts += stmtList.size();
+    nbStmts += maplet.second.size();
   }
   return nbStmts;
 }
@@ -70,10 +60,9 @@ uint64_t StmtPool::getNbStmts() const {
 // returnStmt
 //------------------------------------------------------------------------------
 void StmtPool::returnStmt(std::unique_ptr<wrapper::StmtWrapper> stmt) {
-  threading::MutexLocker locker(m_stmtsMutex);
-
   stmt->clear();
 
+  threading::MutexLocker locker(m_stmtsMutex);
   m_stmts[stmt->getSql()].push_back(std::move(stmt));
 }
 
@@ -23,10 +23,10 @@
 #include "rdbms/Stmt.hpp"
 
 #include <iostream>
-#include <list>
-#include <map>
 #include <memory>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace cta {
 namespace rdbms {
@@ -85,9 +85,12 @@ private:
    * The cached database statements.
    *
    * Please note that for a single key there maybe more than one cached
-   * statement, hence the map to list of statements.
+   * statement, hence the map to vector of statements.  The SQL statements of
+   * the catalogue are long and share long prefixes, so they are hashed rather
+   * than compared.  The vector of a key is kept when it becomes empty, so that
+   * taking and returning a statement does not allocate memory.
    */
-  std::map<std::string, std::list< std::unique_ptr<wrapper::StmtWrapper> > > m_stmts;
+  std::unordered_map<std::string, std::vector< std::unique_ptr<wrapper::StmtWrapper> > > m_stmts;
 
 }; // class StmtPool
 
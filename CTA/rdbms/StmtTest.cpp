@@ -1016,4 +1016,80 @@ TEST_P(cta_rdbms_StmtTest, insert_same_primary_twice) {
   }
 }
 
+TEST_P(cta_rdbms_StmtTest, insert_with_bindArrays) {
+  using namespace cta::rdbms;
+
+  // Enough rows for the multi-row INSERT statements of MySQL and SQLite to be
+  // split into several chunks
+  const uint64_t nbRows = 12000;
+  std::vector<cta::optional<uint64_t>> ids;
+  std::vector<cta::optional<uint64_t>> uint64s;
+  std::vector<cta::optional<std::string>> strings;
+  for(uint64_t i = 0; i < nbRows; i++) {
+    ids.push_back(i);
+    uint64s.push_back(i * 2);
+    if(i % 2) {
+      strings.push_back(cta::nullopt);
+    } else {
+      strings.push_back("value_" + std::to_string(i));
+    }
+  }
+
+  // Insert the rows into the test table
+  {
+    const char *const sql =
+      "INSERT INTO STMT_TEST(" "\n"
+      "  ID,"                  "\n"
+      "  UINT64_COL,"          "\n"
+      "  STRING_COL) "         "\n"
+      "VALUES("                "\n"
+      "  :ID,"                 "\n"
+      "  :UINT64_COL,"         "\n"
+      "  :STRING_COL)";
+    auto stmt = m_conn.createStmt(sql);
+    stmt.bindUint64Array(":ID", ids);
+    stmt.bindUint64Array(":UINT64_COL", uint64s);
+    stmt.bindStringArray(":STRING_COL", strings);
+    ASSERT_EQ(nbRows, stmt.executeArrayNonQuery());
+  }
+
+  // Select the rows back from the table
+  {
+    const char *const sql =
+      "SELECT"                      "\n"
+      "  ID AS ID,"                 "\n"
+      "  UINT64_COL AS UINT64_COL," "\n"
+      "  STRING_COL AS STRING_COL"  "\n"
+      "FROM"                        "\n"
+      "  STMT_TEST"                 "\n"
+      "ORDER BY"                    "\n"
+      "  ID";
+    auto stmt = m_conn.createStmt(sql);
+    auto rset = stmt.executeQuery();
+    for(uint64_t i = 0; i < nbRows; i++) {
+      ASSERT_TRUE(rset.next());
+      ASSERT_EQ(i, rset.columnUint64("ID"));
+      ASSERT_EQ(i * 2, rset.columnUint64("UINT64_COL"));
+      ASSERT_EQ(strings[i], rset.columnOptionalString("STRING_COL"));
+    }
+    ASSERT_FALSE(rset.next());
+  }
+}
+
+TEST_P(cta_rdbms_StmtTest, insert_with_bindArrays_of_different_sizes) {
+  using namespace cta::rdbms;
+
+  const char *const sql =
+    "INSERT INTO STMT_TEST(" "\n"
+    "  ID,"                  "\n"
+    "  UINT64_COL) "         "\n"
+    "VALUES("                "\n"
+    "  :ID,"                 "\n"
+    "  :UINT64_COL)";
+  auto stmt = m_conn.createStmt(sql);
+  stmt.bindUint64Array(":ID", {1, 2});
+  stmt.bindUint64Array(":UINT64_COL", {1});
+  ASSERT_THROW(stmt.executeArrayNonQuery(), cta::exception::Exception);
+}
+
 } // namespace unitTests
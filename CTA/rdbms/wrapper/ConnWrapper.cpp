@@ -29,6 +29,18 @@ namespace wrapper {
 ConnWrapper::~ConnWrapper() {
 }
 
+//------------------------------------------------------------------------------
+// executeQueries
+//------------------------------------------------------------------------------
+std::vector<std::unique_ptr<RsetWrapper>> ConnWrapper::executeQueries(const std::vector<StmtWrapper *> &stmts) {
+  std::vector<std::unique_ptr<RsetWrapper>> rsets;
+  rsets.reserve(stmts.size());
+  for(auto stmt: stmts) {
+    rsets.push_back(stmt->executeQuery());
+  }
+  return rsets;
+}
+
 } // namespace wrapper
 } // namespace rdbms
 } // namespace cta
@@ -24,6 +24,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace cta {
 namespace rdbms {
@@ -76,6 +77,22 @@ public:
    */
   virtual std::unique_ptr<StmtWrapper> createStmt(const std::string &sql) = 0;
 
+  /**
+   * Executes the specified queries and returns their result sets in the same
+   * order.
+   *
+   * The queries must not depend on each other.  This default implementation
+   * executes them one after the other.  Database technologies able to send
+   * several queries without waiting for their results override this method in
+   * order to pay a single round trip to the database server.
+   *
+   * @param stmts The prepared statements of the queries, created by this
+   * connection and with their parameters bound.
+   * @return The result sets of the queries, in the same order as the
+   * statements.
+   */
+  virtual std::vector<std::unique_ptr<RsetWrapper>> executeQueries(const std::vector<StmtWrapper *> &stmts);
+
   /**
    * Commits the current transaction.
    */
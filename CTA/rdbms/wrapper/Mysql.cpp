@@ -44,34 +44,28 @@ std::string replace_string(const std::string& sql,
 }
 
 std::string Mysql::translate_it(const std::string& sql) {
-  std::string real_sql = sql;
-
-  // if found :name, replace it with '?'
-  const std::string named_tok = ":";
-  const std::string replaced_tok = "?";
-  while (true) {
-    auto idx = real_sql.find(named_tok);
-    if (idx == std::string::npos) {
-      break;
+  // if found :name, replace it with '?'.  This is done in a single pass as
+  // the multi-row INSERT statements can have tens of thousands of parameters.
+  std::string real_sql;
+  real_sql.reserve(sql.length());
+  for (size_t idx = 0; idx < sql.length(); ++idx) {
+    if (sql[idx] != ':') {
+      real_sql += sql[idx];
+      continue;
     }
-    // find the next token
-    size_t len = real_sql.length();
-    size_t l = 1; // next to ":"
-    for (; idx+l < len; ++l) {
-      const char& c = real_sql[idx+l];
-      // check token
+    real_sql += '?';
+    // skip the name of the token
+    while (idx+1 < sql.length()) {
+      const char& c = sql[idx+1];
       if (('0' <= c && c <= '9') ||
           ('A' <= c && c <= 'Z') ||
           ('a' <= c && c <= 'z') ||
           c == '_') {
-
+        ++idx;
       } else {
         break;
       }
     }
-
-    real_sql.replace(idx, l, replaced_tok);
-
   }
 
   // replace CONSTRAINT name from sql 
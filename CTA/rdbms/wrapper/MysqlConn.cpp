@@ -42,7 +42,7 @@ MysqlConn::MysqlConn(const std::string& host,
                      const std::string& passwd,
                      const std::string& db,
                      unsigned int port)
-  : m_mysqlConn(NULL) {
+  : m_mysqlConn(NULL), m_maxAllowedPacket(0) {
 
   // create the MYSQL data structure
 
@@ -372,7 +372,28 @@ std::list<std::string> MysqlConn::getTypeNames() {
   return std::list<std::string>();
 }
 
-
+//------------------------------------------------------------------------------
+// getMaxAllowedPacket
+//------------------------------------------------------------------------------
+uint64_t MysqlConn::getMaxAllowedPacket() {
+  try {
+    if(0 == m_maxAllowedPacket) {
+      auto stmt = createStmt("SELECT @@max_allowed_packet AS MAX_ALLOWED_PACKET");
+      auto rset = stmt->executeQuery();
+      if(!rset->next()) {
+        throw exception::Exception("SELECT @@max_allowed_packet returned no row");
+      }
+      const auto maxAllowedPacket = rset->columnOptionalUint64("MAX_ALLOWED_PACKET");
+      if(!maxAllowedPacket) {
+        throw exception::Exception("max_allowed_packet is NULL");
+      }
+      m_maxAllowedPacket = maxAllowedPacket.value();
+    }
+    return m_maxAllowedPacket;
+  } catch(exception::Exception &ex) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed: " + ex.getMessage().str());
+  }
+}
 
 } // namespace wrapper
 } // namespace rdbms
@@ -224,6 +224,14 @@ public:
    */
   std::list<std::string> getTypeNames() override;
 
+  /**
+   * Returns the max_allowed_packet of the server, which limits the size of a
+   * statement and of the values bound to it.  The value is queried once per
+   * connection.
+   *
+   * @return The maximum size of a packet in bytes.
+   */
+  uint64_t getMaxAllowedPacket();
 
 private:
 
@@ -237,6 +245,11 @@ private:
    */
   MYSQL* m_mysqlConn;
 
+  /**
+   * The max_allowed_packet of the server, 0 until queried.
+   */
+  uint64_t m_maxAllowedPacket;
+
 
 }; // class MysqlConn
 
@@ -191,6 +191,7 @@ void MysqlStmt::bindUint8(const std::string &paramName, const optional<uint8_t>
 
     if (paramValue) {
       holder->val = paramValue.value();
+      holder->is_null = false;
     } else {
       holder->is_null = true;
     }
@@ -225,6 +226,7 @@ void MysqlStmt::bindUint16(const std::string &paramName, const optional<uint16_t
 
     if (paramValue) {
       holder->val = paramValue.value();
+      holder->is_null = false;
     } else {
       holder->is_null = true;
     }
@@ -259,6 +261,7 @@ void MysqlStmt::bindUint32(const std::string &paramName, const optional<uint32_t
 
     if (paramValue) {
       holder->val = paramValue.value();
+      holder->is_null = false;
     } else {
       holder->is_null = true;
     }
@@ -293,6 +296,7 @@ void MysqlStmt::bindUint64(const std::string &paramName, const optional<uint64_t
 
     if (paramValue) {
       holder->val = paramValue.value();
+      holder->is_null = false;
     } else {
       holder->is_null = true;
     }
@@ -327,6 +331,7 @@ void MysqlStmt::bindDouble(const std::string &paramName, const optional<double>
 
     if (paramValue) {
       holder->val = paramValue.value();
+      holder->is_null = false;
     } else {
       holder->is_null = true;
     }
@@ -476,6 +481,17 @@ uint64_t MysqlStmt::getNbAffectedRows() const {
   return m_nbAffectedRows;
 }
 
+//------------------------------------------------------------------------------
+// executeArrayNonQuery
+//------------------------------------------------------------------------------
+uint64_t MysqlStmt::executeArrayNonQuery() {
+  // MySQL numbers the placeholders of a prepared statement with 16 bits.  Half
+  // of max_allowed_packet leaves room for the overheads of the protocol and
+  // for the underestimation of the size of the statement.
+  const uint64_t maxNbParams = 65535;
+  return executeArrayNonQueryAsMultiRowInserts(m_conn, maxNbParams, m_conn.getMaxAllowedPacket() / 2);
+}
+
 Mysql::Placeholder* MysqlStmt::columnHolder(const std::string& colName) const {
 
   if (not m_fields_info->exists(colName)) {
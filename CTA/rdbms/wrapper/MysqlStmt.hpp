@@ -163,6 +163,15 @@ public:
    */
   uint64_t getNbAffectedRows() const override;
 
+  /**
+   * Executes the INSERT statement for all the rows of the bound arrays using
+   * multi-row INSERT statements.  Each statement has at most 65535 SQL
+   * parameters and is kept well within the max_allowed_packet of the server.
+   *
+   * @return The total number of rows affected.
+   */
+  uint64_t executeArrayNonQuery() override;
+
 
   Mysql::Placeholder* columnHolder(const std::string &colName) const;
 
@@ -26,9 +26,10 @@ namespace wrapper {
 //------------------------------------------------------------------------------
 // constructor
 //------------------------------------------------------------------------------
-PostgresColumn::PostgresColumn(const std::string &colName, const size_t nbRows):
+PostgresColumn::PostgresColumn(const std::string &colName, const size_t nbRows, const BinaryType binaryType):
   m_colName(colName),
   m_nbRows(nbRows),
+  m_binaryType(binaryType),
   m_fieldValues(nbRows,std::make_pair(false, std::string())) {
 }
 
@@ -46,6 +47,13 @@ size_t PostgresColumn::getNbRows() const {
   return m_nbRows;
 }
 
+//------------------------------------------------------------------------------
+// getBinaryType
+//------------------------------------------------------------------------------
+PostgresColumn::BinaryType PostgresColumn::getBinaryType() const {
+  return m_binaryType;
+}
+
 //------------------------------------------------------------------------------
 // setFieldByteA
 //------------------------------------------------------------------------------
@@ -84,6 +92,28 @@ const char *PostgresColumn::getValue(size_t index) const {
   }
 }
 
+//------------------------------------------------------------------------------
+// getValueStr
+//------------------------------------------------------------------------------
+const std::string *PostgresColumn::getValueStr(size_t index) const {
+  try {
+    if(index >= m_nbRows) {
+      exception::Exception ex;
+      ex.getMessage() << "Field index is outside the available rows:"
+        " index=" << index << " m_nbRows=" << m_nbRows;
+      throw ex;
+    }
+    if (m_fieldValues[index].first) {
+      return &m_fieldValues[index].second;
+    } else {
+      return nullptr;
+    }
+  } catch(exception::Exception &ex) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed: colName=" + m_colName + ": " +
+      ex.getMessage().str());
+  }
+}
+
 //------------------------------------------------------------------------------
 // copyStrIntoField
 //------------------------------------------------------------------------------
@@ -33,13 +33,24 @@ namespace wrapper {
  */
 class PostgresColumn {
 public:
+  /**
+   * The type of the column's fields as sent by a binary COPY FROM. Text COPY
+   * ignores it.
+   */
+  enum class BinaryType {
+    TEXT,    // The field value is sent as is (VARCHAR, TEXT...)
+    NUMERIC, // The field value is an unsigned decimal integer sent as a NUMERIC
+    BYTEA    // The field value is a raw (unescaped) byte array
+  };
+
   /**
    * Constructor.
    *
    * @param colName The name of the column.
    * @param nbRows The number of rows in the column.
+   * @param binaryType The type of the column's fields for a binary COPY.
    */
-  PostgresColumn(const std::string &colName, const size_t nbRows);
+  PostgresColumn(const std::string &colName, const size_t nbRows, const BinaryType binaryType = BinaryType::TEXT);
 
   /**
    * Returns the name of the column.
@@ -55,6 +66,13 @@ public:
    */
   size_t getNbRows() const;
 
+  /**
+   * Returns the type of the column's fields for a binary COPY.
+   *
+   * @return The type of the column's fields for a binary COPY.
+   */
+  BinaryType getBinaryType() const;
+
   /**
    * Returns a pointer to the column field value at the specified index.
    *
@@ -62,6 +80,14 @@ public:
    */
   const char *getValue(size_t index) const;
 
+  /**
+   * Returns the column field value at the specified index, including any
+   * embedded null characters.
+   *
+   * @return The pointer to the row value or nullptr if the field is NULL.
+   */
+  const std::string *getValueStr(size_t index) const;
+
   /**
    * Sets the field at the specified index to the specified value.
    *
@@ -129,6 +155,11 @@ private:
    */
   size_t m_nbRows;
 
+  /**
+   * The type of the column's fields for a binary COPY.
+   */
+  BinaryType m_binaryType;
+
   /**
    * The array of field values.
    */
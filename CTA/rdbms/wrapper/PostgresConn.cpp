@@ -24,9 +24,11 @@
 
 #include "rdbms/Conn.hpp"
 #include "rdbms/wrapper/PostgresConn.hpp"
+#include "rdbms/wrapper/PostgresRset.hpp"
 #include "rdbms/wrapper/PostgresStmt.hpp"
 
 #include <stdio.h>
+#include <set>
 #include <sstream>
 #include <exception>
 
@@ -130,6 +132,103 @@ std::unique_ptr<StmtWrapper> PostgresConn::createStmt(const std::string &sql) {
   return cta::make_unique<PostgresStmt>(*this, sql);
 }
 
+//------------------------------------------------------------------------------
+// executeQueries
+//------------------------------------------------------------------------------
+std::vector<std::unique_ptr<RsetWrapper>> PostgresConn::executeQueries(const std::vector<StmtWrapper *> &stmts) {
+  std::vector<PostgresStmt *> pgStmts;
+  std::set<PostgresStmt *> distinctPgStmts;
+  for(auto stmt: stmts) {
+    auto pgStmt = dynamic_cast<PostgresStmt *>(stmt);
+    if(nullptr == pgStmt || &pgStmt->m_conn != this) {
+      throw exception::Exception(std::string(__FUNCTION__) + " failed: Statement was not created by this connection");
+    }
+    if(!distinctPgStmts.insert(pgStmt).second) {
+      throw exception::Exception(std::string(__FUNCTION__) + " failed: Statement " + pgStmt->getSqlForException() +
+        " is used by more than one query");
+    }
+    pgStmts.push_back(pgStmt);
+  }
+
+  // always locks in order statements and then connection
+  std::list<std::unique_ptr<threading::RWLockWrLocker>> stmtLockers;
+  for(auto pgStmt: pgStmts) {
+    stmtLockers.push_back(cta::make_unique<threading::RWLockWrLocker>(pgStmt->m_lock));
+  }
+  threading::RWLockWrLocker locker(m_lock);
+
+  PostgresStmt *currentStmt = nullptr;
+  try {
+    if(!isOpenAssumeLocked()) {
+      throw exception::Exception("Connection is closed");
+    }
+
+    if(isAsyncInProgress()) {
+      throw exception::Exception("can not execute sql, another query is in progress");
+    }
+
+    for(auto pgStmt: pgStmts) {
+      currentStmt = pgStmt;
+      if(pgStmt->m_stmt.empty()) {
+        pgStmt->doPrepare();
+      }
+    }
+    currentStmt = nullptr;
+
+    std::vector<std::unique_ptr<Postgres::Result>> results;
+#ifdef LIBPQ_HAS_PIPELINING
+    if(1 != PQenterPipelineMode(m_pgsqlConn)) {
+      Postgres::ThrowInfo(m_pgsqlConn, nullptr, "Entering pipeline mode");
+    }
+    try {
+      for(auto pgStmt: pgStmts) {
+        currentStmt = pgStmt;
+        pgStmt->doPQsendPrepared();
+      }
+      currentStmt = nullptr;
+      if(1 != PQpipelineSync(m_pgsqlConn)) {
+        Postgres::ThrowInfo(m_pgsqlConn, nullptr, "Sending pipeline synchronization point");
+      }
+      for(size_t i = 0; i < pgStmts.size(); i++) {
+        results.push_back(getNextQueryResult());
+      }
+      Postgres::Result syncRes(PQgetResult(m_pgsqlConn));
+      if(PGRES_PIPELINE_SYNC != syncRes.rcode() || 1 != PQexitPipelineMode(m_pgsqlConn)) {
+        Postgres::ThrowInfo(m_pgsqlConn, syncRes.get(), "Leaving pipeline mode");
+      }
+    } catch(...) {
+      // The connection cannot be trusted with queries still in the pipeline
+      closeAssumeLocked();
+      throw;
+    }
+#else
+    for(auto pgStmt: pgStmts) {
+      currentStmt = pgStmt;
+      pgStmt->doPQsendPrepared();
+      results.push_back(getNextQueryResult());
+    }
+    currentStmt = nullptr;
+#endif
+
+    std::vector<std::unique_ptr<RsetWrapper>> rsets;
+    for(size_t i = 0; i < pgStmts.size(); i++) {
+      currentStmt = pgStmts[i];
+      currentStmt->throwDBIfNotStatus(results[i]->get(), PGRES_TUPLES_OK, "Executing query statement");
+      currentStmt->m_nbAffectedRows = 0;
+      rsets.push_back(cta::make_unique<PostgresRset>(*this, *currentStmt, std::move(results[i])));
+    }
+    return rsets;
+  } catch(exception::LostDatabaseConnection &ex) {
+    throw exception::LostDatabaseConnection(std::string(__FUNCTION__) + " detected lost connection" +
+      (nullptr == currentStmt ? "" : " for SQL statement " + currentStmt->getSqlForException()) + ": " +
+      ex.getMessage().str());
+  } catch(exception::Exception &ex) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed" +
+      (nullptr == currentStmt ? "" : " for SQL statement " + currentStmt->getSqlForException()) + ": " +
+      ex.getMessage().str());
+  }
+}
+
 //------------------------------------------------------------------------------
 // executeNonQuery
 //------------------------------------------------------------------------------
@@ -444,6 +543,21 @@ void PostgresConn::deallocateStmt(const std::string &stmt) {
   throwDBIfNotStatus(res.get(), PGRES_COMMAND_OK, std::string(__FUNCTION__) + " failed to DEALLOCATE statement " + stmt);
 }
 
+//------------------------------------------------------------------------------
+// getNextQueryResult
+//------------------------------------------------------------------------------
+std::unique_ptr<Postgres::Result> PostgresConn::getNextQueryResult() {
+  // assumes connection wr lock held
+  auto result = cta::make_unique<Postgres::Result>(PQgetResult(m_pgsqlConn));
+  if(nullptr != result->get()) {
+    PGresult *res = nullptr;
+    while(nullptr != (res = PQgetResult(m_pgsqlConn))) {
+      PQclear(res);
+    }
+  }
+  return result;
+}
+
 //------------------------------------------------------------------------------
 // isOpenAssumeLocked
 //------------------------------------------------------------------------------
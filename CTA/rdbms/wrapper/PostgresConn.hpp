@@ -75,6 +75,21 @@ public:
    */
   std::unique_ptr<StmtWrapper> createStmt(const std::string &sql) override;
 
+  /**
+   * Executes the specified queries and returns their result sets in the same
+   * order.
+   *
+   * If libpq supports pipeline mode then all the queries are sent before
+   * their results are read, which costs a single round trip to the database
+   * server.  The rows of each query are fetched in full before returning.
+   *
+   * @param stmts The prepared statements of the queries, created by this
+   * connection and with their parameters bound.
+   * @return The result sets of the queries, in the same order as the
+   * statements.
+   */
+  std::vector<std::unique_ptr<RsetWrapper>> executeQueries(const std::vector<StmtWrapper *> &stmts) override;
+
   /**
    * Executes the sql string, without returning any result set.
    *
@@ -221,6 +236,14 @@ private:
    */
   void deallocateStmt(const std::string &stmt);
 
+  /**
+   * Gets the whole result of the next query whose results have not been read
+   * yet, together with the nullptr marking the end of its results.
+   *
+   * @return The result of the query.
+   */
+  std::unique_ptr<Postgres::Result> getNextQueryResult();
+
   /**
    * Get the libpq postgres connection
    */
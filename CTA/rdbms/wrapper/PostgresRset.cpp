@@ -32,7 +32,7 @@ namespace wrapper {
 // constructor
 //------------------------------------------------------------------------------
 PostgresRset::PostgresRset(PostgresConn &conn, PostgresStmt &stmt, std::unique_ptr<Postgres::ResultItr> resItr)
-  : m_conn(conn), m_stmt(stmt), m_resItr(std::move(resItr)), m_asyncCleared(false), m_nfetched(0) {
+  : m_conn(conn), m_stmt(stmt), m_resItr(std::move(resItr)), m_row(0), m_asyncCleared(false), m_nfetched(0) {
 
   // assumes statement and connection locks have already been taken
   if (!m_conn.isAsyncInProgress()) {
@@ -40,10 +40,20 @@ PostgresRset::PostgresRset(PostgresConn &conn, PostgresStmt &stmt, std::unique_p
   }
 }
 
+//------------------------------------------------------------------------------
+// constructor
+//------------------------------------------------------------------------------
+PostgresRset::PostgresRset(PostgresConn &conn, PostgresStmt &stmt, std::unique_ptr<Postgres::Result> res)
+  : m_conn(conn), m_stmt(stmt), m_res(std::move(res)), m_row(-1), m_asyncCleared(true), m_nfetched(0) {
+}
+
 //------------------------------------------------------------------------------
 // destructor.
 //------------------------------------------------------------------------------
 PostgresRset::~PostgresRset() {
+  if (nullptr == m_resItr) {
+    return;
+  }
 
   try {
     threading::RWLockWrLocker locker(m_conn.m_lock);
@@ -60,16 +70,16 @@ PostgresRset::~PostgresRset() {
 //------------------------------------------------------------------------------
 bool PostgresRset::columnIsNull(const std::string &colName) const {
 
-  if (nullptr == m_resItr->get()) {
+  if (nullptr == getCurrentRes()) {
     throw exception::Exception(std::string(__FUNCTION__) + " no row available");
   }
 
-  const int ifield = PQfnumber(m_resItr->get(), colName.c_str());
+  const int ifield = PQfnumber(getCurrentRes(), colName.c_str());
   if (ifield < 0) {
     throw exception::Exception(std::string(__FUNCTION__) + " column does not exist: " + colName);
   }
 
-  return PQgetisnull(m_resItr->get(), 0, ifield);
+  return PQgetisnull(getCurrentRes(), m_row, ifield);
 }
 
 std::string PostgresRset::columnBlob(const std::string &colName) const {
@@ -91,21 +101,21 @@ std::string PostgresRset::columnBlob(const std::string &colName) const {
 //------------------------------------------------------------------------------
 optional<std::string> PostgresRset::columnOptionalString(const std::string &colName) const {
 
-  if (nullptr == m_resItr->get()) {
+  if (nullptr == getCurrentRes()) {
     throw exception::Exception(std::string(__FUNCTION__) + " no row available");
   }
 
-  const int ifield = PQfnumber(m_resItr->get(), colName.c_str());
+  const int ifield = PQfnumber(getCurrentRes(), colName.c_str());
   if (ifield < 0) {
     throw exception::Exception(std::string(__FUNCTION__) + " column does not exist: " + colName);
   }
 
   // the value can be null
-  if (PQgetisnull(m_resItr->get(), 0, ifield)) {
+  if (PQgetisnull(getCurrentRes(), m_row, ifield)) {
     return nullopt;
   }
 
-  return optional<std::string>(PQgetvalue(m_resItr->get(), 0, ifield));
+  return optional<std::string>(PQgetvalue(getCurrentRes(), m_row, ifield));
 }
 
 //------------------------------------------------------------------------------
@@ -113,21 +123,21 @@ optional<std::string> PostgresRset::columnOptionalString(const std::string &colN
 //------------------------------------------------------------------------------
 optional<uint8_t> PostgresRset::columnOptionalUint8(const std::string &colName) const {
 
-  if (nullptr == m_resItr->get()) {
+  if (nullptr == getCurrentRes()) {
     throw exception::Exception(std::string(__FUNCTION__) + " no row available");
   }
 
-  const int ifield = PQfnumber(m_resItr->get(), colName.c_str());
+  const int ifield = PQfnumber(getCurrentRes(), colName.c_str());
   if (ifield < 0) {
     throw exception::Exception(std::string(__FUNCTION__) + " column does not exist: " + colName);
   }
 
   // the value can be null
-  if (PQgetisnull(m_resItr->get(), 0, ifield)) {
+  if (PQgetisnull(getCurrentRes(), m_row, ifield)) {
     return nullopt;
   }
 
-  const std::string stringValue(PQgetvalue(m_resItr->get(), 0, ifield));
+  const std::string stringValue(PQgetvalue(getCurrentRes(), m_row, ifield));
 
   if(!utils::isValidUInt(stringValue)) {
     throw exception::Exception(std::string("Column ") + colName + " contains the value " + stringValue +
@@ -142,21 +152,21 @@ optional<uint8_t> PostgresRset::columnOptionalUint8(const std::string &colName)
 //------------------------------------------------------------------------------
 optional<uint16_t> PostgresRset::columnOptionalUint16(const std::string &colName) const {
 
-  if (nullptr == m_resItr->get()) {
+  if (nullptr == getCurrentRes()) {
     throw exception::Exception(std::string(__FUNCTION__) + " no row available");
   }
 
-  const int ifield = PQfnumber(m_resItr->get(), colName.c_str());
+  const int ifield = PQfnumber(getCurrentRes(), colName.c_str());
   if (ifield < 0) {
     throw exception::Exception(std::string(__FUNCTION__) + " column does not exist: " + colName);
   }
 
   // the value can be null
-  if (PQgetisnull(m_resItr->get(), 0, ifield)) {
+  if (PQgetisnull(getCurrentRes(), m_row, ifield)) {
     return nullopt;
   }
 
-  const std::string stringValue(PQgetvalue(m_resItr->get(), 0, ifield));
+  const std::string stringValue(PQgetvalue(getCurrentRes(), m_row, ifield));
 
   if(!utils::isValidUInt(stringValue)) {
     throw exception::Exception(std::string("Column ") + colName + " contains the value " + stringValue +
@@ -171,21 +181,21 @@ optional<uint16_t> PostgresRset::columnOptionalUint16(const std::string &colName
 //------------------------------------------------------------------------------
 optional<uint32_t> PostgresRset::columnOptionalUint32(const std::string &colName) const {
 
-  if (nullptr == m_resItr->get()) {
+  if (nullptr == getCurrentRes()) {
     throw exception::Exception(std::string(__FUNCTION__) + " no row available");
   }
 
-  const int ifield = PQfnumber(m_resItr->get(), colName.c_str());
+  const int ifield = PQfnumber(getCurrentRes(), colName.c_str());
   if (ifield < 0) {
     throw exception::Exception(std::string(__FUNCTION__) + " column does not exist: " + colName);
   }
 
   // the value can be null
-  if (PQgetisnull(m_resItr->get(), 0, ifield)) {
+  if (PQgetisnull(getCurrentRes(), m_row, ifield)) {
     return nullopt;
   }
 
-  const std::string stringValue(PQgetvalue(m_resItr->get(), 0, ifield));
+  const std::string stringValue(PQgetvalue(getCurrentRes(), m_row, ifield));
 
   if(!utils::isValidUInt(stringValue)) {
     throw exception::Exception(std::string("Column ") + colName + " contains the value " + stringValue +
@@ -200,21 +210,21 @@ optional<uint32_t> PostgresRset::columnOptionalUint32(const std::string &colName
 //------------------------------------------------------------------------------
 optional<uint64_t> PostgresRset::columnOptionalUint64(const std::string &colName) const {
 
-  if (nullptr == m_resItr->get()) {
+  if (nullptr == getCurrentRes()) {
     throw exception::Exception(std::string(__FUNCTION__) + " no row available");
   }
 
-  const int ifield = PQfnumber(m_resItr->get(), colName.c_str());
+  const int ifield = PQfnumber(getCurrentRes(), colName.c_str());
   if (ifield < 0) {
     throw exception::Exception(std::string(__FUNCTION__) + " column does not exist: " + colName);
   }
 
   // the value can be null
-  if (PQgetisnull(m_resItr->get(), 0, ifield)) {
+  if (PQgetisnull(getCurrentRes(), m_row, ifield)) {
     return nullopt;
   }
 
-  const std::string stringValue(PQgetvalue(m_resItr->get(), 0, ifield));
+  const std::string stringValue(PQgetvalue(getCurrentRes(), m_row, ifield));
 
   if(!utils::isValidUInt(stringValue)) {
     throw exception::Exception(std::string("Column ") + colName + " contains the value " + stringValue +
@@ -228,21 +238,21 @@ optional<uint64_t> PostgresRset::columnOptionalUint64(const std::string &colName
 // columnOptionalDouble
 //------------------------------------------------------------------------------
 optional<double> PostgresRset::columnOptionalDouble(const std::string &colName) const {
-  if (nullptr == m_resItr->get()) {
+  if (nullptr == getCurrentRes()) {
     throw exception::Exception(std::string(__FUNCTION__) + " no row available");
   }
 
-  const int ifield = PQfnumber(m_resItr->get(), colName.c_str());
+  const int ifield = PQfnumber(getCurrentRes(), colName.c_str());
   if (ifield < 0) {
     throw exception::Exception(std::string(__FUNCTION__) + " column does not exist: " + colName);
   }
 
   // the value can be null
-  if (PQgetisnull(m_resItr->get(), 0, ifield)) {
+  if (PQgetisnull(getCurrentRes(), m_row, ifield)) {
     return nullopt;
   }
 
-  const std::string stringValue(PQgetvalue(m_resItr->get(), 0, ifield));
+  const std::string stringValue(PQgetvalue(getCurrentRes(), m_row, ifield));
 
   if(!utils::isValidDecimal(stringValue)) {
     throw exception::Exception(std::string("Column ") + colName + " contains the value " + stringValue +
@@ -266,6 +276,20 @@ bool PostgresRset::next() {
 
   // always locks in order statement and then connection
   threading::RWLockWrLocker locker2(m_stmt.m_lock);
+
+  // All the rows have already been fetched
+  if (nullptr == m_resItr) {
+    if (m_row < PQntuples(m_res->get())) {
+      ++m_row;
+    }
+    if (m_row < PQntuples(m_res->get())) {
+      ++m_nfetched;
+      m_stmt.setAffectedRows(m_nfetched);
+      return true;
+    }
+    return false;
+  }
+
   threading::RWLockWrLocker locker(m_conn.m_lock);
 
   if (m_resItr->next()) {
@@ -298,6 +322,19 @@ bool PostgresRset::next() {
   return false;
 }
 
+//------------------------------------------------------------------------------
+// getCurrentRes
+//------------------------------------------------------------------------------
+const PGresult *PostgresRset::getCurrentRes() const {
+  if (nullptr != m_resItr) {
+    return m_resItr->get();
+  }
+  if (0 <= m_row && m_row < PQntuples(m_res->get())) {
+    return m_res->get();
+  }
+  return nullptr;
+}
+
 //------------------------------------------------------------------------------
 // doClearAsync
 //------------------------------------------------------------------------------
@@ -46,6 +46,16 @@ public:
    */
   PostgresRset(PostgresConn &conn, PostgresStmt &stmt, std::unique_ptr<Postgres::ResultItr> resitr);
 
+  /**
+   * Constructor of a result set whose rows have all been fetched, as for the
+   * queries executed by PostgresConn::executeQueries().
+   *
+   * @param conn The Conn
+   * @param stmt The prepared statement.
+   * @param res The result holding all the rows of the query.
+   */
+  PostgresRset(PostgresConn &conn, PostgresStmt &stmt, std::unique_ptr<Postgres::Result> res);
+
   /**
    * Destructor.
    */
@@ -144,6 +154,12 @@ public:
 
 private:
 
+  /**
+   * Returns the libpq result holding the current row, or nullptr if there is
+   * no current row.
+   */
+  const PGresult *getCurrentRes() const;
+
   /**
    * Clears the async command in process indicator on our conneciton,
    * if we haven't done so already.
@@ -165,6 +181,17 @@ private:
    */
   std::unique_ptr<Postgres::ResultItr> m_resItr;
 
+  /**
+   * The result holding all the rows, if they have all been fetched, in which
+   * case m_resItr is nullptr.
+   */
+  std::unique_ptr<Postgres::Result> m_res;
+
+  /**
+   * The index of the current row within the current libpq result.
+   */
+  int m_row;
+
   /**
    * Indicates we have cleared the async in progress flag of the conneciton.
    * This is to make sure we don't clear it more than once
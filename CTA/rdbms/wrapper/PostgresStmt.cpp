@@ -249,11 +249,13 @@ void PostgresStmt::executeCopyInsert(const size_t rows) {
     std::ostringstream msg;
     if (nfields != m_nParams) {
       msg << "Wrong number of fields: Copy expected " << nfields << ", we have " << m_nParams;
-    } else if (0 != binType) {
-      msg << "COPY is expecting binary data, not textual data";
     } else {
       try {
-        doCopyData(rows);
+        if (0 != binType) {
+          doCopyDataBinary(rows);
+        } else {
+          doCopyData(rows);
+        }
       } catch(exception::Exception &ex) {
         msg << "PQputCopyData failed: " << ex.getMessage().str();
       }
@@ -565,6 +567,105 @@ void PostgresStmt::doCopyData(const size_t rows) {
   }
 }
 
+//------------------------------------------------------------------------------
+// doCopyDataBinary
+//------------------------------------------------------------------------------
+void PostgresStmt::doCopyDataBinary(const size_t rows) {
+  // Rows are accumulated and sent by chunks rather than one by one.
+  const size_t flushThreshold = 64 * 1024;
+  auto flush = [this]() {
+    if (m_copyRow.empty()) return;
+    const int iret = PQputCopyData(m_conn.get(), m_copyRow.c_str(), m_copyRow.size());
+    if (iret < 0) {
+      throwDB(nullptr, "Writing bulk insert data to the database");
+    }
+    m_copyRow.clear();
+  };
+
+  // Header: signature, flags field and header extension area length.
+  m_copyRow.assign("PGCOPY\n\377\r\n\0", 11);
+  appendBinaryInt32(m_copyRow, 0);
+  appendBinaryInt32(m_copyRow, 0);
+  std::string numeric;
+  for(size_t i=0;i<rows;++i) {
+    appendBinaryInt16(m_copyRow, m_nParams);
+    for(int j=0;j<m_nParams;++j) {
+      const std::string *const val = m_columnPtrs[j]->getValueStr(i);
+      if (nullptr == val) {
+        appendBinaryInt32(m_copyRow, -1);
+        continue;
+      }
+      switch (m_columnPtrs[j]->getBinaryType()) {
+      case PostgresColumn::BinaryType::NUMERIC:
+        encodeBinaryNumeric(*val, numeric);
+        appendBinaryInt32(m_copyRow, numeric.size());
+        m_copyRow += numeric;
+        break;
+      case PostgresColumn::BinaryType::TEXT:
+      case PostgresColumn::BinaryType::BYTEA:
+        appendBinaryInt32(m_copyRow, val->size());
+        m_copyRow += *val;
+        break;
+      }
+    }
+    if (m_copyRow.size() >= flushThreshold) flush();
+  }
+  // Trailer
+  appendBinaryInt16(m_copyRow, -1);
+  flush();
+}
+
+//------------------------------------------------------------------------------
+// appendBinaryInt16
+//------------------------------------------------------------------------------
+void PostgresStmt::appendBinaryInt16(std::string &buf, const int16_t value) {
+  const uint16_t v = value;
+  buf += static_cast<char>(v >> 8);
+  buf += static_cast<char>(v & 0xFF);
+}
+
+//------------------------------------------------------------------------------
+// appendBinaryInt32
+//------------------------------------------------------------------------------
+void PostgresStmt::appendBinaryInt32(std::string &buf, const int32_t value) {
+  const uint32_t v = value;
+  buf += static_cast<char>(v >> 24);
+  buf += static_cast<char>((v >> 16) & 0xFF);
+  buf += static_cast<char>((v >> 8) & 0xFF);
+  buf += static_cast<char>(v & 0xFF);
+}
+
+//------------------------------------------------------------------------------
+// encodeBinaryNumeric
+//------------------------------------------------------------------------------
+void PostgresStmt::encodeBinaryNumeric(const std::string &decimal, std::string &numeric) {
+  if (decimal.empty() || decimal.size() > 1000 ||
+    std::string::npos != decimal.find_first_not_of("0123456789")) {
+    throw exception::Exception(std::string("Value is not an unsigned decimal integer: ") + decimal);
+  }
+  const size_t firstNonZero = decimal.find_first_not_of('0');
+  // NUMERIC stores base 10000 digits: split the value in groups of 4 decimal
+  // digits, starting from the units.
+  std::vector<int16_t> digits;
+  if (std::string::npos != firstNonZero) {
+    const std::string significant = decimal.substr(firstNonZero);
+    size_t groupLen = significant.size() % 4 ? significant.size() % 4 : 4;
+    for (size_t pos = 0; pos < significant.size(); pos += groupLen, groupLen = 4) {
+      digits.push_back(std::stoi(significant.substr(pos, groupLen)));
+    }
+  }
+  // The weight is the power of 10000 of the first digit. Trailing zero digits
+  // are implied by it.
+  const int16_t weight = digits.empty() ? 0 : digits.size() - 1;
+  while (!digits.empty() && 0 == digits.back()) digits.pop_back();
+  numeric.clear();
+  appendBinaryInt16(numeric, digits.size());
+  appendBinaryInt16(numeric, weight);
+  appendBinaryInt16(numeric, 0); // Sign: positive
+  appendBinaryInt16(numeric, 0); // Display scale: integer
+  for (auto d: digits) appendBinaryInt16(numeric, d);
+}
+
 //------------------------------------------------------------------------------
 // doPrepare
 //------------------------------------------------------------------------------
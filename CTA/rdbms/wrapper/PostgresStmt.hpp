@@ -47,6 +47,12 @@ public:
    */
   friend PostgresRset;
 
+  /**
+   * The PostgresConn class needs to send the statement itself when pipelining
+   * several queries.
+   */
+  friend PostgresConn;
+
   /**
    * Constructor.
    *
@@ -211,6 +217,39 @@ private:
    */
   void doCopyData(const size_t rows);
 
+  /**
+   * Copies the data from the supplied PostgresColumns and sends it to PQputCopyData
+   * in the binary COPY format, according to the binary type of each column.
+   * The fields are sent without any escaping and the rows are sent by chunks.
+   *
+   * @param rows The number of rows to be sent to the DB connection
+   */
+  void doCopyDataBinary(const size_t rows);
+
+  /**
+   * Appends a 16 bits integer in network byte order, as used by the binary COPY format.
+   *
+   * @param buf The buffer to append to.
+   * @param value The value to append.
+   */
+  static void appendBinaryInt16(std::string &buf, const int16_t value);
+
+  /**
+   * Appends a 32 bits integer in network byte order, as used by the binary COPY format.
+   *
+   * @param buf The buffer to append to.
+   * @param value The value to append.
+   */
+  static void appendBinaryInt32(std::string &buf, const int32_t value);
+
+  /**
+   * Encodes an unsigned decimal integer in the binary representation of a NUMERIC.
+   *
+   * @param decimal The decimal representation of the value.
+   * @param numeric Output the binary representation of the value.
+   */
+  static void encodeBinaryNumeric(const std::string &decimal, std::string &numeric);
+
   /**
    * Starts async execution of prepared tatement on the postgres connection.
    */
@@ -290,7 +329,7 @@ private:
   std::vector<std::string> m_paramValues;
 
   /**
-   * Used as storage for a row to send to PQputCopyData
+   * Used as storage for a row (or a chunk of rows in binary format) to send to PQputCopyData
    */
   std::string m_copyRow;
 
@@ -284,6 +284,49 @@ TEST_F(DISABLED_cta_rdbms_wrapper_PostgresStmtTest, insert_with_bind) {
   }
 }
 
+TEST_F(DISABLED_cta_rdbms_wrapper_PostgresStmtTest, executeQueries) {
+  using namespace cta;
+  using namespace cta::rdbms::wrapper;
+
+  ASSERT_TRUE(m_conn->getTableNames().empty());
+
+  m_conn->executeNonQuery("CREATE TABLE TEST(ID NUMERIC(20,0), NAME VARCHAR(100));");
+  m_conn->executeNonQuery("INSERT INTO TEST(ID, NAME) VALUES(1, 'one');");
+  m_conn->executeNonQuery("INSERT INTO TEST(ID, NAME) VALUES(2, NULL);");
+
+  // Two queries sent together
+  {
+    auto stmt1 = m_conn->createStmt("SELECT ID AS ID, NAME AS NAME FROM TEST ORDER BY ID;");
+    auto stmt2 = m_conn->createStmt("SELECT COUNT(*) AS NB FROM TEST WHERE ID > :ID;");
+    stmt2->bindUint64(":ID", 1);
+    auto rsets = m_conn->executeQueries({stmt1.get(), stmt2.get()});
+    ASSERT_EQ(2, rsets.size());
+
+    ASSERT_TRUE(rsets.at(0)->next());
+    ASSERT_EQ(1, rsets.at(0)->columnOptionalUint64("ID").value());
+    ASSERT_EQ("one", rsets.at(0)->columnOptionalString("NAME").value());
+    ASSERT_TRUE(rsets.at(0)->next());
+    ASSERT_EQ(2, rsets.at(0)->columnOptionalUint64("ID").value());
+    ASSERT_TRUE(rsets.at(0)->columnIsNull("NAME"));
+    ASSERT_FALSE(rsets.at(0)->next());
+
+    ASSERT_TRUE(rsets.at(1)->next());
+    ASSERT_EQ(1, rsets.at(1)->columnOptionalUint64("NB").value());
+    ASSERT_FALSE(rsets.at(1)->next());
+  }
+
+  // A failing query reports its own statement and leaves the connection usable
+  {
+    auto stmt1 = m_conn->createStmt("SELECT ID AS ID FROM TEST;");
+    auto stmt2 = m_conn->createStmt("SELECT ID AS ID FROM NO_SUCH_TABLE;");
+    ASSERT_THROW(m_conn->executeQueries({stmt1.get(), stmt2.get()}), exception::Exception);
+    ASSERT_TRUE(m_conn->isOpen());
+
+    auto rsets = m_conn->executeQueries({stmt1.get()});
+    ASSERT_TRUE(rsets.at(0)->next());
+  }
+}
+
 TEST_F(DISABLED_cta_rdbms_wrapper_PostgresStmtTest, isolated_transaction) {
   using namespace cta;
   using namespace cta::rdbms::wrapper;
@@ -630,6 +673,89 @@ TEST_F(DISABLED_cta_rdbms_wrapper_PostgresStmtTest, executeCopyInsert_10000_rows
   }
 }
 
+TEST_F(DISABLED_cta_rdbms_wrapper_PostgresStmtTest, executeCopyInsert_binary) {
+  using namespace cta;
+  using namespace cta::rdbms::wrapper;
+
+  ASSERT_TRUE(m_conn->getTableNames().empty());
+
+  // Create a test table
+  {
+    const char *const sql =
+      "CREATE TABLE TEST("
+        "COL1 VARCHAR(100),"
+        "COL2 BYTEA,"
+        "COL3 NUMERIC(20,0));";
+    auto stmt = m_conn->createStmt(sql);
+    stmt->executeNonQuery();
+    ASSERT_EQ(1, m_conn->getTableNames().size());
+  }
+
+  // Values exercising the NUMERIC encoding: zero, trailing zero digits and the largest uint64
+  const std::vector<uint64_t> numbers = {0, 1, 9999, 10000, 123450000, 100000000, 18446744073709551615ULL};
+  const size_t nbBulkRows = 10000;
+  // Insert rows into the test table using a binary bulk method
+  {
+    PostgresColumn c1("MYCOL1", nbBulkRows);
+    PostgresColumn c2("MYCOL2", nbBulkRows, PostgresColumn::BinaryType::BYTEA);
+    PostgresColumn c3("MYCOL3", nbBulkRows, PostgresColumn::BinaryType::NUMERIC);
+
+    for(size_t i=0;i<nbBulkRows;++i) {
+      c1.setFieldValue(i, "column1 string \" \' \\ \n\r\t for row " + std::to_string(i));
+      if ((i % 2) == 0) {
+        c2.setFieldValue(i, std::string("\0\1\n\\", 4) + std::to_string(i));
+      }
+      c3.setFieldValue(i, numbers[i % numbers.size()]);
+    }
+
+    const char *const sql =
+      "COPY TEST("
+        "COL1,"
+        "COL2,"
+        "COL3) "
+      "FROM STDIN WITH (FORMAT BINARY) --"
+        ":MYCOL1,"
+        ":MYCOL2,"
+        ":MYCOL3";
+    auto stmt = m_conn->createStmt(sql);
+    PostgresStmt &pgStmt = dynamic_cast<PostgresStmt &>(*stmt);
+    pgStmt.setColumn(c1);
+    pgStmt.setColumn(c2);
+    pgStmt.setColumn(c3);
+
+    pgStmt.executeCopyInsert(nbBulkRows);
+    ASSERT_EQ(nbBulkRows, stmt->getNbAffectedRows());
+  }
+
+  {
+    const char *const sql =
+      "SELECT "
+        "COL1 AS COL1,"
+        "COL2 AS COL2,"
+        "COL3 AS COL3 "
+      "FROM "
+        "TEST;";
+    auto stmt = m_conn->createStmt(sql);
+    auto rset = stmt->executeQuery();
+    size_t nbrows = 0;
+    while(rset->next()) {
+      const auto col1 = rset->columnOptionalString("COL1");
+      const auto col3 = rset->columnOptionalUint64("COL3");
+      ASSERT_TRUE((bool)col1);
+      ASSERT_TRUE((bool)col3);
+      ASSERT_EQ("column1 string \" \' \\ \n\r\t for row " + std::to_string(nbrows), col1.value());
+      if ((nbrows % 2) == 0) {
+        ASSERT_EQ(std::string("\0\1\n\\", 4) + std::to_string(nbrows), rset->columnBlob("COL2"));
+      } else {
+        ASSERT_TRUE(rset->columnIsNull("COL2"));
+      }
+      ASSERT_EQ(numbers[nbrows % numbers.size()], col3.value());
+      ++nbrows;
+    }
+    ASSERT_EQ(nbrows, nbBulkRows);
+  }
+}
+
 TEST_F(DISABLED_cta_rdbms_wrapper_PostgresStmtTest, nbaffected) {
   using namespace cta;
   using namespace cta::rdbms::wrapper;
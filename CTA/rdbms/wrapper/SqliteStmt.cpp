@@ -27,6 +27,7 @@
 #include "rdbms/wrapper/SqliteRset.hpp"
 #include "rdbms/wrapper/SqliteStmt.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -351,6 +352,19 @@ uint64_t SqliteStmt::getNbAffectedRows() const {
   return m_nbAffectedRows;
 }
 
+//------------------------------------------------------------------------------
+// executeArrayNonQuery
+//------------------------------------------------------------------------------
+uint64_t SqliteStmt::executeArrayNonQuery() {
+  // SQLite looks up named parameters linearly when preparing a statement, so
+  // the statements are kept to the historical default of 999 parameters even
+  // if the connection allows more.  A negative new limit only queries the
+  // current one.
+  const int64_t maxNbParams = std::min(999, sqlite3_limit(m_conn.m_sqliteConn, SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+  const int64_t maxSqlLength = sqlite3_limit(m_conn.m_sqliteConn, SQLITE_LIMIT_SQL_LENGTH, -1);
+  return executeArrayNonQueryAsMultiRowInserts(m_conn, maxNbParams, maxSqlLength);
+}
+
 //------------------------------------------------------------------------------
 // autoCommitModeToBool
 //------------------------------------------------------------------------------
@@ -155,6 +155,16 @@ public:
    */
   uint64_t getNbAffectedRows() const override;
 
+  /**
+   * Executes the INSERT statement for all the rows of the bound arrays using
+   * multi-row INSERT statements of at most 999 SQL parameters, within the
+   * SQLITE_LIMIT_VARIABLE_NUMBER and SQLITE_LIMIT_SQL_LENGTH limits of the
+   * connection.
+   *
+   * @return The total number of rows affected.
+   */
+  uint64_t executeArrayNonQuery() override;
+
 private:
 
   /**
@@ -15,13 +15,56 @@
  *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "common/exception/Exception.hpp"
+#include "common/utils/utils.hpp"
 #include "rdbms/rdbms.hpp"
+#include "rdbms/wrapper/ConnWrapper.hpp"
 #include "rdbms/wrapper/StmtWrapper.hpp"
 
+#include <list>
+
 namespace cta {
 namespace rdbms {
 namespace wrapper {
 
+namespace {
+
+/**
+ * An SQL parameter of an SQL statement.
+ */
+struct ParamPosition {
+  /**
+   * The position of the parameter in the SQL statement.
+   */
+  std::string::size_type pos;
+
+  /**
+   * The name of the parameter, including its leading colon.
+   */
+  std::string name;
+};
+
+/**
+ * Returns the SQL parameters of the specified SQL statement in order of
+ * appearance, following the same rules as ParamNameToIdx.
+ */
+std::list<ParamPosition> getParamPositions(const std::string &sql) {
+  std::list<ParamPosition> params;
+  for(std::string::size_type i = 0; i < sql.size(); i++) {
+    if(':' == sql[i] && i + 1 < sql.size() && ParamNameToIdx::isValidParamNameChar(sql[i + 1])) {
+      std::string::size_type end = i + 1;
+      while(end < sql.size() && ParamNameToIdx::isValidParamNameChar(sql[end])) {
+        end++;
+      }
+      params.push_back({i, sql.substr(i, end - i)});
+      i = end - 1;
+    }
+  }
+  return params;
+}
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // constructor
 //------------------------------------------------------------------------------
@@ -68,6 +111,253 @@ void StmtWrapper::bindBool(const std::string &paramName, const optional<bool> &p
   }
 }
 
+//------------------------------------------------------------------------------
+// bindUint64Array
+//------------------------------------------------------------------------------
+void StmtWrapper::bindUint64Array(const std::string &paramName, const std::vector<optional<uint64_t>> &paramValues) {
+  try {
+    getParamIdx(paramName); // Throws if the parameter does not exist
+    ArrayParam &param = m_arrayParams[paramName];
+    param = ArrayParam();
+    param.type = ArrayParam::Type::UINT64;
+    param.uint64Values = paramValues;
+  } catch(exception::Exception &ex) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed for SQL statement " +
+      getSqlForException() + ": " + ex.getMessage().str());
+  }
+}
+
+//------------------------------------------------------------------------------
+// bindStringArray
+//------------------------------------------------------------------------------
+void StmtWrapper::bindStringArray(const std::string &paramName,
+  const std::vector<optional<std::string>> &paramValues) {
+  try {
+    getParamIdx(paramName); // Throws if the parameter does not exist
+    ArrayParam &param = m_arrayParams[paramName];
+    param = ArrayParam();
+    param.type = ArrayParam::Type::STRING;
+    param.stringValues = paramValues;
+  } catch(exception::Exception &ex) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed for SQL statement " +
+      getSqlForException() + ": " + ex.getMessage().str());
+  }
+}
+
+//------------------------------------------------------------------------------
+// bindBlobArray
+//------------------------------------------------------------------------------
+void StmtWrapper::bindBlobArray(const std::string &paramName, const std::vector<std::string> &paramValues) {
+  try {
+    getParamIdx(paramName); // Throws if the parameter does not exist
+    ArrayParam &param = m_arrayParams[paramName];
+    param = ArrayParam();
+    param.type = ArrayParam::Type::BLOB;
+    param.blobValues = paramValues;
+  } catch(exception::Exception &ex) {
+    throw exception::Exception(std::string(__FUNCTION__) + " failed for SQL statement " +
+      getSqlForException() + ": " + ex.getMessage().str());
+  }
+}
+
+//------------------------------------------------------------------------------
+// executeArrayNonQuery
+//------------------------------------------------------------------------------
+uint64_t StmtWrapper::executeArrayNonQuery() {
+  std::map<std::string, ArrayParam> arrayParams;
+  arrayParams.swap(m_arrayParams);
+  try {
+    const uint64_t nbRows = getArrayNbRows(arrayParams);
+    uint64_t nbAffectedRows = 0;
+    for(uint64_t row = 0; row < nbRows; row++) {
+      for(const auto &param: arrayParams) {
+        param.second.bindValue(*this, param.first, row);
+      }
+      executeNonQuery();
+      nbAffectedRows += getNbAffectedRows();
+    }
+    return nbAffectedRows;
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + " failed: " + ex.getMessage().str());
+    throw;
+  }
+}
+
+//------------------------------------------------------------------------------
+// executeArrayNonQueryAsMultiRowInserts
+//------------------------------------------------------------------------------
+uint64_t StmtWrapper::executeArrayNonQueryAsMultiRowInserts(ConnWrapper &conn, const uint64_t maxNbParams,
+  const uint64_t maxNbBytes) {
+  std::map<std::string, ArrayParam> arrayParams;
+  arrayParams.swap(m_arrayParams);
+  try {
+    const uint64_t nbRows = getArrayNbRows(arrayParams);
+    if(0 == nbRows) {
+      return 0;
+    }
+
+    // Split the statement into the part before the VALUES tuple, the tuple and
+    // the part after it
+    std::string upperSql = m_sql;
+    utils::toUpper(upperSql);
+    const std::string::size_type valuesPos = upperSql.find("VALUES");
+    if(std::string::npos == valuesPos) {
+      throw exception::Exception("The statement is not an INSERT ... VALUES(...) statement");
+    }
+    const std::string::size_type tupleBegin = m_sql.find_first_not_of(" \t\n", valuesPos + 6);
+    if(std::string::npos == tupleBegin || '(' != m_sql[tupleBegin]) {
+      throw exception::Exception("VALUES is not followed by an opening parenthesis");
+    }
+    std::string::size_type tupleEnd = tupleBegin;
+    for(uint64_t depth = 0; tupleEnd < m_sql.size(); tupleEnd++) {
+      if('(' == m_sql[tupleEnd]) {
+        depth++;
+      } else if(')' == m_sql[tupleEnd] && 0 == --depth) {
+        break;
+      }
+    }
+    if(tupleEnd == m_sql.size()) {
+      throw exception::Exception("The VALUES tuple has no closing parenthesis");
+    }
+    const std::string prefix = m_sql.substr(0, tupleBegin);
+    const std::string tuple = m_sql.substr(tupleBegin, tupleEnd + 1 - tupleBegin);
+    const std::string suffix = m_sql.substr(tupleEnd + 1);
+    if(!getParamPositions(prefix).empty() || !getParamPositions(suffix).empty()) {
+      throw exception::Exception("The statement has SQL parameters outside of its VALUES tuple");
+    }
+    const std::list<ParamPosition> tupleParams = getParamPositions(tuple);
+    for(const auto &param: tupleParams) {
+      if(arrayParams.end() == arrayParams.find(param.name)) {
+        throw exception::Exception("The SQL parameter " + param.name + " is not bound with an array");
+      }
+    }
+
+    // The parameters of the ith tuple of a chunk are suffixed with __i
+    auto appendTuple = [&tuple, &tupleParams](std::string &sql, const uint64_t idx) {
+      std::string::size_type copied = 0;
+      for(const auto &param: tupleParams) {
+        const std::string::size_type paramEnd = param.pos + param.name.size();
+        sql.append(tuple, copied, paramEnd - copied);
+        sql += "__" + std::to_string(idx);
+        copied = paramEnd;
+      }
+      sql.append(tuple, copied, std::string::npos);
+    };
+
+    uint64_t nbAffectedRows = 0;
+    std::unique_ptr<StmtWrapper> chunkStmt;
+    uint64_t chunkStmtNbRows = 0;
+    for(uint64_t firstRow = 0; firstRow < nbRows;) {
+      // A chunk has at least one row
+      uint64_t chunkNbRows = 0;
+      uint64_t chunkNbBytes = prefix.size() + suffix.size();
+      while(firstRow + chunkNbRows < nbRows) {
+        uint64_t rowNbBytes = tuple.size() + 1 + 8 * tupleParams.size();
+        for(const auto &param: arrayParams) {
+          rowNbBytes += param.second.valueSize(firstRow + chunkNbRows);
+        }
+        if(0 < chunkNbRows && ((chunkNbRows + 1) * tupleParams.size() > maxNbParams ||
+          chunkNbBytes + rowNbBytes > maxNbBytes)) {
+          break;
+        }
+        chunkNbRows++;
+        chunkNbBytes += rowNbBytes;
+      }
+
+      // Consecutive chunks of the same size reuse the same statement
+      if(nullptr == chunkStmt || chunkNbRows != chunkStmtNbRows) {
+        std::string chunkSql = prefix;
+        for(uint64_t i = 0; i < chunkNbRows; i++) {
+          if(0 < i) {
+            chunkSql += ",";
+          }
+          appendTuple(chunkSql, i);
+        }
+        chunkSql += suffix;
+        chunkStmt = conn.createStmt(chunkSql);
+        chunkStmtNbRows = chunkNbRows;
+      } else {
+        chunkStmt->clear();
+      }
+      for(uint64_t i = 0; i < chunkNbRows; i++) {
+        for(const auto &param: arrayParams) {
+          param.second.bindValue(*chunkStmt, param.first + "__" + std::to_string(i), firstRow + i);
+        }
+      }
+      chunkStmt->executeNonQuery();
+      nbAffectedRows += chunkStmt->getNbAffectedRows();
+      firstRow += chunkNbRows;
+    }
+    return nbAffectedRows;
+  } catch(exception::Exception &ex) {
+    ex.getMessage().str(std::string(__FUNCTION__) + " failed for SQL statement " + getSqlForException() + ": " +
+      ex.getMessage().str());
+    throw;
+  }
+}
+
+//------------------------------------------------------------------------------
+// getArrayNbRows
+//------------------------------------------------------------------------------
+uint64_t StmtWrapper::getArrayNbRows(const std::map<std::string, ArrayParam> &arrayParams) {
+  if(arrayParams.empty()) {
+    return 0;
+  }
+  const uint64_t nbRows = arrayParams.begin()->second.size();
+  for(const auto &param: arrayParams) {
+    if(param.second.size() != nbRows) {
+      throw exception::Exception("The arrays bound to " + arrayParams.begin()->first + " and " + param.first +
+        " have different sizes");
+    }
+  }
+  return nbRows;
+}
+
+//------------------------------------------------------------------------------
+// ArrayParam::size
+//------------------------------------------------------------------------------
+size_t StmtWrapper::ArrayParam::size() const {
+  switch(type) {
+  case Type::UINT64:
+    return uint64Values.size();
+  case Type::STRING:
+    return stringValues.size();
+  default:
+    return blobValues.size();
+  }
+}
+
+//------------------------------------------------------------------------------
+// ArrayParam::valueSize
+//------------------------------------------------------------------------------
+size_t StmtWrapper::ArrayParam::valueSize(const size_t row) const {
+  switch(type) {
+  case Type::UINT64:
+    return sizeof(uint64_t);
+  case Type::STRING:
+    return stringValues[row] ? stringValues[row].value().size() : 0;
+  default:
+    return blobValues[row].size();
+  }
+}
+
+//------------------------------------------------------------------------------
+// ArrayParam::bindValue
+//------------------------------------------------------------------------------
+void StmtWrapper::ArrayParam::bindValue(StmtWrapper &stmt, const std::string &paramName, const size_t row) const {
+  switch(type) {
+  case Type::UINT64:
+    stmt.bindUint64(paramName, uint64Values[row]);
+    break;
+  case Type::STRING:
+    stmt.bindString(paramName, stringValues[row]);
+    break;
+  default:
+    stmt.bindBlob(paramName, blobValues[row]);
+    break;
+  }
+}
+
 } // namespace wrapper
 } // namespace rdbms
 } // namespace cta
@@ -23,14 +23,18 @@
 #include "rdbms/wrapper/ParamNameToIdx.hpp"
 #include "rdbms/wrapper/RsetWrapper.hpp"
 
+#include <map>
 #include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace cta {
 namespace rdbms {
 namespace wrapper {
 
+class ConnWrapper;
+
 /**
  * Abstract class specifying the interface to a database statement.
  */
@@ -197,6 +201,48 @@ public:
    */
   virtual uint64_t getNbAffectedRows() const = 0;
 
+  /**
+   * Binds an array of values to an SQL parameter.  The ith value is the one of
+   * the ith row of the next call to executeArrayNonQuery().
+   *
+   * @param paramName The name of the parameter.
+   * @param paramValues The values to be bound.
+   */
+  void bindUint64Array(const std::string &paramName, const std::vector<optional<uint64_t>> &paramValues);
+
+  /**
+   * Binds an array of values to an SQL parameter of type optional-string.  The
+   * ith value is the one of the ith row of the next call to
+   * executeArrayNonQuery().
+   *
+   * @param paramName The name of the parameter.
+   * @param paramValues The values to be bound.
+   */
+  void bindStringArray(const std::string &paramName, const std::vector<optional<std::string>> &paramValues);
+
+  /**
+   * Binds an array of values to an SQL parameter of type binary string (byte
+   * array).  The ith value is the one of the ith row of the next call to
+   * executeArrayNonQuery().
+   *
+   * @param paramName The name of the parameter.
+   * @param paramValues The values to be bound.
+   */
+  void bindBlobArray(const std::string &paramName, const std::vector<std::string> &paramValues);
+
+  /**
+   * Executes the statement once for each row of the arrays bound with the
+   * bind*Array() methods, which must all have the same number of values.  The
+   * arrays are unbound afterwards, whether or not the execution succeeded.
+   *
+   * This implementation binds and executes the statement row by row.  The
+   * database types able to insert several rows with a single statement
+   * override it.
+   *
+   * @return The total number of rows affected.
+   */
+  virtual uint64_t executeArrayNonQuery();
+
   /**
    * Returns the SQL string to be used in an exception message.  The string
    * will be clipped at a maxmum of c_maxSqlLenInExceptions characters.  If the
@@ -211,8 +257,66 @@ public:
    */
   std::string getSqlForException(const std::string::size_type maxSqlLenInExceptions = MAX_SQL_LEN_IN_EXCEPTIONS) const;
 
+protected:
+
+  /**
+   * Executes the INSERT ... VALUES(...) statement of this object for the rows
+   * of the bound arrays as a series of multi-row INSERT ... VALUES(...),(...)
+   * statements created with the specified connection.  The rows are split into
+   * chunks so that neither the number of SQL parameters nor the estimated size
+   * of a statement and its values exceed the specified limits.  The arrays are
+   * unbound afterwards.
+   *
+   * The SQL parameters of the statement must all be inside its VALUES tuple and
+   * must all be bound with arrays.
+   *
+   * @param conn The connection used to create the multi-row statements.
+   * @param maxNbParams The maximum number of SQL parameters of a statement.
+   * @param maxNbBytes The maximum size of a statement and its values.
+   * @return The total number of rows affected.
+   */
+  uint64_t executeArrayNonQueryAsMultiRowInserts(ConnWrapper &conn, const uint64_t maxNbParams,
+    const uint64_t maxNbBytes);
+
 private:
 
+  /**
+   * The values of an SQL parameter bound with an array.
+   */
+  struct ArrayParam {
+    enum class Type { UINT64, STRING, BLOB } type;
+    std::vector<optional<uint64_t>> uint64Values;
+    std::vector<optional<std::string>> stringValues;
+    std::vector<std::string> blobValues;
+
+    /**
+     * Returns the number of values.
+     */
+    size_t size() const;
+
+    /**
+     * Returns an estimation of the size in bytes of the specified value.
+     */
+    size_t valueSize(const size_t row) const;
+
+    /**
+     * Binds the specified value to the specified parameter of the specified
+     * statement.
+     */
+    void bindValue(StmtWrapper &stmt, const std::string &paramName, const size_t row) const;
+  };
+
+  /**
+   * Returns the number of rows of the specified bound arrays, throwing an
+   * exception if they do not all have the same number of values.
+   */
+  static uint64_t getArrayNbRows(const std::map<std::string, ArrayParam> &arrayParams);
+
+  /**
+   * The SQL parameters bound with arrays.
+   */
+  std::map<std::string, ArrayParam> m_arrayParams;
+
   /**
    * The SQL statement.
    */
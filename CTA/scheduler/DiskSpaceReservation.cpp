@@ -17,7 +17,6 @@
 
 #include <map>
 #include <string>
-#include <tuple>
 
 #include "DiskSpaceReservation.hpp"
 
@@ -33,93 +32,40 @@ void DiskSpaceReservationRequest::addRequest(const std::string& diskSystemName,
 
 std::map<std::string, uint64_t> DiskSpaceReservation::getExistingDrivesReservations(
   catalogue::Catalogue* catalogue) {
-  std::map<std::string, uint64_t> ret;
-  const auto tdNames = catalogue->getTapeDriveNames();
-  for (const auto& driveName : tdNames) {
-    const auto tdStatus = catalogue->getTapeDrive(driveName);
-    try {
-      ret.at(tdStatus.value().diskSystemName) += tdStatus.value().reservedBytes;
-    } catch (std::out_of_range &) {
-      ret[tdStatus.value().diskSystemName] = tdStatus.value().reservedBytes;
-    }
-  }
-  return ret;
-}
-
-void DiskSpaceReservation::reserveDiskSpace(catalogue::Catalogue* catalogue, const std::string& driveName,
-  const DiskSpaceReservationRequest& diskSpaceReservation, log::LogContext & lc) {
-  if (diskSpaceReservation.empty()) return;
-  // Try add our reservation to the drive status.
-  auto setLogParam = [&lc](const std::string& diskSystemName, uint64_t bytes) {
-    log::ScopedParamContainer params(lc);
-    params.add("diskSystem", diskSystemName)
-          .add("reservation", bytes);
-  };
-  std::string diskSystemName = diskSpaceReservation.begin()->first;
-  uint64_t bytes = diskSpaceReservation.begin()->second;
-  setLogParam(diskSystemName, bytes);
-  lc.log(log::DEBUG, "In RetrieveMount::reserveDiskSpace(): reservation request content.");
-
-  std::tie(diskSystemName, bytes) = getDiskSpaceReservation(catalogue, driveName);
-  setLogParam(diskSystemName, bytes);
-  lc.log(log::DEBUG, "In RetrieveMount::reserveDiskSpace(): state before reservation.");
-
-  addDiskSpaceReservation(catalogue, driveName, diskSpaceReservation.begin()->first,
-    diskSpaceReservation.begin()->second);
-  std::tie(diskSystemName, bytes) = getDiskSpaceReservation(catalogue, driveName);
-  setLogParam(diskSystemName, bytes);
-  lc.log(log::DEBUG, "In RetrieveMount::reserveDiskSpace(): state after reservation.");
+  return catalogue->getDiskSpaceReservations();
 }
 
-void DiskSpaceReservation::addDiskSpaceReservation(catalogue::Catalogue* catalogue, const std::string& driveName,
-  const std::string& diskSystemName, uint64_t bytes) {
-  auto tdStatus = catalogue->getTapeDrive(driveName);
-  if (!tdStatus) return;
-  tdStatus.value().diskSystemName = diskSystemName;
-  tdStatus.value().reservedBytes += bytes;
-  catalogue->modifyTapeDrive(tdStatus.value());
-}
-
-std::tuple<std::string, uint64_t> DiskSpaceReservation::getDiskSpaceReservation(catalogue::Catalogue* catalogue,
-  const std::string& driveName) {
-  const auto tdStatus = catalogue->getTapeDrive(driveName);
-  return std::make_tuple(tdStatus.value().diskSystemName, tdStatus.value().reservedBytes);
+bool DiskSpaceReservation::reserveDiskSpace(catalogue::Catalogue* catalogue, const std::string& driveName,
+  const DiskSpaceReservationRequest& diskSpaceReservation, const disk::DiskSystemFreeSpaceList& diskSystemFreeSpace,
+  log::LogContext & lc) {
+  if (diskSpaceReservation.empty()) return true;
+  // The drive holds the reservation of a single disk system.
+  const std::string & diskSystemName = diskSpaceReservation.begin()->first;
+  const uint64_t bytes = diskSpaceReservation.begin()->second;
+  const auto & freeSpace = diskSystemFreeSpace.at(diskSystemName);
+  const uint64_t maxReservedBytes = freeSpace.freeSpace > freeSpace.targetedFreeSpace ?
+    freeSpace.freeSpace - freeSpace.targetedFreeSpace : 0;
+  const bool reserved = catalogue->reserveDiskSpace(driveName, diskSystemName, bytes, maxReservedBytes);
+  log::ScopedParamContainer params(lc);
+  params.add("diskSystem", diskSystemName)
+        .add("reservation", bytes)
+        .add("maxReservedBytes", maxReservedBytes)
+        .add("reserved", reserved);
+  lc.log(log::DEBUG, "In RetrieveMount::reserveDiskSpace(): reservation request done.");
+  return reserved;
 }
 
 void DiskSpaceReservation::releaseDiskSpace(catalogue::Catalogue* catalogue, const std::string& driveName,
   const DiskSpaceReservationRequest& diskSpaceReservation, log::LogContext & lc) {
   if (diskSpaceReservation.empty()) return;
-  // Try add our reservation to the drive status.
-  auto setLogParam = [&lc](const std::string& diskSystemName, uint64_t bytes) {
-    log::ScopedParamContainer params(lc);
-    params.add("diskSystem", diskSystemName)
-          .add("reservation", bytes);
-  };
-  std::string diskSystemName = diskSpaceReservation.begin()->first;
-  uint64_t bytes = diskSpaceReservation.begin()->second;
-  setLogParam(diskSystemName, bytes);
+  const std::string & diskSystemName = diskSpaceReservation.begin()->first;
+  const uint64_t bytes = diskSpaceReservation.begin()->second;
+  log::ScopedParamContainer params(lc);
+  params.add("diskSystem", diskSystemName)
+        .add("reservation", bytes);
   lc.log(log::DEBUG, "In RetrieveMount::releaseDiskSpace(): release request content.");
-
-  std::tie(diskSystemName, bytes) = getDiskSpaceReservation(catalogue, driveName);
-  setLogParam(diskSystemName, bytes);
-  lc.log(log::DEBUG, "In RetrieveMount::releaseDiskSpace(): state before release.");
-
-  subtractDiskSpaceReservation(catalogue, driveName, diskSpaceReservation.begin()->first,
-    diskSpaceReservation.begin()->second);
-
-  std::tie(diskSystemName, bytes) = getDiskSpaceReservation(catalogue, driveName);
-  setLogParam(diskSystemName, bytes);
-  lc.log(log::DEBUG, "In RetrieveMount::releaseDiskSpace(): state after release.");
-}
-
-void DiskSpaceReservation::subtractDiskSpaceReservation(catalogue::Catalogue* catalogue,
-  const std::string& driveName, const std::string& diskSystemName, uint64_t bytes) {
-    auto tdStatus = catalogue->getTapeDrive(driveName);
-    if (bytes > tdStatus.value().reservedBytes) throw NegativeDiskSpaceReservationReached(
-      "In DriveState::subtractDiskSpaceReservation(): we would reach a negative reservation size.");
-    tdStatus.value().diskSystemName = diskSystemName;
-    tdStatus.value().reservedBytes -= bytes;
-    catalogue->modifyTapeDrive(tdStatus.value());
+  if (!catalogue->releaseDiskSpace(driveName, diskSystemName, bytes)) throw NegativeDiskSpaceReservationReached(
+    "In DiskSpaceReservation::releaseDiskSpace(): we would reach a negative reservation size.");
 }
 
 }
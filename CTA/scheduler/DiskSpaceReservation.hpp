@@ -19,10 +19,10 @@
 
 #include <map>
 #include <string>
-#include <tuple>
 
 #include "catalogue/Catalogue.hpp"
 #include "common/log/Logger.hpp"
+#include "disk/DiskSystem.hpp"
 
 namespace cta {
 
@@ -32,16 +32,20 @@ struct DiskSpaceReservationRequest: public std::map<std::string, uint64_t> {
 
 class DiskSpaceReservation {
  public:
+  /**
+   * Returns the disk space reserved by all the drives, by disk system (a single catalogue query).
+   */
   static std::map<std::string, uint64_t> getExistingDrivesReservations(catalogue::Catalogue* catalogue);
-  static void reserveDiskSpace(catalogue::Catalogue* catalogue, const std::string& driveName,
-    const DiskSpaceReservationRequest& diskSpaceReservation, log::LogContext & lc);
-  static void addDiskSpaceReservation(catalogue::Catalogue* catalogue, const std::string& driveName,
-    const std::string& diskSystemName, uint64_t bytes);
+  /**
+   * Reserves the requested disk space for the drive, unless the reservations of all the drives for the disk system
+   * would then exceed its free space minus its targeted free space. The check and the reservation are atomic in the
+   * catalogue, so concurrent mounts cannot overbook a disk system.
+   * @return false if nothing was reserved because the disk system would be overbooked.
+   */
+  static bool reserveDiskSpace(catalogue::Catalogue* catalogue, const std::string& driveName,
+    const DiskSpaceReservationRequest& diskSpaceReservation, const disk::DiskSystemFreeSpaceList& diskSystemFreeSpace,
+    log::LogContext & lc);
   CTA_GENERATE_EXCEPTION_CLASS(NegativeDiskSpaceReservationReached);
-  static void subtractDiskSpaceReservation(catalogue::Catalogue* catalogue, const std::string& driveName,
-    const std::string& diskSystemName, uint64_t bytes);
-  static std::tuple<std::string, uint64_t> getDiskSpaceReservation(catalogue::Catalogue* catalogue,
-    const std::string& driveName);
   static void releaseDiskSpace(catalogue::Catalogue* catalogue, const std::string& driveName,
     const DiskSpaceReservationRequest& diskSpaceReservation, log::LogContext & lc);
 };
@@ -54,6 +54,7 @@ void DriveConfig::setTapedConfiguration(const cta::tape::daemon::TapedConfigurat
   setConfigToDB(&config->disableRepackManagement, catalogue, tapeDriveName);
   setConfigToDB(&config->disableMaintenanceProcess, catalogue, tapeDriveName);
   setConfigToDB(&config->fetchEosFreeSpaceScript, catalogue, tapeDriveName);
+  setConfigToDB(&config->diskSystemFreeSpaceCacheFile, catalogue, tapeDriveName);
   setConfigToDB(&config->tapeLoadTimeout, catalogue, tapeDriveName);
 }
 
@@ -19,7 +19,6 @@
 #include <bits/unique_ptr.h>
 #include <cmath>
 #include <iostream>
-#include <numeric>      /* std::accumulate */
 #include <set>
 #include <stdexcept>
 #include <stdlib.h>     /* srand, rand */
@@ -186,24 +185,98 @@ void OStoreDB::ping() {
   re.fetchNoLock();
 }
 
+//------------------------------------------------------------------------------
+// OStoreDB::setMountInfoSnapshotMaxAge()
+//------------------------------------------------------------------------------
+void OStoreDB::setMountInfoSnapshotMaxAge(time_t maxAge) {
+  threading::MutexLocker ml(m_mountInfoSnapshotMutex);
+  m_mountInfoSnapshotMaxAge = maxAge;
+}
+
 //------------------------------------------------------------------------------
 // OStoreDB::fetchMountInfo()
 //------------------------------------------------------------------------------
 void OStoreDB::fetchMountInfo(SchedulerDatabase::TapeMountDecisionInfo& tmdi, RootEntry& re, SchedulerDatabase::PurposeGetMountInfo purpose,
-    log::LogContext & logContext) {
-  utils::Timer t, t2;
+    bool schedulerGlobalLockHeld, log::LogContext & logContext) {
+  if (purpose == SchedulerDatabase::PurposeGetMountInfo::GET_NEXT_MOUNT) {
+    threading::MutexLocker ml(m_mountInfoSnapshotMutex);
+    time_t snapshotAge = ::time(nullptr) - m_mountInfoSnapshot.time;
+    // The read under the global scheduling lock confirms the mount decision: it always reads the queues, and refreshes
+    // the snapshot for the next unlocked reads.
+    if (!schedulerGlobalLockHeld && m_mountInfoSnapshotMaxAge && m_mountInfoSnapshot.time &&
+        snapshotAge <= m_mountInfoSnapshotMaxAge) {
+      // Reuse the queue summaries from the previous mount decision.
+      tmdi.potentialMounts = m_mountInfoSnapshot.potentialMounts;
+      tmdi.queueTrimRequired = m_mountInfoSnapshot.queueTrimRequired;
+      ml.unlock();
+      log::ScopedParamContainer params(logContext);
+      params.add("snapshotAge", snapshotAge)
+            .add("potentialMounts", tmdi.potentialMounts.size());
+      logContext.log(log::DEBUG, "In OStoreDB::fetchMountInfo(): reused the queues snapshot.");
+    } else {
+      ml.unlock();
+      fetchQueuesMountInfo(tmdi, re, purpose, logContext);
+      ml.lock();
+      if (m_mountInfoSnapshotMaxAge) {
+        m_mountInfoSnapshot.potentialMounts = tmdi.potentialMounts;
+        m_mountInfoSnapshot.queueTrimRequired = tmdi.queueTrimRequired;
+        m_mountInfoSnapshot.time = ::time(nullptr);
+      }
+    }
+  } else {
+    fetchQueuesMountInfo(tmdi, re, purpose, logContext);
+  }
+  fetchDrivesMountInfo(tmdi, logContext);
+}
+
+//------------------------------------------------------------------------------
+// OStoreDB::fetchQueuesMountInfo()
+//------------------------------------------------------------------------------
+void OStoreDB::fetchQueuesMountInfo(SchedulerDatabase::TapeMountDecisionInfo& tmdi, RootEntry& re,
+    SchedulerDatabase::PurposeGetMountInfo purpose, log::LogContext & logContext) {
+  utils::Timer t;
   std::list<common::dataStructures::MountPolicy> mountPolicies = m_catalogue.getCachedMountPolicies();
+  // Read all the queues in one go.
+  auto archiveQueuesForUser = re.dumpArchiveQueues(JobQueueType::JobsToTransferForUser);
+  auto archiveQueuesForRepack = re.dumpArchiveQueues(JobQueueType::JobsToTransferForRepack);
+  auto retrieveQueues = re.dumpRetrieveQueues(JobQueueType::JobsToTransferForUser);
+  // The user and repack archive queues are of the same type and go in the same batch (user queues first).
+  std::list<objectstore::ArchiveQueue> aqueues;
+  std::list<RetrieveQueue> rqueues;
+  for (auto & aqp: archiveQueuesForUser) aqueues.emplace_back(aqp.address, m_objectStore);
+  for (auto & aqp: archiveQueuesForRepack) aqueues.emplace_back(aqp.address, m_objectStore);
+  for (auto & rqp: retrieveQueues) rqueues.emplace_back(rqp.address, m_objectStore);
+  auto aqueuesFetchResults = objectstore::ArchiveQueue::multiLockfreeFetch(m_objectStore, aqueues);
+  auto rqueuesFetchResults = RetrieveQueue::multiLockfreeFetch(m_objectStore, rqueues);
+  auto queuesFetchTime = t.secs(utils::Timer::resetCounter);
+  // The states of the tapes with a retrieve queue, in one catalogue query.
+  std::set<std::string> retrieveQueuesVids;
+  auto rqueueFetchResult = rqueuesFetchResults.begin();
+  for (auto & rqp: retrieveQueues) {
+    if (!*(rqueueFetchResult++)) retrieveQueuesVids.insert(rqp.vid);
+  }
+  auto vidToTapeMap = m_catalogue.getTapesByVid(retrieveQueuesVids);
+  auto tapesFetchTime = t.secs(utils::Timer::resetCounter);
+  {
+    log::ScopedParamContainer params (logContext);
+    params.add("queuesNumber", aqueues.size() + rqueues.size())
+          .add("queuesFetchTime", queuesFetchTime)
+          .add("tapesFetchTime", tapesFetchTime);
+    if (queuesFetchTime > 1 || tapesFetchTime > 1) {
+      logContext.log(log::WARNING, "In OStoreDB::fetchMountInfo(): fetching the queues and tapes lasted more than 1 second.");
+    }
+  }
+  auto queueFetchResult = aqueuesFetchResults.begin();
   // Walk the archive queues for USER for statistics
-  for (auto & aqp: re.dumpArchiveQueues(JobQueueType::JobsToTransferForUser)) {
-    objectstore::ArchiveQueue aqueue(aqp.address, m_objectStore);
+  auto aqueueIt = aqueues.begin();
+  for (auto & aqp: archiveQueuesForUser) {
+    utils::Timer queueTimer;
+    objectstore::ArchiveQueue & aqueue = *(aqueueIt++);
+    auto fetchResult = *(queueFetchResult++);
     // debug utility variable
     std::string __attribute__((__unused__)) poolName = aqp.tapePool;
-    objectstore::ScopedSharedLock aqlock;
-    double queueLockTime = 0;
-    double queueFetchTime = 0;
     try {
-      aqueue.fetchNoLock();
-      queueFetchTime = t.secs(utils::Timer::resetCounter);
+      if (fetchResult) std::rethrow_exception(fetchResult);
     } catch (cta::exception::Exception &ex) {
       log::ScopedParamContainer params (logContext);
       params.add("queueObject", aqp.address)
@@ -241,29 +314,26 @@ void OStoreDB::fetchMountInfo(SchedulerDatabase::TapeMountDecisionInfo& tmdi, Ro
     } else {
       tmdi.queueTrimRequired = true;
     }
-    auto processingTime = t.secs(utils::Timer::resetCounter);
-    log::ScopedParamContainer params (logContext);
-    params.add("queueObject", aqp.address)
-          .add("tapePool", aqp.tapePool)
-          .add("queueType", toString(cta::common::dataStructures::MountType::ArchiveForUser))
-          .add("queueLockTime", queueLockTime)
-          .add("queueFetchTime", queueFetchTime)
-          .add("processingTime", processingTime);
-    if(queueLockTime > 1 || queueFetchTime > 1) {
-      logContext.log(log::WARNING, "In OStoreDB::fetchMountInfo(): fetched an archive for user queue and that lasted more than 1 second.");
+    auto processingTime = queueTimer.secs();
+    if (processingTime > 1) {
+      log::ScopedParamContainer params (logContext);
+      params.add("queueObject", aqp.address)
+            .add("tapePool", aqp.tapePool)
+            .add("queueType", toString(cta::common::dataStructures::MountType::ArchiveForUser))
+            .add("queuesFetchTime", queuesFetchTime)
+            .add("processingTime", processingTime);
+      logContext.log(log::WARNING, "In OStoreDB::fetchMountInfo(): processed an archive for user queue and that lasted more than 1 second.");
     }
   }
   // Walk the archive queues for REPACK for statistics
-  for (auto & aqp: re.dumpArchiveQueues(JobQueueType::JobsToTransferForRepack)) {
-    objectstore::ArchiveQueue aqueue(aqp.address, m_objectStore);
+  for (auto & aqp: archiveQueuesForRepack) {
+    utils::Timer queueTimer;
+    objectstore::ArchiveQueue & aqueue = *(aqueueIt++);
+    auto fetchResult = *(queueFetchResult++);
     // debug utility variable
     std::string __attribute__((__unused__)) poolName = aqp.tapePool;
-    objectstore::ScopedSharedLock aqlock;
-    double queueLockTime = 0;
-    double queueFetchTime = 0;
     try {
-      aqueue.fetchNoLock();
-      queueFetchTime = t.secs(utils::Timer::resetCounter);
+      if (fetchResult) std::rethrow_exception(fetchResult);
     } catch (cta::exception::Exception &ex) {
       log::ScopedParamContainer params (logContext);
       params.add("queueObject", aqp.address)
@@ -300,29 +370,28 @@ void OStoreDB::fetchMountInfo(SchedulerDatabase::TapeMountDecisionInfo& tmdi, Ro
     } else {
       tmdi.queueTrimRequired = true;
     }
-    auto processingTime = t.secs(utils::Timer::resetCounter);
-    log::ScopedParamContainer params (logContext);
-    params.add("queueObject", aqp.address)
-          .add("tapePool", aqp.tapePool)
-          .add("queueType", toString(cta::common::dataStructures::MountType::ArchiveForRepack))
-          .add("queueLockTime", queueLockTime)
-          .add("queueFetchTime", queueFetchTime)
-          .add("processingTime", processingTime);
-    if(queueLockTime > 1 || queueFetchTime > 1) {
-      logContext.log(log::WARNING, "In OStoreDB::fetchMountInfo(): fetched an archive for repack queue and that lasted more than 1 second.");
+    auto processingTime = queueTimer.secs();
+    if (processingTime > 1) {
+      log::ScopedParamContainer params (logContext);
+      params.add("queueObject", aqp.address)
+            .add("tapePool", aqp.tapePool)
+            .add("queueType", toString(cta::common::dataStructures::MountType::ArchiveForRepack))
+            .add("queuesFetchTime", queuesFetchTime)
+            .add("processingTime", processingTime);
+      logContext.log(log::WARNING, "In OStoreDB::fetchMountInfo(): processed an archive for repack queue and that lasted more than 1 second.");
     }
   }
   // Walk the retrieve queues for statistics
-  for (auto & rqp: re.dumpRetrieveQueues(JobQueueType::JobsToTransferForUser)) {
-    RetrieveQueue rqueue(rqp.address, m_objectStore);
+  auto rqueueIt = rqueues.begin();
+  queueFetchResult = rqueuesFetchResults.begin();
+  for (auto & rqp: retrieveQueues) {
+    utils::Timer queueTimer;
+    RetrieveQueue & rqueue = *(rqueueIt++);
+    auto fetchResult = *(queueFetchResult++);
     // debug utility variable
     std::string __attribute__((__unused__)) vid = rqp.vid;
-    ScopedSharedLock rqlock;
-    double queueLockTime = 0;
-    double queueFetchTime = 0;
     try {
-      rqueue.fetchNoLock();
-      queueFetchTime = t.secs(utils::Timer::resetCounter);
+      if (fetchResult) std::rethrow_exception(fetchResult);
     } catch (cta::exception::Exception &ex) {
       log::LogContext lc(m_logger);
       log::ScopedParamContainer params (lc);
@@ -336,37 +405,11 @@ void OStoreDB::fetchMountInfo(SchedulerDatabase::TapeMountDecisionInfo& tmdi, Ro
     // mount candidates list.
     auto rqSummary = rqueue.getJobsSummary();
     bool isPotentialMount = false;
-    auto vidToTapeMap = m_catalogue.getTapesByVid({rqp.vid});
     common::dataStructures::Tape::State tapeState = vidToTapeMap.at(rqp.vid).state;
     bool tapeIsDisabled = tapeState == common::dataStructures::Tape::DISABLED;
     bool tapeIsBroken = tapeState == common::dataStructures::Tape::BROKEN;
     if(tapeIsDisabled || tapeIsBroken){
-      //In the case there are Repack Retrieve Requests with the force disabled flag set
-      //on it, we will trigger a mount.
-      //In the case there are only deleted Retrieve Request on a DISABLED or BROKEN tape
-      //we want to trigger a mount to flush the queue.
-      auto retrieveQueueJobs = rqueue.dumpJobs();
-      uint64_t nbJobsNotExistInQueue = 0;
-      for(auto &job: retrieveQueueJobs){
-        cta::objectstore::RetrieveRequest rr(job.address,this->m_objectStore);
-        try{
-          rr.fetchNoLock();
-          if(tapeIsDisabled && rr.getRepackInfo().forceDisabledTape){
-            //At least one Retrieve job is a Repack Retrieve job with the tape disabled flag,
-            //we have a potential mount.
-            isPotentialMount = true;
-            break;
-          }
-        } catch(const cta::objectstore::Backend::NoSuchObject & ex){
-          //In the case of a repack cancellation, the RetrieveRequest object is deleted, so we just ignore the exception
-          //it will not be a potential mount.
-          nbJobsNotExistInQueue++;
-        }
-      }
-      if(!isPotentialMount && nbJobsNotExistInQueue == retrieveQueueJobs.size()){
-        //The tape is disabled or broken, there are only jobs that have been deleted, it is a potential mount as we want to flush the queue.
-        isPotentialMount = true;
-      }
+      isPotentialMount = isPotentialMountOnUnavailableTape(rqueue, tapeIsDisabled);
     } else {
       //A BROKEN tape cannot be a potential mount, only ACTIVE tape
       if(tapeState == common::dataStructures::Tape::ACTIVE)
@@ -455,17 +498,62 @@ void OStoreDB::fetchMountInfo(SchedulerDatabase::TapeMountDecisionInfo& tmdi, Ro
       if(!rqSummary.jobs)
         tmdi.queueTrimRequired = true;
     }
-    auto processingTime = t.secs(utils::Timer::resetCounter);
-    log::ScopedParamContainer params (logContext);
-    params.add("queueObject", rqp.address)
-          .add("tapeVid", rqp.vid)
-          .add("queueLockTime", queueLockTime)
-          .add("queueFetchTime", queueFetchTime)
-          .add("processingTime", processingTime);
-    if(queueLockTime > 1 || queueFetchTime > 1){
-      logContext.log(log::WARNING, "In OStoreDB::fetchMountInfo(): fetched a retrieve queue and that lasted more than 1 second.");
+    auto processingTime = queueTimer.secs();
+    if (processingTime > 1) {
+      log::ScopedParamContainer params (logContext);
+      params.add("queueObject", rqp.address)
+            .add("tapeVid", rqp.vid)
+            .add("queuesFetchTime", queuesFetchTime)
+            .add("processingTime", processingTime);
+      logContext.log(log::WARNING, "In OStoreDB::fetchMountInfo(): processed a retrieve queue and that lasted more than 1 second.");
     }
   }
+}
+
+//------------------------------------------------------------------------------
+// OStoreDB::isPotentialMountOnUnavailableTape()
+//------------------------------------------------------------------------------
+bool OStoreDB::isPotentialMountOnUnavailableTape(RetrieveQueue& rqueue, bool tapeIsDisabled) {
+  //In the case there are Repack Retrieve Requests with the force disabled flag set
+  //on it, we will trigger a mount.
+  //In the case there are only deleted Retrieve Request on a DISABLED or BROKEN tape
+  //we want to trigger a mount to flush the queue.
+  auto retrieveQueueJobs = rqueue.dumpJobs();
+  uint64_t nbJobsNotExistInQueue = 0;
+  auto job = retrieveQueueJobs.begin();
+  while (job != retrieveQueueJobs.end()) {
+    std::list<RetrieveRequest> requests;
+    while (job != retrieveQueueJobs.end() && requests.size() < c_unavailableTapeRequestsBatchSize) {
+      requests.emplace_back(job->address, m_objectStore);
+      job++;
+    }
+    auto fetchResults = RetrieveRequest::multiLockfreeFetch(m_objectStore, requests);
+    auto fetchResult = fetchResults.begin();
+    for (auto & rr: requests) {
+      try {
+        if (*fetchResult) std::rethrow_exception(*fetchResult);
+        if(tapeIsDisabled && rr.getRepackInfo().forceDisabledTape){
+          //At least one Retrieve job is a Repack Retrieve job with the tape disabled flag,
+          //we have a potential mount.
+          return true;
+        }
+      } catch(const cta::objectstore::Backend::NoSuchObject & ex){
+        //In the case of a repack cancellation, the RetrieveRequest object is deleted, so we just ignore the exception
+        //it will not be a potential mount.
+        nbJobsNotExistInQueue++;
+      }
+      fetchResult++;
+    }
+  }
+  //The tape is disabled or broken, there are only jobs that have been deleted, it is a potential mount as we want to flush the queue.
+  return nbJobsNotExistInQueue == retrieveQueueJobs.size();
+}
+
+//------------------------------------------------------------------------------
+// OStoreDB::fetchDrivesMountInfo()
+//------------------------------------------------------------------------------
+void OStoreDB::fetchDrivesMountInfo(SchedulerDatabase::TapeMountDecisionInfo& tmdi, log::LogContext& logContext) {
+  utils::Timer t;
   // Collect information about the existing and next mounts
   // If a next mount exists the drive "counts double", but the corresponding drive
   // is either about to mount, or about to replace its current mount.
@@ -610,7 +698,7 @@ std::unique_ptr<SchedulerDatabase::TapeMountDecisionInfo>
   tmdi.m_lockTaken = true;
   tmdi.m_schedulerGlobalLock->fetch();
   auto fetchSchedGlobalTime = t.secs(utils::Timer::resetCounter);;
-  fetchMountInfo(tmdi, re, SchedulerDatabase::PurposeGetMountInfo::GET_NEXT_MOUNT, logContext);
+  fetchMountInfo(tmdi, re, SchedulerDatabase::PurposeGetMountInfo::GET_NEXT_MOUNT, true, logContext);
   auto fetchMountInfoTime = t.secs(utils::Timer::resetCounter);
   std::unique_ptr<SchedulerDatabase::TapeMountDecisionInfo> ret(std::move(privateRet));
   {
@@ -638,7 +726,7 @@ std::unique_ptr<SchedulerDatabase::TapeMountDecisionInfo> OStoreDB::getMountInfo
   re.fetchNoLock();
   auto rootFetchNoLockTime = t.secs(utils::Timer::resetCounter);
   TapeMountDecisionInfoNoLock & tmdi=*privateRet;
-  fetchMountInfo(tmdi, re, purpose, logContext);
+  fetchMountInfo(tmdi, re, purpose, false, logContext);
   auto fetchMountInfoTime = t.secs(utils::Timer::resetCounter);
   std::unique_ptr<SchedulerDatabase::TapeMountDecisionInfo> ret(std::move(privateRet));
   {
@@ -740,16 +828,11 @@ std::unique_ptr<SchedulerDatabase::RetrieveMount> OStoreDB::TapeMountDecisionInf
 OStoreDB::TapeMountDecisionInfoNoLock::~TapeMountDecisionInfoNoLock() {}
 
 //------------------------------------------------------------------------------
-// OStoreDB::queueArchive()
+// OStoreDB::makeArchiveRequest()
 //------------------------------------------------------------------------------
-std::string OStoreDB::queueArchive(const std::string &instanceName, const cta::common::dataStructures::ArchiveRequest &request,
-        const cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId &criteria, log::LogContext &logContext) {
-  assertAgentAddressSet();
-  cta::utils::Timer timer;
-  auto mutexForHelgrind = cta::make_unique<cta::threading::Mutex>();
-  cta::threading::MutexLocker mlForHelgrind(*mutexForHelgrind);
-  auto * mutexForHelgrindAddr = mutexForHelgrind.release();
-  // Construct the archive request object in memory
+std::unique_ptr<objectstore::ArchiveRequest> OStoreDB::makeArchiveRequest(const std::string &instanceName,
+        const cta::common::dataStructures::ArchiveRequest &request,
+        const cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId &criteria) {
   auto aReq = cta::make_unique<cta::objectstore::ArchiveRequest> (m_agentReference->nextId("ArchiveRequest"), m_objectStore);
   aReq->initialize();
   // Summarize all as an archiveFile
@@ -771,20 +854,32 @@ std::string OStoreDB::queueArchive(const std::string &instanceName, const cta::c
   aReq->setRequester(request.requester);
   aReq->setSrcURL(request.srcURL);
   aReq->setEntryLog(request.creationLog);
-  std::list<cta::objectstore::ArchiveRequest::JobDump> jl;
   for (auto & copy:criteria.copyToPoolMap) {
     const uint32_t hardcodedRetriesWithinMount = 2;
     const uint32_t hardcodedTotalRetries = 2;
     const uint32_t hardcodedReportRetries = 2;
     aReq->addJob(copy.first, copy.second, m_agentReference->getAgentAddress(),
         hardcodedRetriesWithinMount, hardcodedTotalRetries, hardcodedReportRetries);
-    jl.push_back(cta::objectstore::ArchiveRequest::JobDump());
-    jl.back().copyNb = copy.first;
-    jl.back().tapePool = copy.second;
   }
-  if (jl.empty()) {
-    throw ArchiveRequestHasNoCopies("In OStoreDB::queue: the archive to file request has no copy");
+  if (criteria.copyToPoolMap.empty()) {
+    throw ArchiveRequestHasNoCopies("In OStoreDB::makeArchiveRequest(): the archive to file request has no copy");
   }
+  return aReq;
+}
+
+//------------------------------------------------------------------------------
+// OStoreDB::queueArchive()
+//------------------------------------------------------------------------------
+std::string OStoreDB::queueArchive(const std::string &instanceName, const cta::common::dataStructures::ArchiveRequest &request,
+        const cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId &criteria, log::LogContext &logContext) {
+  assertAgentAddressSet();
+  cta::utils::Timer timer;
+  auto mutexForHelgrind = cta::make_unique<cta::threading::Mutex>();
+  cta::threading::MutexLocker mlForHelgrind(*mutexForHelgrind);
+  auto * mutexForHelgrindAddr = mutexForHelgrind.release();
+  // Construct the archive request object in memory
+  auto aReq = makeArchiveRequest(instanceName, request, criteria);
+  const auto aFile = aReq->getArchiveFile();
   // We create the object here
   m_agentReference->addToOwnership(aReq->getAddressIfSet(), m_objectStore);
   double agentReferencingTime = timer.secs(cta::utils::Timer::reset_t::resetCounter);
@@ -908,6 +1003,149 @@ std::string OStoreDB::queueArchive(const std::string &instanceName, const cta::c
   return archiveRequestAddr;
 }
 
+//------------------------------------------------------------------------------
+// OStoreDB::queueArchiveBatch()
+//------------------------------------------------------------------------------
+std::vector<SchedulerDatabase::ArchiveRequestQueueingOutcome> OStoreDB::queueArchiveBatch(const std::string &instanceName,
+        const std::vector<ArchiveRequestToQueue> &requests, log::LogContext &logContext) {
+  assertAgentAddressSet();
+  utils::Timer t;
+  log::TimingList timingList;
+  std::vector<ArchiveRequestQueueingOutcome> outcomes(requests.size());
+  // Construct the archive request objects in memory. Their jobs are described for the sorter now, as the
+  // objects cannot be read without lock once created.
+  struct RequestToCreate {
+    size_t index;
+    std::shared_ptr<objectstore::ArchiveRequest> archiveRequest;
+    SorterArchiveRequest sorterArchiveRequest;
+    std::unique_ptr<objectstore::ArchiveRequest::AsyncInserter> inserter;
+  };
+  std::list<RequestToCreate> requestsToCreate;
+  std::list<std::string> requestsAddresses;
+  for (size_t i = 0; i < requests.size(); i++) {
+    try {
+      std::shared_ptr<objectstore::ArchiveRequest> aReq(makeArchiveRequest(instanceName, requests[i].request,
+        requests[i].criteria));
+      SorterArchiveRequest sorterArchiveRequest;
+      for (auto & j: aReq->dumpJobs()) {
+        sorterArchiveRequest.archiveJobs.emplace_back();
+        auto & job = sorterArchiveRequest.archiveJobs.back();
+        job.archiveRequest = aReq;
+        job.archiveFile = aReq->getArchiveFile();
+        job.jobDump = j;
+        job.mountPolicy = requests[i].criteria.mountPolicy;
+        job.jobQueueType = JobQueueType::JobsToTransferForUser;
+      }
+      requestsAddresses.push_back(aReq->getAddressIfSet());
+      requestsToCreate.push_back({i, aReq, sorterArchiveRequest, nullptr});
+    } catch (...) {
+      outcomes[i].error = std::current_exception();
+    }
+  }
+  // Reference all the requests from the agent in one go, then create them asynchronously.
+  m_agentReference->addBatchToOwnership(requestsAddresses, m_objectStore);
+  timingList.insertAndReset("agentReferencingTime", t);
+  for (auto & rtc: requestsToCreate) {
+    try {
+      rtc.inserter.reset(rtc.archiveRequest->asyncInsert());
+    } catch (...) {
+      outcomes[rtc.index].error = std::current_exception();
+    }
+  }
+  // Hand the created requests to the sorter. The ones which were not created are dereferenced from the
+  // agent. The ones which were created but could not be handed to the sorter are removed with the requests
+  // which could not be queued, once the queues are flushed (some of their jobs could have been sorted).
+  objectstore::Sorter sorter(*m_agentReference, m_objectStore, m_catalogue);
+  std::list<RequestToCreate *> createdRequests;
+  std::list<std::string> failedRequestsAddresses;
+  for (auto & rtc: requestsToCreate) {
+    if (!outcomes[rtc.index].error) {
+      try {
+        rtc.inserter->wait();
+      } catch (...) {
+        outcomes[rtc.index].error = std::current_exception();
+        failedRequestsAddresses.push_back(rtc.archiveRequest->getAddressIfSet());
+        continue;
+      }
+      try {
+        sorter.insertArchiveRequest(rtc.sorterArchiveRequest, *m_agentReference, logContext);
+      } catch (...) {
+        outcomes[rtc.index].error = std::current_exception();
+      }
+      createdRequests.push_back(&rtc);
+      continue;
+    }
+    failedRequestsAddresses.push_back(rtc.archiveRequest->getAddressIfSet());
+  }
+  timingList.insertAndReset("insertionTime", t);
+  // Queue all the jobs: the sorter does one commit per queue and moves the ownership of the requests
+  // from the agent to the queues.
+  std::map<std::string, std::list<std::future<void>>> queueingFutures;
+  auto archiveQueues = sorter.getAllArchive();
+  for (auto & queue: archiveQueues) {
+    for (auto & job: queue.second) {
+      auto & jobToQueue = job->jobToQueue;
+      queueingFutures[std::get<0>(jobToQueue).archiveRequest->getAddressIfSet()].emplace_back(
+        std::get<1>(jobToQueue).get_future());
+    }
+  }
+  try {
+    sorter.flushAllInParallel(logContext);
+  } catch (objectstore::Sorter::QueueFlushFailure & ex) {
+    // The jobs of the failed queues got the failure: their requests are handled below.
+    log::ScopedParamContainer params(logContext);
+    params.add("exceptionMessage", ex.getMessageValue());
+    logContext.log(log::ERR, "In OStoreDB::queueArchiveBatch(): failed to flush some archive queues");
+  }
+  timingList.insertAndReset("queueingTime", t);
+  // Requests with a job which could not be sorted or queued are removed, like in queueArchive().
+  uint64_t queuedRequests = 0;
+  for (auto rtc: createdRequests) {
+    auto & aReq = *rtc->archiveRequest;
+    if (!outcomes[rtc->index].error) {
+      try {
+        for (auto & f: queueingFutures.at(aReq.getAddressIfSet())) f.get();
+        outcomes[rtc->index].archiveRequestAddr = aReq.getAddressIfSet();
+        queuedRequests++;
+        continue;
+      } catch (...) {
+        outcomes[rtc->index].error = std::current_exception();
+      }
+    }
+    try {
+      ScopedExclusiveLock arl(aReq);
+      aReq.fetch();
+      for (auto & j: aReq.dumpJobs()) {
+        if (j.owner != m_agentReference->getAgentAddress()) {
+          objectstore::ArchiveQueue aq(j.owner, m_objectStore);
+          ScopedExclusiveLock aql(aq);
+          aq.fetch();
+          aq.removeJobsAndCommit({aReq.getAddressIfSet()});
+        }
+      }
+      aReq.remove();
+    } catch (exception::Exception & ex) {
+      log::ScopedParamContainer params(logContext);
+      params.add("archiveRequestObject", aReq.getAddressIfSet())
+            .add("exceptionMessage", ex.getMessageValue());
+      logContext.log(log::ERR, "In OStoreDB::queueArchiveBatch(): failed to remove a request which could not be queued");
+    }
+    failedRequestsAddresses.push_back(aReq.getAddressIfSet());
+  }
+  if (failedRequestsAddresses.size()) {
+    m_agentReference->removeBatchFromOwnership(failedRequestsAddresses, m_objectStore);
+  }
+  timingList.insertAndReset("cleanupTime", t);
+  log::ScopedParamContainer params(logContext);
+  params.add("diskInstance", instanceName)
+        .add("requests", requests.size())
+        .add("queuedRequests", queuedRequests)
+        .add("queues", archiveQueues.size());
+  timingList.addToLog(params);
+  logContext.log(log::INFO, "In OStoreDB::queueArchiveBatch(): queued a batch of archive requests.");
+  return outcomes;
+}
+
 //------------------------------------------------------------------------------
 // OStoreDB::getArchiveJobs()
 //------------------------------------------------------------------------------
@@ -2412,7 +2650,7 @@ void OStoreDB::RepackRetrieveSuccessesReportBatch::report(log::LogContext& lc) {
     for (auto &sts: successfullyTransformedSubrequests) {
       sorter.insertArchiveRequest(sts.sorterArchiveRequest, *m_oStoreDb.m_agentReference, lc);
     }
-    sorter.flushAll(lc);
+    sorter.flushAllInParallel(lc);
   }
   timingList.insertAndReset("archiveRequestsQueueingTime", t);
   log::ScopedParamContainer params(lc);
@@ -2822,7 +3060,7 @@ uint64_t OStoreDB::RepackRequest::addSubrequestsAndUpdateStats(std::list<Subrequ
       }
       nbRetrieveSubrequestsCreated = sorter.getAllRetrieve().size();
       locks.clear();
-      sorter.flushAll(lc);
+      sorter.flushAllInParallel(lc);
     }
   }
   m_repackRequest.setLastExpandedFSeq(fSeq);
@@ -3367,12 +3605,8 @@ std::list<std::unique_ptr<SchedulerDatabase::RetrieveJob>> OStoreDB::RetrieveMou
     for (auto &j: jobs.elements)
       if (j.diskSystemName)
         diskSpaceReservationRequest.addRequest(j.diskSystemName.value(), j.archiveFile.fileSize);
-    // Get the existing reservation map from drives (including this drive's previous pending reservations).
+    // Get the existing reservations of the drives by disk system (including this drive's previous pending reservations).
     auto previousDrivesReservations = DiskSpaceReservation::getExistingDrivesReservations(&this->m_oStoreDB.m_catalogue);
-    typedef std::pair<std::string, uint64_t> Res;
-    uint64_t previousDrivesReservationTotal = 0;
-    previousDrivesReservationTotal = std::accumulate(previousDrivesReservations.begin(), previousDrivesReservations.end(),
-        previousDrivesReservationTotal, [](uint64_t t, Res a){ return t+a.second;});
     // Get the free space from disk systems involved.
     std::set<std::string> diskSystemNames;
     for (auto const & dsrr: diskSpaceReservationRequest) diskSystemNames.insert(dsrr.first);
@@ -3412,6 +3646,7 @@ std::list<std::unique_ptr<SchedulerDatabase::RetrieveJob>> OStoreDB::RetrieveMou
               .add("isRepack", j.repackInfo.isRepack);
         logContext.log(log::ERR, "In OStoreDB::RetrieveMount::getNextJobBatch(): unable to request EOS free space for the job.");
         diskSystemNames.erase(diskSystemName);
+        diskSpaceReservationRequest.erase(diskSystemName);
       }
     } catch (std::exception &ex) {
       // Leave a log message before letting the possible exception go up the stack.
@@ -3423,19 +3658,34 @@ std::list<std::unique_ptr<SchedulerDatabase::RetrieveJob>> OStoreDB::RetrieveMou
     // If any file system does not have enough space, mark it as full for this mount, requeue all (slight but rare inefficiency)
     // and retry the pop.
     for (auto const & ds: diskSystemNames) {
+      const auto previousDrivesReservation = previousDrivesReservations.find(ds);
+      const uint64_t existingReservations =
+        previousDrivesReservation == previousDrivesReservations.end() ? 0 : previousDrivesReservation->second;
       if (diskSystemFreeSpace.at(ds).freeSpace < diskSpaceReservationRequest.at(ds) + diskSystemFreeSpace.at(ds).targetedFreeSpace +
-          previousDrivesReservationTotal) {
+          existingReservations) {
         m_diskSystemsToSkip.insert({ds, diskSystemFreeSpace.getDiskSystemList().at(ds).sleepTime});
         failedAllocation = true;
         log::ScopedParamContainer params(logContext);
         params.add("diskSystemName", ds)
               .add("freeSpace", diskSystemFreeSpace.at(ds).freeSpace)
-              .add("existingReservations", previousDrivesReservationTotal)
+              .add("existingReservations", existingReservations)
               .add("spaceToReserve", diskSpaceReservationRequest.at(ds))
               .add("targetedFreeSpace", diskSystemFreeSpace.at(ds).targetedFreeSpace);
         logContext.log(log::WARNING, "In OStoreDB::RetrieveMount::getNextJobBatch(): could not allocate disk space for job batch.");
       }
     }
+    // The reservations checked above could have grown since: the catalogue checks them again while reserving.
+    if (!failedAllocation && !DiskSpaceReservation::reserveDiskSpace(&this->m_oStoreDB.m_catalogue, mountInfo.drive,
+        diskSpaceReservationRequest, diskSystemFreeSpace, logContext)) {
+      const std::string & ds = diskSpaceReservationRequest.begin()->first;
+      m_diskSystemsToSkip.insert({ds, diskSystemFreeSpace.getDiskSystemList().at(ds).sleepTime});
+      failedAllocation = true;
+      log::ScopedParamContainer params(logContext);
+      params.add("diskSystemName", ds)
+            .add("spaceToReserve", diskSpaceReservationRequest.at(ds));
+      logContext.log(log::WARNING, "In OStoreDB::RetrieveMount::getNextJobBatch(): could not reserve disk space for job batch "
+        "as other drives reserved it meanwhile.");
+    }
   }
   if (failedAllocation) {
     std::list<std::unique_ptr<OStoreDB::RetrieveJob>> rjl;
@@ -3449,8 +3699,6 @@ std::list<std::unique_ptr<SchedulerDatabase::RetrieveJob>> OStoreDB::RetrieveMou
     diskSpaceReservationRequest.clear();
     goto retryPop;
   }
-  DiskSpaceReservation::reserveDiskSpace(&this->m_oStoreDB.m_catalogue, mountInfo.drive, diskSpaceReservationRequest,
-    logContext);
   // Allocation went fine, we can construct the return value (we did not hit any full disk system.
   std::list<std::unique_ptr<SchedulerDatabase::RetrieveJob>> ret;
   for(auto &j : jobs.elements)
@@ -3486,7 +3734,32 @@ void OStoreDB::RetrieveMount::requeueJobBatch(std::list<std::unique_ptr<OStoreDB
   }
   locks.clear();
   rrlist.clear();
-  sorter.flushAll(logContext);
+  std::map<std::string, std::future<void>> requeueingFutures;
+  for (auto & queue: sorter.getAllRetrieve()) {
+    for (auto & job: queue.second) {
+      auto & jobToQueue = job->jobToQueue;
+      requeueingFutures[std::get<0>(jobToQueue).retrieveRequest->getAddressIfSet()] = std::get<1>(jobToQueue).get_future();
+    }
+  }
+  try {
+    sorter.flushAllInParallel(logContext);
+  } catch (objectstore::Sorter::QueueFlushFailure & ex) {
+    // The jobs of the failed queues got the failure: they are reported below.
+    log::ScopedParamContainer params(logContext);
+    params.add("exceptionMessage", ex.getMessageValue());
+    logContext.log(log::ERR, "In OStoreDB::RetrieveMount::requeueJobBatch(): failed to flush some retrieve queues");
+  }
+  for (auto & rf: requeueingFutures) {
+    try {
+      rf.second.get();
+    } catch (exception::Exception & ex) {
+      // The request stays owned by the agent.
+      log::ScopedParamContainer params(logContext);
+      params.add("retrieveRequestObject", rf.first)
+            .add("exceptionMessage", ex.getMessageValue());
+      logContext.log(log::ERR, "In OStoreDB::RetrieveMount::requeueJobBatch(): failed to requeue a retrieve request");
+    }
+  }
 }
 
 //------------------------------------------------------------------------------
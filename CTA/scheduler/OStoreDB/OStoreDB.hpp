@@ -22,6 +22,7 @@
 #include "catalogue/Catalogue.hpp"
 #include "common/log/Logger.hpp"
 #include "common/threading/BlockingQueue.hpp"
+#include "common/threading/MutexLocker.hpp"
 #include "common/threading/Thread.hpp"
 #include "objectstore/Agent.hpp"
 #include "objectstore/AgentReference.hpp"
@@ -147,9 +148,60 @@ private:
    * An internal helper function with commonalities of both following functions
    * @param tmdi The TapeMountDecisionInfo where to store the data.
    * @param re A RootEntry object that should be locked and fetched.
+   * @param schedulerGlobalLockHeld true when called with the global scheduling lock held: the queues are then always
+   * read, and refresh the snapshot of the GET_NEXT_MOUNT reads.
    */
   void fetchMountInfo(SchedulerDatabase::TapeMountDecisionInfo &tmdi, objectstore::RootEntry &re, SchedulerDatabase::PurposeGetMountInfo purpose,
-    log::LogContext & logContext);
+    bool schedulerGlobalLockHeld, log::LogContext & logContext);
+
+  /**
+   * Builds the potential mounts from the archive and retrieve queues. All the queues are read in a
+   * single batch and the states of the tapes of the retrieve queues are fetched in a single catalogue query.
+   * @param tmdi The TapeMountDecisionInfo where to store the potential mounts.
+   * @param re A RootEntry object that should be locked and fetched.
+   */
+  void fetchQueuesMountInfo(SchedulerDatabase::TapeMountDecisionInfo &tmdi, objectstore::RootEntry &re,
+    SchedulerDatabase::PurposeGetMountInfo purpose, log::LogContext & logContext);
+
+  /**
+   * Lists the existing and next mounts from the drive states.
+   * @param tmdi The TapeMountDecisionInfo where to store the existing mounts.
+   */
+  void fetchDrivesMountInfo(SchedulerDatabase::TapeMountDecisionInfo &tmdi, log::LogContext & logContext);
+
+  /**
+   * Decides whether a retrieve queue on a DISABLED or BROKEN tape should be mounted anyway: either one of
+   * its jobs is a repack retrieve forcing the use of a disabled tape, or all its requests were deleted and
+   * the queue should be flushed. The requests are read in batches.
+   */
+  bool isPotentialMountOnUnavailableTape(objectstore::RetrieveQueue & rqueue, bool tapeIsDisabled);
+
+  /** Number of retrieve requests read per batch by isPotentialMountOnUnavailableTape() */
+  static const size_t c_unavailableTapeRequestsBatchSize = 500;
+
+  /**
+   * The potential mounts found by the last queue scan for GET_NEXT_MOUNT. Drive states are not part of
+   * the snapshot: they are cheap to get and are what changes when mounts get scheduled.
+   */
+  struct MountInfoSnapshot {
+    std::vector<SchedulerDatabase::PotentialMount> potentialMounts;
+    bool queueTrimRequired = false;
+    time_t time = 0;
+  };
+  MountInfoSnapshot m_mountInfoSnapshot;
+  /** Maximum age of the snapshot for it to be reused, 0 disables the reuse */
+  time_t m_mountInfoSnapshotMaxAge = 0;
+  threading::Mutex m_mountInfoSnapshotMutex;
+
+public:
+  /**
+   * Allows the mount decisions to reuse the queue summaries read by a previous mount decision (be it
+   * getMountInfo() or getMountInfoNoLock(GET_NEXT_MOUNT)) for maxAge seconds instead of reading all the
+   * queues again. The drive states are always fetched. By default (0) the queues are always read.
+   * @param maxAge maximum age of the reused queue summaries, in seconds
+   */
+  void setMountInfoSnapshotMaxAge(time_t maxAge);
+private:
 
   /**
    * An internal helper function to build a list of mount policies with the map of the
@@ -314,6 +366,19 @@ public:
   std::string queueArchive(const std::string &instanceName, const cta::common::dataStructures::ArchiveRequest &request,
     const cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId &criteria, log::LogContext &logContext) override;
 
+  std::vector<ArchiveRequestQueueingOutcome> queueArchiveBatch(const std::string &instanceName,
+    const std::vector<ArchiveRequestToQueue> &requests, log::LogContext &logContext) override;
+
+private:
+  /**
+   * Builds in memory the archive request object of a request, with its jobs owned by the agent.
+   * Throws ArchiveRequestHasNoCopies if the criteria give no copy.
+   */
+  std::unique_ptr<objectstore::ArchiveRequest> makeArchiveRequest(const std::string &instanceName,
+    const cta::common::dataStructures::ArchiveRequest &request,
+    const cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId &criteria);
+public:
+
   std::map<std::string, std::list<common::dataStructures::ArchiveJob>> getArchiveJobs() const override;
 
   std::list<cta::common::dataStructures::ArchiveJob> getArchiveJobs(const std::string& tapePoolName) const override;
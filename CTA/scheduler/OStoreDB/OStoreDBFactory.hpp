@@ -109,6 +109,11 @@ public:
     return m_OStoreDB.queueArchive(instanceName, request, criteria, logContext);
   }
 
+  std::vector<ArchiveRequestQueueingOutcome> queueArchiveBatch(const std::string &instanceName,
+    const std::vector<ArchiveRequestToQueue> &requests, log::LogContext &logContext) override {
+    return m_OStoreDB.queueArchiveBatch(instanceName, requests, logContext);
+  }
+
   void deleteRetrieveRequest(const common::dataStructures::SecurityIdentity& cliIdentity, const std::string& remoteFile) override {
     m_OStoreDB.deleteRetrieveRequest(cliIdentity, remoteFile);
   }
@@ -181,6 +181,54 @@ TEST_P(OStoreDBTest, getBatchArchiveJob) {
   ASSERT_EQ(false, osdbi.getBackend().exists(aqAddr));
 }
 
+TEST_P(OStoreDBTest, mountInfoSnapshot) {
+  using namespace cta::objectstore;
+  cta::log::StringLogger logger("dummy", "OStoreAbstractTest", cta::log::DEBUG);
+  cta::log::LogContext lc(logger);
+  OStoreDBWrapperInterface & osdbi = getDb();
+  auto queueArchives = [&](size_t first, size_t number) {
+    for (size_t i=first; i<first+number; i++) {
+      cta::common::dataStructures::ArchiveRequest ar;
+      cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId afqc;
+      ar.fileSize=123;
+      afqc.copyToPoolMap[1] = "Tapepool1";
+      afqc.fileId = i;
+      afqc.mountPolicy.name = "policy";
+      afqc.mountPolicy.archivePriority = 1;
+      osdbi.queueArchive("testInstance", ar, afqc, lc);
+      osdbi.waitSubthreadsComplete();
+    }
+  };
+  using cta::SchedulerDatabase;
+  auto queuedFiles = [&](SchedulerDatabase::PurposeGetMountInfo purpose) {
+    auto mountInfo = osdbi.getMountInfoNoLock(purpose, lc);
+    uint64_t ret = 0;
+    for (auto & pm: mountInfo->potentialMounts) ret += pm.filesQueued;
+    return ret;
+  };
+  osdbi.getOstoreDB().setMountInfoSnapshotMaxAge(3600);
+  queueArchives(0, 5);
+  ASSERT_EQ(5, queuedFiles(SchedulerDatabase::PurposeGetMountInfo::GET_NEXT_MOUNT));
+  queueArchives(5, 3);
+  // The queues are not read again while the snapshot is valid...
+  ASSERT_EQ(5, queuedFiles(SchedulerDatabase::PurposeGetMountInfo::GET_NEXT_MOUNT));
+  // ... but they are for the other purposes...
+  ASSERT_EQ(8, queuedFiles(SchedulerDatabase::PurposeGetMountInfo::SHOW_QUEUES));
+  // ... and under the global scheduling lock, which also refreshes the snapshot...
+  queueArchives(8, 2);
+  {
+    auto mountInfo = osdbi.getMountInfo(lc);
+    uint64_t lockedQueuedFiles = 0;
+    for (auto & pm: mountInfo->potentialMounts) lockedQueuedFiles += pm.filesQueued;
+    ASSERT_EQ(10, lockedQueuedFiles);
+  }
+  queueArchives(10, 1);
+  ASSERT_EQ(10, queuedFiles(SchedulerDatabase::PurposeGetMountInfo::GET_NEXT_MOUNT));
+  // ... and when the reuse is disabled.
+  osdbi.getOstoreDB().setMountInfoSnapshotMaxAge(0);
+  ASSERT_EQ(11, queuedFiles(SchedulerDatabase::PurposeGetMountInfo::GET_NEXT_MOUNT));
+}
+
 TEST_P(OStoreDBTest, MemQueuesSharedAddToArchiveQueue) {
   using namespace cta::objectstore;
   cta::log::StringLogger logger("dummy", "OStoreAbstractTest", cta::log::DEBUG);
@@ -143,8 +143,9 @@ std::list<std::unique_ptr<cta::RetrieveJob> > cta::RetrieveMount::getNextJobBatc
   disk::DiskSystemList diskSystemList;
   diskSystemList = m_catalogue.getAllDiskSystems();
   diskSystemList.setFetchEosFreeSpaceScript(m_fetchEosFreeSpaceScript);
-  // TODO: the diskSystemFreeSpaceList could be made a member of the retrieve mount and cache the fetched values, limiting the re-querying
-  // of the disk systems free space.
+  // The free space fetched by the previous batches (of any drive of the host) is shared through the cache file, and
+  // re-queried once per refresh interval of the disk system.
+  diskSystemList.setFreeSpaceCacheFile(m_diskSystemFreeSpaceCacheFile);
   disk::DiskSystemFreeSpaceList diskSystemFreeSpaceList (diskSystemList);
   // Try and get a new job from the DB. The DB mount (in memory object) is taking care of reserving the free space for the popped 
   // elements and query the disk systems, via the diskSystemFreeSpaceList object.
@@ -337,6 +338,13 @@ void cta::RetrieveMount::setFetchEosFreeSpaceScript(const std::string& name){
   m_fetchEosFreeSpaceScript = name;
 }
 
+//------------------------------------------------------------------------------
+// setDiskSystemFreeSpaceCacheFile()
+//------------------------------------------------------------------------------
+void cta::RetrieveMount::setDiskSystemFreeSpaceCacheFile(const std::string& path){
+  m_diskSystemFreeSpaceCacheFile = path;
+}
+
 //------------------------------------------------------------------------------
 // destructor
 //------------------------------------------------------------------------------
@@ -199,6 +199,12 @@ namespace cta {
     disk::DiskReporter * createDiskReporter(std::string & URL);
     
     void setFetchEosFreeSpaceScript(const std::string & name);
+
+    /**
+     * Sets the file through which the free space of the disk systems is
+     * shared with the other drive processes (empty for no sharing).
+     */
+    void setDiskSystemFreeSpaceCacheFile(const std::string & path);
     
     /**
      * Destructor.
@@ -245,6 +251,11 @@ namespace cta {
      * to get the EOS free space 
      */
     std::string m_fetchEosFreeSpaceScript;
+
+    /**
+     * The file sharing the free space of the disk systems
+     */
+    std::string m_diskSystemFreeSpaceCacheFile;
     
   }; // class RetrieveMount
 
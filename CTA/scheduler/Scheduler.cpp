@@ -44,6 +44,7 @@
 #include <random>
 #include <chrono>
 #include <cstdlib>
+#include <future>
 
 namespace cta {
 
@@ -133,8 +134,6 @@ uint64_t Scheduler::checkAndGetNextArchiveFileId(const std::string &instanceName
 std::string Scheduler::queueArchiveWithGivenId(const uint64_t archiveFileId, const std::string &instanceName,
   const cta::common::dataStructures::ArchiveRequest &request, log::LogContext &lc) {
   cta::utils::Timer t;
-  using utils::postEllipsis;
-  using utils::midEllipsis;
 
   if (!request.fileSize)
     throw cta::exception::UserError(std::string("Rejecting archive request for zero-length file: ")+request.diskFileInfo.path);
@@ -149,6 +148,80 @@ std::string Scheduler::queueArchiveWithGivenId(const uint64_t archiveFileId, con
   std::string archiveReqAddr = m_db.queueArchive(instanceName, request, catalogueInfo, lc);
   auto schedulerDbTime = t.secs();
   log::ScopedParamContainer spc(lc);
+  spc.add("catalogueTime", catalogueTime)
+     .add("schedulerDbTime", schedulerDbTime);
+  logQueuedArchiveRequest(instanceName, request, catalogueInfo, lc);
+  return archiveReqAddr;
+}
+
+//------------------------------------------------------------------------------
+// queueArchiveBatch
+//------------------------------------------------------------------------------
+std::vector<SchedulerDatabase::ArchiveRequestQueueingOutcome> Scheduler::queueArchiveBatch(const std::string &instanceName,
+  const std::vector<ArchiveRequestWithGivenId> &requests, log::LogContext &lc) {
+  cta::utils::Timer t;
+  std::vector<SchedulerDatabase::ArchiveRequestQueueingOutcome> outcomes(requests.size());
+  // The criteria only depend on the storage class and the requester: look them up once for each.
+  struct QueueCriteriaOrError {
+    common::dataStructures::ArchiveFileQueueCriteria queueCriteria;
+    std::exception_ptr error;
+  };
+  std::map<std::tuple<std::string, std::string, std::string>, QueueCriteriaOrError> queueCriteriaCache;
+  std::vector<SchedulerDatabase::ArchiveRequestToQueue> requestsToQueue;
+  std::vector<size_t> requestsToQueueIndexes;
+  for (size_t i = 0; i < requests.size(); i++) {
+    const auto &request = requests[i].request;
+    if (!request.fileSize) {
+      outcomes[i].error = std::make_exception_ptr(cta::exception::UserError(
+        std::string("Rejecting archive request for zero-length file: ")+request.diskFileInfo.path));
+      continue;
+    }
+    auto criteriaKey = std::make_tuple(request.storageClass, request.requester.name, request.requester.group);
+    auto queueCriteria = queueCriteriaCache.find(criteriaKey);
+    if (queueCriteria == queueCriteriaCache.end()) {
+      QueueCriteriaOrError queueCriteriaOrError;
+      try {
+        queueCriteriaOrError.queueCriteria = m_catalogue.getArchiveFileQueueCriteria(instanceName, request.storageClass,
+          request.requester);
+      } catch (...) {
+        queueCriteriaOrError.error = std::current_exception();
+      }
+      queueCriteria = queueCriteriaCache.emplace(criteriaKey, queueCriteriaOrError).first;
+    }
+    if (queueCriteria->second.error) {
+      outcomes[i].error = queueCriteria->second.error;
+      continue;
+    }
+    requestsToQueue.push_back({request, common::dataStructures::ArchiveFileQueueCriteriaAndFileId(requests[i].archiveFileId,
+      queueCriteria->second.queueCriteria.copyToPoolMap, queueCriteria->second.queueCriteria.mountPolicy)});
+    requestsToQueueIndexes.push_back(i);
+  }
+  auto catalogueTime = t.secs(cta::utils::Timer::resetCounter);
+
+  auto queueingOutcomes = m_db.queueArchiveBatch(instanceName, requestsToQueue, lc);
+  auto schedulerDbTime = t.secs();
+  log::ScopedParamContainer spc(lc);
+  spc.add("batchSize", requests.size())
+     .add("catalogueLookups", queueCriteriaCache.size())
+     .add("catalogueTime", catalogueTime)
+     .add("schedulerDbTime", schedulerDbTime);
+  for (size_t i = 0; i < requestsToQueue.size(); i++) {
+    outcomes[requestsToQueueIndexes[i]] = queueingOutcomes.at(i);
+    if (!queueingOutcomes.at(i).error) {
+      logQueuedArchiveRequest(instanceName, requestsToQueue[i].request, requestsToQueue[i].criteria, lc);
+    }
+  }
+  return outcomes;
+}
+
+//------------------------------------------------------------------------------
+// logQueuedArchiveRequest
+//------------------------------------------------------------------------------
+void Scheduler::logQueuedArchiveRequest(const std::string &instanceName,
+  const cta::common::dataStructures::ArchiveRequest &request,
+  const common::dataStructures::ArchiveFileQueueCriteriaAndFileId &catalogueInfo, log::LogContext &lc) {
+  using utils::midEllipsis;
+  log::ScopedParamContainer spc(lc);
   spc.add("instanceName", instanceName)
      .add("storageClass", request.storageClass)
      .add("diskFileID", request.diskFileID)
@@ -172,12 +245,9 @@ std::string Scheduler::queueArchiveWithGivenId(const uint64_t archiveFileId, con
      .add("creationUser", request.creationLog.username)
      .add("requesterName", request.requester.name)
      .add("requesterGroup", request.requester.group)
-     .add("srcURL", midEllipsis(request.srcURL, 50, 15))
-     .add("catalogueTime", catalogueTime)
-     .add("schedulerDbTime", schedulerDbTime);
+     .add("srcURL", midEllipsis(request.srcURL, 50, 15));
   request.checksumBlob.addFirstChecksumToLog(spc);
   lc.log(log::INFO, "Queued archive request");
-  return archiveReqAddr;
 }
 
 //------------------------------------------------------------------------------
@@ -530,182 +600,222 @@ void Scheduler::expandRepackRequest(std::unique_ptr<RepackRequest>& repackReques
   }
 
   std::list<common::dataStructures::StorageClass> storageClasses = m_catalogue.getStorageClasses();
+  auto diskSystemList = m_catalogue.getAllDiskSystems();
+  timingList.insertAndReset("getDisksystemsListTime",t);
 
   repackRequest->m_dbReq->setExpandStartedAndChangeStatus();
   uint64_t nbRetrieveSubrequestsQueued = 0;
-
-  std::list<cta::common::dataStructures::ArchiveFile> archiveFilesFromCatalogue;
-
-  while(archiveFilesForCatalogue.hasMore()){
-    archiveFilesFromCatalogue.push_back(archiveFilesForCatalogue.next());
-  }
-
-  if(repackInfo.noRecall){
-    archiveFilesFromCatalogue.remove_if([&repackInfo, &filesInDirectory](const common::dataStructures::ArchiveFile & archiveFile){
-      //We remove all the elements that are not in the repack buffer so that we don't recall them
-      return std::find_if(filesInDirectory.begin(), filesInDirectory.end(),[&archiveFile, &repackInfo](const std::string & fseq){
-        //If we find a tape file that has the current fseq and belongs to the VID to repack, then we DON'T remove it from
-        //the archiveFilesFromCatalogue list
-        return std::find_if(archiveFile.tapeFiles.begin(), archiveFile.tapeFiles.end(),[&repackInfo, &fseq](const common::dataStructures::TapeFile & tapeFile){
-          //Can we find, in the archiveFilesFromCatalogue list an archiveFile that contains a tapefile that belongs to the VID to repack and that has the
-          //fseq of the current file read from the filesInDirectory list ?
-          return tapeFile.vid == repackInfo.vid && tapeFile.fSeq == cta::utils::toUint64(cta::utils::removePrefix(fseq,'0'));
-        }) != archiveFile.tapeFiles.end();
-      }) == filesInDirectory.end();
-    });
-  }
-
-  std::list<SchedulerDatabase::RepackRequest::Subrequest> retrieveSubrequests;
+  uint64_t nbPagesQueued = 0;
   uint64_t maxAddedFSeq = 0;
-  while(!archiveFilesFromCatalogue.empty()) {
-    fSeq++;
-    retrieveSubrequests.push_back(cta::SchedulerDatabase::RepackRequest::Subrequest());
-    auto archiveFile = archiveFilesFromCatalogue.front();
-    archiveFilesFromCatalogue.pop_front();
-    auto & retrieveSubRequest  = retrieveSubrequests.back();
-
-    retrieveSubRequest.archiveFile = archiveFile;
-    retrieveSubRequest.fSeq = std::numeric_limits<decltype(retrieveSubRequest.fSeq)>::max();
-
-     //Check that all the archive routes have been configured, if one archive route is missing, we fail the repack request.
-    auto archiveFileRoutes = archiveRoutesMap[archiveFile.storageClass];
-    auto storageClassOfArchiveFile = std::find_if(storageClasses.begin(),storageClasses.end(),[&archiveFile](const common::dataStructures::StorageClass& sc){
-      return sc.name == archiveFile.storageClass;
-    });
-
-    if(storageClassOfArchiveFile == storageClasses.end()) {
-      //No storage class have been found for the current tapefile throw an exception
-      deleteRepackBuffer(std::move(dir),lc);
-      std::ostringstream oss;
-      oss << "In Scheduler::expandRepackRequest(): No storage class have been found for the file to repack. ArchiveFileID=" << archiveFile.archiveFileID << " StorageClass of the file=" << archiveFile.storageClass;
-      throw ExpandRepackRequestException(oss.str());
+
+  // The expansion is pipelined by pages of archive files: the subrequests of a page are created in the scheduler
+  // database in the background while the next page is read from the catalogue and checked against the repack
+  // buffer. At most two pages are in memory at a time.
+  std::future<uint64_t> pageQueueing;
+  auto waitForPageQueueing = [&pageQueueing, &nbRetrieveSubrequestsQueued, &nbPagesQueued]() {
+    if (pageQueueing.valid()) {
+      nbRetrieveSubrequestsQueued += pageQueueing.get();
+      nbPagesQueued++;
     }
+  };
 
-    common::dataStructures::StorageClass sc = *storageClassOfArchiveFile;
+  try {
+    // A first (possibly empty) page is always queued so that the statistics of the repack request are recorded.
+    do {
+      std::list<cta::common::dataStructures::ArchiveFile> archiveFilesFromCatalogue;
+      uint64_t nbArchiveFilesInPage = 0;
+      while(nbArchiveFilesInPage < m_repackExpansionPageSize && archiveFilesForCatalogue.hasMore()){
+        archiveFilesFromCatalogue.push_back(archiveFilesForCatalogue.next());
+        nbArchiveFilesInPage++;
+      }
 
-    // We have to determine which copynbs we want to rearchive, and under which fSeq we record this file.
-    if (repackInfo.type == RepackType::MoveAndAddCopies || repackInfo.type == RepackType::MoveOnly) {
-      // determine which fSeq(s) (normally only one) lives on this tape.
-      for (auto & tc: archiveFile.tapeFiles) if (tc.vid == repackInfo.vid) {
-        // We make the (reasonable) assumption that the archive file only has one copy on this tape.
-        // If not, we will ensure the subrequest is filed under the lowest fSeq existing on this tape.
-        // This will prevent double subrequest creation (we already have such a mechanism in case of crash and
-        // restart of expansion.
+      if(repackInfo.noRecall){
+        archiveFilesFromCatalogue.remove_if([&repackInfo, &filesInDirectory](const common::dataStructures::ArchiveFile & archiveFile){
+          //We remove all the elements that are not in the repack buffer so that we don't recall them
+          return std::find_if(filesInDirectory.begin(), filesInDirectory.end(),[&archiveFile, &repackInfo](const std::string & fseq){
+            //If we find a tape file that has the current fseq and belongs to the VID to repack, then we DON'T remove it from
+            //the archiveFilesFromCatalogue list
+            return std::find_if(archiveFile.tapeFiles.begin(), archiveFile.tapeFiles.end(),[&repackInfo, &fseq](const common::dataStructures::TapeFile & tapeFile){
+              //Can we find, in the archiveFilesFromCatalogue list an archiveFile that contains a tapefile that belongs to the VID to repack and that has the
+              //fseq of the current file read from the filesInDirectory list ?
+              return tapeFile.vid == repackInfo.vid && tapeFile.fSeq == cta::utils::toUint64(cta::utils::removePrefix(fseq,'0'));
+            }) != archiveFile.tapeFiles.end();
+          }) == filesInDirectory.end();
+        });
+      }
 
-        //Here, test that the archive route of the copyNb of the tape file is configured
-        try {
-          archiveFileRoutes.at(tc.copyNb);
-        } catch (const std::out_of_range & ex) {
-          deleteRepackBuffer(std::move(dir),lc);
+      auto retrieveSubrequests = std::make_shared<std::list<SchedulerDatabase::RepackRequest::Subrequest>>();
+      while(!archiveFilesFromCatalogue.empty()) {
+        fSeq++;
+        retrieveSubrequests->push_back(cta::SchedulerDatabase::RepackRequest::Subrequest());
+        auto archiveFile = archiveFilesFromCatalogue.front();
+        archiveFilesFromCatalogue.pop_front();
+        auto & retrieveSubRequest  = retrieveSubrequests->back();
+
+        retrieveSubRequest.archiveFile = archiveFile;
+        retrieveSubRequest.fSeq = std::numeric_limits<decltype(retrieveSubRequest.fSeq)>::max();
+
+         //Check that all the archive routes have been configured, if one archive route is missing, we fail the repack request.
+        auto archiveFileRoutesItor = archiveRoutesMap.find(archiveFile.storageClass);
+        auto archiveFileRoutes = archiveFileRoutesItor != archiveRoutesMap.end() ? archiveFileRoutesItor->second :
+          decltype(archiveRoutesMap)::mapped_type();
+        auto storageClassOfArchiveFile = std::find_if(storageClasses.begin(),storageClasses.end(),[&archiveFile](const common::dataStructures::StorageClass& sc){
+          return sc.name == archiveFile.storageClass;
+        });
+
+        if(storageClassOfArchiveFile == storageClasses.end()) {
+          //No storage class have been found for the current tapefile throw an exception
           std::ostringstream oss;
-          oss << "In Scheduler::expandRepackRequest(): the file archiveFileID=" << archiveFile.archiveFileID << ", copyNb=" << std::to_string(tc.copyNb) << ", storageClass=" << archiveFile.storageClass << " does not have any archive route for archival.";
+          oss << "In Scheduler::expandRepackRequest(): No storage class have been found for the file to repack. ArchiveFileID=" << archiveFile.archiveFileID << " StorageClass of the file=" << archiveFile.storageClass;
           throw ExpandRepackRequestException(oss.str());
         }
 
-        totalStatsFile.totalFilesToArchive += 1;
-        totalStatsFile.totalBytesToArchive += retrieveSubRequest.archiveFile.fileSize;
-        retrieveSubRequest.copyNbsToRearchive.insert(tc.copyNb);
-        retrieveSubRequest.fSeq = tc.fSeq;
-      }
-    }
+        common::dataStructures::StorageClass sc = *storageClassOfArchiveFile;
 
-    if(repackInfo.type == RepackType::AddCopiesOnly || repackInfo.type == RepackType::MoveAndAddCopies){
-      //We are in the case where we possibly need to create new copies (if the number of copies the storage class of the current ArchiveFile
-      //is greater than the number of tape files we have in the current ArchiveFile)
-      uint64_t nbFilesAlreadyArchived = getNbFilesAlreadyArchived(archiveFile);
-      uint64_t nbCopiesInStorageClass = sc.nbCopies;
-      uint64_t filesToArchive = nbCopiesInStorageClass - nbFilesAlreadyArchived;
-      if(filesToArchive > 0){
-        totalStatsFile.totalFilesToArchive += filesToArchive;
-        totalStatsFile.totalBytesToArchive += (filesToArchive * archiveFile.fileSize);
-        std::set<uint64_t> copyNbsAlreadyInCTA;
-        for (auto & tc: archiveFile.tapeFiles) {
-          copyNbsAlreadyInCTA.insert(tc.copyNb);
-          if (tc.vid == repackInfo.vid) {
+        // We have to determine which copynbs we want to rearchive, and under which fSeq we record this file.
+        if (repackInfo.type == RepackType::MoveAndAddCopies || repackInfo.type == RepackType::MoveOnly) {
+          // determine which fSeq(s) (normally only one) lives on this tape.
+          for (auto & tc: archiveFile.tapeFiles) if (tc.vid == repackInfo.vid) {
             // We make the (reasonable) assumption that the archive file only has one copy on this tape.
             // If not, we will ensure the subrequest is filed under the lowest fSeq existing on this tape.
             // This will prevent double subrequest creation (we already have such a mechanism in case of crash and
             // restart of expansion.
-            //We found the copy of the file we want to retrieve and archive
-            //retrieveSubRequest.fSeq = tc.fSeq;
-            if(repackInfo.type == RepackType::AddCopiesOnly)
-              retrieveSubRequest.fSeq = (retrieveSubRequest.fSeq == std::numeric_limits<decltype(retrieveSubRequest.fSeq)>::max()) ? tc.fSeq : std::max(tc.fSeq, retrieveSubRequest.fSeq);
+
+            //Here, test that the archive route of the copyNb of the tape file is configured
+            try {
+              archiveFileRoutes.at(tc.copyNb);
+            } catch (const std::out_of_range & ex) {
+              std::ostringstream oss;
+              oss << "In Scheduler::expandRepackRequest(): the file archiveFileID=" << archiveFile.archiveFileID << ", copyNb=" << std::to_string(tc.copyNb) << ", storageClass=" << archiveFile.storageClass << " does not have any archive route for archival.";
+              throw ExpandRepackRequestException(oss.str());
+            }
+
+            totalStatsFile.totalFilesToArchive += 1;
+            totalStatsFile.totalBytesToArchive += retrieveSubRequest.archiveFile.fileSize;
+            retrieveSubRequest.copyNbsToRearchive.insert(tc.copyNb);
+            retrieveSubRequest.fSeq = tc.fSeq;
           }
         }
-        for(auto archiveFileRoutesItor = archiveFileRoutes.begin(); archiveFileRoutesItor != archiveFileRoutes.end(); ++archiveFileRoutesItor){
-          if(copyNbsAlreadyInCTA.find(archiveFileRoutesItor->first) == copyNbsAlreadyInCTA.end()){
-            //We need to archive the missing copy
-            retrieveSubRequest.copyNbsToRearchive.insert(archiveFileRoutesItor->first);
+
+        if(repackInfo.type == RepackType::AddCopiesOnly || repackInfo.type == RepackType::MoveAndAddCopies){
+          //We are in the case where we possibly need to create new copies (if the number of copies the storage class of the current ArchiveFile
+          //is greater than the number of tape files we have in the current ArchiveFile)
+          uint64_t nbFilesAlreadyArchived = getNbFilesAlreadyArchived(archiveFile);
+          uint64_t nbCopiesInStorageClass = sc.nbCopies;
+          uint64_t filesToArchive = nbCopiesInStorageClass - nbFilesAlreadyArchived;
+          if(filesToArchive > 0){
+            totalStatsFile.totalFilesToArchive += filesToArchive;
+            totalStatsFile.totalBytesToArchive += (filesToArchive * archiveFile.fileSize);
+            std::set<uint64_t> copyNbsAlreadyInCTA;
+            for (auto & tc: archiveFile.tapeFiles) {
+              copyNbsAlreadyInCTA.insert(tc.copyNb);
+              if (tc.vid == repackInfo.vid) {
+                // We make the (reasonable) assumption that the archive file only has one copy on this tape.
+                // If not, we will ensure the subrequest is filed under the lowest fSeq existing on this tape.
+                // This will prevent double subrequest creation (we already have such a mechanism in case of crash and
+                // restart of expansion.
+                //We found the copy of the file we want to retrieve and archive
+                //retrieveSubRequest.fSeq = tc.fSeq;
+                if(repackInfo.type == RepackType::AddCopiesOnly)
+                  retrieveSubRequest.fSeq = (retrieveSubRequest.fSeq == std::numeric_limits<decltype(retrieveSubRequest.fSeq)>::max()) ? tc.fSeq : std::max(tc.fSeq, retrieveSubRequest.fSeq);
+              }
+            }
+            for(auto archiveFileRoutesItor = archiveFileRoutes.begin(); archiveFileRoutesItor != archiveFileRoutes.end(); ++archiveFileRoutesItor){
+              if(copyNbsAlreadyInCTA.find(archiveFileRoutesItor->first) == copyNbsAlreadyInCTA.end()){
+                //We need to archive the missing copy
+                retrieveSubRequest.copyNbsToRearchive.insert(archiveFileRoutesItor->first);
+              }
+            }
+            if(retrieveSubRequest.copyNbsToRearchive.size() < filesToArchive){
+              throw ExpandRepackRequestException("In Scheduler::expandRepackRequest(): Missing archive routes for the creation of the new copies of the files");
+            }
+          } else {
+            if(repackInfo.type == RepackType::AddCopiesOnly){
+              //Nothing to Archive so nothing to Retrieve as well
+              retrieveSubrequests->pop_back();
+              continue;
+            }
           }
         }
-        if(retrieveSubRequest.copyNbsToRearchive.size() < filesToArchive){
-          deleteRepackBuffer(std::move(dir),lc);
-          throw ExpandRepackRequestException("In Scheduler::expandRepackRequest(): Missing archive routes for the creation of the new copies of the files");
-        }
-      } else {
-        if(repackInfo.type == RepackType::AddCopiesOnly){
-          //Nothing to Archive so nothing to Retrieve as well
-          retrieveSubrequests.pop_back();
-          continue;
-        }
       }
-    }
 
-
-    std::stringstream fileName;
-    fileName << std::setw(9) << std::setfill('0') << retrieveSubRequest.fSeq;
-    bool createArchiveSubrequest = false;
-    if(filesInDirectory.count(fileName.str())){
-      cta::disk::RadosStriperPool radosStriperPool;
-      cta::disk::DiskFileFactory fileFactory("",0,radosStriperPool);
-      cta::disk::ReadFile *fileReader = fileFactory.createReadFile(dirBufferURL.str() + fileName.str());
-      if(fileReader->size() == archiveFile.fileSize){
-        createArchiveSubrequest = true;
-      }
-    }
-    if (!createArchiveSubrequest && retrieveSubRequest.fSeq == std::numeric_limits<decltype(retrieveSubRequest.fSeq)>::max()) {
-      if(!createArchiveSubrequest){
-        log::ScopedParamContainer params(lc);
-        params.add("fileId", retrieveSubRequest.archiveFile.archiveFileID)
-              .add("repackVid", repackInfo.vid);
-        lc.log(log::ERR, "In Scheduler::expandRepackRequest(): no fSeq found for this file on this tape.");
-        totalStatsFile.totalBytesToRetrieve -= retrieveSubRequest.archiveFile.fileSize;
-        totalStatsFile.totalFilesToRetrieve -= 1;
-        retrieveSubrequests.pop_back();
+      // The files of the page provided by the user in the repack buffer are checked in parallel.
+      std::vector<std::string> fileNames;
+      std::vector<SchedulerDatabase::RepackRequest::Subrequest *> filesToCheck;
+      for(auto & retrieveSubRequest: *retrieveSubrequests){
+        std::stringstream fileName;
+        fileName << std::setw(9) << std::setfill('0') << retrieveSubRequest.fSeq;
+        fileNames.push_back(fileName.str());
+        if(filesInDirectory.count(fileName.str())){
+          filesToCheck.push_back(&retrieveSubRequest);
+        }
       }
-    } else {
-      if(!createArchiveSubrequest){
-        totalStatsFile.totalBytesToRetrieve += retrieveSubRequest.archiveFile.fileSize;
-        totalStatsFile.totalFilesToRetrieve += 1;
-      } else {
-        totalStatsFile.userProvidedFiles += 1;
-        retrieveSubRequest.hasUserProvidedFile = true;
+      std::set<const SchedulerDatabase::RepackRequest::Subrequest *> userProvidedFiles =
+        checkRepackBufferFiles(dirBufferURL.str(), filesToCheck);
+      timingList.insertOrIncrement("checkRepackBufferFilesTime",t.secs(utils::Timer::resetCounter));
+
+      auto fileName = fileNames.begin();
+      for(auto retrieveSubRequestItor = retrieveSubrequests->begin(); retrieveSubRequestItor != retrieveSubrequests->end(); fileName++){
+        auto & retrieveSubRequest = *retrieveSubRequestItor;
+        bool createArchiveSubrequest = userProvidedFiles.count(&retrieveSubRequest);
+        if (!createArchiveSubrequest && retrieveSubRequest.fSeq == std::numeric_limits<decltype(retrieveSubRequest.fSeq)>::max()) {
+          log::ScopedParamContainer params(lc);
+          params.add("fileId", retrieveSubRequest.archiveFile.archiveFileID)
+                .add("repackVid", repackInfo.vid);
+          lc.log(log::ERR, "In Scheduler::expandRepackRequest(): no fSeq found for this file on this tape.");
+          totalStatsFile.totalBytesToRetrieve -= retrieveSubRequest.archiveFile.fileSize;
+          totalStatsFile.totalFilesToRetrieve -= 1;
+          retrieveSubRequestItor = retrieveSubrequests->erase(retrieveSubRequestItor);
+          continue;
+        }
+        if(!createArchiveSubrequest){
+          totalStatsFile.totalBytesToRetrieve += retrieveSubRequest.archiveFile.fileSize;
+          totalStatsFile.totalFilesToRetrieve += 1;
+        } else {
+          totalStatsFile.userProvidedFiles += 1;
+          retrieveSubRequest.hasUserProvidedFile = true;
+        }
+        // We found some copies to rearchive. We still have to decide which file path we are going to use.
+        // File path will be base URL + /<VID>/<fSeq>
+        maxAddedFSeq = std::max(maxAddedFSeq,retrieveSubRequest.fSeq);
+        retrieveSubRequest.fileBufferURL = dirBufferURL.str() + *fileName;
+        retrieveSubRequestItor++;
       }
-      // We found some copies to rearchive. We still have to decide which file path we are going to use.
-      // File path will be base URL + /<VID>/<fSeq>
-      maxAddedFSeq = std::max(maxAddedFSeq,retrieveSubRequest.fSeq);
-      retrieveSubRequest.fileBufferURL = dirBufferURL.str() + fileName.str();
+      timingList.insertOrIncrement("buildSubrequestsTime",t.secs(utils::Timer::resetCounter));
+
+      // Only one page is queued at a time.
+      waitForPageQueueing();
+      timingList.insertOrIncrement("addSubrequestsAndUpdateStatsTime",t.secs(utils::Timer::resetCounter));
+      // Note: the highest fSeq will be recorded internally in the following call.
+      // We know that the fSeq processed on the tape are >= initial fSeq + filesCount - 1 (or fSeq - 1 as we counted).
+      // We pass this information to the db for recording in the repack request. This will allow restarting from the right
+      // value in case of crash.
+      pageQueueing = std::async(std::launch::async,
+        [&repackRequest, archiveRoutesMap, retrieveSubrequests, fSeq, maxAddedFSeq, totalStatsFile, diskSystemList, &lc]() mutable {
+          log::LogContext pageLc(lc.logger());
+          return repackRequest->m_dbReq->addSubrequestsAndUpdateStats(*retrieveSubrequests, archiveRoutesMap, fSeq,
+            maxAddedFSeq, totalStatsFile, diskSystemList, pageLc);
+        });
+    } while(archiveFilesForCatalogue.hasMore());
+    waitForPageQueueing();
+    timingList.insertOrIncrement("addSubrequestsAndUpdateStatsTime",t.secs(utils::Timer::resetCounter));
+  } catch(const cta::ExpandRepackRequestException&){
+    try {
+      waitForPageQueueing();
+    } catch(const cta::exception::Exception&) {}
+    // The repack buffer is still used by the subrequests of the pages already queued.
+    if(!nbPagesQueued) {
+      deleteRepackBuffer(std::move(dir),lc);
     }
+    throw;
   }
-  auto diskSystemList = m_catalogue.getAllDiskSystems();
-  timingList.insertAndReset("getDisksystemsListTime",t);
-  try{
-    // Note: the highest fSeq will be recorded internally in the following call.
-    // We know that the fSeq processed on the tape are >= initial fSeq + filesCount - 1 (or fSeq - 1 as we counted).
-    // We pass this information to the db for recording in the repack request. This will allow restarting from the right
-    // value in case of crash.
-    nbRetrieveSubrequestsQueued = repackRequest->m_dbReq->addSubrequestsAndUpdateStats(retrieveSubrequests, archiveRoutesMap, fSeq, maxAddedFSeq, totalStatsFile, diskSystemList, lc);
-  } catch(const cta::ExpandRepackRequestException& e){
-    deleteRepackBuffer(std::move(dir),lc);
-    throw e;
-  }
-  timingList.insertAndReset("addSubrequestsAndUpdateStatsTime",t);
 
   log::ScopedParamContainer params(lc);
-  params.add("tapeVid",repackInfo.vid);
+  params.add("tapeVid",repackInfo.vid)
+        .add("nbPagesQueued",nbPagesQueued);
   timingList.addToLog(params);
 
-  if(archiveFilesFromCatalogue.empty() && totalStatsFile.totalFilesToArchive == 0 && (totalStatsFile.totalFilesToRetrieve == 0 || nbRetrieveSubrequestsQueued == 0)){
+  if(totalStatsFile.totalFilesToArchive == 0 && (totalStatsFile.totalFilesToRetrieve == 0 || nbRetrieveSubrequestsQueued == 0)){
     //If no files have been retrieve, the repack buffer will have to be deleted
     //TODO : in case of Repack tape repair, we should not try to delete the buffer
     deleteRepackBuffer(std::move(dir),lc);
@@ -714,6 +824,55 @@ void Scheduler::expandRepackRequest(std::unique_ptr<RepackRequest>& repackReques
   lc.log(log::INFO,"In Scheduler::expandRepackRequest(), repack request expanded");
 }
 
+//------------------------------------------------------------------------------
+// setRepackExpansionPageSize
+//------------------------------------------------------------------------------
+void Scheduler::setRepackExpansionPageSize(const uint64_t pageSize) {
+  if(!pageSize) {
+    throw exception::Exception("In Scheduler::setRepackExpansionPageSize(): the page size must be greater than 0");
+  }
+  m_repackExpansionPageSize = pageSize;
+}
+
+//------------------------------------------------------------------------------
+// checkRepackBufferFiles
+//------------------------------------------------------------------------------
+std::set<const SchedulerDatabase::RepackRequest::Subrequest *> Scheduler::checkRepackBufferFiles(
+  const std::string &dirBufferURL, const std::vector<SchedulerDatabase::RepackRequest::Subrequest *> &filesToCheck) {
+  std::set<const SchedulerDatabase::RepackRequest::Subrequest *> ret;
+  if(filesToCheck.empty()) return ret;
+  // Each check is a round trip to the disk system: the files are spread over a bounded number of threads.
+  const size_t nbThreads = std::min<size_t>(filesToCheck.size(), c_maxParallelRepackBufferChecks);
+  std::vector<char> fileProvided(filesToCheck.size(), 0);
+  std::list<std::future<void>> checks;
+  for(size_t thread = 0; thread < nbThreads; thread++) {
+    checks.emplace_back(std::async(std::launch::async, [&dirBufferURL, &filesToCheck, &fileProvided, nbThreads, thread]() {
+      cta::disk::RadosStriperPool radosStriperPool;
+      cta::disk::DiskFileFactory fileFactory("",0,radosStriperPool);
+      for(size_t i = thread; i < filesToCheck.size(); i += nbThreads) {
+        std::stringstream fileName;
+        fileName << std::setw(9) << std::setfill('0') << filesToCheck[i]->fSeq;
+        std::unique_ptr<cta::disk::ReadFile> fileReader(fileFactory.createReadFile(dirBufferURL + fileName.str()));
+        fileProvided[i] = fileReader->size() == filesToCheck[i]->archiveFile.fileSize;
+      }
+    }));
+  }
+  // Wait for all the checks before rethrowing the first failure, as they reference our arguments.
+  std::exception_ptr failure;
+  for(auto &check: checks) {
+    try {
+      check.get();
+    } catch(...) {
+      if(!failure) failure = std::current_exception();
+    }
+  }
+  if(failure) std::rethrow_exception(failure);
+  for(size_t i = 0; i < filesToCheck.size(); i++) {
+    if(fileProvided[i]) ret.insert(filesToCheck[i]);
+  }
+  return ret;
+}
+
 //------------------------------------------------------------------------------
 // Scheduler::getNextRepackReportBatch
 //------------------------------------------------------------------------------
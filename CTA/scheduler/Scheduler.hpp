@@ -60,8 +60,10 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace cta {
 
@@ -141,6 +143,29 @@ public:
   std::string queueArchiveWithGivenId(const uint64_t archiveFileId, const std::string &instanceName,
     const cta::common::dataStructures::ArchiveRequest &request, log::LogContext &lc);
 
+  /**
+   * An archive request to be queued by queueArchiveBatch(), with the archive
+   * file identifier to be associated with the new archive file.
+   */
+  struct ArchiveRequestWithGivenId {
+    uint64_t archiveFileId;
+    cta::common::dataStructures::ArchiveRequest request;
+  };
+
+  /**
+   * Queue the specified archive requests together. The queueing criteria are
+   * looked up once per storage class and requester, and the requests are
+   * queued with one commit per queue.
+   * A request with wrong parameters gets a UserError exception as outcome,
+   * the other requests are still queued.
+   * @param instanceName name of the EOS instance
+   * @param requests the archive requests with their archive file identifiers
+   * @param lc a log context allowing logging from within the scheduler routine.
+   * @return the outcome of the queueing of each request, in the order of the requests.
+   */
+  std::vector<SchedulerDatabase::ArchiveRequestQueueingOutcome> queueArchiveBatch(const std::string &instanceName,
+    const std::vector<ArchiveRequestWithGivenId> &requests, log::LogContext &lc);
+
   /**
    * Queue a retrieve request.
    * Throws a UserError exception in case of wrong request parameters (ex. unknown file id)
@@ -336,6 +361,12 @@ private:
    */
   void checkNeededEnvironmentVariables();
 
+  /**
+   * Logs the queueing of an archive request.
+   */
+  void logQueuedArchiveRequest(const std::string &instanceName, const cta::common::dataStructures::ArchiveRequest &request,
+    const common::dataStructures::ArchiveFileQueueCriteriaAndFileId &catalogueInfo, log::LogContext &lc);
+
 public:
   /**
    * Run the mount decision logic lock free, so we have no contention in the
@@ -391,6 +422,11 @@ public:
   // Expansion support
   std::unique_ptr<RepackRequest> getNextRepackRequestToExpand();
   void expandRepackRequest(std::unique_ptr<RepackRequest> & repqckRequest, log::TimingList& , utils::Timer &, log::LogContext &);
+  /**
+   * Sets the number of archive files read from the catalogue and turned into retrieve subrequests at a time
+   * by expandRepackRequest(). It bounds the memory used by the expansion of a repack request.
+   */
+  void setRepackExpansionPageSize(const uint64_t pageSize);
   // Scheduler level will not distinguish between report types. It will just do a getnext-report cycle.
   class RepackReportBatch {
     friend Scheduler;
@@ -469,6 +505,31 @@ private:
   const uint64_t m_minBytesToWarrantAMount;
 
   std::unique_ptr<TapeDrivesCatalogueState> m_tapeDrivesState;
+
+  /**
+   * The default number of archive files expanded at a time by expandRepackRequest().
+   */
+  static const uint64_t c_defaultRepackExpansionPageSize = 1000;
+
+  /**
+   * The maximum number of files of a repack buffer checked in parallel.
+   */
+  static const uint64_t c_maxParallelRepackBufferChecks = 16;
+
+  /**
+   * The number of archive files expanded at a time by expandRepackRequest().
+   */
+  uint64_t m_repackExpansionPageSize = c_defaultRepackExpansionPageSize;
+
+  /**
+   * Checks in parallel which of the files present in the repack buffer have been fully provided by the user.
+   *
+   * @param dirBufferURL The URL of the repack buffer directory of the tape.
+   * @param filesToCheck The subrequests whose file is present in the repack buffer.
+   * @return The subrequests whose file in the repack buffer has the size of the archive file.
+   */
+  std::set<const SchedulerDatabase::RepackRequest::Subrequest *> checkRepackBufferFiles(const std::string &dirBufferURL,
+    const std::vector<SchedulerDatabase::RepackRequest::Subrequest *> &filesToCheck);
 }; // class Scheduler
 
 } // namespace cta
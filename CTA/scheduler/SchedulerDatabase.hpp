@@ -43,6 +43,7 @@
 #include "scheduler/TapeMount.hpp"
 #include "tapeserver/daemon/TapedConfiguration.hpp"
 
+#include <exception>
 #include <list>
 #include <limits>
 #include <map>
@@ -123,6 +124,36 @@ public:
     const cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId &criteria,
     log::LogContext &logContext) = 0;
 
+  /**
+   * An archive request to be queued by queueArchiveBatch(), with its criteria.
+   */
+  struct ArchiveRequestToQueue {
+    cta::common::dataStructures::ArchiveRequest request;
+    cta::common::dataStructures::ArchiveFileQueueCriteriaAndFileId criteria;
+  };
+
+  /**
+   * The outcome of the queueing of one request of a batch: the objectstore
+   * ArchiveRequest address, or the error which prevented the queueing.
+   */
+  struct ArchiveRequestQueueingOutcome {
+    std::string archiveRequestAddr;
+    std::exception_ptr error;
+  };
+
+  /**
+   * Queues the specified requests. The requests are created together and their
+   * jobs are added to the queues with one commit per queue.
+   *
+   * @param instanceName The disk instance of the requests.
+   * @param requests The requests and their criteria.
+   * @param logContext context allowing logging db operation
+   * @returns the outcome of the queueing of each request, in the order of the
+   * requests.
+   */
+  virtual std::vector<ArchiveRequestQueueingOutcome> queueArchiveBatch(const std::string &instanceName,
+    const std::vector<ArchiveRequestToQueue> &requests, log::LogContext &logContext) = 0;
+
 
   /**
    * Returns all of the queued archive jobs.  The returned jobs are
@@ -372,6 +372,68 @@ TEST_P(SchedulerTest, archive_to_new_file) {
   }
 }
 
+TEST_P(SchedulerTest, archive_batch_to_new_files) {
+  using namespace cta;
+
+  setupDefaultCatalogue();
+  Scheduler &scheduler = getScheduler();
+
+  log::DummyLogger dl("", "");
+  log::LogContext lc(dl);
+
+  std::vector<Scheduler::ArchiveRequestWithGivenId> requests;
+  const size_t nbRequests = 10;
+  for (size_t i = 0; i < nbRequests; i++) {
+    Scheduler::ArchiveRequestWithGivenId request;
+    request.request.checksumBlob.insert(cta::checksum::ADLER32, "1111");
+    request.request.creationLog.host="host2";
+    request.request.creationLog.time=0;
+    request.request.creationLog.username="admin1";
+    request.request.diskFileInfo.gid=GROUP_2;
+    request.request.diskFileInfo.owner_uid=CMS_USER;
+    request.request.diskFileInfo.path="path/to/file" + std::to_string(i);
+    request.request.diskFileID="diskFileID" + std::to_string(i);
+    request.request.fileSize=100*1000*1000;
+    request.request.requester.name = s_userName;
+    request.request.requester.group = "userGroup";
+    request.request.srcURL="srcURL";
+    request.request.storageClass=s_storageClassName;
+    request.archiveFileId = scheduler.checkAndGetNextArchiveFileId(s_diskInstance, request.request.storageClass,
+      request.request.requester, lc);
+    requests.push_back(request);
+  }
+  // A zero-length file and an unknown storage class are rejected without preventing the queueing of the others.
+  requests[3].request.fileSize = 0;
+  requests[7].request.storageClass = "unknownStorageClass";
+
+  auto outcomes = scheduler.queueArchiveBatch(s_diskInstance, requests, lc);
+  ASSERT_EQ(nbRequests, outcomes.size());
+  std::set<std::string> queuedFiles;
+  for (size_t i = 0; i < nbRequests; i++) {
+    if (i == 3 || i == 7) {
+      ASSERT_TRUE((bool)outcomes[i].error);
+      ASSERT_TRUE(outcomes[i].archiveRequestAddr.empty());
+    } else {
+      ASSERT_FALSE((bool)outcomes[i].error);
+      ASSERT_FALSE(outcomes[i].archiveRequestAddr.empty());
+      queuedFiles.insert(requests[i].request.diskFileInfo.path);
+    }
+  }
+  ASSERT_THROW(std::rethrow_exception(outcomes[3].error), cta::exception::UserError);
+
+  {
+    auto rqsts = scheduler.getPendingArchiveJobs(lc);
+    ASSERT_EQ(1, rqsts.size());
+    auto poolItor = rqsts.cbegin();
+    ASSERT_EQ(s_tapePoolName, poolItor->first);
+    std::set<std::string> remoteFiles;
+    for (auto &rqst: poolItor->second) {
+      remoteFiles.insert(rqst.request.diskFileInfo.path);
+    }
+    ASSERT_EQ(queuedFiles, remoteFiles);
+  }
+}
+
 // smurray commented this test out on Mon 17 Jul 2017.  The test assumes that
 // Scheduler::deleteArchive() calls SchedulerDatabase::deleteArchiveRequest().
 // This fact is currently not true as Scheduler::deleteArchive() has been
@@ -2212,6 +2274,100 @@ TEST_P(SchedulerTest, expandRepackRequest) {
   }
 }
 
+TEST_P(SchedulerTest, expandRepackRequestByPages) {
+  using namespace cta;
+  unitTests::TempDirectory tempDirectory;
+
+  auto &catalogue = getCatalogue();
+  auto &scheduler = getScheduler();
+
+  setupDefaultCatalogue();
+  catalogue.createDiskSystem({"user", "host"}, "diskSystem", "/public_dir/public_file", "constantFreeSpace:10", 10, 10L*1000*1000*1000, 15*60, "no comment");
+
+#ifdef STDOUT_LOGGING
+  log::StdoutLogger dl("dummy", "unitTest");
+#else
+  log::DummyLogger dl("", "");
+#endif
+  log::LogContext lc(dl);
+
+  cta::common::dataStructures::SecurityIdentity admin;
+  admin.username = "admin_user_name";
+  admin.host = "admin_host";
+
+  //Create a logical library in the catalogue
+  const bool libraryIsDisabled = false;
+  catalogue.createLogicalLibrary(admin, s_libraryName, libraryIsDisabled, "Create logical library");
+
+  auto tape = getDefaultTape();
+  tape.full = true;
+  catalogue.createTape(s_adminOnAdminHost, tape);
+
+  const std::string tapeDrive = "tape_drive";
+  const uint64_t nbArchiveFiles = 10;
+  const uint64_t archiveFileSize = 2 * 1000 * 1000 * 1000;
+  checksum::ChecksumBlob checksumBlob;
+  checksumBlob.insert(cta::checksum::ADLER32, "1234");
+  {
+    std::set<catalogue::TapeItemWrittenPointer> tapeFilesWrittenCopy1;
+    for(uint64_t j = 1; j <= nbArchiveFiles; ++j) {
+      std::ostringstream diskFileId;
+      diskFileId << (12345677 + j);
+      auto fileWrittenUP=cta::make_unique<cta::catalogue::TapeFileWritten>();
+      auto & fileWritten = *fileWrittenUP;
+      fileWritten.archiveFileId = j;
+      fileWritten.diskInstance = s_diskInstance;
+      fileWritten.diskFileId = diskFileId.str();
+      fileWritten.diskFileOwnerUid = PUBLIC_OWNER_UID;
+      fileWritten.diskFileGid = PUBLIC_GID;
+      fileWritten.size = archiveFileSize;
+      fileWritten.checksumBlob = checksumBlob;
+      fileWritten.storageClassName = s_storageClassName;
+      fileWritten.vid = s_vid;
+      fileWritten.fSeq = j;
+      fileWritten.blockId = j * 100;
+      fileWritten.copyNb = 1;
+      fileWritten.tapeDrive = tapeDrive;
+      tapeFilesWrittenCopy1.emplace(fileWrittenUP.release());
+    }
+    catalogue.filesWrittenToTape(tapeFilesWrittenCopy1);
+  }
+
+  //Expand the repack request by pages of 3 files: the last page only contains 1 file
+  scheduler.setRepackExpansionPageSize(3);
+  {
+    cta::SchedulerDatabase::QueueRepackRequest qrr(s_vid,"file://"+tempDirectory.path(),common::dataStructures::RepackInfo::Type::MoveOnly,
+      common::dataStructures::MountPolicy::s_defaultMountPolicyForRepack,s_defaultRepackDisabledTapeFlag,s_defaultRepackNoRecall);
+    scheduler.queueRepack(admin,qrr,lc);
+    scheduler.waitSchedulerDbSubthreadsComplete();
+    scheduler.promoteRepackRequestsToToExpand(lc);
+    scheduler.waitSchedulerDbSubthreadsComplete();
+    auto repackRequestToExpand = scheduler.getNextRepackRequestToExpand();
+    ASSERT_NE(nullptr, repackRequestToExpand);
+    log::TimingList tl;
+    utils::Timer t;
+    scheduler.expandRepackRequest(repackRequestToExpand,tl,t,lc);
+    scheduler.waitSchedulerDbSubthreadsComplete();
+  }
+
+  std::list<common::dataStructures::RetrieveJob> retrieveJobs = scheduler.getPendingRetrieveJobs(s_vid,lc);
+  ASSERT_EQ(nbArchiveFiles, retrieveJobs.size());
+  uint64_t archiveFileId = 1;
+  for(auto & retrieveJob: retrieveJobs){
+    ASSERT_EQ(archiveFileId, retrieveJob.request.archiveFileID);
+    std::stringstream ss;
+    ss<<"file://"<<tempDirectory.path()<<"/"<<s_vid<<"/"<<std::setw(9)<<std::setfill('0')<<archiveFileId;
+    ASSERT_EQ(ss.str(), retrieveJob.request.dstURL);
+    archiveFileId++;
+  }
+
+  const common::dataStructures::RepackInfo repackInfo = scheduler.getRepack(s_vid);
+  ASSERT_EQ(nbArchiveFiles, repackInfo.totalFilesToRetrieve);
+  ASSERT_EQ(nbArchiveFiles * archiveFileSize, repackInfo.totalBytesToRetrieve);
+  ASSERT_EQ(nbArchiveFiles, repackInfo.totalFilesToArchive);
+  ASSERT_TRUE(repackInfo.isExpandFinished);
+}
+
 TEST_P(SchedulerTest, expandRepackRequestRetrieveFailed) {
   using namespace cta;
   using namespace cta::objectstore;
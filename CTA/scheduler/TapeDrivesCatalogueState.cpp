@@ -16,24 +16,348 @@
  */
 
 #include <algorithm>
+#include <functional>
+#include <map>
+#include <unistd.h>
 
 #include "common/dataStructures/DesiredDriveState.hpp"
 #include "common/dataStructures/DriveInfo.hpp"
 #include "common/dataStructures/TapeDrive.hpp"
 #include "common/log/Logger.hpp"
+#include "common/threading/CondVar.hpp"
+#include "common/threading/MutexLocker.hpp"
+#include "common/threading/Thread.hpp"
 #include "scheduler/DiskSpaceReservation.hpp"
 #include "TapeDrivesCatalogueState.hpp"
 #include "tapeserver/daemon/TpconfigLine.hpp"
 
 namespace cta {
 
-TapeDrivesCatalogueState::TapeDrivesCatalogueState(catalogue::Catalogue &catalogue) : m_catalogue(catalogue) {}
+namespace {
+
+/**
+ * Copies the columns written by Catalogue::modifyTapeDriveStatuses() from one row to another.
+ */
+void copyReportedStatus(const common::dataStructures::TapeDrive & from, common::dataStructures::TapeDrive & to) {
+  to.host = from.host;
+  to.logicalLibrary = from.logicalLibrary;
+  to.sessionId = from.sessionId;
+  to.bytesTransferedInSession = from.bytesTransferedInSession;
+  to.filesTransferedInSession = from.filesTransferedInSession;
+  to.latestBandwidth = from.latestBandwidth;
+  to.sessionStartTime = from.sessionStartTime;
+  to.mountStartTime = from.mountStartTime;
+  to.transferStartTime = from.transferStartTime;
+  to.unloadStartTime = from.unloadStartTime;
+  to.unmountStartTime = from.unmountStartTime;
+  to.drainingStartTime = from.drainingStartTime;
+  to.downOrUpStartTime = from.downOrUpStartTime;
+  to.probeStartTime = from.probeStartTime;
+  to.cleanupStartTime = from.cleanupStartTime;
+  to.startStartTime = from.startStartTime;
+  to.shutdownTime = from.shutdownTime;
+  to.mountType = from.mountType;
+  to.driveStatus = from.driveStatus;
+  to.currentVid = from.currentVid;
+  to.currentActivity = from.currentActivity;
+  to.currentActivityWeight = from.currentActivityWeight;
+  to.currentTapePool = from.currentTapePool;
+  to.currentVo = from.currentVo;
+  to.lastModificationLog = from.lastModificationLog;
+}
+
+}  // anonymous namespace
+
+class TapeDrivesCatalogueState::DriveStatusReporter {
+public:
+  explicit DriveStatusReporter(catalogue::Catalogue &catalogue);
+  ~DriveStatusReporter();
+
+  /**
+   * Returns the reporter shared by all the users of the catalogue in the process.
+   */
+  static std::shared_ptr<DriveStatusReporter> get(catalogue::Catalogue &catalogue);
+
+  /**
+   * Returns the latest row reported for the drive, if the drive is cached.
+   */
+  optional<common::dataStructures::TapeDrive> getCachedRow(const std::string &driveName);
+
+  /**
+   * Caches the row of a drive and queues it for the background thread.
+   */
+  void queueRow(const common::dataStructures::TapeDrive &row, log::LogContext &lc);
+
+  /**
+   * Modifies the whole row of a drive synchronously, with the reported status not written yet. The drive is then
+   * removed from the cache. Does nothing if the drive does not exist.
+   */
+  void modifyRow(const std::string &driveName, const std::function<void(common::dataStructures::TapeDrive &)> &modify);
+
+  /**
+   * Removes a drive from the cache, dropping its reported status not written yet.
+   */
+  void forgetDrive(const std::string &driveName);
+
+  /**
+   * Waits until the rows queued before the call are written (or failed to be).
+   */
+  void flush();
+
+private:
+  class WriterThread: public threading::Thread {
+  public:
+    explicit WriterThread(DriveStatusReporter &reporter): m_reporter(reporter) {}
+  protected:
+    void run() override { m_reporter.writeQueuedRows(); }
+  private:
+    DriveStatusReporter &m_reporter;
+  };
+
+  /**
+   * The loop of the background thread.
+   */
+  void writeQueuedRows();
+
+  /**
+   * Marks all the queued rows as written if none is left. Called with both mutexes held.
+   */
+  void markWrittenIfNothingPending();
+
+  catalogue::Catalogue &m_catalogue;
+
+  /**
+   * Serializes the writes of the rows by the background thread and by modifyRow().
+   */
+  threading::Mutex m_writeMutex;
+
+  /**
+   * Protects all the members below.
+   */
+  threading::Mutex m_mutex;
+  threading::CondVar m_rowsQueued;
+  threading::CondVar m_rowsWritten;
+
+  /**
+   * The latest row of each drive, and the ones not yet written.
+   */
+  std::map<std::string, common::dataStructures::TapeDrive> m_cachedRows;
+  std::map<std::string, common::dataStructures::TapeDrive> m_pendingRows;
+
+  /**
+   * Counters of the queued rows, used for flushing. After a failed write, the background thread waits for the next
+   * report before retrying.
+   */
+  uint64_t m_queuedRows = 0;
+  uint64_t m_writtenRows = 0;
+  uint64_t m_queuedRowsAtLastFailure = std::numeric_limits<uint64_t>::max();
+
+  /**
+   * The failed writes, reported in the log by the next report.
+   */
+  uint64_t m_failedWrites = 0;
+  uint64_t m_reportedFailedWrites = 0;
+  std::string m_lastFailure;
+
+  /**
+   * The background thread, and the process in which it runs (it is restarted after a fork()).
+   */
+  std::unique_ptr<WriterThread> m_thread;
+  pid_t m_threadPid = 0;
+  bool m_stopRequested = false;
+};
+
+TapeDrivesCatalogueState::DriveStatusReporter::DriveStatusReporter(catalogue::Catalogue &catalogue):
+  m_catalogue(catalogue) {}
+
+TapeDrivesCatalogueState::DriveStatusReporter::~DriveStatusReporter() {
+  if (!m_thread) return;
+  if (m_threadPid != getpid()) {
+    // We are in the child of a fork(): the thread object belongs to the parent process.
+    m_thread.release();
+    return;
+  }
+  {
+    threading::MutexLocker ml(m_mutex);
+    m_stopRequested = true;
+    m_rowsQueued.signal();
+  }
+  try {
+    m_thread->wait();
+  } catch (...) {}
+}
+
+std::shared_ptr<TapeDrivesCatalogueState::DriveStatusReporter> TapeDrivesCatalogueState::DriveStatusReporter::get(
+  catalogue::Catalogue &catalogue) {
+  static threading::Mutex mutex;
+  static std::map<catalogue::Catalogue *, std::weak_ptr<DriveStatusReporter>> reporters;
+  threading::MutexLocker ml(mutex);
+  for (auto r = reporters.begin(); r != reporters.end(); ) {
+    if (r->second.expired()) {
+      r = reporters.erase(r);
+    } else {
+      r++;
+    }
+  }
+  auto & weakReporter = reporters[&catalogue];
+  auto reporter = weakReporter.lock();
+  if (!reporter) {
+    reporter = std::make_shared<DriveStatusReporter>(catalogue);
+    weakReporter = reporter;
+  }
+  return reporter;
+}
+
+optional<common::dataStructures::TapeDrive> TapeDrivesCatalogueState::DriveStatusReporter::getCachedRow(
+  const std::string &driveName) {
+  threading::MutexLocker ml(m_mutex);
+  if (m_threadPid != getpid()) return nullopt;
+  const auto row = m_cachedRows.find(driveName);
+  if (row == m_cachedRows.end()) return nullopt;
+  return row->second;
+}
+
+void TapeDrivesCatalogueState::DriveStatusReporter::queueRow(const common::dataStructures::TapeDrive &row,
+  log::LogContext &lc) {
+  uint64_t failedWrites = 0;
+  std::string lastFailure;
+  {
+    threading::MutexLocker ml(m_mutex);
+    if (m_threadPid != getpid()) {
+      if (m_thread) {
+        // We are in the child of a fork(): the thread and the rows belong to the parent process.
+        m_thread.release();
+        m_cachedRows.clear();
+        m_pendingRows.clear();
+        m_queuedRows = m_writtenRows = m_failedWrites = m_reportedFailedWrites = 0;
+        m_queuedRowsAtLastFailure = std::numeric_limits<uint64_t>::max();
+      }
+      m_stopRequested = false;
+      m_thread.reset(new WriterThread(*this));
+      m_thread->start();
+      m_threadPid = getpid();
+    }
+    m_cachedRows[row.driveName] = row;
+    m_pendingRows[row.driveName] = row;
+    m_queuedRows++;
+    m_rowsQueued.signal();
+    if (m_failedWrites != m_reportedFailedWrites) {
+      failedWrites = m_failedWrites - m_reportedFailedWrites;
+      lastFailure = m_lastFailure;
+      m_reportedFailedWrites = m_failedWrites;
+    }
+  }
+  if (failedWrites) {
+    log::ScopedParamContainer params(lc);
+    params.add("failedWrites", failedWrites)
+          .add("exceptionMessage", lastFailure);
+    lc.log(log::WARNING, "In TapeDrivesCatalogueState::DriveStatusReporter::queueRow(): failed to write the drive "
+      "statuses to the catalogue, will retry with the next report.");
+  }
+}
+
+void TapeDrivesCatalogueState::DriveStatusReporter::modifyRow(const std::string &driveName,
+  const std::function<void(common::dataStructures::TapeDrive &)> &modify) {
+  threading::MutexLocker wl(m_writeMutex);
+  optional<common::dataStructures::TapeDrive> pendingRow;
+  {
+    threading::MutexLocker ml(m_mutex);
+    const auto row = m_pendingRows.find(driveName);
+    if (row != m_pendingRows.end()) {
+      pendingRow = row->second;
+      m_pendingRows.erase(row);
+    }
+    // The next report reads the row again, as this one could be changed by another process from now on.
+    m_cachedRows.erase(driveName);
+    markWrittenIfNothingPending();
+  }
+  auto driveState = m_catalogue.getTapeDrive(driveName);
+  if (!driveState) return;
+  if (pendingRow) copyReportedStatus(pendingRow.value(), driveState.value());
+  modify(driveState.value());
+  m_catalogue.modifyTapeDrive(driveState.value());
+}
+
+void TapeDrivesCatalogueState::DriveStatusReporter::forgetDrive(const std::string &driveName) {
+  threading::MutexLocker wl(m_writeMutex);
+  threading::MutexLocker ml(m_mutex);
+  m_pendingRows.erase(driveName);
+  m_cachedRows.erase(driveName);
+  markWrittenIfNothingPending();
+}
+
+void TapeDrivesCatalogueState::DriveStatusReporter::flush() {
+  threading::MutexLocker ml(m_mutex);
+  if (m_threadPid != getpid()) return;
+  const uint64_t queuedRows = m_queuedRows;
+  while (m_writtenRows < queuedRows) {
+    m_rowsWritten.wait(ml);
+  }
+}
+
+void TapeDrivesCatalogueState::DriveStatusReporter::markWrittenIfNothingPending() {
+  if (m_pendingRows.empty() && m_writtenRows != m_queuedRows) {
+    m_writtenRows = m_queuedRows;
+    m_rowsWritten.broadcast();
+  }
+}
+
+void TapeDrivesCatalogueState::DriveStatusReporter::writeQueuedRows() {
+  while (true) {
+    {
+      threading::MutexLocker ml(m_mutex);
+      while (!m_stopRequested && (m_pendingRows.empty() || m_queuedRows == m_queuedRowsAtLastFailure)) {
+        m_rowsQueued.wait(ml);
+      }
+      if (m_stopRequested && m_pendingRows.empty()) return;
+    }
+    threading::MutexLocker wl(m_writeMutex);
+    std::map<std::string, common::dataStructures::TapeDrive> rows;
+    uint64_t batchQueuedRows;
+    bool lastBatch;
+    {
+      threading::MutexLocker ml(m_mutex);
+      rows.swap(m_pendingRows);
+      batchQueuedRows = m_queuedRows;
+      lastBatch = m_stopRequested;
+    }
+    bool failed = false;
+    std::string failure;
+    try {
+      std::list<common::dataStructures::TapeDrive> tapeDrives;
+      for (const auto & row: rows) tapeDrives.push_back(row.second);
+      m_catalogue.modifyTapeDriveStatuses(tapeDrives);
+    } catch (exception::Exception &ex) {
+      failed = true;
+      failure = ex.getMessageValue();
+    } catch (std::exception &ex) {
+      failed = true;
+      failure = ex.what();
+    }
+    threading::MutexLocker ml(m_mutex);
+    if (failed) {
+      m_failedWrites++;
+      m_lastFailure = failure;
+      if (!lastBatch) {
+        // Keep the rows for the next attempt, unless newer ones were queued meanwhile.
+        m_pendingRows.insert(rows.begin(), rows.end());
+        m_queuedRowsAtLastFailure = m_queuedRows;
+      }
+    }
+    m_writtenRows = batchQueuedRows;
+    m_rowsWritten.broadcast();
+  }
+}
+
+TapeDrivesCatalogueState::TapeDrivesCatalogueState(catalogue::Catalogue &catalogue) : m_catalogue(catalogue),
+  m_reporter(DriveStatusReporter::get(catalogue)) {}
 
 void TapeDrivesCatalogueState::createTapeDriveStatus(const common::dataStructures::DriveInfo& driveInfo,
   const common::dataStructures::DesiredDriveState & desiredState, const common::dataStructures::MountType& type,
   const common::dataStructures::DriveStatus& status, const tape::daemon::TpconfigLine& tpConfigLine,
   const common::dataStructures::SecurityIdentity& identity, log::LogContext & lc) {
   const auto tapeDriveStatus = setTapeDriveStatus(driveInfo, desiredState, type, status, tpConfigLine, identity);
+  m_reporter->forgetDrive(tapeDriveStatus.driveName);
   auto driveNames = m_catalogue.getTapeDriveNames();
   auto it = std::find(driveNames.begin(), driveNames.end(), tapeDriveStatus.driveName);
   if (it != driveNames.end()) {
@@ -67,6 +391,7 @@ void TapeDrivesCatalogueState::checkDriveCanBeCreated(const cta::common::dataStr
 std::list<cta::common::dataStructures::TapeDrive> TapeDrivesCatalogueState::getDriveStates(
   log::LogContext & lc) const {
   std::list<cta::common::dataStructures::TapeDrive> tapeDrivesList;
+  m_reporter->flush();
   const auto driveNames = m_catalogue.getTapeDriveNames();
   for (const auto& driveName : driveNames) {
     const auto tapeDrive = m_catalogue.getTapeDrive(driveName);
@@ -77,6 +402,7 @@ std::list<cta::common::dataStructures::TapeDrive> TapeDrivesCatalogueState::getD
 
 void TapeDrivesCatalogueState::removeDrive(const std::string& drive, log::LogContext &lc) {
   try {
+    m_reporter->forgetDrive(drive);
     m_catalogue.deleteTapeDrive(drive);
     log::ScopedParamContainer params(lc);
     params.add("driveName", drive);
@@ -89,6 +415,7 @@ void TapeDrivesCatalogueState::removeDrive(const std::string& drive, log::LogCon
 void TapeDrivesCatalogueState::setDesiredDriveState(const std::string& drive,
   const common::dataStructures::DesiredDriveState & desiredState, log::LogContext &lc) {
   common::dataStructures::DesiredDriveState newDesiredState = desiredState;
+  m_reporter->flush();
   auto driveState = m_catalogue.getTapeDrive(drive);
   if (!driveState) return;
   if(desiredState.comment){
@@ -105,7 +432,8 @@ void TapeDrivesCatalogueState::setDesiredDriveState(const std::string& drive,
 
 void TapeDrivesCatalogueState::updateDriveStatistics(const common::dataStructures::DriveInfo& driveInfo,
   const ReportDriveStatsInputs& inputs, log::LogContext & lc) {
-  auto driveState = m_catalogue.getTapeDrive(driveInfo.driveName);
+  auto driveState = m_reporter->getCachedRow(driveInfo.driveName);
+  if (!driveState) driveState = m_catalogue.getTapeDrive(driveInfo.driveName);
   if (!driveState) return;
   // Set the parameters that we always set
   driveState.value().host = driveInfo.host;
@@ -127,7 +455,7 @@ void TapeDrivesCatalogueState::updateDriveStatistics(const common::dataStructure
     default:
       return;
   }
-  m_catalogue.modifyTapeDrive(driveState.value());
+  m_reporter->queueRow(driveState.value(), lc);
 }
 
 void TapeDrivesCatalogueState::reportDriveStatus(const common::dataStructures::DriveInfo& driveInfo,
@@ -153,10 +481,29 @@ void TapeDrivesCatalogueState::reportDriveStatus(const common::dataStructures::D
 
 void TapeDrivesCatalogueState::updateDriveStatus(const common::dataStructures::DriveInfo& driveInfo,
   const ReportDriveStatusInputs& inputs, log::LogContext &lc) {
+  switch (inputs.status) {
+    case common::dataStructures::DriveStatus::Down:
+    case common::dataStructures::DriveStatus::Up:
+    case common::dataStructures::DriveStatus::Shutdown:
+      // These depend on the desired state and clear the disk space reservation: write them synchronously.
+      m_reporter->modifyRow(driveInfo.driveName, [&](common::dataStructures::TapeDrive & driveState) {
+        applyDriveStatus(driveState, driveInfo, inputs, lc);
+      });
+      return;
+    default:
+      break;
+  }
   // First, get the drive state.
-  const auto driveStateOptional = m_catalogue.getTapeDrive(driveInfo.driveName);
+  auto driveStateOptional = m_reporter->getCachedRow(driveInfo.driveName);
+  if (!driveStateOptional) driveStateOptional = m_catalogue.getTapeDrive(driveInfo.driveName);
   if (!driveStateOptional) return;
   auto driveState = driveStateOptional.value();
+  applyDriveStatus(driveState, driveInfo, inputs, lc);
+  m_reporter->queueRow(driveState, lc);
+}
+
+void TapeDrivesCatalogueState::applyDriveStatus(common::dataStructures::TapeDrive & driveState,
+  const common::dataStructures::DriveInfo& driveInfo, const ReportDriveStatusInputs& inputs, log::LogContext &lc) {
   // Set the parameters that we always set
   driveState.host = driveInfo.host;
   driveState.logicalLibrary = driveInfo.logicalLibrary;
@@ -227,7 +574,6 @@ void TapeDrivesCatalogueState::updateDriveStatus(const common::dataStructures::D
           .add("newStatus", toString(driveState.driveStatus));
     lc.log(log::INFO, "In TapeDrivesCatalogueState::updateDriveStatus(): changing drive status.");
   }
-  m_catalogue.modifyTapeDrive(driveState);
 }
 
 void TapeDrivesCatalogueState::setDriveDown(common::dataStructures::TapeDrive & driveState,
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 #include <string>
 
 #include "catalogue/Catalogue.hpp"
@@ -62,6 +63,19 @@ struct ReportDriveStatsInputs {
   uint64_t filesTransferred;
 };
 
+/**
+ * The states of the tape drives, as stored in the TAPE_DRIVE table of the catalogue.
+ *
+ * The statuses reported during a tape session (and the statistics of the transfers) are written behind: the
+ * latest row of each drive is cached, the reports only update the cached row and a background thread writes the
+ * rows changed since its previous write in one batch, so that the data transfer threads never wait for the
+ * catalogue. Several reports for the same drive coalesce into a single write of the latest row. The write-behind
+ * state is shared by all the instances using the same catalogue in the process.
+ *
+ * The reports of the Up, Down and Shutdown statuses, which depend on the desired state of the drive set by the
+ * operators and clear its disk space reservation, are written synchronously. The functions reading or changing the
+ * whole rows first wait for the rows reported before their call to be written.
+ */
 class TapeDrivesCatalogueState {
 public:
   TapeDrivesCatalogueState(catalogue::Catalogue &catalogue);
@@ -94,6 +108,18 @@ public:
 private:
   cta::catalogue::Catalogue &m_catalogue;
 
+  /**
+   * The write-behind cache of the reported drive statuses (defined in the .cpp).
+   */
+  class DriveStatusReporter;
+  std::shared_ptr<DriveStatusReporter> m_reporter;
+
+  /**
+   * Applies a reported status to the row of a drive.
+   */
+  void applyDriveStatus(common::dataStructures::TapeDrive & driveState,
+    const common::dataStructures::DriveInfo& driveInfo, const ReportDriveStatusInputs& inputs, log::LogContext &lc);
+
   common::dataStructures::TapeDrive setTapeDriveStatus(const common::dataStructures::DriveInfo& driveInfo,
     const common::dataStructures::DesiredDriveState & desiredState, const common::dataStructures::MountType& type,
     const common::dataStructures::DriveStatus& status, const tape::daemon::TpconfigLine& tpConfigLine,
@@ -28,9 +28,29 @@ DatabaseStatisticsService::~DatabaseStatisticsService() {
 
 void DatabaseStatisticsService::updateStatisticsPerTape(){
   //to update the statistics, we will first select the DIRTY tapes ordered by VID and we will run an update for each row.
-  
-  const char * const selectVids = "SELECT TAPE.VID AS VID FROM TAPE WHERE TAPE.DIRTY='1' ORDER BY TAPE.VID";
-  
+  updateStatisticsPerTape(getTapesToUpdate(false));
+}
+
+std::list<std::string> DatabaseStatisticsService::getTapesToUpdate(const bool allTapes) {
+  const char * const selectDirtyVids = "SELECT TAPE.VID AS VID FROM TAPE WHERE TAPE.DIRTY='1' ORDER BY TAPE.VID";
+  const char * const selectAllVids = "SELECT TAPE.VID AS VID FROM TAPE ORDER BY TAPE.VID";
+  try {
+    std::list<std::string> vids;
+    auto selectStmt = m_conn.createStmt(allTapes ? selectAllVids : selectDirtyVids);
+    auto rset = selectStmt.executeQuery();
+    while(rset.next()){
+      vids.push_back(rset.columnString("VID"));
+    }
+    return vids;
+  } catch(cta::exception::Exception &ex) {
+    ex.getMessage().str(std::string(__PRETTY_FUNCTION__) + ": " + ex.getMessage().str());
+    throw;
+  }
+}
+
+void DatabaseStatisticsService::updateStatisticsPerTape(const std::list<std::string> &vids){
+  //The statistics are maintained by the catalogue when the tape files are written or deleted, the recomputation
+  //fixes the DIRTY tapes and verifies the other ones: the tapes whose statistics change are counted as corrected.
   const char * const updateSql = 
   "UPDATE TAPE TAPE_TO_UPDATE SET"
   "("
@@ -87,14 +107,16 @@ void DatabaseStatisticsService::updateStatisticsPerTape(){
   "WHERE TAPE_TO_UPDATE.VID = :VID";
   
   try {
-    auto selectStmt = m_conn.createStmt(selectVids);
-    auto rset = selectStmt.executeQuery();
-    while(rset.next()){
-      //For all DIRTY tapes, update its statistics
-      auto updateStmt = m_conn.createStmt(updateSql);
-      updateStmt.bindString(":VID",rset.columnString("VID"));
+    auto updateStmt = m_conn.createStmt(updateSql);
+    for(auto &vid: vids){
+      const TapeStatistics statisticsBefore = getTapeStatistics(vid);
+      updateStmt.bindString(":VID",vid);
       updateStmt.executeNonQuery();
-      m_nbUpdatedTapes += updateStmt.getNbAffectedRows();
+      const uint64_t nbAffectedRows = updateStmt.getNbAffectedRows();
+      m_nbUpdatedTapes += nbAffectedRows;
+      if(nbAffectedRows && !(getTapeStatistics(vid) == statisticsBefore)){
+        m_nbCorrectedTapes++;
+      }
     }
   } catch(cta::exception::Exception &ex) {
     ex.getMessage().str(std::string(__PRETTY_FUNCTION__) + ": " + ex.getMessage().str());
@@ -102,6 +124,40 @@ void DatabaseStatisticsService::updateStatisticsPerTape(){
   }
 }
 
+DatabaseStatisticsService::TapeStatistics DatabaseStatisticsService::getTapeStatistics(const std::string &vid) {
+  const char * const sql = 
+  "SELECT "
+    "TAPE.NB_MASTER_FILES AS NB_MASTER_FILES,"
+    "TAPE.MASTER_DATA_IN_BYTES AS MASTER_DATA_IN_BYTES,"
+    "TAPE.NB_COPY_NB_1 AS NB_COPY_NB_1,"
+    "TAPE.COPY_NB_1_IN_BYTES AS COPY_NB_1_IN_BYTES,"
+    "TAPE.NB_COPY_NB_GT_1 AS NB_COPY_NB_GT_1,"
+    "TAPE.COPY_NB_GT_1_IN_BYTES AS COPY_NB_GT_1_IN_BYTES "
+  "FROM "
+    "TAPE "
+  "WHERE "
+    "TAPE.VID = :VID";
+  auto stmt = m_conn.createStmt(sql);
+  stmt.bindString(":VID",vid);
+  auto rset = stmt.executeQuery();
+  TapeStatistics statistics;
+  if(rset.next()){
+    statistics.nbMasterFiles = rset.columnUint64("NB_MASTER_FILES");
+    statistics.masterDataInBytes = rset.columnUint64("MASTER_DATA_IN_BYTES");
+    statistics.nbCopyNb1 = rset.columnUint64("NB_COPY_NB_1");
+    statistics.copyNb1InBytes = rset.columnUint64("COPY_NB_1_IN_BYTES");
+    statistics.nbCopyNbGt1 = rset.columnUint64("NB_COPY_NB_GT_1");
+    statistics.copyNbGt1InBytes = rset.columnUint64("COPY_NB_GT_1_IN_BYTES");
+  }
+  return statistics;
+}
+
+bool DatabaseStatisticsService::TapeStatistics::operator==(const TapeStatistics &rhs) const {
+  return nbMasterFiles == rhs.nbMasterFiles && masterDataInBytes == rhs.masterDataInBytes &&
+    nbCopyNb1 == rhs.nbCopyNb1 && copyNb1InBytes == rhs.copyNb1InBytes &&
+    nbCopyNbGt1 == rhs.nbCopyNbGt1 && copyNbGt1InBytes == rhs.copyNbGt1InBytes;
+}
+
 void DatabaseStatisticsService::saveStatistics(const cta::statistics::Statistics& statistics) {
   //First we save the general FILE statistics, then we go for the per-vo statisticss
   saveFileStatistics(statistics);
@@ -46,6 +46,19 @@ public:
    */
   virtual void updateStatisticsPerTape() override;
   
+  /**
+   * Returns the VIDs of the DIRTY tapes, or of all the tapes
+   * @param allTapes true to return all the tapes of the database used by this service
+   */
+  virtual std::list<std::string> getTapesToUpdate(const bool allTapes) override;
+  
+  /**
+   * Recompute the statistics of the specified tapes in the database used by this service
+   * and count the tapes whose statistics were not up to date
+   * @param vids the VIDs of the tapes to update
+   */
+  virtual void updateStatisticsPerTape(const std::list<std::string> &vids) override;
+  
   /**
    * Saves the statistics in the service database
    * @param statistics the statistics to save in the database used by this service
@@ -75,6 +88,26 @@ protected:
    * @param statistics the statistics to save
    */
   virtual void saveStatisticsPerVo(const cta::statistics::Statistics & statistics);
+  
+private:
+  /**
+   * The statistics columns of a tape
+   */
+  struct TapeStatistics {
+    uint64_t nbMasterFiles = 0;
+    uint64_t masterDataInBytes = 0;
+    uint64_t nbCopyNb1 = 0;
+    uint64_t copyNb1InBytes = 0;
+    uint64_t nbCopyNbGt1 = 0;
+    uint64_t copyNbGt1InBytes = 0;
+    bool operator==(const TapeStatistics &rhs) const;
+  };
+  
+  /**
+   * Returns the statistics currently stored for the specified tape
+   * @param vid the VID of the tape
+   */
+  TapeStatistics getTapeStatistics(const std::string &vid);
 };
 
 }}
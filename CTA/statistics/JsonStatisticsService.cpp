@@ -40,6 +40,14 @@ void JsonStatisticsService::updateStatisticsPerTape(){
   throw cta::exception::Exception("In JsonStatistics::updateStatisticsPerTape(), method not implemented.");
 } 
 
+std::list<std::string> JsonStatisticsService::getTapesToUpdate(const bool allTapes){
+  throw cta::exception::Exception("In JsonStatistics::getTapesToUpdate(), method not implemented.");
+}
+
+void JsonStatisticsService::updateStatisticsPerTape(const std::list<std::string> &vids){
+  throw cta::exception::Exception("In JsonStatistics::updateStatisticsPerTape(), method not implemented.");
+}
+
 
 JsonStatisticsService::~JsonStatisticsService() {
 }
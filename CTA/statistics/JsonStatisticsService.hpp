@@ -50,6 +50,8 @@ public:
   virtual void saveStatistics(const cta::statistics::Statistics& statistics) override;
   virtual std::unique_ptr<cta::statistics::Statistics> getStatistics() override;
   virtual void updateStatisticsPerTape() override;
+  virtual std::list<std::string> getTapesToUpdate(const bool allTapes) override;
+  virtual void updateStatisticsPerTape(const std::list<std::string> &vids) override;
   
   virtual ~JsonStatisticsService();
   
@@ -28,5 +28,9 @@ void MySQLStatisticsService::updateStatisticsPerTape() {
   throw cta::exception::Exception("In MySQLStatisticsService::updateStatisticsPerTape() cannot update tape statistics because it is not implemented for MySQL databases");
 }
 
+void MySQLStatisticsService::updateStatisticsPerTape(const std::list<std::string> &vids) {
+  throw cta::exception::Exception("In MySQLStatisticsService::updateStatisticsPerTape() cannot update tape statistics because it is not implemented for MySQL databases");
+}
+
 
 }}
\ No newline at end of file
@@ -41,6 +41,7 @@ public:
    * as the UPDATE query only works for PostgreSQL and Oracle
    */
   void updateStatisticsPerTape() override;
+  void updateStatisticsPerTape(const std::list<std::string> &vids) override;
 private:
 
 };
@@ -29,4 +29,8 @@ uint64_t StatisticsService::getNbUpdatedTapes() {
   return m_nbUpdatedTapes;
 }
 
+uint64_t StatisticsService::getNbCorrectedTapes() {
+  return m_nbCorrectedTapes;
+}
+
 }}
\ No newline at end of file
@@ -19,6 +19,9 @@
 
 #include "Statistics.hpp"
 
+#include <list>
+#include <string>
+
 
 namespace cta { namespace statistics {
   
@@ -36,6 +39,18 @@ public:
    * Update the TAPE statistics of CTA
    */
   virtual void updateStatisticsPerTape() = 0;
+  /**
+   * Returns the VIDs of the tapes whose statistics have to be recomputed
+   * @param allTapes true to return all the tapes, in order to verify the
+   * statistics maintained by the catalogue, false to only return the DIRTY tapes
+   * @return the VIDs of the tapes ordered by VID
+   */
+  virtual std::list<std::string> getTapesToUpdate(const bool allTapes) = 0;
+  /**
+   * Recompute the statistics of the specified tapes
+   * @param vids the VIDs of the tapes to update
+   */
+  virtual void updateStatisticsPerTape(const std::list<std::string> &vids) = 0;
   /**
    * Save the statistics
    * @param statistics the statistics to save
@@ -53,8 +68,15 @@ public:
    */
   uint64_t getNbUpdatedTapes();
   
+  /**
+   * Returns the number of TAPE whose statistics were different from the recomputed ones
+   * @return the number of TAPE whose statistics have been corrected by the updateStatistics() method
+   */
+  uint64_t getNbCorrectedTapes();
+  
 protected:
   uint64_t m_nbUpdatedTapes = 0;
+  uint64_t m_nbCorrectedTapes = 0;
 };
 
 }}
@@ -24,6 +24,9 @@
 #include "StatisticsService.hpp"
 #include "StatisticsServiceFactory.hpp"
 #include <cstdlib>
+#include <future>
+#include <list>
+#include <vector>
 
 namespace cta {
 namespace statistics {
@@ -53,7 +56,8 @@ int StatisticsUpdateCmd::exceptionThrowingMain(const int argc, char *const *cons
     return 0;
   }
 
-  const uint64_t maxNbConns = 1;
+  //One connection for the schema check and the selection of the tapes, plus one per job
+  const uint64_t maxNbConns = 1 + cmdLineArgs.nbJobs;
     
   //Connect to the database
   auto loginCatalogue = rdbms::Login::parseFile(cmdLineArgs.catalogueDbConfigPath);
@@ -87,8 +91,33 @@ int StatisticsUpdateCmd::exceptionThrowingMain(const int argc, char *const *cons
   //Update TAPE statistics
   std::cout<<"Updating tape statistics in the catalogue..."<<std::endl;
   cta::utils::Timer t;
-  service->updateStatisticsPerTape();
-  std::cout<<"Updated catalogue tape statistics in "<<t.secs()<<" seconds, "<<service->getNbUpdatedTapes()<<" tape(s) have been updated"<<std::endl; 
+  const std::list<std::string> vids = service->getTapesToUpdate(cmdLineArgs.allTapes);
+  //Distribute the tapes over the jobs, each job updates its tapes with its own connection and service
+  std::vector<std::list<std::string>> vidsPerJob(cmdLineArgs.nbJobs);
+  uint64_t vidIndex = 0;
+  for(auto &vid: vids) {
+    vidsPerJob[vidIndex++ % cmdLineArgs.nbJobs].push_back(vid);
+  }
+  std::list<std::future<std::pair<uint64_t, uint64_t>>> jobs;
+  for(auto &jobVids: vidsPerJob) {
+    if(jobVids.empty()) continue;
+    jobs.emplace_back(std::async(std::launch::async, [&catalogueConnPool, &loginCatalogue, &jobVids]() {
+      auto jobConn = catalogueConnPool.getConn();
+      std::unique_ptr<StatisticsService> jobService = StatisticsServiceFactory::create(jobConn,loginCatalogue.dbType);
+      jobService->updateStatisticsPerTape(jobVids);
+      return std::make_pair(jobService->getNbUpdatedTapes(), jobService->getNbCorrectedTapes());
+    }));
+  }
+  uint64_t nbUpdatedTapes = 0;
+  uint64_t nbCorrectedTapes = 0;
+  for(auto &job: jobs) {
+    //Rethrows the exception of the job if any
+    const auto jobResult = job.get();
+    nbUpdatedTapes += jobResult.first;
+    nbCorrectedTapes += jobResult.second;
+  }
+  std::cout<<"Updated catalogue tape statistics in "<<t.secs()<<" seconds, "<<nbUpdatedTapes<<" tape(s) have been updated, "
+           <<nbCorrectedTapes<<" of them had statistics different from the recomputed ones"<<std::endl; 
   
   return EXIT_SUCCESS;
 }
@@ -17,6 +17,7 @@
 
 #include "StatisticsUpdateCmdLineArgs.hpp"
 #include "common/exception/CommandLineNotParsed.hpp"
+#include "common/utils/utils.hpp"
 
 #include <getopt.h>
 #include <ostream>
@@ -28,10 +29,14 @@ namespace statistics {
 // constructor
 //------------------------------------------------------------------------------
 StatisticsUpdateCmdLineArgs::StatisticsUpdateCmdLineArgs(const int argc, char *const *const argv):
-  help(false) {
+  help(false),
+  allTapes(false),
+  nbJobs(1) {
 
   static struct option longopts[] = {
+    {"all", no_argument, NULL, 'a'},
     {"help", no_argument, NULL, 'h'},
+    {"jobs", required_argument, NULL, 'j'},
     {NULL  ,           0, NULL,   0}
   };
 
@@ -40,11 +45,22 @@ StatisticsUpdateCmdLineArgs::StatisticsUpdateCmdLineArgs(const int argc, char *c
   opterr = 0;
 
   int opt = 0;
-  while((opt = getopt_long(argc, argv, ":h", longopts, NULL)) != -1) {
+  while((opt = getopt_long(argc, argv, ":ahj:", longopts, NULL)) != -1) {
     switch(opt) {
+    case 'a':
+      allTapes = true;
+      break;
     case 'h':
       help = true;
       break;
+    case 'j':
+      if(!utils::isValidUInt(optarg) || 0 == utils::toUint64(optarg)) {
+        exception::CommandLineNotParsed ex;
+        ex.getMessage() << "The -j option requires a positive integer: value=" << optarg;
+        throw ex;
+      }
+      nbJobs = utils::toUint64(optarg);
+      break;
     case ':': // Missing parameter
       {
         exception::CommandLineNotParsed ex;
@@ -102,8 +118,14 @@ void StatisticsUpdateCmdLineArgs::printUsage(std::ostream &os) {
     "        The path to the file containing the connection details of the CTA" << std::endl <<
     "        catalogue database" << std::endl <<
     "Options:" << std::endl <<
+    "    -a,--all" << std::endl <<
+    "        Recomputes the statistics of all the tapes instead of only the DIRTY" << std::endl <<
+    "        ones, in order to verify the statistics maintained by the catalogue" << std::endl <<
     "    -h,--help" << std::endl <<     
-    "        Prints this usage message" << std::endl;
+    "        Prints this usage message" << std::endl <<
+    "    -j,--jobs nbJobs" << std::endl <<
+    "        The number of tapes updated in parallel, each job using its own" << std::endl <<
+    "        database connection (default 1)" << std::endl;
 }
 
 } // namespace statistics
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <string>
 
 namespace cta {
@@ -32,6 +33,19 @@ struct StatisticsUpdateCmdLineArgs {
    */
   bool help;
 
+  /**
+   * True if the statistics of all the tapes should be recomputed in order to
+   * verify the ones maintained by the catalogue, false if only the DIRTY tapes
+   * should be updated.
+   */
+  bool allTapes;
+
+  /**
+   * The number of tapes updated in parallel, each with its own database
+   * connection.
+   */
+  uint64_t nbJobs;
+
   /**
    * Path to the file containing the connection details of the catalogue
    * database.
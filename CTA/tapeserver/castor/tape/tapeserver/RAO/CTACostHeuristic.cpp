@@ -43,4 +43,11 @@ double CTACostHeuristic::getCost(const FilePositionInfos & file1, const FilePosi
   return cost;
 }
 
+double CTACostHeuristic::getCostLowerBound(const FilePositionInfos & file1, const uint32_t file2BeginningWrap, const uint64_t longitudinalDistance) const {
+  uint32_t file1EndWrap = file1.getEndPosition().getWrap();
+  int wrapChange = file1EndWrap != file2BeginningWrap;
+  int directionChange = (file1EndWrap % 2) != (file2BeginningWrap % 2);
+  return 4.29 + wrapChange * 6.69 + (-6.04) + directionChange * 5.22 + longitudinalDistance * 0.0006192;
+}
+
 }}}}
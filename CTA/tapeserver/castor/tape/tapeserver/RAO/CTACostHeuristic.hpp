@@ -34,6 +34,11 @@ public:
    * documented here : https://codimd.web.cern.ch/3adcp34cTqiv7tZJHpdxgA#Cost-Coefficients-calculated-by-Germ%C3%A1n-for-LTO-7M-media
    */
   double getCost(const FilePositionInfos & file1, const FilePositionInfos & file2) const override;
+  /**
+   * The wrap and direction changes are known from the wraps, the longitudinal distance is bounded
+   * and the other terms are taken at their cheapest (landing zone change, no band change, no step back).
+   */
+  double getCostLowerBound(const FilePositionInfos & file1, const uint32_t file2BeginningWrap, const uint64_t longitudinalDistance) const override;
   virtual ~CTACostHeuristic();
 
 };
@@ -17,8 +17,14 @@
 
 #include "CostHeuristic.hpp"
 
+#include <limits>
+
 namespace castor { namespace tape { namespace tapeserver { namespace rao {
 
+double CostHeuristic::getCostLowerBound(const FilePositionInfos & file1, const uint32_t file2BeginningWrap, const uint64_t longitudinalDistance) const {
+  return -std::numeric_limits<double>::infinity();
+}
+
 CostHeuristic::~CostHeuristic() {
 }
 
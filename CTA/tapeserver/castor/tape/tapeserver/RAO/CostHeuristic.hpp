@@ -30,6 +30,18 @@ public:
    * @return the value it costs for going from the end of file1 to the beginning of file2
    */
   virtual double getCost(const FilePositionInfos & file1, const FilePositionInfos & file2) const = 0;
+  /**
+   * Returns a lower bound of the cost for going from the end of file1 to the beginning of any file starting
+   * on the given wrap, at a longitudinal distance of at least longitudinalDistance from the end of file1.
+   * The bound must not decrease when longitudinalDistance increases. It allows the RAO algorithms to skip the
+   * files that cannot be cheaper than the best one found so far.
+   * The default implementation does not know anything about the cost and returns -infinity.
+   * @param file1 the file from which we will go from it's end position
+   * @param file2BeginningWrap the wrap on which the files to reach begin
+   * @param longitudinalDistance the minimal longitudinal distance between the end of file1 and the files to reach
+   * @return a lower bound of the cost for going from the end of file1 to such a file
+   */
+  virtual double getCostLowerBound(const FilePositionInfos & file1, const uint32_t file2BeginningWrap, const uint64_t longitudinalDistance) const;
   virtual ~CostHeuristic();
 private:
 
@@ -0,0 +1,127 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2003-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Micro-benchmark of the CTA RAO algorithms. For development use.
+ *
+ * Times RAOManager::queryRAO() on synthetic recall batches spread over a full LTO7M tape.
+ * Built only when CMake is run with -DBUILD_RAO_BENCHMARK=1.
+ * Usage: cta-rao-benchmark [algorithm options] [batch sizes...]
+ * e.g. cta-rao-benchmark cost_heuristic_name:cta,two_opt_time_budget_ms:2000 1000 10000 100000
+ */
+
+#include "RAOManager.hpp"
+#include "RAOParams.hpp"
+#include "castor/tape/tapeserver/drive/FakeDrive.hpp"
+#include "catalogue/DummyCatalogue.hpp"
+#include "common/log/DummyLogger.hpp"
+#include "common/log/LogContext.hpp"
+#include "common/Timer.hpp"
+#include "scheduler/RetrieveJob.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint64_t c_nbWraps = 112;
+const uint64_t c_nbBlocksPerWrap = 208000;
+
+/**
+ * A fake drive returning the end of wrap positions of a full LTO7M tape
+ */
+class BenchmarkDrive: public castor::tape::tapeserver::drive::FakeDrive {
+public:
+  std::vector<castor::tape::tapeserver::drive::endOfWrapPosition> getEndOfWrapPositions() override {
+    std::vector<castor::tape::tapeserver::drive::endOfWrapPosition> ret;
+    for(uint16_t wrap = 0; wrap < c_nbWraps; ++wrap){
+      ret.push_back({wrap, (wrap + 1) * c_nbBlocksPerWrap, 0});
+    }
+    return ret;
+  }
+};
+
+/**
+ * A catalogue that only knows that every tape is an LTO7M
+ */
+class BenchmarkCatalogue: public cta::catalogue::DummyCatalogue {
+public:
+  cta::catalogue::MediaType getMediaTypeByVid(const std::string & vid) const override {
+    cta::catalogue::MediaType mediaType;
+    mediaType.name = "LTO7M";
+    mediaType.minLPos = 2696;
+    mediaType.maxLPos = 171097;
+    mediaType.nbWraps = c_nbWraps;
+    return mediaType;
+  }
+};
+
+std::vector<std::unique_ptr<cta::RetrieveJob>> generateRetrieveJobs(const uint64_t nbJobs, std::mt19937_64 & generator){
+  std::vector<std::unique_ptr<cta::RetrieveJob>> ret;
+  std::uniform_int_distribution<uint64_t> blockIdDistribution(0, c_nbWraps * c_nbBlocksPerWrap - 1);
+  for(uint64_t i = 0; i < nbJobs; ++i){
+    cta::common::dataStructures::ArchiveFile archiveFile;
+    cta::common::dataStructures::TapeFile tapeFile;
+    tapeFile.blockId = blockIdDistribution(generator);
+    tapeFile.copyNb = 1;
+    tapeFile.fSeq = i + 1;
+    tapeFile.fileSize = 1000000000;
+    archiveFile.tapeFiles.push_back(tapeFile);
+    cta::common::dataStructures::RetrieveRequest retrieveRequest;
+    ret.emplace_back(new cta::RetrieveJob(nullptr,retrieveRequest,archiveFile,1,cta::PositioningMethod::ByBlock));
+  }
+  return ret;
+}
+
+} // anonymous namespace
+
+int main(const int argc, char ** const argv) {
+  std::string algorithmOptions = "cost_heuristic_name:cta";
+  std::vector<uint64_t> batchSizes;
+  for(int i = 1; i < argc; ++i){
+    std::string arg = argv[i];
+    if(arg.find(':') != std::string::npos){
+      algorithmOptions = arg;
+    } else {
+      batchSizes.push_back(std::stoull(arg));
+    }
+  }
+  if(batchSizes.empty()){
+    batchSizes = {1000, 10000, 100000};
+  }
+  cta::log::DummyLogger dl("dummy", "cta-rao-benchmark");
+  cta::log::LogContext lc(dl);
+  BenchmarkDrive drive;
+  BenchmarkCatalogue catalogue;
+  castor::tape::tapeserver::rao::RAOParams raoParams(true, "sltf", algorithmOptions, "V00001");
+  castor::tape::tapeserver::rao::RAOManager raoManager(raoParams, &drive, &catalogue);
+  std::mt19937_64 generator(0);
+  for(auto batchSize: batchSizes){
+    auto jobs = generateRetrieveJobs(batchSize, generator);
+    cta::utils::Timer t;
+    std::vector<uint64_t> order = raoManager.queryRAO(jobs, lc);
+    std::cout << "queryRAO nbFiles=" << batchSize << " options=" << algorithmOptions
+              << " time=" << t.secs() << "s" << std::endl;
+    if(order.size() != jobs.size()){
+      std::cerr << "Unexpected RAO result size: " << order.size() << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
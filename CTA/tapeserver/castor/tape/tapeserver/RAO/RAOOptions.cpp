@@ -63,6 +63,17 @@ bool RAOOptions::getBooleanValue(const std::string& name) const {
   return ret;
 }
 
+bool RAOOptions::hasOption(const std::string& name) const {
+  for(auto & option: m_allOptions){
+    std::vector<std::string> keyValue;
+    cta::utils::splitString(option,':',keyValue);
+    if(keyValue.size() && keyValue.at(0) == name){
+      return true;
+    }
+  }
+  return false;
+}
+
 std::string RAOOptions::getStringValue(const std::string& name) const {
   std::string ret;
   bool found = false;
@@ -104,6 +115,17 @@ RAOOptions::FilePositionEstimatorType RAOOptions::getFilePositionEstimatorType()
   return RAOOptions::FilePositionEstimatorType::interpolation;
 }
 
+uint64_t RAOOptions::getTwoOptTimeBudgetMs() {
+  if(!hasOption("two_opt_time_budget_ms")){
+    return 0;
+  }
+  std::string value = getStringValue("two_opt_time_budget_ms");
+  if(!cta::utils::isValidUInt(value)){
+    throw cta::exception::Exception("In RAOOptions::getTwoOptTimeBudgetMs(), the value of two_opt_time_budget_ms (" + value + ") is not an unsigned integer");
+  }
+  return cta::utils::toUint64(value);
+}
+
 std::string RAOOptions::getOptionsString() {
   return m_options;
 }
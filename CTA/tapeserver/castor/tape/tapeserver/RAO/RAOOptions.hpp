@@ -71,6 +71,14 @@ public:
    */
   FilePositionEstimatorType getFilePositionEstimatorType();
   
+  /**
+   * Returns the time budget (in milliseconds) of the 2-opt refinement of the SLTF RAO ordering
+   * from the optional two_opt_time_budget_ms option
+   * @return the time budget, 0 (no refinement) if the option is not set
+   * @throws cta::exception::Exception if the value of the option is not an unsigned integer
+   */
+  uint64_t getTwoOptTimeBudgetMs();
+  
   /**
    * Returns the RAOLTOAlgorithmOptions
    * @return 
@@ -90,6 +98,12 @@ private:
    * @return the boolean value of the option.
    */
   bool getBooleanValue(const std::string & name) const;
+  /**
+   * Returns true if the option whose name is passed
+   * in parameter is set
+   * @param name the name of the option
+   */
+  bool hasOption(const std::string & name) const;
   /**
    * Returns the string value of the option
    * whose name is passed in parameter
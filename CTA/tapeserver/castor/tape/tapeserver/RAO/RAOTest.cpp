@@ -18,6 +18,9 @@
 
 #include <vector>
 #include <map>
+#include <random>
+#include <algorithm>
+#include <limits>
 
 #include "InterpolationFilePositionEstimator.hpp"
 #include "common/make_unique.hpp"
@@ -82,6 +85,17 @@ namespace unitTests {
       return ret;
     }
     
+    static std::vector<std::unique_ptr<cta::RetrieveJob>> generateRandomRetrieveJobs(const uint64_t nbJobs){
+      std::vector<std::unique_ptr<cta::RetrieveJob>> ret;
+      std::mt19937_64 generator(42);
+      //Small range so that some files share the same blockId
+      std::uniform_int_distribution<uint64_t> blockIdDistribution(0,633000);
+      for(uint64_t i = 0; i < nbJobs; ++i){
+        ret.emplace_back(createRetrieveJobForRAOTests(blockIdDistribution(generator) / 100 * 100,1,i + 1,1000000000));
+      }
+      return ret;
+    }
+    
   };
   
   class RAOTest: public ::testing::Test {
@@ -350,4 +364,58 @@ namespace unitTests {
     std::vector<uint64_t> expectedRAOOrder = {4,6,5,3,2,7,0,1};
     ASSERT_EQ(expectedRAOOrder,raoOrder);
   }
+  
+  TEST_F(RAOTest, RAOSLTFAlgorithmSameOrderAsExhaustiveSearch){
+    auto jobs = RAOTestEnvironment::generateRandomRetrieveJobs(1000);
+    rao::InterpolationFilePositionEstimator estimator(RAOTestEnvironment::getLTO7MEndOfWrapPositions(),RAOTestEnvironment::getLTO7MMediaType());
+    rao::CTACostHeuristic heuristic;
+    std::vector<rao::FilePositionInfos> positions;
+    for(auto & job: jobs){
+      positions.push_back(estimator.getFilePosition(*job));
+    }
+    //Exhaustive SLTF: from the beginning of the tape, always go to the cheapest remaining file (lowest index on equal costs)
+    auto beginningOfTapeJob = RAOTestEnvironment::createRetrieveJobForRAOTests(0,1,0,0);
+    rao::FilePositionInfos current = estimator.getFilePosition(*beginningOfTapeJob);
+    std::vector<bool> picked(jobs.size(),false);
+    std::vector<uint64_t> expectedRAOOrder;
+    while(expectedRAOOrder.size() < jobs.size()){
+      double bestCost = std::numeric_limits<double>::infinity();
+      uint64_t bestIndex = 0;
+      for(uint64_t i = 0; i < jobs.size(); ++i){
+        if(picked[i]) continue;
+        double cost = heuristic.getCost(current,positions[i]);
+        if(cost < bestCost){
+          bestCost = cost;
+          bestIndex = i;
+        }
+      }
+      picked[bestIndex] = true;
+      expectedRAOOrder.push_back(bestIndex);
+      current = positions[bestIndex];
+    }
+    std::unique_ptr<rao::FilePositionEstimator> filePositionEstimator;
+    std::unique_ptr<rao::CostHeuristic> costHeuristic;
+    filePositionEstimator.reset(new rao::InterpolationFilePositionEstimator(RAOTestEnvironment::getLTO7MEndOfWrapPositions(),RAOTestEnvironment::getLTO7MMediaType()));
+    costHeuristic.reset(new rao::CTACostHeuristic());
+    std::unique_ptr<rao::SLTFRAOAlgorithm> sltfRAOAlgorithm = cta::make_unique<rao::SLTFRAOAlgorithm>(filePositionEstimator,costHeuristic);
+    ASSERT_EQ(expectedRAOOrder,sltfRAOAlgorithm->performRAO(jobs));
+    
+    //The 2-opt improvement must return a permutation of the files that does not cost more
+    auto totalCost = [&](const std::vector<uint64_t> & order){
+      rao::FilePositionInfos from = estimator.getFilePosition(*beginningOfTapeJob);
+      double ret = 0.0;
+      for(auto index: order){
+        ret += heuristic.getCost(from,positions[index]);
+        from = positions[index];
+      }
+      return ret;
+    };
+    sltfRAOAlgorithm->setTwoOptTimeBudgetMs(10000);
+    std::vector<uint64_t> twoOptRAOOrder = sltfRAOAlgorithm->performRAO(jobs);
+    ASSERT_LE(totalCost(twoOptRAOOrder),totalCost(expectedRAOOrder) + 1e-6);
+    std::sort(twoOptRAOOrder.begin(),twoOptRAOOrder.end());
+    for(uint64_t i = 0; i < twoOptRAOOrder.size(); ++i){
+      ASSERT_EQ(i,twoOptRAOOrder[i]);
+    }
+  }
 }
@@ -18,6 +18,9 @@
 #include "RandomRAOAlgorithm.hpp"
 #include "common/Timer.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 namespace castor { namespace tape { namespace tapeserver { namespace rao {
 
 RandomRAOAlgorithm::RandomRAOAlgorithm() {
@@ -23,8 +23,157 @@
 #include "CostHeuristicFactory.hpp"
 #include "FilePositionEstimatorFactory.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace castor { namespace tape { namespace tapeserver { namespace rao {
 
+namespace {
+
+/**
+ * Index of the files the SLTF algorithm has not picked yet. The files are grouped by the wrap of their beginning
+ * and sorted by the longitudinal position of their beginning, so that the cheapest file to reach from a position
+ * is found by walking away from this position and stopping as soon as the cost lower bound exceeds the best cost
+ * found. The picked files are skipped thanks to path-compressed links to the next and previous remaining files.
+ */
+class RemainingFilesIndex {
+public:
+  RemainingFilesIndex(const std::vector<FilePositionInfos> & positions, const uint64_t nbFiles);
+  void remove(const uint64_t fileIndex);
+  /**
+   * Returns the index of the remaining file that is the cheapest to reach from the end of the file passed in parameter,
+   * the lowest index in case of equal costs
+   */
+  uint64_t findCheapestFile(const FilePositionInfos & from, const CostHeuristic & costHeuristic);
+private:
+  struct WrapFiles {
+    uint32_t wrap;
+    std::vector<uint64_t> lpos;
+    std::vector<uint64_t> fileIndexes;
+    // nextRemaining[p] leads to the first remaining file at or after p (lpos.size() if none).
+    std::vector<uint64_t> nextRemaining;
+    // prevRemaining[p + 1] leads to p + 1 for the last remaining file at or before p (0 if none).
+    std::vector<uint64_t> prevRemaining;
+    uint64_t nbRemaining;
+  };
+  static uint64_t follow(std::vector<uint64_t> & links, uint64_t i);
+  void searchWrap(WrapFiles & wrapFiles, const FilePositionInfos & from, const CostHeuristic & costHeuristic,
+    double & bestCost, uint64_t & bestFileIndex);
+  // Tolerance on the lower bounds, that are not computed in the same order as the costs
+  static constexpr double c_epsilon = 1e-9;
+  const std::vector<FilePositionInfos> & m_positions;
+  std::vector<WrapFiles> m_wraps;
+  // For each file, the index in m_wraps and the position in the wrap
+  std::vector<std::pair<uint64_t, uint64_t>> m_fileLocations;
+};
+
+RemainingFilesIndex::RemainingFilesIndex(const std::vector<FilePositionInfos> & positions, const uint64_t nbFiles):
+  m_positions(positions), m_fileLocations(nbFiles) {
+  std::vector<std::pair<Position, uint64_t>> files;
+  files.reserve(nbFiles);
+  for(uint64_t i = 0; i < nbFiles; ++i){
+    files.emplace_back(positions[i].getBeginningPosition(), i);
+  }
+  std::sort(files.begin(), files.end(), [](const std::pair<Position, uint64_t> & a, const std::pair<Position, uint64_t> & b){
+    if(a.first.getWrap() != b.first.getWrap()) return a.first.getWrap() < b.first.getWrap();
+    if(a.first.getLPos() != b.first.getLPos()) return a.first.getLPos() < b.first.getLPos();
+    return a.second < b.second;
+  });
+  for(auto & file: files){
+    if(m_wraps.empty() || m_wraps.back().wrap != file.first.getWrap()){
+      m_wraps.emplace_back();
+      m_wraps.back().wrap = file.first.getWrap();
+      m_wraps.back().nbRemaining = 0;
+    }
+    WrapFiles & wrapFiles = m_wraps.back();
+    m_fileLocations[file.second] = std::make_pair(m_wraps.size() - 1, wrapFiles.lpos.size());
+    wrapFiles.lpos.push_back(file.first.getLPos());
+    wrapFiles.fileIndexes.push_back(file.second);
+    wrapFiles.nbRemaining++;
+  }
+  for(auto & wrapFiles: m_wraps){
+    wrapFiles.nextRemaining.resize(wrapFiles.lpos.size() + 1);
+    wrapFiles.prevRemaining.resize(wrapFiles.lpos.size() + 1);
+    for(uint64_t i = 0; i <= wrapFiles.lpos.size(); ++i){
+      wrapFiles.nextRemaining[i] = i;
+      wrapFiles.prevRemaining[i] = i;
+    }
+  }
+}
+
+void RemainingFilesIndex::remove(const uint64_t fileIndex){
+  const auto & location = m_fileLocations[fileIndex];
+  WrapFiles & wrapFiles = m_wraps[location.first];
+  wrapFiles.nextRemaining[location.second] = location.second + 1;
+  wrapFiles.prevRemaining[location.second + 1] = location.second;
+  wrapFiles.nbRemaining--;
+}
+
+uint64_t RemainingFilesIndex::follow(std::vector<uint64_t> & links, uint64_t i){
+  uint64_t target = i;
+  while(links[target] != target){
+    target = links[target];
+  }
+  while(links[i] != target){
+    uint64_t next = links[i];
+    links[i] = target;
+    i = next;
+  }
+  return target;
+}
+
+uint64_t RemainingFilesIndex::findCheapestFile(const FilePositionInfos & from, const CostHeuristic & costHeuristic){
+  double bestCost = std::numeric_limits<double>::infinity();
+  uint64_t bestFileIndex = std::numeric_limits<uint64_t>::max();
+  //Start with the wrap we are on: it usually holds the cheapest file, which makes the other wraps cheaper to skip
+  const uint32_t fromWrap = from.getEndPosition().getWrap();
+  auto fromWrapFiles = std::find_if(m_wraps.begin(), m_wraps.end(), [fromWrap](const WrapFiles & w){ return w.wrap == fromWrap; });
+  if(fromWrapFiles != m_wraps.end()){
+    searchWrap(*fromWrapFiles, from, costHeuristic, bestCost, bestFileIndex);
+  }
+  for(auto wrapFiles = m_wraps.begin(); wrapFiles != m_wraps.end(); ++wrapFiles){
+    if(wrapFiles != fromWrapFiles){
+      searchWrap(*wrapFiles, from, costHeuristic, bestCost, bestFileIndex);
+    }
+  }
+  return bestFileIndex;
+}
+
+void RemainingFilesIndex::searchWrap(WrapFiles & wrapFiles, const FilePositionInfos & from, const CostHeuristic & costHeuristic,
+  double & bestCost, uint64_t & bestFileIndex){
+  if(!wrapFiles.nbRemaining || costHeuristic.getCostLowerBound(from, wrapFiles.wrap, 0) - c_epsilon > bestCost){
+    return;
+  }
+  const uint64_t nbFilesInWrap = wrapFiles.lpos.size();
+  const uint64_t fromLPos = from.getEndPosition().getLPos();
+  const uint64_t start = std::lower_bound(wrapFiles.lpos.begin(), wrapFiles.lpos.end(), fromLPos) - wrapFiles.lpos.begin();
+  //Walk away from the position on both sides, always taking the closest file first: the lower bound only grows
+  uint64_t right = follow(wrapFiles.nextRemaining, start);
+  uint64_t leftPlusOne = follow(wrapFiles.prevRemaining, start);
+  while(right < nbFilesInWrap || leftPlusOne > 0){
+    bool goRight = right < nbFilesInWrap &&
+      (leftPlusOne == 0 || wrapFiles.lpos[right] - fromLPos <= fromLPos - wrapFiles.lpos[leftPlusOne - 1]);
+    uint64_t position = goRight ? right : leftPlusOne - 1;
+    uint64_t distance = goRight ? wrapFiles.lpos[position] - fromLPos : fromLPos - wrapFiles.lpos[position];
+    if(costHeuristic.getCostLowerBound(from, wrapFiles.wrap, distance) - c_epsilon > bestCost){
+      break;
+    }
+    uint64_t fileIndex = wrapFiles.fileIndexes[position];
+    double cost = costHeuristic.getCost(from, m_positions[fileIndex]);
+    if(cost < bestCost || (cost == bestCost && fileIndex < bestFileIndex)){
+      bestCost = cost;
+      bestFileIndex = fileIndex;
+    }
+    if(goRight){
+      right = follow(wrapFiles.nextRemaining, right + 1);
+    } else {
+      leftPlusOne = follow(wrapFiles.prevRemaining, leftPlusOne - 1);
+    }
+  }
+}
+
+} // anonymous namespace
+
 SLTFRAOAlgorithm::SLTFRAOAlgorithm() {}
 
 SLTFRAOAlgorithm::SLTFRAOAlgorithm(std::unique_ptr<FilePositionEstimator> & filePositionEstimator, std::unique_ptr<CostHeuristic> & costHeuristic):m_filePositionEstimator(std::move(filePositionEstimator)),m_costHeuristic(std::move(costHeuristic)) {}
@@ -34,11 +183,15 @@ std::vector<uint64_t> SLTFRAOAlgorithm::performRAO(const std::vector<std::unique
   //Determine all the files position
   cta::utils::Timer t;
   cta::utils::Timer totalTimer;
-  SLTFRAOAlgorithm::RAOFilesContainer files = computeAllFilesPosition(jobs);
+  std::vector<FilePositionInfos> positions = computeAllFilesPosition(jobs);
   m_raoTimings.insertAndReset("computeAllFilesPositionTime",t);
   //Perform a Short Locate Time First algorithm on the files
-  ret = performSLTF(files);
+  ret = performSLTF(positions);
   m_raoTimings.insertAndReset("performSLTFTime",t);
+  if(m_twoOptTimeBudgetMs){
+    performTwoOpt(positions,ret);
+    m_raoTimings.insertAndReset("performTwoOptTime",t);
+  }
   m_raoTimings.insertAndReset("RAOAlgorithmTime",totalTimer);
   return ret;
 }
@@ -47,6 +200,10 @@ std::vector<uint64_t> SLTFRAOAlgorithm::performRAO(const std::vector<std::unique
 SLTFRAOAlgorithm::~SLTFRAOAlgorithm() {
 }
 
+void SLTFRAOAlgorithm::setTwoOptTimeBudgetMs(const uint64_t timeBudgetMs) {
+  m_twoOptTimeBudgetMs = timeBudgetMs;
+}
+
 
 SLTFRAOAlgorithm::Builder::Builder(const RAOParams& data):m_raoParams(data){
   m_algorithm.reset(new SLTFRAOAlgorithm());
@@ -63,6 +220,7 @@ void SLTFRAOAlgorithm::Builder::setDrive(drive::DriveInterface* drive) {
 std::unique_ptr<SLTFRAOAlgorithm> SLTFRAOAlgorithm::Builder::build() {
   initializeFilePositionEstimator();
   initializeCostHeuristic();
+  m_algorithm->setTwoOptTimeBudgetMs(m_raoParams.getRAOAlgorithmOptions().getTwoOptTimeBudgetMs());
   return std::move(m_algorithm);
 }
 
@@ -92,46 +250,88 @@ void SLTFRAOAlgorithm::Builder::initializeCostHeuristic() {
   m_algorithm->m_costHeuristic = factory.createCostHeuristic(m_raoParams.getRAOAlgorithmOptions().getCostHeuristicType());
 }
 
-SLTFRAOAlgorithm::RAOFilesContainer SLTFRAOAlgorithm::computeAllFilesPosition(const std::vector<std::unique_ptr<cta::RetrieveJob> >& jobs) const {
-  SLTFRAOAlgorithm::RAOFilesContainer files;
+std::vector<FilePositionInfos> SLTFRAOAlgorithm::computeAllFilesPosition(const std::vector<std::unique_ptr<cta::RetrieveJob> >& jobs) const {
+  std::vector<FilePositionInfos> positions;
+  positions.reserve(jobs.size() + 1);
   for(uint64_t i = 0; i < jobs.size(); ++i){
-    files.insert({i,RAOFile(i,m_filePositionEstimator->getFilePosition(*(jobs.at(i))))});
+    positions.push_back(m_filePositionEstimator->getFilePosition(*(jobs.at(i))));
   }
   //Create a dummy file that starts at the beginning of the tape (blockId = 0) (the SLTF algorithm will start from this file)
   std::unique_ptr<cta::RetrieveJob> dummyRetrieveJob = createFakeRetrieveJobForFileAtBeginningOfTape();
-  files.insert({jobs.size(),RAOFile(jobs.size(),m_filePositionEstimator->getFilePosition(*dummyRetrieveJob))});
-  return files;
+  positions.push_back(m_filePositionEstimator->getFilePosition(*dummyRetrieveJob));
+  return positions;
 }
 
-void SLTFRAOAlgorithm::computeCostBetweenFileAndOthers(RAOFile & file, const SLTFRAOAlgorithm::RAOFilesContainer & otherFiles) const {
-  FilePositionInfos filePositionInfos = file.getFilePositionInfos();
-  for(auto &otherFile: otherFiles) {
-    double distance = m_costHeuristic->getCost(filePositionInfos,otherFile.second.getFilePositionInfos());
-    file.addDistanceToFile(distance,otherFile.second);
+std::vector<uint64_t> SLTFRAOAlgorithm::performSLTF(const std::vector<FilePositionInfos> & positions) const {
+  const uint64_t nbFiles = positions.size() - 1;
+  std::vector<uint64_t> solution;
+  solution.reserve(nbFiles);
+  RemainingFilesIndex remainingFiles(positions, nbFiles);
+  //Start from the fake file that is at the beginning of the tape (end of the positions)
+  uint64_t currentFileIndex = nbFiles;
+  while(solution.size() < nbFiles){
+    currentFileIndex = remainingFiles.findCheapestFile(positions[currentFileIndex], *m_costHeuristic);
+    remainingFiles.remove(currentFileIndex);
+    solution.push_back(currentFileIndex);
   }
+  return solution;
 }
 
-std::vector<uint64_t> SLTFRAOAlgorithm::performSLTF(SLTFRAOAlgorithm::RAOFilesContainer & files) const {
-  std::vector<uint64_t> solution;
-  //Start from the fake file that is at the beginning of the tape (end of the files container)
-  RAOFile firstFile = files.rbegin()->second;
-  files.erase(firstFile.getIndex());
-  computeCostBetweenFileAndOthers(firstFile,files);
-  uint64_t closestFileIndex = firstFile.getClosestFileIndex();
-  solution.push_back(closestFileIndex);
-  while(!files.empty()){
-    RAOFile currentFile = files.at(closestFileIndex);
-    files.erase(currentFile.getIndex());
-    if(files.size()){
-      computeCostBetweenFileAndOthers(currentFile,files);
-      closestFileIndex = currentFile.getClosestFileIndex();
-      solution.push_back(closestFileIndex);
+void SLTFRAOAlgorithm::performTwoOpt(const std::vector<FilePositionInfos> & positions, std::vector<uint64_t> & solution) {
+  if(solution.size() < 3){
+    return;
+  }
+  cta::utils::Timer t;
+  const int64_t timeBudgetUs = m_twoOptTimeBudgetMs * 1000;
+  const double epsilon = 1e-9;
+  //The path starts from the fake file at the beginning of the tape, that never moves
+  std::vector<uint64_t> path;
+  path.reserve(solution.size() + 1);
+  path.push_back(positions.size() - 1);
+  path.insert(path.end(), solution.begin(), solution.end());
+  auto cost = [this, &positions](const uint64_t from, const uint64_t to){
+    return m_costHeuristic->getCost(positions[from], positions[to]);
+  };
+  //edgeCosts[k] is the cost of going from path[k] to path[k + 1]
+  std::vector<double> edgeCosts(path.size() - 1);
+  for(uint64_t k = 0; k + 1 < path.size(); ++k){
+    edgeCosts[k] = cost(path[k], path[k + 1]);
+  }
+  bool improved = true;
+  bool timeBudgetSpent = false;
+  while(improved && !timeBudgetSpent){
+    improved = false;
+    for(uint64_t i = 0; i + 2 < path.size(); ++i){
+      if(t.usecs() >= timeBudgetUs){
+        timeBudgetSpent = true;
+        break;
+      }
+      //Try to reverse path[i + 1 .. j]. The costs are not symmetric, so the segment walked backward is costed too.
+      double forwardCost = 0.0;
+      double backwardCost = 0.0;
+      for(uint64_t j = i + 2; j < path.size() && j <= i + c_twoOptMaxSegmentLength; ++j){
+        forwardCost += edgeCosts[j - 1];
+        backwardCost += cost(path[j], path[j - 1]);
+        double currentCost = edgeCosts[i] + forwardCost;
+        double reversedCost = cost(path[i], path[j]) + backwardCost;
+        if(j + 1 < path.size()){
+          currentCost += edgeCosts[j];
+          reversedCost += cost(path[i + 1], path[j + 1]);
+        }
+        if(reversedCost < currentCost - epsilon){
+          std::reverse(path.begin() + i + 1, path.begin() + j + 1);
+          for(uint64_t k = i; k <= j && k + 1 < path.size(); ++k){
+            edgeCosts[k] = cost(path[k], path[k + 1]);
+          }
+          improved = true;
+          break;
+        }
+      }
     }
   }
-  return solution;
+  std::copy(path.begin() + 1, path.end(), solution.begin());
 }
 
-
 std::unique_ptr<cta::RetrieveJob> SLTFRAOAlgorithm::createFakeRetrieveJobForFileAtBeginningOfTape() const {
   std::unique_ptr<cta::RetrieveJob> ret;
   cta::common::dataStructures::ArchiveFile archiveFile;
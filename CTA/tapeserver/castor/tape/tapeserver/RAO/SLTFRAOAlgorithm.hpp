@@ -22,9 +22,8 @@
 #include "CostHeuristic.hpp"
 #include "FilePositionEstimator.hpp"
 #include "castor/tape/tapeserver/drive/DriveInterface.hpp"
-#include "RAOFile.hpp"
 
-#include <map>
+#include <vector>
 
 namespace castor { namespace tape { namespace tapeserver { namespace rao {
   
@@ -43,6 +42,11 @@ public:
    */
   std::vector<uint64_t> performRAO(const std::vector<std::unique_ptr<cta::RetrieveJob> >& jobs) override;
   std::string getName() const override;
+  /**
+   * Enables the 2-opt refinement of the SLTF ordering
+   * @param timeBudgetMs the maximum time spent refining the ordering, 0 disables the refinement
+   */
+  void setTwoOptTimeBudgetMs(const uint64_t timeBudgetMs);
   virtual ~SLTFRAOAlgorithm();
   
   /**
@@ -71,12 +75,34 @@ private:
   SLTFRAOAlgorithm();
   std::unique_ptr<FilePositionEstimator> m_filePositionEstimator;
   std::unique_ptr<CostHeuristic> m_costHeuristic;
-    
-  typedef std::map<uint64_t,RAOFile> RAOFilesContainer;
+  uint64_t m_twoOptTimeBudgetMs = 0;
+  
+  /**
+   * The 2-opt refinement only reverses segments of at most this number of files
+   */
+  static const uint64_t c_twoOptMaxSegmentLength = 64;
   
-  RAOFilesContainer computeAllFilesPosition(const std::vector<std::unique_ptr<cta::RetrieveJob> > & jobs) const;
-  void computeCostBetweenFileAndOthers(RAOFile & file, const RAOFilesContainer & files) const;
-  std::vector<uint64_t> performSLTF(RAOFilesContainer & files) const;
+  /**
+   * Returns the position of all the files, indexed like the jobs, followed by the position of
+   * a fake file at the beginning of the tape (from where the SLTF algorithm starts)
+   */
+  std::vector<FilePositionInfos> computeAllFilesPosition(const std::vector<std::unique_ptr<cta::RetrieveJob> > & jobs) const;
+  /**
+   * Builds the SLTF ordering: starting from the fake file at the beginning of the tape, the next file is always
+   * the cheapest one to reach from the current file (the one with the lowest index in case of equal costs).
+   * The candidates are looked up in an index of the remaining files by wrap and longitudinal position, and the
+   * cost lower bound of the heuristic allows to stop the lookup without evaluating the cost to all the files.
+   * @param positions the positions returned by computeAllFilesPosition()
+   * @return the indexes of the files in SLTF order (without the fake file)
+   */
+  std::vector<uint64_t> performSLTF(const std::vector<FilePositionInfos> & positions) const;
+  /**
+   * Improves the ordering with 2-opt moves (reversal of a segment of the ordering when it lowers the total cost)
+   * until no move improves it or the time budget is spent.
+   * @param positions the positions returned by computeAllFilesPosition()
+   * @param solution the SLTF ordering to improve
+   */
+  void performTwoOpt(const std::vector<FilePositionInfos> & positions, std::vector<uint64_t> & solution);
   std::unique_ptr<cta::RetrieveJob> createFakeRetrieveJobForFileAtBeginningOfTape() const;
 };
 
@@ -17,7 +17,7 @@
 
 #pragma once
 
-#include "common/threading/BlockingQueue.hpp"
+#include "common/threading/RingQueue.hpp"
 #include "castor/tape/tapeserver/daemon/MemBlock.hpp"
 #include "common/exception/Exception.hpp"
 
@@ -47,9 +47,13 @@ public:
  /**
   * Constructor
   * @param bn :how many memory block we want in the fifo (its size)
+  * @param maxBlocksInFlight :the number of blocks in the memory pool, which
+  * bounds the number of blocks held by the fifo at any time
   */
-  DataPipeline(int bn)  : m_blocksNeeded(bn), m_freeBlocksProvided(0),
-  m_dataBlocksPushed(0), m_dataBlocksPopped(0) {};
+  DataPipeline(int bn, size_t maxBlocksInFlight)  : m_blocksNeeded(bn), m_freeBlocksProvided(0),
+  m_dataBlocksPushed(0), m_dataBlocksPopped(0),
+  m_freeBlocks(queueCapacity(bn, maxBlocksInFlight)),
+  m_dataBlocks(queueCapacity(bn, maxBlocksInFlight)) {};
   
   ~DataPipeline() throw() { 
     cta::threading::MutexLocker ml(m_freeBlockProviderProtection); 
@@ -135,6 +139,13 @@ public:
   }
   
 private:
+  /** Capacity of the internal queues: no more than the blocks needed, nor than the pool size */
+  static size_t queueCapacity(int blocksNeeded, size_t maxBlocksInFlight) {
+    size_t ret = blocksNeeded > 0 ? blocksNeeded : 1;
+    if (maxBlocksInFlight && maxBlocksInFlight < ret) ret = maxBlocksInFlight;
+    return ret;
+  }
+
   cta::threading::Mutex m_countersMutex;
   cta::threading::Mutex m_freeBlockProviderProtection;
   
@@ -150,11 +161,14 @@ private:
   ///how many data blocks have been currently taken
   volatile int m_dataBlocksPopped;
   
-    ///thread sage storage of all free blocks
-  cta::threading::BlockingQueue<MemBlock *> m_freeBlocks;
+  ///thread safe storage of all free blocks (pushed back by the consumer on error,
+  ///hence multi-producer)
+  cta::threading::BlockingRingQueue<MemBlock *> m_freeBlocks;
   
-  ///thread sage storage of all blocks filled with data
-  cta::threading::BlockingQueue<MemBlock *> m_dataBlocks;
+  ///thread safe storage of all blocks filled with data (producers are serialized
+  ///by the owner's producer protection mutex, single consumer)
+  cta::threading::BlockingRingQueue<MemBlock *,
+    cta::threading::SpscRing<MemBlock *> > m_dataBlocks;
 };
 
 }
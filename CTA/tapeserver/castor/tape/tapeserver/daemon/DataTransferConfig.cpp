@@ -24,6 +24,8 @@ castor::tape::tapeserver::daemon::DataTransferConfig::DataTransferConfig()
   throw():
   bufsz(0),
   nbBufs(0),
+  useHugePages(false),
+  lockMemoryBuffers(false),
   bulkRequestMigrationMaxBytes(0),
   bulkRequestMigrationMaxFiles(0),
   bulkRequestRecallMaxBytes(0),
@@ -31,8 +33,10 @@ castor::tape::tapeserver::daemon::DataTransferConfig::DataTransferConfig()
   maxBytesBeforeFlush(0),
   maxFilesBeforeFlush(0),
   nbDiskThreads(0),
+  xrootAsyncRequests(1),
   useLbp(false),
   useRAO(false),
   externalEncryptionKeyScript(""),
-  fetchEosFreeSpaceScript(""){}
+  fetchEosFreeSpaceScript(""),
+  diskSystemFreeSpaceCacheFile(""){}
 
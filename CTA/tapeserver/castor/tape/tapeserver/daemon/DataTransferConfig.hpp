@@ -42,6 +42,16 @@ struct DataTransferConfig {
    */
   uint32_t nbBufs;
 
+  /**
+   * Try to back the data-transfer buffers with huge pages.
+   */
+  bool useHugePages;
+
+  /**
+   * Lock the data-transfer buffers in memory.
+   */
+  bool lockMemoryBuffers;
+
   /**
    * When the tapebridged daemon requests the tapegatewayd daemon for a set of
    * files to migrate to tape, this parameter defines the maximum number of
@@ -100,6 +110,12 @@ struct DataTransferConfig {
    */
   uint16_t xrootTimeout;
 
+  /**
+   * The number of asynchronous xroot reads or writes in flight per disk file.
+   * The default is 1 (synchronous transfers).
+   */
+  uint32_t xrootAsyncRequests;
+
   /**
    * The boolean variable describing to use on not to use Logical
    * Block Protection.
@@ -131,6 +147,12 @@ struct DataTransferConfig {
    * The path to the operator provided EOS free space fetch script (or empty string)
    */
   std::string fetchEosFreeSpaceScript;
+
+  /**
+   * The path of the file sharing the free space of the disk systems between
+   * the drive processes (or empty string)
+   */
+  std::string diskSystemFreeSpaceCacheFile;
   
   /**
    * The timeout after which the mount of a tape is considered failed
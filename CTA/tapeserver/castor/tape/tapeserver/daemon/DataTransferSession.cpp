@@ -35,6 +35,7 @@
 #include "scheduler/RetrieveMount.hpp"
 #include "castor/tape/tapeserver/RAO/RAOParams.hpp"
 
+#include <algorithm>
 #include <google/protobuf/stubs/common.h>
 #include <memory>
 
@@ -227,6 +228,7 @@ castor::tape::tapeserver::daemon::Session::EndOfSessionAction
   // findDrive does not throw exceptions (it catches them to log errors)
   // A NULL pointer is returned on failure
   retrieveMount->setFetchEosFreeSpaceScript(m_castorConf.fetchEosFreeSpaceScript);
+  retrieveMount->setDiskSystemFreeSpaceCacheFile(m_castorConf.diskSystemFreeSpaceCacheFile);
   std::unique_ptr<castor::tape::tapeserver::drive::DriveInterface> drive(findDrive(m_driveConfig,lc,retrieveMount));
   if(!drive.get()) return MARK_DRIVE_AS_DOWN;    
   // We can now start instantiating all the components of the data path
@@ -237,7 +239,10 @@ castor::tape::tapeserver::daemon::Session::EndOfSessionAction
     rrp.disableBulk(); //no bulk needed anymore
     RecallWatchDog rwd(15,60*10,m_intialProcess,*retrieveMount,m_driveConfig.unitName,lc);
     
-    RecallMemoryManager mm(m_castorConf.nbBufs, m_castorConf.bufsz,lc);
+    MemBlockArena::Options arenaOptions;
+    arenaOptions.useHugePages = m_castorConf.useHugePages;
+    arenaOptions.lockMemory = m_castorConf.lockMemoryBuffers;
+    RecallMemoryManager mm(m_castorConf.nbBufs, m_castorConf.bufsz,lc,arenaOptions);
     TapeServerReporter tsr(m_intialProcess, m_driveConfig, 
             m_hostname, m_volInfo, lc);
     //we retrieved the detail from the client in execute, so at this point 
@@ -248,12 +253,17 @@ castor::tape::tapeserver::daemon::Session::EndOfSessionAction
     TapeReadSingleThread trst(*drive, m_mc, tsr, m_volInfo, 
         m_castorConf.bulkRequestRecallMaxFiles,m_capUtils,rwd,lc,rrp,
         m_castorConf.useLbp, m_castorConf.useRAO, m_castorConf.externalEncryptionKeyScript,*retrieveMount, m_castorConf.tapeLoadTimeout);
+    // Each disk thread keeps up to xrootAsyncRequests - 1 blocks while waiting
+    // for the next one: leave at least one block to the tape thread.
+    const uint32_t xrootAsyncWrites = std::max(1U, std::min(m_castorConf.xrootAsyncRequests,
+      (uint32_t)((m_castorConf.nbBufs - 1) / std::max(1U, m_castorConf.nbDiskThreads) + 1)));
     DiskWriteThreadPool dwtp(m_castorConf.nbDiskThreads,
         rrp,
         rwd,
         lc,
         m_castorConf.xrootPrivateKey,
-        m_castorConf.xrootTimeout);
+        m_castorConf.xrootTimeout,
+        xrootAsyncWrites);
     RecallTaskInjector rti(mm, trst, dwtp, *retrieveMount,
             m_castorConf.bulkRequestRecallMaxFiles,
             m_castorConf.bulkRequestRecallMaxBytes,lc);
@@ -355,8 +365,11 @@ castor::tape::tapeserver::daemon::Session::EndOfSessionAction
     //then findDrive would have return NULL and we would have not end up there
     TapeServerReporter tsr(m_intialProcess, m_driveConfig, m_hostname,m_volInfo,lc);
     
+    MemBlockArena::Options arenaOptions;
+    arenaOptions.useHugePages = m_castorConf.useHugePages;
+    arenaOptions.lockMemory = m_castorConf.lockMemoryBuffers;
     MigrationMemoryManager mm(m_castorConf.nbBufs,
-        m_castorConf.bufsz,lc);
+        m_castorConf.bufsz,lc,arenaOptions);
     MigrationReportPacker mrp(archiveMount, lc);
     MigrationWatchDog mwd(15,60*10,m_intialProcess,*archiveMount,m_driveConfig.unitName,lc);
     TapeWriteSingleThread twst(*drive,
@@ -374,13 +387,18 @@ castor::tape::tapeserver::daemon::Session::EndOfSessionAction
         *archiveMount,
         m_castorConf.tapeLoadTimeout);
  
+    // A disk thread waits for all the blocks of its reads before handing them
+    // over: it cannot read ahead more blocks than there are.
+    const uint32_t xrootAsyncReads = std::max(1U, std::min(m_castorConf.xrootAsyncRequests,
+      (uint32_t)m_castorConf.nbBufs));
     DiskReadThreadPool drtp(m_castorConf.nbDiskThreads,
         m_castorConf.bulkRequestMigrationMaxFiles,
         m_castorConf.bulkRequestMigrationMaxBytes,
         mwd,
         lc,
         m_castorConf.xrootPrivateKey,
-        m_castorConf.xrootTimeout);
+        m_castorConf.xrootTimeout,
+        xrootAsyncReads);
     MigrationTaskInjector mti(mm, drtp, twst, *archiveMount, 
             m_castorConf.bulkRequestMigrationMaxFiles,
             m_castorConf.bulkRequestMigrationMaxBytes,lc);
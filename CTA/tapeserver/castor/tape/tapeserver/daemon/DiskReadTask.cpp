@@ -55,14 +55,16 @@ void DiskReadTask::execute(cta::log::LogContext&  lc, cta::disk::DiskFileFactory
   // We will not record errors for an empty string. This will allow us to
   // prevent counting where error happened upstream.
   std::string currentErrorToCount = "";
+  // The file outlives the try block, so that the reads still in flight on
+  // error complete before it is closed.
+  std::unique_ptr<cta::disk::ReadFile> sourceFile;
   try{
     //we first check here to not even try to open the disk  if a previous task has failed
     //because the disk could the very reason why the previous one failed, 
     //so dont do the same mistake twice !
     checkMigrationFailing();
     currentErrorToCount = "Error_diskOpenForRead";
-    std::unique_ptr<cta::disk::ReadFile> sourceFile(
-      fileFactory.createReadFile(m_archiveJob->srcURL));
+    sourceFile.reset(fileFactory.createReadFile(m_archiveJob->srcURL));
     cta::log::ScopedParamContainer URLcontext(lc);
     URLcontext.add("path", m_archiveJob->srcURL)
               .add("actualURL", sourceFile->URL());
@@ -81,19 +83,35 @@ void DiskReadTask::execute(cta::log::LogContext&  lc, cta::disk::DiskFileFactory
     watchdog.addParameter(cta::log::Param("stillOpenFileForThread"+
       std::to_string((long long)threadID), sourceFile->URL()));
     
+    // Up to maxInFlightReads blocks are read at the same time, and handed
+    // over to the write task in order.
+    const size_t maxInFlightReads = sourceFile->maxAsyncRequests();
+    size_t requestedFileSize = 0;
     while(migratingFileSize>0){
 
-      checkMigrationFailing();
-      
-      mb = m_nextTask.getFreeBlock();
-      m_stats.waitFreeMemoryTime+=localTime.secs(cta::utils::Timer::resetCounter);
-      
-      //set metadata and read the data
-      mb->m_fileid = m_archiveJob->archiveFile.archiveFileID;
-      mb->m_fileBlock = blockId++;
-      
+      while(requestedFileSize < m_archiveJob->archiveFile.fileSize && m_inFlightReads.size() < maxInFlightReads){
+        checkMigrationFailing();
+
+        mb = m_nextTask.getFreeBlock();
+        m_stats.waitFreeMemoryTime+=localTime.secs(cta::utils::Timer::resetCounter);
+
+        //set metadata and start reading the data
+        mb->m_fileid = m_archiveJob->archiveFile.archiveFileID;
+        mb->m_fileBlock = blockId++;
+
+        currentErrorToCount = "Error_diskRead";
+        requestedFileSize += mb->m_payload.totalCapacity();
+        m_inFlightReads.push_back({mb, mb->m_payload.startRead(*sourceFile)});
+        mb=NULL;
+        m_stats.readWriteTime+=localTime.secs(cta::utils::Timer::resetCounter);
+      }
+
+      mb = m_inFlightReads.front().block;
+      std::unique_ptr<cta::disk::ReadFile::AsyncRead> read = std::move(m_inFlightReads.front().read);
+      m_inFlightReads.pop_front();
+
       currentErrorToCount = "Error_diskRead";
-      migratingFileSize -= mb->m_payload.read(*sourceFile);
+      migratingFileSize -= mb->m_payload.completeRead(*read);
       m_stats.readWriteTime+=localTime.secs(cta::utils::Timer::resetCounter);
 
       m_stats.dataVolume += mb->m_payload.size();
@@ -119,6 +137,11 @@ void DiskReadTask::execute(cta::log::LogContext&  lc, cta::disk::DiskFileFactory
       }
       currentErrorToCount = "";
       m_stats.checkingErrorTime += localTime.secs(cta::utils::Timer::resetCounter);
+
+      // Checksum the block here, in the disk thread, so the tape thread only
+      // has to combine the block checksums.
+      mb->m_payload.computeBlockAdler32();
+      m_stats.checksumingTime += localTime.secs(cta::utils::Timer::resetCounter);
       
       // We are done with the block, push it to the write task
       m_nextTask.pushDataBlock(mb);
@@ -151,7 +174,11 @@ void DiskReadTask::execute(cta::log::LogContext&  lc, cta::disk::DiskFileFactory
     // The tape write task, upon reception of the failed block will mark the 
     // session as failed, hence signalling to the remaining disk read tasks to
     // cancel as nothing more will be written to tape.
-    if (!mb) {
+    waitForInFlightReads();
+    if (!mb && m_inFlightReads.size()) {
+      mb = m_inFlightReads.front().block;
+      m_inFlightReads.pop_front();
+    } else if (!mb) {
       mb=m_nextTask.getFreeBlock();
       ++blockId;
     }
@@ -178,8 +205,13 @@ void DiskReadTask::execute(cta::log::LogContext&  lc, cta::disk::DiskFileFactory
 //------------------------------------------------------------------------------
 void DiskReadTask::circulateAllBlocks(size_t fromBlockId, MemBlock * mb){
   size_t blockId = fromBlockId;
-  while(blockId<m_numberOfBlock) {
-    if (!mb) {
+  // The blocks of the reads in flight are already counted in fromBlockId.
+  waitForInFlightReads();
+  while(blockId<m_numberOfBlock || m_inFlightReads.size()) {
+    if (!mb && m_inFlightReads.size()) {
+      mb = m_inFlightReads.front().block;
+      m_inFlightReads.pop_front();
+    } else if (!mb) {
       mb = m_nextTask.getFreeBlock();
       ++blockId;
     }
@@ -190,6 +222,18 @@ void DiskReadTask::circulateAllBlocks(size_t fromBlockId, MemBlock * mb){
   } //end of while
 }
 
+//------------------------------------------------------------------------------
+// DiskReadTask::waitForInFlightReads
+//------------------------------------------------------------------------------
+void DiskReadTask::waitForInFlightReads(){
+  for (auto & inFlightRead: m_inFlightReads) {
+    try {
+      if (inFlightRead.read) inFlightRead.read->wait();
+    } catch (...) {}
+    inFlightRead.read.reset();
+  }
+}
+
 //------------------------------------------------------------------------------
 // logWithStat
 //------------------------------------------------------------------------------  
@@ -26,6 +26,8 @@
 #include "common/log/LogContext.hpp"
 #include "disk/DiskFile.hpp"
 
+#include <deque>
+
 namespace castor {
 namespace tape {
 namespace tapeserver {
@@ -81,6 +83,27 @@ private:
    * @param mb pointer to a possible already popped free block (NULL otherwise)
    */
   void circulateAllBlocks(size_t fromBlockId, MemBlock * mb);
+
+  /**
+   * Waits for the completion of all the reads in flight, ignoring their
+   * result, so that their blocks can be circulated.
+   */
+  void waitForInFlightReads();
+
+  /**
+   * A memory block being filled by an asynchronous disk read
+   */
+  struct InFlightRead {
+    MemBlock * block;
+    std::unique_ptr<cta::disk::ReadFile::AsyncRead> read;
+  };
+
+  /**
+   * The reads in flight, in the order of the blocks of the file. There are
+   * at most ReadFile::maxAsyncRequests() of them.
+   */
+  std::deque<InFlightRead> m_inFlightReads;
+
   /**
    * The task (a TapeWriteTask) that will handle the read blocks
    */
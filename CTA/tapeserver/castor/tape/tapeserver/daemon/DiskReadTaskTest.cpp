@@ -27,8 +27,10 @@
 #include "scheduler/TapeMountDummy.hpp"
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <fstream>
 #include <cmath>
+#include <limits>
 #include <ext/stdio_filebuf.h>
 
 namespace unitTests{
@@ -142,4 +144,205 @@ namespace unitTests{
     ASSERT_EQ(original_checksum,ftwt.getChecksum());
     delete ftwt.getFreeBlock();
   }
+
+  /**
+   * A disk file read with several requests in flight, which complete out of
+   * order: waiting for a read completes all the reads in flight, the last
+   * started first. One of the reads can be made to fail.
+   */
+  class OutOfOrderReadFile: public ReadFile {
+  public:
+    OutOfOrderReadFile(const std::string & content, size_t maxAsyncRequests, size_t failingRead,
+      std::vector<size_t> & completionOrder): m_content(content), m_maxAsyncRequests(maxAsyncRequests),
+      m_failingRead(failingRead), m_completionOrder(completionOrder) {
+      m_URL = "fake://outOfOrderReadFile";
+    }
+    size_t size() const override { return m_content.size(); }
+    size_t read(void *data, const size_t size) const override {
+      throw cta::exception::Exception("In OutOfOrderReadFile::read(): unexpected synchronous read");
+    }
+    std::unique_ptr<AsyncRead> asyncRead(void *data, const size_t size) const override {
+      const size_t offset = m_requests.empty() ? 0 : m_requests.back().offset + m_requests.back().size;
+      m_requests.push_back({static_cast<char *>(data), offset, size, false, 0});
+      return std::unique_ptr<AsyncRead>(new OutOfOrderRead(*this, m_requests.size() - 1));
+    }
+    size_t maxAsyncRequests() const override { return m_maxAsyncRequests; }
+  private:
+    struct Request {
+      char * data;
+      size_t offset;
+      size_t size;
+      bool completed;
+      size_t copied;
+    };
+    class OutOfOrderRead: public AsyncRead {
+    public:
+      OutOfOrderRead(const OutOfOrderReadFile & file, size_t index): m_file(file), m_index(index) {}
+      size_t wait() override {
+        m_file.completeAll();
+        if (m_index == m_file.m_failingRead) {
+          throw cta::exception::Exception("In OutOfOrderRead::wait(): injected read failure");
+        }
+        return m_file.m_requests[m_index].copied;
+      }
+    private:
+      const OutOfOrderReadFile & m_file;
+      const size_t m_index;
+    };
+    void completeAll() const {
+      for (size_t i = m_requests.size(); i > 0; i--) {
+        auto & r = m_requests[i - 1];
+        if (r.completed) continue;
+        if (r.offset < m_content.size()) {
+          r.copied = std::min(r.size, m_content.size() - r.offset);
+          m_content.copy(r.data, r.copied, r.offset);
+        }
+        r.completed = true;
+        m_completionOrder.push_back(i - 1);
+      }
+    }
+    const std::string m_content;
+    const size_t m_maxAsyncRequests;
+    const size_t m_failingRead;
+    std::vector<size_t> & m_completionOrder;
+    mutable std::vector<Request> m_requests;
+  };
+
+  class OutOfOrderReadFileFactory: public DiskFileFactory {
+  public:
+    OutOfOrderReadFileFactory(cta::disk::RadosStriperPool & striperPool, const std::string & content,
+      size_t maxAsyncRequests, size_t failingRead): DiskFileFactory("", 0, striperPool), m_content(content),
+      m_maxAsyncRequests(maxAsyncRequests), m_failingRead(failingRead) {}
+    ReadFile * createReadFile(const std::string & path) override {
+      return new OutOfOrderReadFile(m_content, m_maxAsyncRequests, m_failingRead, completionOrder);
+    }
+    std::vector<size_t> completionOrder;
+  private:
+    const std::string m_content;
+    const size_t m_maxAsyncRequests;
+    const size_t m_failingRead;
+  };
+
+  /**
+   * A tape write task recording the blocks it receives and giving them back
+   * to its pool of free blocks straight away
+   */
+  class RecordingTapeWriteTask: public DataConsumer {
+  public:
+    struct ReceivedBlock {
+      int fileBlock;
+      bool failed;
+      bool cancelled;
+      std::string data;
+    };
+    RecordingTapeWriteTask(size_t blockCount, size_t blockSize): m_blockCount(blockCount) {
+      for (size_t i = 0; i < blockCount; i++) m_freeBlocks.push(new MemBlock(i, blockSize));
+    }
+    ~RecordingTapeWriteTask() {
+      while (m_freeBlocks.size()) delete m_freeBlocks.pop();
+    }
+    MemBlock * getFreeBlock() override {
+      return m_freeBlocks.pop();
+    }
+    void pushDataBlock(MemBlock *mb) override {
+      receivedBlocks.push_back({mb->m_fileBlock, mb->isFailed(), mb->isCanceled(),
+        std::string(reinterpret_cast<const char *>(mb->m_payload.get()), mb->m_payload.size())});
+      mb->reset();
+      m_freeBlocks.push(mb);
+    }
+    bool allBlocksBack() const {
+      return m_freeBlocks.size() == m_blockCount;
+    }
+    std::vector<ReceivedBlock> receivedBlocks;
+  private:
+    const size_t m_blockCount;
+    cta::threading::BlockingQueue<MemBlock*> m_freeBlocks;
+  };
+
+  const size_t c_asyncReadBlockSize = 1000;
+  const size_t c_asyncReadMaxRequests = 4;
+  const size_t c_asyncReadBlockCount = 11;
+
+  /**
+   * Runs a DiskReadTask on an OutOfOrderReadFile of 10.5 blocks, with 4 reads
+   * in flight
+   */
+  struct AsyncDiskReadTaskRun {
+    std::string content;
+    std::vector<RecordingTapeWriteTask::ReceivedBlock> receivedBlocks;
+    std::vector<size_t> completionOrder;
+    bool allBlocksBack;
+
+    AsyncDiskReadTaskRun(size_t failingRead) {
+      for (size_t i = 0; i < c_asyncReadBlockSize * 10 + c_asyncReadBlockSize / 2; i++) content.push_back('a' + i % 23);
+      cta::log::StringLogger log("dummy","castor_tape_tapeserver_daemon_DiskReadTaskAsync",cta::log::DEBUG);
+      cta::log::LogContext lc(log);
+      cta::threading::AtomicFlag flag;
+      TestingArchiveJob file;
+      file.archiveFile.fileSize = content.size();
+      file.srcURL = "fake://outOfOrderReadFile";
+      // More blocks than reads in flight, as the session guarantees.
+      RecordingTapeWriteTask rtwt(c_asyncReadMaxRequests + 2, c_asyncReadBlockSize);
+      castor::tape::tapeserver::daemon::DiskReadTask drt(rtwt, &file, c_asyncReadBlockCount, flag);
+      cta::disk::RadosStriperPool striperPool;
+      OutOfOrderReadFileFactory fileFactory(striperPool, content, c_asyncReadMaxRequests, failingRead);
+      castor::messages::TapeserverProxyDummy tspd;
+      cta::TapeMountDummy tmd;
+      MockMigrationWatchDog mmwd(1.0, 1.0, tspd, tmd, "", lc);
+      drt.execute(lc, fileFactory, mmwd, 0);
+      receivedBlocks = rtwt.receivedBlocks;
+      completionOrder = fileFactory.completionOrder;
+      allBlocksBack = rtwt.allBlocksBack();
+    }
+  };
+
+  TEST(castor_tape_tapeserver_daemon, DiskReadTaskAsyncReadsOutOfOrder){
+    AsyncDiskReadTaskRun run(std::numeric_limits<size_t>::max());
+    // The reads completed out of order...
+    ASSERT_EQ(c_asyncReadBlockCount, run.completionOrder.size());
+    std::vector<size_t> sortedCompletionOrder(run.completionOrder);
+    std::sort(sortedCompletionOrder.begin(), sortedCompletionOrder.end());
+    ASSERT_NE(sortedCompletionOrder, run.completionOrder);
+    // ...but the blocks were handed over in the order of the file.
+    ASSERT_EQ(c_asyncReadBlockCount, run.receivedBlocks.size());
+    std::string receivedContent;
+    for (size_t i = 0; i < run.receivedBlocks.size(); i++) {
+      ASSERT_EQ((int)i, run.receivedBlocks[i].fileBlock);
+      ASSERT_FALSE(run.receivedBlocks[i].failed);
+      ASSERT_FALSE(run.receivedBlocks[i].cancelled);
+      receivedContent += run.receivedBlocks[i].data;
+    }
+    ASSERT_EQ(run.content, receivedContent);
+    ASSERT_TRUE(run.allBlocksBack);
+  }
+
+  TEST(castor_tape_tapeserver_daemon, DiskReadTaskAsyncReadFailure){
+    // Block 5 fails while the reads of blocks 6 to 8 are in flight.
+    const size_t failingRead = 5;
+    AsyncDiskReadTaskRun run(failingRead);
+    // The tape write task gets exactly one block per block of the file: the
+    // good ones, the failed one, then the cancelled ones.
+    ASSERT_EQ(c_asyncReadBlockCount, run.receivedBlocks.size());
+    size_t goodBlocks = 0, failedBlocks = 0, cancelledBlocks = 0;
+    for (size_t i = 0; i < run.receivedBlocks.size(); i++) {
+      auto & block = run.receivedBlocks[i];
+      if (i < failingRead) {
+        ASSERT_EQ((int)i, block.fileBlock);
+        ASSERT_EQ(run.content.substr(i * c_asyncReadBlockSize, c_asyncReadBlockSize), block.data);
+      }
+      if (block.failed) {
+        ASSERT_EQ(failingRead, i);
+        failedBlocks++;
+      } else if (block.cancelled) {
+        cancelledBlocks++;
+      } else {
+        goodBlocks++;
+      }
+    }
+    ASSERT_EQ(failingRead, goodBlocks);
+    ASSERT_EQ(1U, failedBlocks);
+    ASSERT_EQ(c_asyncReadBlockCount - failingRead - 1, cancelledBlocks);
+    // Every memory block went back to the pool: none is left with a read in flight.
+    ASSERT_TRUE(run.allBlocksBack);
+  }
 }
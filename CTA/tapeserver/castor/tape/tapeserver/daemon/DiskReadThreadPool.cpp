@@ -31,9 +31,11 @@ namespace daemon {
 //------------------------------------------------------------------------------
 DiskReadThreadPool::DiskReadThreadPool(int nbThread, uint64_t maxFilesReq,uint64_t maxBytesReq,
     castor::tape::tapeserver::daemon::MigrationWatchDog & migrationWatchDog,
-    cta::log::LogContext lc, const std::string & xrootPrivateKeyPath, uint16_t xrootTimeout) : 
+    cta::log::LogContext lc, const std::string & xrootPrivateKeyPath, uint16_t xrootTimeout,
+    uint32_t xrootAsyncRequests) : 
     m_xrootPrivateKeyPath(xrootPrivateKeyPath),
     m_xrootTimeout(xrootTimeout),
+    m_xrootAsyncRequests(xrootAsyncRequests),
     m_watchdog(migrationWatchDog),
     m_lc(lc),m_maxFilesReq(maxFilesReq),
     m_maxBytesReq(maxBytesReq), m_nbActiveThread(0) {
@@ -44,11 +44,12 @@ public:
    * @param maxBytesReq maximal number of bytes we might require
    *  within a single request a single request to the task injector
    * @param lc log context for logging purpose
+   * @param xrootAsyncRequests number of asynchronous xroot reads in flight per file
    */
   DiskReadThreadPool(int nbThread, uint64_t maxFilesReq,uint64_t maxBytesReq, 
           castor::tape::tapeserver::daemon::MigrationWatchDog & migrationWatchDog,
           cta::log::LogContext lc, const std::string & xrootPrivateKeyPath, 
-          uint16_t xrootTimeout);
+          uint16_t xrootTimeout, uint32_t xrootAsyncRequests = 1);
   
   /**
    * Destructor.
@@ -141,7 +142,7 @@ private:
     DiskReadWorkerThread(DiskReadThreadPool & parent):
     m_parent(parent),m_threadID(parent.m_nbActiveThread++),m_lc(parent.m_lc),
     m_diskFileFactory(parent.m_xrootPrivateKeyPath,
-      parent.m_xrootTimeout, parent.m_striperPool){
+      parent.m_xrootTimeout, parent.m_striperPool, parent.m_xrootAsyncRequests){
        cta::log::LogContext::ScopedParam param(m_lc, cta::log::Param("threadID", m_threadID));
        m_lc.log(cta::log::INFO,"DisReadThread created");
     }
@@ -194,6 +195,11 @@ private:
    */
   uint16_t m_xrootTimeout;
 
+  /**
+   * Parameter: number of asynchronous xroot reads or writes in flight per file
+   */
+  uint32_t m_xrootAsyncRequests;
+
   /**
    * A pool of rados striper connections, to be shared by all threads
    */
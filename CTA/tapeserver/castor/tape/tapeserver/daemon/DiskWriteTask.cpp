@@ -21,6 +21,8 @@
 #include "castor/tape/tapeserver/daemon/MemBlock.hpp"
 #include "common/Timer.hpp"
 
+#include <algorithm>
+
 namespace castor {
 namespace tape {
 namespace tapeserver {
@@ -30,8 +32,20 @@ namespace daemon {
 // constructor
 //------------------------------------------------------------------------------
 DiskWriteTask::DiskWriteTask(cta::RetrieveJob *retrieveJob, RecallMemoryManager& mm): 
+m_fifo(fifoCapacity(retrieveJob->archiveFile.fileSize, mm)),
 m_retrieveJob(retrieveJob),m_memManager(mm){}
 
+//------------------------------------------------------------------------------
+// DiskWriteTask::fifoCapacity
+//------------------------------------------------------------------------------
+size_t DiskWriteTask::fifoCapacity(const uint64_t fileSize, const RecallMemoryManager& mm) {
+  // The blocks of the file plus the end of file (or error) markers, but never more than the whole pool and its
+  // end marker. Should the tape blocks fill the memory blocks less than expected, the tape read task only waits
+  // for this task to pop.
+  const uint64_t fileBlocks = mm.blockSize() ? fileSize / mm.blockSize() + (fileSize % mm.blockSize() ? 1 : 0) : 0;
+  return std::min<uint64_t>(fileBlocks + 2, mm.totalNumberOfBlocks() + 1);
+}
+
 //------------------------------------------------------------------------------
 // DiskWriteTask::execute
 //------------------------------------------------------------------------------
@@ -55,28 +69,33 @@ bool DiskWriteTask::execute(RecallReportPacker& reporter,cta::log::LogContext&
   // prevent counting where error happened upstream.
   std::string currentErrorToCount = "";
   bool isVerifyOnly(false);
+  // Placeholder for the disk file. We will open it only
+  // after getting a first correct memory block. It outlives the try block,
+  // so that the writes still in flight on error complete before it is closed.
+  std::unique_ptr<cta::disk::WriteFile> writeFile;
   try{
     currentErrorToCount = "";
-    // Placeholder for the disk file. We will open it only
-    // after getting a first correct memory block.
-    std::unique_ptr<cta::disk::WriteFile> writeFile;
     
     int blockId  = 0;
     unsigned long checksum = Payload::zeroAdler32();
     while(1) {
       if(MemBlock* const mb = m_fifo.pop()) {
         m_stats.waitDataTime+=localTime.secs(cta::utils::Timer::resetCounter);
-        AutoReleaseBlock<RecallMemoryManager> releaser(mb,m_memManager);
         if(mb->isVerifyOnly()) {
+          AutoReleaseBlock<RecallMemoryManager> releaser(mb,m_memManager);
           // For verifyOnly, there is no disk file to write. Ignore the memory block and continue.
           isVerifyOnly = true;
           continue;
         } else if(mb->isCanceled()) {
+          AutoReleaseBlock<RecallMemoryManager> releaser(mb,m_memManager);
+          releaseInFlightWrites();
           // If the tape side got canceled, we report nothing and count
           // it as a success.
           lc.log(cta::log::DEBUG, "File transfer canceled");
           return true;
         }
+        // The block is released once written.
+        m_inFlightWrites.push_back({mb, nullptr});
         
         //will throw (thus exiting the loop) if something is wrong
         checkErrors(mb,blockId,lc);
@@ -96,15 +115,21 @@ bool DiskWriteTask::execute(RecallReportPacker& reporter,cta::log::LogContext&
             std::to_string((long long)threadID), writeFile->URL()));
         }
         
-        // Write the data.
+        // Start writing the data.
         currentErrorToCount = "Error_diskWrite";
         m_stats.dataVolume+=mb->m_payload.size();
         if (mb->m_payload.size())
-          mb->m_payload.write(*writeFile);
+          m_inFlightWrites.back().write = mb->m_payload.startWrite(*writeFile);
         m_stats.readWriteTime+=localTime.secs(cta::utils::Timer::resetCounter);
         
         checksum = mb->m_payload.adler32(checksum);
         m_stats.checksumingTime+=localTime.secs(cta::utils::Timer::resetCounter);
+
+        // Wait for the oldest writes, so that at most maxAsyncRequests() stay
+        // in flight while we wait for the next block.
+        while (m_inFlightWrites.size() >= writeFile->maxAsyncRequests())
+          completeOldestWrite();
+        m_stats.readWriteTime+=localTime.secs(cta::utils::Timer::resetCounter);
         currentErrorToCount = "";
        
         blockId++;
@@ -116,6 +141,10 @@ bool DiskWriteTask::execute(RecallReportPacker& reporter,cta::log::LogContext&
         //close has to be explicit, because it may throw. 
         //A close is done  in WriteFile's destructor, but it may lead to some 
         //silent data loss
+        currentErrorToCount = "Error_diskWrite";
+        while (m_inFlightWrites.size())
+          completeOldestWrite();
+        m_stats.readWriteTime+=localTime.secs(cta::utils::Timer::resetCounter);
         currentErrorToCount = "Error_diskCloseAfterWrite";
         // Set the checksum on the server (actually needed only for Rados striper
         // noop in other cases).
@@ -202,6 +231,7 @@ DiskWriteTask::~DiskWriteTask() {
 // DiskWriteTask::releaseAllBlock
 //------------------------------------------------------------------------------
 void DiskWriteTask::releaseAllBlock(){
+  releaseInFlightWrites();
   while(1){
     if(MemBlock* mb=m_fifo.pop())
       AutoReleaseBlock<RecallMemoryManager> release(mb,m_memManager);
@@ -210,6 +240,27 @@ void DiskWriteTask::releaseAllBlock(){
   }
 }
 
+//------------------------------------------------------------------------------
+// DiskWriteTask::completeOldestWrite
+//------------------------------------------------------------------------------
+void DiskWriteTask::completeOldestWrite(){
+  AutoReleaseBlock<RecallMemoryManager> release(m_inFlightWrites.front().block,m_memManager);
+  std::unique_ptr<cta::disk::WriteFile::AsyncWrite> write = std::move(m_inFlightWrites.front().write);
+  m_inFlightWrites.pop_front();
+  if (write) write->wait();
+}
+
+//------------------------------------------------------------------------------
+// DiskWriteTask::releaseInFlightWrites
+//------------------------------------------------------------------------------
+void DiskWriteTask::releaseInFlightWrites(){
+  while(m_inFlightWrites.size()){
+    try {
+      completeOldestWrite();
+    } catch (...) {}
+  }
+}
+
 //------------------------------------------------------------------------------
 // checkErrors
 //------------------------------------------------------------------------------  
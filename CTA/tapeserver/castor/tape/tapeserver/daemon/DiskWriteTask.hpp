@@ -25,6 +25,7 @@
 #include "castor/tape/tapeserver/daemon/DiskStats.hpp"
 #include "castor/tape/tapeserver/daemon/TaskWatchDog.hpp"
 
+#include <deque>
 #include <memory>
 
 namespace castor {
@@ -98,11 +99,45 @@ private:
    * in order to push them back into the memory manager
    */
   void releaseAllBlock();
+
+  /**
+   * Waits for the oldest write in flight and releases its block
+   */
+  void completeOldestWrite();
+
+  /**
+   * Waits for all the writes in flight, ignoring their result, and releases
+   * their blocks
+   */
+  void releaseInFlightWrites();
+
+  /**
+   * Capacity of the fifo of a file: its blocks and end marker, bounded by the
+   * memory pool
+   * @param fileSize the size of the file
+   * @param mm the memory manager the blocks come from
+   */
+  static size_t fifoCapacity(uint64_t fileSize, const RecallMemoryManager& mm);
+
+  /**
+   * A memory block being written to disk. The write is null until started.
+   */
+  struct InFlightWrite {
+    MemBlock * block;
+    std::unique_ptr<cta::disk::WriteFile::AsyncWrite> write;
+  };
+
+  /**
+   * The blocks being written, in the order of the file. There are at most
+   * WriteFile::maxAsyncRequests() of them between two blocks.
+   */
+  std::deque<InFlightWrite> m_inFlightWrites;
   
   /**
    * The fifo containing the memory blocks holding data to be written to disk
    */
-  cta::threading::BlockingQueue<MemBlock *> m_fifo;
+  cta::threading::BlockingRingQueue<MemBlock *,
+    cta::threading::SpscRing<MemBlock *> > m_fifo;
   
   /** 
    * All we need to know about the file we are currently recalling
@@ -30,7 +30,10 @@
 #include "scheduler/SchedulerDatabase.hpp"
 #include "scheduler/testingMocks/MockRetrieveMount.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <thread>
 #include <gtest/gtest.h>
 
 namespace unitTests{
@@ -111,6 +114,9 @@ namespace unitTests{
     cta::MockRetrieveMount mrm(*catalogue);
     std::unique_ptr<TestingRetrieveJob> fileToRecall(new TestingRetrieveJob(mrm));
     fileToRecall->retrieveRequest.archiveFileID = 1;
+    // All the blocks are pushed before the task runs: the file must be big
+    // enough for its fifo to hold them.
+    fileToRecall->archiveFile.fileSize = 7 * 100;
     fileToRecall->selectedCopyNb=1;
     cta::common::dataStructures::TapeFile tf;
     tf.copyNb = 1;
@@ -135,5 +141,197 @@ namespace unitTests{
     t.execute(report,lc,fileFactory,rwd, 0);
     ASSERT_EQ(1, report.failedJobs);
   }
+
+  /**
+   * A disk file written with several requests in flight, which complete out
+   * of order: waiting for a write completes all the writes in flight, the last
+   * started first. The data is only copied from the memory block when the
+   * write completes. One of the writes can be made to fail.
+   */
+  class OutOfOrderWriteFile: public WriteFile {
+  public:
+    /** What the test can check once the task has deleted the file */
+    struct Outcome {
+      std::string content;
+      size_t maxWritesInFlight = 0;
+      std::vector<size_t> completionOrder;
+      bool closed = false;
+    };
+    OutOfOrderWriteFile(Outcome & outcome, size_t maxAsyncRequests, size_t failingWrite):
+      m_outcome(outcome), m_maxAsyncRequests(maxAsyncRequests), m_failingWrite(failingWrite) {
+      m_URL = "fake://outOfOrderWriteFile";
+    }
+    void write(const void *data, const size_t size) override {
+      throw cta::exception::Exception("In OutOfOrderWriteFile::write(): unexpected synchronous write");
+    }
+    std::unique_ptr<AsyncWrite> asyncWrite(const void *data, const size_t size) override {
+      const size_t offset = m_requests.empty() ? 0 : m_requests.back().offset + m_requests.back().size;
+      m_requests.push_back({static_cast<const char *>(data), offset, size, false});
+      size_t writesInFlight = 0;
+      for (auto & r: m_requests) if (!r.completed) writesInFlight++;
+      m_outcome.maxWritesInFlight = std::max(m_outcome.maxWritesInFlight, writesInFlight);
+      return std::unique_ptr<AsyncWrite>(new OutOfOrderWrite(*this, m_requests.size() - 1));
+    }
+    size_t maxAsyncRequests() const override { return m_maxAsyncRequests; }
+    void setChecksum(uint32_t checksum) override {}
+    void close() override { m_outcome.closed = true; }
+  private:
+    struct Request {
+      const char * data;
+      size_t offset;
+      size_t size;
+      bool completed;
+    };
+    class OutOfOrderWrite: public AsyncWrite {
+    public:
+      OutOfOrderWrite(OutOfOrderWriteFile & file, size_t index): m_file(file), m_index(index) {}
+      void wait() override {
+        m_file.completeAll();
+        if (m_index == m_file.m_failingWrite) {
+          throw cta::exception::Exception("In OutOfOrderWrite::wait(): injected write failure");
+        }
+      }
+    private:
+      OutOfOrderWriteFile & m_file;
+      const size_t m_index;
+    };
+    void completeAll() {
+      for (size_t i = m_requests.size(); i > 0; i--) {
+        auto & r = m_requests[i - 1];
+        if (r.completed) continue;
+        if (m_outcome.content.size() < r.offset + r.size) m_outcome.content.resize(r.offset + r.size);
+        m_outcome.content.replace(r.offset, r.size, r.data, r.size);
+        r.completed = true;
+        m_outcome.completionOrder.push_back(i - 1);
+      }
+    }
+    Outcome & m_outcome;
+    const size_t m_maxAsyncRequests;
+    const size_t m_failingWrite;
+    std::vector<Request> m_requests;
+  };
+
+  class OutOfOrderWriteFileFactory: public DiskFileFactory {
+  public:
+    OutOfOrderWriteFileFactory(cta::disk::RadosStriperPool & striperPool, size_t maxAsyncRequests,
+      size_t failingWrite): DiskFileFactory("", 0, striperPool), m_maxAsyncRequests(maxAsyncRequests),
+      m_failingWrite(failingWrite) {}
+    WriteFile * createWriteFile(const std::string & path) override {
+      return new OutOfOrderWriteFile(outcome, m_maxAsyncRequests, m_failingWrite);
+    }
+    OutOfOrderWriteFile::Outcome outcome;
+  private:
+    const size_t m_maxAsyncRequests;
+    const size_t m_failingWrite;
+  };
+
+  /**
+   * Serves a string as a disk file, to fill the memory blocks
+   */
+  class StringReadFile: public ReadFile {
+  public:
+    StringReadFile(const std::string & content): m_content(content) {}
+    size_t size() const override { return m_content.size(); }
+    size_t read(void *data, const size_t size) const override {
+      const size_t copied = m_content.copy(static_cast<char *>(data), size, m_offset);
+      m_offset += copied;
+      return copied;
+    }
+  private:
+    const std::string m_content;
+    mutable size_t m_offset = 0;
+  };
+
+  const size_t c_asyncWriteBlockSize = 1000;
+  const size_t c_asyncWriteMaxRequests = 3;
+  const size_t c_asyncWriteBlockCount = 10;
+
+  /**
+   * Runs a DiskWriteTask writing an OutOfOrderWriteFile of 9.5 blocks with 3
+   * writes in flight. A separate thread plays the tape read task with a pool
+   * of 4 memory blocks, so a block released before its write completes gets
+   * overwritten.
+   */
+  struct AsyncDiskWriteTaskRun {
+    std::string content;
+    OutOfOrderWriteFile::Outcome outcome;
+    bool taskSucceeded;
+    int completeJobs;
+    int failedJobs;
+    bool allBlocksBack;
+
+    AsyncDiskWriteTaskRun(size_t failingWrite) {
+      for (size_t i = 0; i < c_asyncWriteBlockSize * 9 + c_asyncWriteBlockSize / 2; i++) content.push_back('a' + i % 23);
+      cta::log::StringLogger log("dummy","castor_tape_tapeserver_daemon_DiskWriteTaskAsync",cta::log::DEBUG);
+      cta::log::LogContext lc(log);
+      std::unique_ptr<cta::SchedulerDatabase::RetrieveMount> dbrm(new TestingDatabaseRetrieveMount());
+      std::unique_ptr<cta::catalogue::Catalogue> catalogue(new cta::catalogue::DummyCatalogue);
+      TestingRetrieveMount trm(*catalogue, std::move(dbrm));
+      MockRecallReportPacker report(&trm,lc);
+      RecallMemoryManager mm(c_asyncWriteMaxRequests + 1, c_asyncWriteBlockSize, lc);
+      cta::disk::RadosStriperPool striperPool;
+      OutOfOrderWriteFileFactory fileFactory(striperPool, c_asyncWriteMaxRequests, failingWrite);
+
+      cta::MockRetrieveMount mrm(*catalogue);
+      std::unique_ptr<TestingRetrieveJob> fileToRecall(new TestingRetrieveJob(mrm));
+      fileToRecall->retrieveRequest.archiveFileID = 1;
+      fileToRecall->retrieveRequest.dstURL = "fake://outOfOrderWriteFile";
+      fileToRecall->archiveFile.fileSize = content.size();
+      fileToRecall->selectedCopyNb=1;
+      cta::common::dataStructures::TapeFile tf;
+      tf.copyNb = 1;
+      fileToRecall->archiveFile.tapeFiles.push_back(tf);
+      DiskWriteTask t(fileToRecall.release(),mm);
+
+      std::thread tapeRead([&](){
+        StringReadFile source(content);
+        for (size_t i = 0; i < c_asyncWriteBlockCount; i++) {
+          MemBlock* mb=mm.getFreeBlock();
+          mb->m_fileid=1;
+          mb->m_fileBlock=i;
+          mb->m_payload.read(source);
+          t.pushDataBlock(mb);
+        }
+        t.pushDataBlock(NULL);
+      });
+      castor::messages::TapeserverProxyDummy tspd;
+      cta::TapeMountDummy tmd;
+      RecallWatchDog rwd(1,1,tspd,tmd,"", lc);
+      taskSucceeded = t.execute(report,lc,fileFactory,rwd, 0);
+      tapeRead.join();
+      outcome = fileFactory.outcome;
+      completeJobs = report.completeJobs;
+      failedJobs = report.failedJobs;
+      allBlocksBack = mm.areBlocksAllBack();
+    }
+  };
+
+  TEST(castor_tape_tapeserver_daemon, DiskWriteTaskAsyncWritesOutOfOrder){
+    AsyncDiskWriteTaskRun run(std::numeric_limits<size_t>::max());
+    ASSERT_TRUE(run.taskSucceeded);
+    ASSERT_EQ(1, run.completeJobs);
+    // The writes were pipelined up to the limit, and completed out of order...
+    ASSERT_EQ(c_asyncWriteMaxRequests, run.outcome.maxWritesInFlight);
+    ASSERT_EQ(c_asyncWriteBlockCount, run.outcome.completionOrder.size());
+    std::vector<size_t> sortedCompletionOrder(run.outcome.completionOrder);
+    std::sort(sortedCompletionOrder.begin(), sortedCompletionOrder.end());
+    ASSERT_NE(sortedCompletionOrder, run.outcome.completionOrder);
+    // ...no block was reused before its write completed, and the file was
+    // closed after the last one.
+    ASSERT_EQ(run.content, run.outcome.content);
+    ASSERT_TRUE(run.outcome.closed);
+    ASSERT_TRUE(run.allBlocksBack);
+  }
+
+  TEST(castor_tape_tapeserver_daemon, DiskWriteTaskAsyncWriteFailure){
+    // Block 4 fails while the write of block 5 is in flight.
+    AsyncDiskWriteTaskRun run(4);
+    ASSERT_FALSE(run.taskSucceeded);
+    ASSERT_EQ(0, run.completeJobs);
+    ASSERT_EQ(1, run.failedJobs);
+    ASSERT_FALSE(run.outcome.closed);
+    // The blocks in flight and the ones still to come were all released.
+    ASSERT_TRUE(run.allBlocksBack);
+  }
 }
 
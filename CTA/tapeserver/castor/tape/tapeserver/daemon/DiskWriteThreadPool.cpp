@@ -35,9 +35,11 @@ DiskWriteThreadPool::DiskWriteThreadPool(int nbThread,
   RecallWatchDog& recallWatchDog,
   cta::log::LogContext lc,
   const std::string & xrootPrivateKeyPath,
-  uint16_t xrootTimeout):
+  uint16_t xrootTimeout,
+  uint32_t xrootAsyncRequests):
   m_xrootPrivateKeyPath(xrootPrivateKeyPath),
   m_xrootTimeout(xrootTimeout),
+  m_xrootAsyncRequests(xrootAsyncRequests),
   m_reporter(report),m_watchdog(recallWatchDog),m_lc(lc)
 {
   m_lc.pushOrReplace(cta::log::Param("threadCount", nbThread));
@@ -52,13 +52,15 @@ public:
    * construction time (and then copied further for each thread). There will
    * be no side effect on the caller's logs.
    * @param xrootPrivateKeyPath the path to the xroot private key file.
+   * @param xrootAsyncRequests number of asynchronous xroot writes in flight per file
    */
   DiskWriteThreadPool(int nbThread, 
           RecallReportPacker& reportPacker,
           RecallWatchDog& recallWatchDog,
           cta::log::LogContext lc,
           const std::string & xrootPrivateKeyPath,
-          uint16_t xrootTimeout);
+          uint16_t xrootTimeout,
+          uint32_t xrootAsyncRequests = 1);
   /**
    * Destructor: we suppose the threads are no running (waitThreads() should
    * be called befor destruction unless the threads were not started.
@@ -103,7 +105,7 @@ private:
     m_threadID(manager.m_nbActiveThread++),m_parentThreadPool(manager),
     m_lc(m_parentThreadPool.m_lc), 
     m_diskFileFactory(manager.m_xrootPrivateKeyPath, 
-      manager.m_xrootTimeout, manager.m_striperPool)
+      manager.m_xrootTimeout, manager.m_striperPool, manager.m_xrootAsyncRequests)
     {
       // This thread Id will remain for the rest of the thread's lifetime (and 
       // also context's lifetime) so ne need for a scope.
@@ -183,6 +185,11 @@ protected:
    */
   uint16_t m_xrootTimeout;
 
+  /**
+   * Parameter: number of asynchronous xroot reads or writes in flight per file
+   */
+  uint32_t m_xrootAsyncRequests;
+
   /**
    * A pool of rados striper connections, to be shared by all threads
    */
@@ -86,6 +86,17 @@ public:
   m_memoryBlockId(id),m_payload(capacity){
     reset();
   }
+
+  /**
+   * Constructor with an externally managed buffer
+   * @param id the block ID for its whole life
+   * @param capacity the capacity (in byte) of the embed payload
+   * @param buffer the payload buffer (see MemBlockArena)
+   */
+  MemBlock(const int id, const size_t capacity, unsigned char* buffer) :
+  m_memoryBlockId(id),m_payload(buffer, capacity){
+    reset();
+  }
   
   /**
    * Get the error message from the context, 
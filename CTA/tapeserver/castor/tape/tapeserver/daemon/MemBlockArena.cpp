@@ -0,0 +1,81 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2003-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "castor/tape/tapeserver/daemon/MemBlockArena.hpp"
+#include "common/exception/MemException.hpp"
+
+#include <sys/mman.h>
+#include <sstream>
+
+namespace castor {
+namespace tape {
+namespace tapeserver {
+namespace daemon {
+
+namespace {
+  size_t roundUp(const size_t value, const size_t multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+MemBlockArena::MemBlockArena(const size_t numberOfBlocks, const size_t blockSize,
+  const Options & options):
+  m_base(nullptr), m_blockStride(roundUp(blockSize ? blockSize : 1, BLOCK_ALIGNMENT)),
+  m_mappedSize(0), m_hugeTLB(false), m_locked(false) {
+  const size_t requiredSize = m_blockStride * (numberOfBlocks ? numberOfBlocks : 1);
+  void * mapping = MAP_FAILED;
+  if (options.useHugePages) {
+    // Explicit huge pages first. This only succeeds if the administrator
+    // reserved enough of them (vm.nr_hugepages).
+    m_mappedSize = roundUp(requiredSize, HUGE_PAGE_SIZE);
+    mapping = ::mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    m_hugeTLB = (MAP_FAILED != mapping);
+  }
+  if (MAP_FAILED == mapping) {
+    m_mappedSize = requiredSize;
+    mapping = ::mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == mapping) {
+      std::stringstream err;
+      err << "In MemBlockArena::MemBlockArena(): failed to allocate " << m_mappedSize
+          << " bytes for " << numberOfBlocks << " memory blocks";
+      throw cta::exception::MemException(err.str());
+    }
+    if (options.useHugePages) {
+      // Fall back to transparent huge pages. Failure is not an error.
+      ::madvise(mapping, m_mappedSize, MADV_HUGEPAGE);
+    }
+  }
+  m_base = static_cast<unsigned char *>(mapping);
+  if (options.lockMemory) {
+    m_locked = (0 == ::mlock(m_base, m_mappedSize));
+  }
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+//------------------------------------------------------------------------------
+MemBlockArena::~MemBlockArena() {
+  if (m_locked) ::munlock(m_base, m_mappedSize);
+  ::munmap(m_base, m_mappedSize);
+}
+
+}}}}
@@ -0,0 +1,102 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2003-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace castor {
+namespace tape {
+namespace tapeserver {
+namespace daemon {
+
+/**
+ * A single memory region from which all the payloads of a session's memory
+ * blocks are carved. The region is allocated once, with one mmap(), which
+ * avoids thousands of individual allocations at session start, and every
+ * block starts on a page boundary so the buffers can be used with O_DIRECT.
+ * Optionally, the region is backed by huge pages (limiting TLB misses on
+ * multi-GB buffer sets) and locked in memory.
+ */
+class MemBlockArena {
+public:
+  /**
+   * Allocation options
+   */
+  struct Options {
+    /** Try to back the arena with huge pages (explicit, then transparent) */
+    bool useHugePages = false;
+    /** Lock the arena in memory (requires CAP_IPC_LOCK or a large enough RLIMIT_MEMLOCK) */
+    bool lockMemory = false;
+  };
+
+  /**
+   * Constructor: allocates the whole arena. Huge pages and memory locking are
+   * best effort: the arena falls back to normal, unlocked pages if they are
+   * not available. Throws a cta::exception::MemException if the memory cannot
+   * be allocated at all.
+   * @param numberOfBlocks number of blocks in the arena
+   * @param blockSize capacity of each block in bytes
+   * @param options allocation options
+   */
+  MemBlockArena(const size_t numberOfBlocks, const size_t blockSize, const Options & options);
+
+  /**
+   * Destructor: releases the arena. No block may be in use anymore.
+   */
+  ~MemBlockArena();
+
+  /**
+   * Returns the buffer of the given block
+   * @param blockIndex index of the block, in [0, numberOfBlocks)
+   */
+  unsigned char * block(const size_t blockIndex) const {
+    return m_base + blockIndex * m_blockStride;
+  }
+
+  /** Total size of the mapping in bytes */
+  size_t totalSize() const { return m_mappedSize; }
+
+  /** True if the arena is backed by explicit huge pages (MAP_HUGETLB) */
+  bool usesHugeTLB() const { return m_hugeTLB; }
+
+  /** True if the arena is locked in memory */
+  bool isLocked() const { return m_locked; }
+
+  /** Alignment of each block (and of the arena itself) */
+  static const size_t BLOCK_ALIGNMENT = 4096;
+
+  /** Size of an explicit huge page */
+  static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+private:
+  MemBlockArena(const MemBlockArena &) = delete;
+  MemBlockArena & operator=(const MemBlockArena &) = delete;
+
+  /** Start of the mapping */
+  unsigned char * m_base;
+  /** Distance in bytes between the starts of two consecutive blocks */
+  size_t m_blockStride;
+  /** Size of the mapping */
+  size_t m_mappedSize;
+  /** Whether the mapping uses MAP_HUGETLB */
+  bool m_hugeTLB;
+  /** Whether the mapping is mlock()ed */
+  bool m_locked;
+};
+
+}}}}
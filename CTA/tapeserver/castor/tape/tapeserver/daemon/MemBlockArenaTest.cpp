@@ -0,0 +1,54 @@
+/*
+ * @project        The CERN Tape Archive (CTA)
+ * @copyright      Copyright(C) 2003-2021 CERN
+ * @license        This program is free software: you can redistribute it and/or modify
+ *                 it under the terms of the GNU General Public License as published by
+ *                 the Free Software Foundation, either version 3 of the License, or
+ *                 (at your option) any later version.
+ *
+ *                 This program is distributed in the hope that it will be useful,
+ *                 but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *                 MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *                 GNU General Public License for more details.
+ *
+ *                 You should have received a copy of the GNU General Public License
+ *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "castor/tape/tapeserver/daemon/MemBlockArena.hpp"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace unitTests {
+
+TEST(castor_tape_tapeserver_daemon, MemBlockArenaBlocksAreAlignedAndDistinct) {
+  using castor::tape::tapeserver::daemon::MemBlockArena;
+  const size_t blockSize = 1000;
+  const size_t blockCount = 10;
+  MemBlockArena arena(blockCount, blockSize, MemBlockArena::Options());
+  ASSERT_FALSE(arena.isLocked());
+  ASSERT_GE(arena.totalSize(), blockCount * blockSize);
+  for (size_t i = 0; i < blockCount; i++) {
+    ASSERT_EQ(0U, reinterpret_cast<uintptr_t>(arena.block(i)) % MemBlockArena::BLOCK_ALIGNMENT);
+    memset(arena.block(i), i, blockSize);
+  }
+  for (size_t i = 0; i < blockCount; i++) {
+    ASSERT_EQ(i, arena.block(i)[0]);
+    ASSERT_EQ(i, arena.block(i)[blockSize - 1]);
+  }
+}
+
+TEST(castor_tape_tapeserver_daemon, MemBlockArenaHugePagesFallBack) {
+  using castor::tape::tapeserver::daemon::MemBlockArena;
+  // Whether or not huge pages are reserved on the test machine, the allocation
+  // must succeed and be usable.
+  MemBlockArena::Options options;
+  options.useHugePages = true;
+  MemBlockArena arena(3, 5 * 1024 * 1024, options);
+  memset(arena.block(2), 0xAA, 5 * 1024 * 1024);
+  ASSERT_EQ(0xAA, arena.block(2)[5 * 1024 * 1024 - 1]);
+}
+
+} // namespace unitTests
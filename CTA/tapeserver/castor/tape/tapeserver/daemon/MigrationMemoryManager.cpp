@@ -28,17 +28,25 @@ namespace daemon {
 // Constructor
 //------------------------------------------------------------------------------
 MigrationMemoryManager::MigrationMemoryManager(const size_t numberOfBlocks, 
-    const size_t blockSize, cta::log::LogContext lc)
+    const size_t blockSize, cta::log::LogContext lc,
+    const MemBlockArena::Options & arenaOptions)
 :
-    m_blockCapacity(blockSize), m_totalNumberOfBlocks(0),
+    m_blockCapacity(blockSize), m_arena(numberOfBlocks, blockSize, arenaOptions),
+    m_totalNumberOfBlocks(0),
     m_totalMemoryAllocated(0), m_blocksProvided(0), 
-    m_blocksReturned(0), m_lc(lc)
+    m_blocksReturned(0), m_freeBlocks(numberOfBlocks), m_lc(lc)
 {
   for (size_t i = 0; i < numberOfBlocks; i++) {
-    m_freeBlocks.push(new MemBlock(i, blockSize));
+    m_freeBlocks.push(new MemBlock(i, blockSize, m_arena.block(i)));
     m_totalNumberOfBlocks++;
     m_totalMemoryAllocated += blockSize;
   }
+  cta::log::ScopedParamContainer params(m_lc);
+  params.add("blockCount", numberOfBlocks)
+        .add("blockSize", blockSize)
+        .add("arenaSize", m_arena.totalSize())
+        .add("hugeTLB", m_arena.usesHugeTLB())
+        .add("memoryLocked", m_arena.isLocked());
   m_lc.log(cta::log::INFO, "MigrationMemoryManager: all blocks have been created");
 }
 
@@ -51,7 +59,7 @@ MigrationMemoryManager::~MigrationMemoryManager() throw() {
   // castor::server::Thread::wait();
   // we expect to be called after all users are finished. Just "free"
   // the memory blocks we still have.
-  cta::threading::BlockingQueue<MemBlock*>::valueRemainingPair ret;
+  cta::threading::BlockingRingQueue<MemBlock*>::valueRemainingPair ret;
   do {
     ret = m_freeBlocks.popGetSize();
     delete ret.value;
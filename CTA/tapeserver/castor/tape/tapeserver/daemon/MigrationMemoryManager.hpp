@@ -18,8 +18,10 @@
 #pragma once
 
 #include "common/threading/BlockingQueue.hpp"
+#include "common/threading/RingQueue.hpp"
 #include "common/threading/Thread.hpp"
 #include "common/log/LogContext.hpp"
+#include "castor/tape/tapeserver/daemon/MemBlockArena.hpp"
 
 namespace castor {
 namespace exception {
@@ -45,16 +47,23 @@ public:
    * Constructor
    * @param numberOfBlocks: number of blocks to allocate
    * @param blockSize: size of each block
+   * @param arenaOptions: allocation options for the memory backing the blocks
    */
   MigrationMemoryManager(const size_t numberOfBlocks, const size_t blockSize, 
-          cta::log::LogContext lc) 
-          ;
+          cta::log::LogContext lc,
+          const MemBlockArena::Options & arenaOptions = MemBlockArena::Options());
   
   /**
    * 
    * @return the nominal capacity of one block 
    */
   size_t blockCapacity();
+
+  /**
+   * Total number of blocks managed (an upper bound of the number of blocks
+   * any client can hold at a time)
+   */
+  size_t totalNumberOfBlocks() const { return m_totalNumberOfBlocks; }
   
   /**
    * Are all sheep back to the farm?
@@ -98,6 +107,11 @@ private:
   
   
   const size_t m_blockCapacity;
+
+  /**
+   * The memory backing all the blocks
+   */
+  MemBlockArena m_arena;
   
   /**
    * Total number of allocated memory blocks
@@ -127,7 +141,7 @@ private:
   /**
    * Container for the free blocks
    */
-  cta::threading::BlockingQueue<MemBlock *> m_freeBlocks;
+  cta::threading::BlockingRingQueue<MemBlock *> m_freeBlocks;
   
   /**
    * The client queue: we will feed them as soon as blocks
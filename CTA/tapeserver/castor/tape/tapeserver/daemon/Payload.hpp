@@ -15,6 +15,7 @@
  *                 along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <zlib.h>
+#include "common/checksum/Adler32.hpp"
 #include "disk/DiskFile.hpp"
 #include "castor/tape/tapeserver/file/File.hpp"
 #include "common/exception/MemException.hpp"
@@ -37,14 +38,25 @@ class Payload
   Payload& operator=(const Payload&);
 public:
   Payload(size_t capacity):
-  m_data(new (std::nothrow) unsigned char[capacity]),m_totalCapacity(capacity),m_size(0) {
+  m_data(new (std::nothrow) unsigned char[capacity]),m_totalCapacity(capacity),m_size(0),
+  m_blockAdler32(0),m_blockAdler32Valid(false),m_ownsData(true) {
     if(NULL == m_data) {
       throw cta::exception::MemException("Failed to allocate memory for a new MemBlock!");
     }
   }
+
+  /**
+   * Constructor using an externally managed buffer (typically carved from a
+   * MemBlockArena). The buffer must outlive the payload.
+   * @param buffer the buffer, of at least capacity bytes
+   * @param capacity Size of the payload buffer in bytes
+   */
+  Payload(unsigned char* buffer, size_t capacity):
+  m_data(buffer),m_totalCapacity(capacity),m_size(0),
+  m_blockAdler32(0),m_blockAdler32Valid(false),m_ownsData(false) {}
   
   ~Payload(){
-    delete[] m_data;
+    if(m_ownsData) delete[] m_data;
   }
   
   /** Amount of data present in the payload buffer */
@@ -55,6 +67,7 @@ public:
   /** Reset the internal counters of the payload */
   void reset() {
     m_size = 0;
+    m_blockAdler32Valid = false;
   }
   
   /** Remaining free space in the payload buffer */
@@ -83,6 +96,28 @@ public:
    */
   size_t read(cta::disk::ReadFile& from){
     m_size = from.read(m_data,m_totalCapacity);
+    m_blockAdler32Valid = false;
+    return m_size;
+  }
+
+  /**
+   * Starts reading the whole buffer from a diskFile::ReadFile object. The
+   * read is complete after completeRead().
+   * @param from reference to the diskFile::ReadFile
+   * @return the read in flight
+   */
+  std::unique_ptr<cta::disk::ReadFile::AsyncRead> startRead(cta::disk::ReadFile& from){
+    m_size = 0;
+    m_blockAdler32Valid = false;
+    return from.asyncRead(m_data,m_totalCapacity);
+  }
+
+  /**
+   * Completes a read started with startRead()
+   * @param read the read in flight
+   */
+  size_t completeRead(cta::disk::ReadFile::AsyncRead& read){
+    m_size = read.wait();
     return m_size;
   }
 
@@ -107,6 +142,7 @@ public:
       throw cta::exception::EndOfFile("In castor::tape::tapeserver::daemon::Payload::append: reached end of file");
     }
     m_size += readSize;
+    m_blockAdler32Valid = false;
     return  from.getBlockSize() <= remainingFreeSpace();
   }
   
@@ -117,6 +153,16 @@ public:
   void write(cta::disk::WriteFile& to){
     to.write(m_data,m_size);
   }
+
+  /**
+   * Starts writing the complete buffer to a diskFile::WriteFile. The buffer
+   * must not be modified or released before the write is complete.
+   * @param to reference to the diskFile::WriteFile
+   * @return the write in flight
+   */
+  std::unique_ptr<cta::disk::WriteFile::AsyncWrite> startWrite(cta::disk::WriteFile& to){
+    return to.asyncWrite(m_data,m_size);
+  }
   
   /**
    * Write the complete buffer to a tapeFile::WriteFile, tape block by
@@ -153,7 +199,32 @@ public:
     * @return the updated checksum
     */
   unsigned long  adler32(unsigned long previous){
-    return ::adler32(previous,m_data,m_size);
+    return cta::checksum::adler32Update(previous,m_data,m_size);
+  }
+
+  /**
+   * Compute the adler32 checksum of the data currently held, on its own, and
+   * keep it with the payload. This allows the producer thread (e.g. the disk
+   * read threads in a migration) to do the checksumming, leaving only a
+   * cheap combination to the consumer (see combineAdler32()).
+   */
+  void computeBlockAdler32(){
+    m_blockAdler32 = cta::checksum::adler32Update(cta::checksum::ADLER32_INIT,m_data,m_size);
+    m_blockAdler32Valid = true;
+  }
+
+  /**
+   * Update a running adler32 checksum with the data currently held. If the
+   * block checksum was already computed by computeBlockAdler32(), it is
+   * combined without going through the data again.
+   * @param previous The previous adler32 checksum from all previous datablock
+   * @return the updated checksum
+   */
+  unsigned long combineAdler32(unsigned long previous){
+    if (!m_blockAdler32Valid) {
+      return adler32(previous);
+    }
+    return cta::checksum::adler32Combine(previous,m_blockAdler32,m_size);
   }
   
   /**
@@ -166,6 +237,12 @@ private:
   unsigned char* m_data;
   size_t m_totalCapacity;
   size_t m_size;
+  /** Adler32 of the data held, as computed by computeBlockAdler32() */
+  uint32_t m_blockAdler32;
+  /** True if m_blockAdler32 matches the data currently held */
+  bool m_blockAdler32Valid;
+  /** True if m_data was allocated by (and should be freed with) the payload */
+  bool m_ownsData;
 };
 
 }}}}
@@ -27,10 +27,12 @@ namespace daemon {
 //------------------------------------------------------------------------------
 // Constructor
 //------------------------------------------------------------------------------
-RecallMemoryManager::RecallMemoryManager(const size_t numberOfBlocks, const size_t blockSize, cta::log::LogContext&  lc)
-: m_totalNumberOfBlocks(numberOfBlocks), m_lc(lc) {
+RecallMemoryManager::RecallMemoryManager(const size_t numberOfBlocks, const size_t blockSize, cta::log::LogContext&  lc,
+  const MemBlockArena::Options & arenaOptions)
+: m_totalNumberOfBlocks(numberOfBlocks), m_blockSize(blockSize), m_arena(numberOfBlocks, blockSize, arenaOptions),
+  m_freeBlocks(numberOfBlocks), m_lc(lc) {
   for (size_t i = 0; i < numberOfBlocks; i++) {
-    m_freeBlocks.push(new MemBlock(i, blockSize));
+    m_freeBlocks.push(new MemBlock(i, blockSize, m_arena.block(i)));
 
     //m_lc.pushOrReplace(cta::log::Param("blockId", i));
     //m_lc.log(cta::log::DEBUG, "RecallMemoryManager created a block");
@@ -38,7 +40,10 @@ RecallMemoryManager::RecallMemoryManager(const size_t numberOfBlocks, const size
   cta::log::ScopedParamContainer params(m_lc);
   params.add("blockCount", numberOfBlocks)
         .add("blockSize", blockSize)
-        .add("totalSize", numberOfBlocks*blockSize);
+        .add("totalSize", numberOfBlocks*blockSize)
+        .add("arenaSize", m_arena.totalSize())
+        .add("hugeTLB", m_arena.usesHugeTLB())
+        .add("memoryLocked", m_arena.isLocked());
   m_lc.log(cta::log::INFO, "RecallMemoryManager: all blocks have been created");
 }
 
@@ -52,7 +57,7 @@ RecallMemoryManager::~RecallMemoryManager() {
   // we expect to be called after all users are finished. Just "free"
   // the memory blocks we still have.
 
-  cta::threading::BlockingQueue<MemBlock*>::valueRemainingPair ret;
+  cta::threading::BlockingRingQueue<MemBlock*>::valueRemainingPair ret;
   do {
     ret = m_freeBlocks.popGetSize();
     delete ret.value;
@@ -17,9 +17,10 @@
 
 #pragma once
 
-#include "common/threading/BlockingQueue.hpp"
+#include "common/threading/RingQueue.hpp"
 #include "common/threading/Thread.hpp"
 #include "common/log/LogContext.hpp"
+#include "castor/tape/tapeserver/daemon/MemBlockArena.hpp"
 
 namespace castor {
 namespace exception {
@@ -42,15 +43,28 @@ public:
    * Constructor
    * @param numberOfBlocks: number of blocks to allocate
    * @param blockSize: size of each block
+   * @param arenaOptions: allocation options for the memory backing the blocks
    */
   RecallMemoryManager(const size_t numberOfBlocks, const size_t blockSize,
-          cta::log::LogContext&  lc);
+          cta::log::LogContext&  lc,
+          const MemBlockArena::Options & arenaOptions = MemBlockArena::Options());
   
   /**
    * Are all sheep back to the farm?
    * @return 
    */
   bool areBlocksAllBack() throw();
+
+  /**
+   * Total number of blocks managed (an upper bound of the number of blocks
+   * any client can hold at a time)
+   */
+  size_t totalNumberOfBlocks() const { return m_totalNumberOfBlocks; }
+  
+  /**
+   * Capacity of each block, in bytes
+   */
+  size_t blockSize() const { return m_blockSize; }
   
   /**
    * Takes back a block which has been released by one of the clients
@@ -75,10 +89,20 @@ private:
    */
   size_t m_totalNumberOfBlocks;
   
+  /**
+   * Capacity of each block
+   */
+  size_t m_blockSize;
+
+  /**
+   * The memory backing all the blocks
+   */
+  MemBlockArena m_arena;
+  
   /**
    * Container for the free blocks
    */
-  cta::threading::BlockingQueue<MemBlock*> m_freeBlocks;
+  cta::threading::BlockingRingQueue<MemBlock*> m_freeBlocks;
   
   /**
    * Logging. The class is not threaded, so it can be shared with its parent
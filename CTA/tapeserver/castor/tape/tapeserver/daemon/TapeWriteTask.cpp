@@ -39,7 +39,7 @@ namespace daemon {
 //------------------------------------------------------------------------------
   TapeWriteTask::TapeWriteTask(int blockCount, cta::ArchiveJob *archiveJob,
           MigrationMemoryManager& mm,cta::threading::AtomicFlag& errorFlag): 
-    m_archiveJob(archiveJob),m_memManager(mm), m_fifo(blockCount),
+    m_archiveJob(archiveJob),m_memManager(mm), m_fifo(blockCount, mm.totalNumberOfBlocks()),
     m_blockCount(blockCount),m_errorFlag(errorFlag), 
     m_archiveFile(m_archiveJob->archiveFile), m_tapeFile(m_archiveJob->tapeFile),
     m_srcURL(m_archiveJob->srcURL)
@@ -118,7 +118,8 @@ namespace daemon {
         //will throw (thus exiting the loop) if something is wrong
         checkErrors(mb,memBlockId,lc);
         
-        ckSum =  mb->m_payload.adler32(ckSum);
+        // The block checksum was computed by the disk read thread: combining is O(1)
+        ckSum =  mb->m_payload.combineAdler32(ckSum);
         m_taskStats.checksumingTime += timer.secs(cta::utils::Timer::resetCounter);
         currentErrorToCount = "Error_tapeWriteData";
         mb->m_payload.write(*output);
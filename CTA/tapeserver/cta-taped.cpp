@@ -16,6 +16,7 @@
  */
 
 #include "common/Configuration.hpp"
+#include "common/log/AsyncLogger.hpp"
 #include "common/log/FileLogger.hpp"
 #include "common/log/StdoutLogger.hpp"
 #include "common/log/SyslogLogger.hpp"
@@ -59,6 +60,8 @@ std::string gHelpString =
     "\t--foreground             or -f         \tRemain in the Foreground\n"
     "\t--stdout                 or -s         \tPrint logs to standard output. Required --foreground\n"
     "\t--log-to-file <log-file> or -l         \tLogs to a given file (instead of default syslog)\n"
+    "\t--log-format <format>    or -o         \tFormat of the logs: default or json\n"
+    "\t--async-logging          or -a         \tFormat and write the logs in a background thread\n"
     "\t--config <config-file>   or -c         \tConfiguration file\n"
     "\t--help                   or -h         \tPrint this help and exit\n";
 
@@ -219,6 +222,10 @@ int main(const int argc, char **const argv) {
     } else {
       logPtr.reset(new log::SyslogLogger(shortHostName, "cta-taped", log::DEBUG));
     }
+    if (commandLine->asyncLogging) {
+      logPtr.reset(new log::AsyncLogger(std::move(logPtr)));
+    }
+    logPtr->setLogFormat(commandLine->logFormat);
   } catch(exception::Exception &ex) {
     std::cerr <<
       "Failed to instantiate object representing CTA logging system: " <<
@@ -23,7 +23,7 @@
 namespace cta { namespace daemon {
 
 CommandLineParams::CommandLineParams(int argc, char** argv):
-  foreground(false), logToStdout(false), logToFile(false),
+  foreground(false), logToStdout(false), logToFile(false), logFormat("default"), asyncLogging(false),
   configFileLocation("/etc/cta/cta-taped.conf"),
   helpRequested(false){
   struct ::option longopts[] = {
@@ -33,6 +33,8 @@ CommandLineParams::CommandLineParams(int argc, char** argv):
     { "help", no_argument, NULL, 'h' },
     { "stdout", no_argument, NULL, 's' },
     { "log-to-file", required_argument, NULL, 'l' },
+    { "log-format", required_argument, NULL, 'o' },
+    { "async-logging", no_argument, NULL, 'a' },
     { NULL, 0, NULL, '\0' }
   };
 
@@ -42,7 +44,7 @@ CommandLineParams::CommandLineParams(int argc, char** argv):
   // Prevent getopt from printing out errors on stdout
   opterr=0;
   // We ask getopt to not reshuffle argv ('+')
-  while ((c = getopt_long(argc, argv, "+fsc:l:h", longopts, NULL)) != -1) {
+  while ((c = getopt_long(argc, argv, "+fsc:l:o:ah", longopts, NULL)) != -1) {
     switch (c) {
     case 'f':
       foreground = true;
@@ -60,6 +62,12 @@ CommandLineParams::CommandLineParams(int argc, char** argv):
       logFilePath = optarg;
       logToFile = true;
       break;
+    case 'o':
+      logFormat = optarg;
+      break;
+    case 'a':
+      asyncLogging = true;
+      break;
     default:
       break;
     }
@@ -78,6 +86,8 @@ std::list<cta::log::Param> CommandLineParams::toLogParams() const {
   ret.push_back({"logToStdout", logToStdout});
   ret.push_back({"logToFile", logToFile});
   ret.push_back({"logFilePath", logFilePath});
+  ret.push_back({"logFormat", logFormat});
+  ret.push_back({"asyncLogging", asyncLogging});
   ret.push_back({"configFileLocation", configFileLocation});
   ret.push_back({"helpRequested", helpRequested});
   return ret;
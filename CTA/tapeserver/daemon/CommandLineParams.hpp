@@ -34,6 +34,8 @@ struct CommandLineParams{
   bool logToStdout;                 ///< Log to stdout instead of syslog. Foreground is required.
   bool logToFile;                   ///< Log to file intead of syslog.
   std::string logFilePath;
+  std::string logFormat;            ///< Format of the log messages: default or json.
+  bool asyncLogging;                ///< Format and write the log messages in a background thread.
   std::string configFileLocation;   ///< Location of the configuration file. Defaults to /etc/cta/cta-taped.conf
   bool helpRequested;               ///< Help requested: will print out help and exit.
   std::list<cta::log::Param> toLogParams() const; ///< Convert the command line into set of parameters for logging.
@@ -899,6 +899,8 @@ int DriveHandler::runChild() {
     sleep(1);
     return castor::tape::tapeserver::daemon::Session::MARK_DRIVE_AS_DOWN;
   }
+  // The dry run and the actual mount decision share the same reading of the queues.
+  sched_db->setMountInfoSnapshotMaxAge(m_tapedConfig.mountInfoSnapshotMaxAge.value());
   lc.log(log::DEBUG, "In DriveHandler::runChild(): will create scheduler.");
   cta::Scheduler scheduler(*m_catalogue, *sched_db, m_tapedConfig.mountCriteria.value().maxFiles,
       m_tapedConfig.mountCriteria.value().maxBytes);
@@ -1061,12 +1063,16 @@ int DriveHandler::runChild() {
     dataTransferConfig.maxFilesBeforeFlush =
         m_tapedConfig.archiveFlushBytesFiles.value().maxFiles;
     dataTransferConfig.nbBufs = m_tapedConfig.bufferCount.value();
+    dataTransferConfig.useHugePages = m_tapedConfig.useHugePages.value() == "yes" ? true : false;
+    dataTransferConfig.lockMemoryBuffers = m_tapedConfig.lockMemoryBuffers.value() == "yes" ? true : false;
     dataTransferConfig.nbDiskThreads = m_tapedConfig.nbDiskThreads.value();
+    dataTransferConfig.xrootAsyncRequests = m_tapedConfig.xrootAsyncRequests.value();
     dataTransferConfig.useLbp = true;
     dataTransferConfig.useRAO = m_tapedConfig.useRAO.value() == "yes" ? true : false;
     dataTransferConfig.raoLtoAlgorithm = m_tapedConfig.raoLtoAlgorithm.value();
     dataTransferConfig.raoLtoAlgorithmOptions = m_tapedConfig.raoLtoOptions.value();
     dataTransferConfig.fetchEosFreeSpaceScript = m_tapedConfig.fetchEosFreeSpaceScript.value();
+    dataTransferConfig.diskSystemFreeSpaceCacheFile = m_tapedConfig.diskSystemFreeSpaceCacheFile.value();
     dataTransferConfig.tapeLoadTimeout = m_tapedConfig.tapeLoadTimeout.value();
     dataTransferConfig.xrootPrivateKey = "";
     dataTransferConfig.externalEncryptionKeyScript = m_tapedConfig.externalEncryptionKeyScript.value();
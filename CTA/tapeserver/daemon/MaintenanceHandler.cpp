@@ -25,13 +25,114 @@
 #include "common/make_unique.hpp"
 #include "scheduler/DiskReportRunner.hpp"
 #include "scheduler/RepackRequestManager.hpp"
+#include "common/threading/CondVar.hpp"
+#include "common/threading/Mutex.hpp"
+#include "common/threading/MutexLocker.hpp"
+#include "common/threading/Thread.hpp"
 
+#include <functional>
+#include <list>
 #include <signal.h>
 #include <sys/wait.h>
 #include <sys/prctl.h>
 
 namespace cta { namespace tape { namespace  daemon {
 
+namespace {
+
+/**
+ * A thread running one of the maintenance tasks in a loop, with its own period.
+ * A slow pass of a task only delays the next pass of that task. A pass lasting
+ * longer than the time budget of the task is reported.
+ */
+class MaintenanceTaskThread: public threading::Thread {
+public:
+  /**
+   * Constructor
+   *
+   * @param taskName The name of the task, for logging.
+   * @param pass A pass of the task.
+   * @param period The interval between the starts of two passes, in seconds.
+   * @param timeBudget The expected maximum duration of a pass, in seconds.
+   * @param logger The logger of the maintenance process.
+   */
+  MaintenanceTaskThread(const std::string & taskName, std::function<void(log::LogContext &)> pass,
+    const time_t period, const time_t timeBudget, log::Logger & logger):
+    m_taskName(taskName), m_pass(pass), m_period(period), m_timeBudget(timeBudget), m_logger(logger) {}
+
+  /**
+   * Asks the thread to exit after its current pass (if any).
+   */
+  void requestStop() {
+    threading::MutexLocker ml(m_mutex);
+    m_stopRequested = true;
+    m_stopRequestedCondVar.signal();
+  }
+
+  /**
+   * Returns true if the thread exited on an exception.
+   */
+  bool failed() {
+    threading::MutexLocker ml(m_mutex);
+    return m_failed;
+  }
+
+private:
+  void run() override {
+    // The log contexts are not thread safe: each task has its own.
+    log::LogContext lc(m_logger);
+    log::ScopedParamContainer params(lc);
+    params.add("maintenanceTask", m_taskName);
+    try {
+      while (true) {
+        utils::Timer t;
+        lc.log(log::DEBUG, "In MaintenanceTaskThread::run(): About to do a maintenance pass.");
+        m_pass(lc);
+        const double passTime = t.secs();
+        if (passTime > m_timeBudget) {
+          log::ScopedParamContainer budgetParams(lc);
+          budgetParams.add("passTime", passTime)
+                      .add("timeBudget", m_timeBudget);
+          lc.log(log::WARNING, "In MaintenanceTaskThread::run(): maintenance pass exceeded its time budget.");
+        }
+        threading::MutexLocker ml(m_mutex);
+        while (!m_stopRequested && t.secs() < m_period) {
+          m_stopRequestedCondVar.timedWait(ml, (m_period - t.secs()) * 1000 + 1);
+        }
+        if (m_stopRequested) return;
+      }
+    } catch(cta::exception::Exception & ex) {
+      {
+        log::ScopedParamContainer exParams(lc);
+        exParams.add("Message", ex.getMessageValue());
+        lc.log(log::ERR, "In MaintenanceTaskThread::run(): received an exception. Backtrace follows.");
+      }
+      lc.logBacktrace(log::ERR, ex.backtrace());
+    } catch(std::exception & ex) {
+      log::ScopedParamContainer exParams(lc);
+      exParams.add("Message", ex.what());
+      lc.log(log::ERR, "In MaintenanceTaskThread::run(): received a std::exception.");
+    } catch(...) {
+      lc.log(log::ERR, "In MaintenanceTaskThread::run(): received an unknown exception.");
+    }
+    threading::MutexLocker ml(m_mutex);
+    m_failed = true;
+  }
+
+  const std::string m_taskName;
+  std::function<void(log::LogContext &)> m_pass;
+  const time_t m_period;
+  const time_t m_timeBudget;
+  log::Logger & m_logger;
+  /** Protects the stop request and the failure state */
+  threading::Mutex m_mutex;
+  threading::CondVar m_stopRequestedCondVar;
+  bool m_stopRequested = false;
+  bool m_failed = false;
+};
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // constructor
 //------------------------------------------------------------------------------
@@ -265,12 +366,30 @@ void MaintenanceHandler::exceptionThrowingRunChild(){
   // fail likewise, so we just wait for shutdown signal (no feedback to main process).
   SchedulerDBInit_t sched_db_init("Maintenance", m_tapedConfig.backendPath.value(), m_processManager.logContext().logger());
 
+  // List the maintenance tasks first: the catalogue gets one connection per task.
+  // Their passes are bound once the catalogue and the scheduler are created.
+  struct MaintenanceTask {
+    std::string name;
+    time_t period;
+    time_t timeBudget;
+    std::function<void(log::LogContext &)> pass;
+  };
+  MaintenanceTask garbageCollectorTask{"GarbageCollector", s_garbageCollectorPeriod, s_garbageCollectorTimeBudget, nullptr};
+  MaintenanceTask diskReportRunnerTask{"DiskReportRunner", s_diskReportRunnerPeriod, s_diskReportRunnerTimeBudget, nullptr};
+  MaintenanceTask repackRequestManagerTask{"RepackRequestManager", s_repackRequestManagerPeriod,
+    s_repackRequestManagerTimeBudget, nullptr};
+  std::list<MaintenanceTask *> tasks{&garbageCollectorTask, &diskReportRunnerTask};
+  if(runRepackRequestManager()){
+    tasks.push_back(&repackRequestManagerTask);
+  }
+
   std::unique_ptr<cta::SchedulerDB_t> sched_db;
   std::unique_ptr<cta::catalogue::Catalogue> catalogue;
   std::unique_ptr<cta::Scheduler> scheduler;
   try {
     const cta::rdbms::Login catalogueLogin = cta::rdbms::Login::parseFile(m_tapedConfig.fileCatalogConfigFile.value());
-    const uint64_t nbConns = 1;
+    // One connection per maintenance task
+    const uint64_t nbConns = tasks.size();
     const uint64_t nbArchiveFileListingConns = 1;
     auto catalogueFactory = cta::catalogue::CatalogueFactoryFactory::create(m_processManager.logContext().logger(),
       catalogueLogin, nbConns, nbArchiveFileListingConns);
@@ -296,7 +415,7 @@ void MaintenanceHandler::exceptionThrowingRunChild(){
     throw ex;
   }
 
-  // Create the garbage collector and the disk reporter
+  // Create the garbage collector, the disk reporter and the repack request manager
   auto gc = sched_db_init.getGarbageCollector(*catalogue);
   DiskReportRunner diskReportRunner(*scheduler);
   RepackRequestManager repackRequestManager(*scheduler);
@@ -306,27 +425,43 @@ void MaintenanceHandler::exceptionThrowingRunChild(){
     "In MaintenanceHandler::exceptionThrowingRunChild(): Repack management is disabled. No repack-related operations will run on this tapeserver.");
   }
   
-  // Run the maintenance in a loop: garbage collector and disk reporter
+  // Run each maintenance task in its own thread, so that a long pass of one of
+  // them (e.g. a repack expansion) does not delay the others. The work is shared
+  // with the maintenance processes of the other tape servers through the object
+  // store: the queues are popped under lock and the garbage collector only
+  // handles the agents it could lock.
+  garbageCollectorTask.pass = [&gc](log::LogContext & lc) { gc.runOnePass(lc); };
+  diskReportRunnerTask.pass = [&diskReportRunner](log::LogContext & lc) { diskReportRunner.runOnePass(lc); };
+  repackRequestManagerTask.pass = [&repackRequestManager](log::LogContext & lc) { repackRequestManager.runOnePass(lc); };
+  log::Logger & logger = m_processManager.logContext().logger();
+  std::list<std::unique_ptr<MaintenanceTaskThread>> taskThreads;
+  for (auto task: tasks) {
+    taskThreads.emplace_back(new MaintenanceTaskThread(task->name, task->pass, task->period, task->timeBudget, logger));
+  }
+  std::list<MaintenanceTaskThread *> startedThreads;
+  bool taskFailed=false;
   try {
+    for (auto & taskThread: taskThreads) {
+      taskThread->start();
+      startedThreads.push_back(taskThread.get());
+    }
+    // Wait for the shutdown message, or for the failure of one of the tasks.
     server::SocketPair::pollMap pollList;
     pollList["0"]=m_socketPair.get();
     bool receivedMessage=false;
     do {
-      utils::Timer t;
-      m_processManager.logContext().log(log::DEBUG, 
-          "In MaintenanceHandler::exceptionThrowingRunChild(): About to do a maintenance pass.");
-      gc.runOnePass(m_processManager.logContext());
-      diskReportRunner.runOnePass(m_processManager.logContext());
-      if(runRepackRequestManager()){
-        repackRequestManager.runOnePass(m_processManager.logContext());
-      }
       try {
-        server::SocketPair::poll(pollList, s_pollInterval - t.secs(), server::SocketPair::Side::parent);
+        server::SocketPair::poll(pollList, s_pollInterval, server::SocketPair::Side::parent);
         receivedMessage=true;
       } catch (server::SocketPair::Timeout & ex) {}
-    } while (!receivedMessage);
-    m_processManager.logContext().log(log::INFO,
-        "In MaintenanceHandler::exceptionThrowingRunChild(): Received shutdown message. Exiting.");
+      for (auto taskThread: startedThreads) {
+        if (taskThread->failed()) taskFailed=true;
+      }
+    } while (!receivedMessage && !taskFailed);
+    if (receivedMessage) {
+      m_processManager.logContext().log(log::INFO,
+          "In MaintenanceHandler::exceptionThrowingRunChild(): Received shutdown message. Exiting.");
+    }
   } catch(cta::exception::Exception & ex) {
     {
       log::ScopedParamContainer params(m_processManager.logContext());
@@ -335,17 +470,24 @@ void MaintenanceHandler::exceptionThrowingRunChild(){
         "In MaintenanceHandler::exceptionThrowingRunChild(): received an exception. Backtrace follows.");
     }
     m_processManager.logContext().logBacktrace(log::ERR, ex.backtrace());
-    throw ex;
+    taskFailed=true;
   } catch(std::exception &ex) {
     log::ScopedParamContainer params(m_processManager.logContext());
     params.add("Message", ex.what());
-    m_processManager.logContext().log(log::ERR, 
+    m_processManager.logContext().log(log::ERR,
         "In MaintenanceHandler::exceptionThrowingRunChild(): received a std::exception.");
-    throw ex;
+    taskFailed=true;
   } catch(...) {
-    m_processManager.logContext().log(log::ERR, 
+    m_processManager.logContext().log(log::ERR,
         "In MaintenanceHandler::exceptionThrowingRunChild(): received an unknown exception.");
-    throw;
+    taskFailed=true;
+  }
+  // Let the tasks complete their current pass before exiting.
+  for (auto taskThread: startedThreads) taskThread->requestStop();
+  for (auto taskThread: startedThreads) taskThread->wait();
+  if (taskFailed) {
+    // Exit with an error: the maintenance process will be respawned.
+    throw exception::Exception("In MaintenanceHandler::exceptionThrowingRunChild(): a maintenance task failed.");
   }
 }
 
@@ -61,8 +61,15 @@ private:
   bool m_shutdownInProgress=false;
   /** A socketpair to ask the child process to gracefully shut down */
   std::unique_ptr<cta::server::SocketPair> m_socketPair;
-  /** The poll period for the garbage collector */
-  static const time_t s_pollInterval = 10;
+  /** The poll period for the shutdown message and the failure of the maintenance tasks */
+  static const time_t s_pollInterval = 1;
+  /** The periods and the time budgets of the maintenance tasks, in seconds */
+  static const time_t s_garbageCollectorPeriod = 10;
+  static const time_t s_garbageCollectorTimeBudget = 30;
+  static const time_t s_diskReportRunnerPeriod = 5;
+  static const time_t s_diskReportRunnerTimeBudget = 30;
+  static const time_t s_repackRequestManagerPeriod = 10;
+  static const time_t s_repackRequestManagerTimeBudget = 60;
 };
 
 }}} // namespace cta::tape::daemon
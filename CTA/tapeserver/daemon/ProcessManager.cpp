@@ -173,6 +173,8 @@ ProcessManager::RunPartStatus ProcessManager::runForkManagement() {
       cta::log::ScopedParamContainer params(m_logContext);
       params.add("SubprocessName", sp.handler->index);
       m_logContext.log(log::INFO, "Subprocess handler will fork");
+      // Write the pending log messages before they get duplicated in the child process.
+      m_logContext.logger().prepareForFork();
       auto newStatus = sp.handler->fork();
       switch (newStatus.forkState) {
       case SubprocessHandler::ForkState::child:
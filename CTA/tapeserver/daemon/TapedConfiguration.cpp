@@ -99,14 +99,18 @@ TapedConfiguration TapedConfiguration::createFromCtaConf(
   // Memory management
   ret.bufferSizeBytes.setFromConfigurationFile(cf, generalConfigPath);
   ret.bufferCount.setFromConfigurationFile(cf, generalConfigPath);
+  ret.useHugePages.setFromConfigurationFile(cf, generalConfigPath);
+  ret.lockMemoryBuffers.setFromConfigurationFile(cf, generalConfigPath);
   // Batched metadata access and tape write flush parameters
   ret.archiveFetchBytesFiles.setFromConfigurationFile(cf, generalConfigPath);
   ret.archiveFlushBytesFiles.setFromConfigurationFile(cf, generalConfigPath);
   ret.retrieveFetchBytesFiles.setFromConfigurationFile(cf, generalConfigPath);
   // Mount criteria
   ret.mountCriteria.setFromConfigurationFile(cf, generalConfigPath);
+  ret.mountInfoSnapshotMaxAge.setFromConfigurationFile(cf, generalConfigPath);
   // Disk file access parameters
   ret.nbDiskThreads.setFromConfigurationFile(cf, generalConfigPath);
+  ret.xrootAsyncRequests.setFromConfigurationFile(cf, generalConfigPath);
   //RAO
   ret.useRAO.setFromConfigurationFile(cf, generalConfigPath);
   ret.raoLtoAlgorithm.setFromConfigurationFile(cf,generalConfigPath);
@@ -125,6 +129,7 @@ TapedConfiguration TapedConfiguration::createFromCtaConf(
   ret.disableMaintenanceProcess.setFromConfigurationFile(cf,generalConfigPath);
   // Fetch EOS Free space script configuration
   ret.fetchEosFreeSpaceScript.setFromConfigurationFile(cf,generalConfigPath);
+  ret.diskSystemFreeSpaceCacheFile.setFromConfigurationFile(cf,generalConfigPath);
   // Timeout for tape load action
   ret.tapeLoadTimeout.setFromConfigurationFile(cf,generalConfigPath);
   // Extract drive list from tpconfig + parsed config file
@@ -142,14 +147,18 @@ TapedConfiguration TapedConfiguration::createFromCtaConf(
   
   ret.bufferSizeBytes.log(log);
   ret.bufferCount.log(log);
+  ret.useHugePages.log(log);
+  ret.lockMemoryBuffers.log(log);
   
   ret.archiveFetchBytesFiles.log(log);
   ret.archiveFlushBytesFiles.log(log);
   ret.retrieveFetchBytesFiles.log(log);
   
   ret.mountCriteria.log(log);
+  ret.mountInfoSnapshotMaxAge.log(log);
   
   ret.nbDiskThreads.log(log);
+  ret.xrootAsyncRequests.log(log);
   ret.useRAO.log(log);
 
   ret.wdIdleSessionTimer.log(log);
@@ -163,6 +172,7 @@ TapedConfiguration TapedConfiguration::createFromCtaConf(
   ret.disableRepackManagement.log(log);
   ret.disableMaintenanceProcess.log(log);
   ret.fetchEosFreeSpaceScript.log(log);
+  ret.diskSystemFreeSpaceCacheFile.log(log);
   
   ret.tapeLoadTimeout.log(log);
   
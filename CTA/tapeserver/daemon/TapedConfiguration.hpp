@@ -66,6 +66,12 @@ struct TapedConfiguration {
   /// Memory buffer count per drive. There is no default to this one.
   cta::SourcedParameter<uint64_t> bufferCount{
     "taped", "BufferCount"};
+  /// Back the memory buffers with huge pages (explicit if reserved, transparent otherwise).
+  cta::SourcedParameter<std::string> useHugePages{
+    "taped", "UseHugePages", "no", "Compile time default"};
+  /// Lock the memory buffers in RAM (requires CAP_IPC_LOCK or a sufficient memlock limit).
+  cta::SourcedParameter<std::string> lockMemoryBuffers{
+    "taped", "LockMemoryBuffers", "no", "Compile time default"};
   //----------------------------------------------------------------------------
   // Batched metadata access and tape write flush parameters 
   //----------------------------------------------------------------------------
@@ -83,12 +89,18 @@ struct TapedConfiguration {
   //----------------------------------------------------------------------------
   cta::SourcedParameter<FetchReportOrFlushLimits> mountCriteria{
     "taped", "MountCriteria", {80L*1000*1000*1000, 500}, "Compile time default"};
+  /// Time during which the queue summaries read for a mount decision are reused by the next one
+  cta::SourcedParameter<time_t> mountInfoSnapshotMaxAge{
+    "taped", "MountInfoSnapshotMaxAge", 5, "Compile time default"};
   //----------------------------------------------------------------------------
   // Disk file access parameters
   //----------------------------------------------------------------------------
   /// Number of disk threads. This is the number of parallel file transfers.
   cta::SourcedParameter<uint64_t> nbDiskThreads{
     "taped", "NbDiskThreads", 10, "Compile time default"};
+  /// Number of asynchronous XRootD reads or writes in flight per disk file (1 for synchronous transfers)
+  cta::SourcedParameter<uint32_t> xrootAsyncRequests{
+    "taped", "XrootAsyncRequests", 1, "Compile time default"};
   //----------------------------------------------------------------------------
   // Recommended Access Order usage
   //----------------------------------------------------------------------------
@@ -107,6 +119,10 @@ struct TapedConfiguration {
   cta::SourcedParameter<std::string> fetchEosFreeSpaceScript {
     "taped", "FetchEosFreeSpaceScript","", "Compile time default"
   };
+  /// File through which the drive processes of the host share the free space of the disk systems
+  cta::SourcedParameter<std::string> diskSystemFreeSpaceCacheFile {
+    "taped", "DiskSystemFreeSpaceCacheFile","", "Compile time default"
+  };
   //----------------------------------------------------------------------------
   // Watchdog: parameters for timeouts in various situations.
   //----------------------------------------------------------------------------
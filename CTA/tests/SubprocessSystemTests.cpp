@@ -18,6 +18,7 @@
 #include "common/threading/SubProcess.hpp"
 
 #include <gtest/gtest.h>
+#include <signal.h>
 
 namespace systemTests {  
 TEST(SubProcessHelper, basicTests) {
@@ -46,4 +47,20 @@ TEST(SubProcessHelper, testSubprocessWithStdinInput) {
   ASSERT_EQ(0, sp2.exitValue());
   ASSERT_EQ("", sp2.stderr());
 }
+
+TEST(SubProcessHelper, testSubprocessWithTimeout) {
+  cta::threading::SubProcess sp("echo", std::list<std::string>({"echo", "Hello,", "world."}));
+  ASSERT_TRUE(sp.wait(10000));
+  ASSERT_EQ("Hello, world.\n", sp.stdout());
+  ASSERT_EQ(0, sp.exitValue());
+  cta::threading::SubProcess sp2("sleep", std::list<std::string>({"sleep", "10"}));
+  ASSERT_FALSE(sp2.wait(100));
+  ASSERT_TRUE(sp2.wasKilled());
+  ASSERT_EQ(SIGKILL, sp2.killSignal());
+  // A child closing its outputs before the timeout is still killed if it does not exit in time.
+  cta::threading::SubProcess sp3("sh", std::list<std::string>({"sh", "-c", "exec >&- 2>&-; sleep 10"}));
+  ASSERT_FALSE(sp3.wait(100));
+  ASSERT_TRUE(sp3.wasKilled());
+  ASSERT_EQ(SIGKILL, sp3.killSignal());
+}
 }
@@ -300,43 +300,7 @@ void RequestMessage::process(const cta::xrd::Request &request, cta::xrd::Respons
          break;
 
       case Request::kNotification:
-         // Validate that instance name in key used to authenticate matches instance name in Protocol buffer
-         if(m_cliIdentity.username != request.notification().wf().instance().name()) {
-            // Special case: allow KRB5 authentication for CLOSEW and PREPARE events, to allow operators
-            // to use a command line tool to resubmit failed archive or prepare requests. This is NOT
-            // permitted for DELETE events as we don't want files removed from the catalogue to be left
-            // in the EOS namespace.
-            if(m_protocol == Protocol::KRB5 &&
-               (request.notification().wf().event() == cta::eos::Workflow::CLOSEW ||
-                request.notification().wf().event() == cta::eos::Workflow::PREPARE)) {
-               m_scheduler.authorizeAdmin(m_cliIdentity, m_lc);
-               m_cliIdentity.username = request.notification().wf().instance().name();
-            } else {
-               throw PbException("Instance name \"" + request.notification().wf().instance().name() +
-                                 "\" does not match key identifier \"" + m_cliIdentity.username + "\"");
-            }
-         }
-
-         // Refuse any workflow events for files in /eos/INSTANCE_NAME/proc/
-         {
-           const std::string &longInstanceName = request.notification().wf().instance().name();
-           const bool longInstanceNameStartsWithEos = 0 == longInstanceName.find("eos");
-           const std::string shortInstanceName =
-             longInstanceNameStartsWithEos ? longInstanceName.substr(3) : longInstanceName;
-           if(shortInstanceName.empty()) {
-             std::ostringstream msg;
-             msg << "Short instance name is an empty string: instance=" << longInstanceName;
-             throw PbException(msg.str());
-           }
-           const std::string procFullPath = std::string("/eos/") + shortInstanceName + "/proc/";
-           if(request.notification().file().lpath().find(procFullPath) == 0) {
-             std::ostringstream msg;
-             msg << "Cannot process a workflow event for a file in " << procFullPath << " instance=" << longInstanceName
-               << " event=" << Workflow_EventType_Name(request.notification().wf().event()) << " lpath=" <<
-               request.notification().file().lpath();
-             throw PbException(msg.str());
-           }
-         }
+         checkNotification(request.notification());
 
          // Map the Workflow Event to a method
          switch(request.notification().wf().event()) {
@@ -371,6 +335,10 @@ void RequestMessage::process(const cta::xrd::Request &request, cta::xrd::Respons
          }
          break;
 
+      case Request::kNotificationBatch:
+         processCLOSEW_Batch(request.notification_batch(), response);
+         break;
+
       case Request::REQUEST_NOT_SET:
          throw PbException("Request message has not been set.");
 
@@ -384,6 +352,49 @@ void RequestMessage::process(const cta::xrd::Request &request, cta::xrd::Respons
 
 // EOS Workflow commands
 
+void RequestMessage::checkNotification(const cta::eos::Notification &notification)
+{
+   // Validate that instance name in key used to authenticate matches instance name in Protocol buffer
+   if(m_cliIdentity.username != notification.wf().instance().name()) {
+      // Special case: allow KRB5 authentication for CLOSEW and PREPARE events, to allow operators
+      // to use a command line tool to resubmit failed archive or prepare requests. This is NOT
+      // permitted for DELETE events as we don't want files removed from the catalogue to be left
+      // in the EOS namespace.
+      if(m_protocol == Protocol::KRB5 &&
+         (notification.wf().event() == cta::eos::Workflow::CLOSEW ||
+          notification.wf().event() == cta::eos::Workflow::PREPARE)) {
+         m_scheduler.authorizeAdmin(m_cliIdentity, m_lc);
+         m_cliIdentity.username = notification.wf().instance().name();
+      } else {
+         throw PbException("Instance name \"" + notification.wf().instance().name() +
+                           "\" does not match key identifier \"" + m_cliIdentity.username + "\"");
+      }
+   }
+
+   // Refuse any workflow events for files in /eos/INSTANCE_NAME/proc/
+   {
+     const std::string &longInstanceName = notification.wf().instance().name();
+     const bool longInstanceNameStartsWithEos = 0 == longInstanceName.find("eos");
+     const std::string shortInstanceName =
+       longInstanceNameStartsWithEos ? longInstanceName.substr(3) : longInstanceName;
+     if(shortInstanceName.empty()) {
+       std::ostringstream msg;
+       msg << "Short instance name is an empty string: instance=" << longInstanceName;
+       throw PbException(msg.str());
+     }
+     const std::string procFullPath = std::string("/eos/") + shortInstanceName + "/proc/";
+     if(notification.file().lpath().find(procFullPath) == 0) {
+       std::ostringstream msg;
+       msg << "Cannot process a workflow event for a file in " << procFullPath << " instance=" << longInstanceName
+         << " event=" << Workflow_EventType_Name(notification.wf().event()) << " lpath=" <<
+         notification.file().lpath();
+       throw PbException(msg.str());
+     }
+   }
+}
+
+
+
 void RequestMessage::processOPENW(const cta::eos::Notification &notification, cta::xrd::Response &response)
 {
    // Create a log entry
@@ -452,7 +463,7 @@ void RequestMessage::processCREATE(const cta::eos::Notification &notification, c
 
 
 
-void RequestMessage::processCLOSEW(const cta::eos::Notification &notification, cta::xrd::Response &response)
+uint64_t RequestMessage::unpackCLOSEW(const cta::eos::Notification &notification, cta::common::dataStructures::ArchiveRequest &request)
 {
    // Validate received protobuf
    checkIsNotEmptyString(notification.cli().user().username(),    "notification.cli.user.username");
@@ -480,7 +491,6 @@ void RequestMessage::processCLOSEW(const cta::eos::Notification &notification, c
                                  " bytes) exceeds maximum allowed size (" + std::to_string(storageClass.vo.maxFileSize) + " bytes)");
    }
 
-   cta::common::dataStructures::ArchiveRequest request;
    checksum::ProtobufToChecksumBlob(notification.file().csb(), request.checksumBlob);
    request.diskFileInfo.owner_uid = notification.file().owner().uid();
    request.diskFileInfo.gid       = notification.file().owner().gid();
@@ -499,7 +509,7 @@ void RequestMessage::processCLOSEW(const cta::eos::Notification &notification, c
 
    cta::log::ScopedParamContainer params(m_lc);
    params.add("requesterInstance", notification.wf().requester_instance());
-   std::string logMessage = "In RequestMessage::processCLOSEW(): ";
+   std::string logMessage = "In RequestMessage::unpackCLOSEW(): ";
 
    // CTA Archive ID is an EOS extended attribute, i.e. it is stored as a string, which
    // must be converted to a valid uint64_t
@@ -518,7 +528,19 @@ void RequestMessage::processCLOSEW(const cta::eos::Notification &notification, c
       m_lc.log(cta::log::INFO, logMessage);
       throw PbException("Invalid archiveFileID " + archiveFileIdStr);
    }
+   return archiveFileId;
+}
+
+
+void RequestMessage::processCLOSEW(const cta::eos::Notification &notification, cta::xrd::Response &response)
+{
+   cta::common::dataStructures::ArchiveRequest request;
+   const uint64_t archiveFileId = unpackCLOSEW(notification, request);
+
+   cta::log::ScopedParamContainer params(m_lc);
+   params.add("requesterInstance", notification.wf().requester_instance());
    params.add("fileId", archiveFileId);
+   std::string logMessage = "In RequestMessage::processCLOSEW(): ";
 
    cta::utils::Timer t;
 
@@ -543,6 +565,103 @@ void RequestMessage::processCLOSEW(const cta::eos::Notification &notification, c
 }
 
 
+void RequestMessage::processCLOSEW_Batch(const cta::eos::NotificationBatch &batch, cta::xrd::Response &response)
+{
+   // All the notifications of a batch come from the same instance
+   if(batch.notifications().empty()) {
+      throw PbException("Notification batch is empty.");
+   }
+   const std::string &instanceName = batch.notifications(0).wf().instance().name();
+   for(auto &notification : batch.notifications()) {
+      if(notification.wf().instance().name() != instanceName) {
+         throw PbException("Notification batch mixes instances \"" + instanceName + "\" and \"" +
+                           notification.wf().instance().name() + "\"");
+      }
+   }
+
+   // Unpack the notifications. A notification which cannot be unpacked gets its error response, the
+   // others are still queued.
+   std::vector<cta::Scheduler::ArchiveRequestWithGivenId> requests;
+   std::vector<int> requestsResponseIndexes;
+   for(auto &notification : batch.notifications()) {
+      auto &notificationResponse = *response.add_batch_responses();
+      try {
+         if(notification.wf().event() != cta::eos::Workflow::CLOSEW) {
+            throw PbException("Workflow event " + cta::eos::Workflow_EventType_Name(notification.wf().event()) +
+                              " cannot be sent in a notification batch.");
+         }
+         checkNotification(notification);
+         cta::Scheduler::ArchiveRequestWithGivenId request;
+         request.archiveFileId = unpackCLOSEW(notification, request.request);
+         if(request.request.fileSize > 0) {
+            requests.push_back(request);
+            requestsResponseIndexes.push_back(response.batch_responses_size() - 1);
+         } else {
+            notificationResponse.set_type(cta::xrd::Response::RSP_SUCCESS);
+         }
+      } catch(...) {
+         setBatchItemError(std::current_exception(), notificationResponse);
+      }
+   }
+
+   // Queue the requests together
+   cta::utils::Timer t;
+   const auto outcomes = m_scheduler.queueArchiveBatch(m_cliIdentity.username, requests, m_lc);
+   uint64_t queuedRequests = 0;
+   for(size_t i = 0; i < outcomes.size(); ++i) {
+      auto &notificationResponse = *response.mutable_batch_responses(requestsResponseIndexes[i]);
+      if(outcomes[i].error) {
+         setBatchItemError(outcomes[i].error, notificationResponse);
+         continue;
+      }
+      // Add archive request reference to response as an extended attribute
+      notificationResponse.mutable_xattr()->insert(google::protobuf::MapPair<std::string,std::string>("sys.cta.objectstore.id", outcomes[i].archiveRequestAddr));
+      notificationResponse.set_type(cta::xrd::Response::RSP_SUCCESS);
+      ++queuedRequests;
+   }
+
+   // Create a log entry
+   cta::log::ScopedParamContainer params(m_lc);
+   params.add("notifications", batch.notifications_size())
+         .add("queuedRequests", queuedRequests)
+         .add("schedulerTime", t.secs());
+   m_lc.log(cta::log::INFO, "In RequestMessage::processCLOSEW_Batch(): processed notification batch.");
+
+   // Set response type: the outcome of each notification is in its own response
+   response.set_type(cta::xrd::Response::RSP_SUCCESS);
+}
+
+
+void RequestMessage::setBatchItemError(const std::exception_ptr &error, cta::xrd::Response &response)
+{
+   // Same mapping of the exceptions as for a whole request
+   try {
+      std::rethrow_exception(error);
+   } catch(PbException &ex) {
+      response.set_type(cta::xrd::Response::RSP_ERR_PROTOBUF);
+      response.set_message_txt(ex.what());
+   } catch(cta::exception::UserError &ex) {
+      response.set_type(cta::xrd::Response::RSP_ERR_USER);
+      response.set_message_txt(ex.getMessageValue());
+   } catch(cta::exception::Exception &ex) {
+      response.set_type(cta::xrd::Response::RSP_ERR_CTA);
+      response.set_message_txt(ex.getMessageValue());
+   } catch(std::runtime_error &ex) {
+      response.set_type(cta::xrd::Response::RSP_ERR_CTA);
+      response.set_message_txt(ex.what());
+   } catch(std::exception &ex) {
+      response.set_type(cta::xrd::Response::RSP_ERR_CTA);
+      response.set_message_txt(ex.what());
+   } catch(...) {
+      // Only this notification fails, the rest of the batch is still answered
+      response.set_type(cta::xrd::Response::RSP_ERR_CTA);
+      response.set_message_txt("Unknown exception");
+   }
+   m_lc.log(cta::log::ERR, "In RequestMessage::processCLOSEW_Batch(): " +
+            cta::xrd::Response::ResponseType_Name(response.type()) + ": " + response.message_txt());
+}
+
+
 void RequestMessage::processPREPARE(const cta::eos::Notification &notification, cta::xrd::Response &response)
 {
    // Validate received protobuf
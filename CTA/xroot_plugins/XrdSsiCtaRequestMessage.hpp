@@ -156,6 +156,36 @@ private:
   void processDELETE       (const cta::eos::Notification &notification, cta::xrd::Response &response);    //!< Delete file event
   void processUPDATE_FID   (const cta::eos::Notification &notification, cta::xrd::Response &response);    //!< Disk file ID update event
 
+  /*!
+   * Process a batch of CLOSEW events. The archive requests are queued together and each notification
+   * gets its own response in response.batch_responses, in the order of the notifications.
+   *
+   * @param[in]     batch           Notifications from EOS WFE
+   * @param[out]    response        Response message to return to EOS
+   */
+  void processCLOSEW_Batch(const cta::eos::NotificationBatch &batch, cta::xrd::Response &response);
+
+  /*!
+   * Check that a Notification can be processed: the instance name must match the key used to
+   * authenticate and the file must not be in the proc directory of the instance
+   */
+  void checkNotification(const cta::eos::Notification &notification);
+
+  /*!
+   * Validate and unpack a CLOSEW event
+   *
+   * @param[in]     notification    Notification request message from EOS WFE
+   * @param[out]    request         The archive request
+   *
+   * @returns       The archive file ID
+   */
+  uint64_t unpackCLOSEW(const cta::eos::Notification &notification, cta::common::dataStructures::ArchiveRequest &request);
+
+  /*!
+   * Set the response to one notification of a batch from the error raised while processing it
+   */
+  void setBatchItemError(const std::exception_ptr &error, cta::xrd::Response &response);
+
   /*!
    * Process AdminCmd events
    *
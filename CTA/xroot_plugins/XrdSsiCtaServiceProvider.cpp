@@ -18,6 +18,7 @@
 #include "catalogue/CatalogueFactoryFactory.hpp"
 #include "cta_frontend.pb.h"
 #include "common/make_unique.hpp"
+#include "common/log/AsyncLogger.hpp"
 #include "common/log/SyslogLogger.hpp"
 #include "common/log/StdoutLogger.hpp"
 #include "common/log/FileLogger.hpp"
@@ -101,6 +102,16 @@ void XrdSsiCtaServiceProvider::ExceptionThrowingInit(XrdSsiLogger *logP, XrdSsiC
       } else {
          throw exception::UserError(std::string("Unknown log URL: ") + loggerURL.second);
       }
+
+      // Optionally format and write the log messages in a background thread
+      auto loggerAsync = config.getOptionValueStr("cta.log.async");
+      if(loggerAsync.first && loggerAsync.second == "true") {
+         m_log.reset(new log::AsyncLogger(std::move(m_log)));
+      }
+
+      // Set the logger format
+      auto loggerFormat = config.getOptionValueStr("cta.log.format");
+      if(loggerFormat.first) m_log->setLogFormat(loggerFormat.second);
    } catch(exception::Exception &ex) {
       std::string ex_str("Failed to instantiate object representing CTA logging system: ");
       throw exception::Exception(ex_str + ex.getMessage().str());